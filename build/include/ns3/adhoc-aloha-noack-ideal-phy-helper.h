@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/helper/adhoc-aloha-noack-ideal-phy-helper.h"
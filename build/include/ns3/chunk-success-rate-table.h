@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/chunk-success-rate-table.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/non-ht/dsss-ppdu.h"
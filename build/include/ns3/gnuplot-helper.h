@@ -0,0 +1 @@
+#include "/root/repo/src/stats/helper/gnuplot-helper.h"
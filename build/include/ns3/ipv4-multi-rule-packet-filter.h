@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/ipv4-multi-rule-packet-filter.h"
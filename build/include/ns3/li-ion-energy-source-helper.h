@@ -0,0 +1 @@
+#include "/root/repo/src/energy/helper/li-ion-energy-source-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/internet/helper/neighbor-cache-helper.h"
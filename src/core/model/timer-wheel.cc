@@ -0,0 +1,425 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "timer-wheel.h"
+
+#include "abort.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::TimerWheel and ns3::WheelTimer class implementations.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TimerWheel");
+
+NS_OBJECT_ENSURE_REGISTERED(TimerWheel);
+
+TypeId
+TimerWheel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TimerWheel")
+            .SetParent<Object>()
+            .SetGroupName("Core")
+            .AddConstructor<TimerWheel>()
+            .AddAttribute("Resolution",
+                          "The duration of a tick of the wheel: timers expire at the end of "
+                          "the tick containing their nominal expiration time. Cannot be "
+                          "changed while timers are running.",
+                          TimeValue(MilliSeconds(1)),
+                          MakeTimeAccessor(&TimerWheel::SetResolution, &TimerWheel::GetResolution),
+                          MakeTimeChecker(TimeStep(1)));
+    return tid;
+}
+
+TimerWheel::TimerWheel()
+    : m_resolution(MilliSeconds(1)),
+      m_now(0),
+      m_nTimers(0),
+      m_eventTick(0)
+{
+    NS_LOG_FUNCTION(this);
+    m_occupied.fill(0);
+    m_heads.fill(nullptr);
+    m_tails.fill(nullptr);
+}
+
+TimerWheel::~TimerWheel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TimerWheel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_event.Cancel();
+    for (uint32_t list = 0; list < NO_LIST; ++list)
+    {
+        WheelTimer* timer = m_heads[list];
+        while (timer != nullptr)
+        {
+            WheelTimer* next = timer->m_next;
+            timer->m_prev = nullptr;
+            timer->m_next = nullptr;
+            timer->m_list = NO_LIST;
+            timer = next;
+        }
+    }
+    m_occupied.fill(0);
+    m_heads.fill(nullptr);
+    m_tails.fill(nullptr);
+    m_nTimers = 0;
+    Object::DoDispose();
+}
+
+void
+TimerWheel::SetResolution(Time resolution)
+{
+    NS_LOG_FUNCTION(this << resolution);
+    NS_ABORT_MSG_IF(m_nTimers > 0, "Cannot change the resolution of a wheel with running timers");
+    m_event.Cancel();
+    m_resolution = resolution;
+    m_now = 0;
+}
+
+Time
+TimerWheel::GetResolution() const
+{
+    return m_resolution;
+}
+
+uint32_t
+TimerWheel::GetNTimers() const
+{
+    return m_nTimers;
+}
+
+void
+TimerWheel::Start(WheelTimer* timer, const Time& delay)
+{
+    NS_LOG_FUNCTION(this << timer << delay);
+    NS_ASSERT(timer->m_list == NO_LIST);
+
+    const int64_t resolution = m_resolution.GetTimeStep();
+    const auto current = static_cast<uint64_t>(Simulator::Now().GetTimeStep() / resolution);
+
+    // Nothing needs to be processed before the pending event, hence the
+    // wheel can be moved forward to the current tick without cascading
+    if (m_event.IsRunning())
+    {
+        m_now = std::max(m_now, std::min(current, m_eventTick - 1));
+    }
+    else
+    {
+        m_now = std::max(m_now, current);
+    }
+
+    const int64_t expiry = (Simulator::Now() + delay).GetTimeStep();
+    timer->m_tick = std::max(static_cast<uint64_t>((expiry + resolution - 1) / resolution),
+                             m_now + 1);
+    Place(timer);
+    ++m_nTimers;
+
+    // Only the slot of the new timer may need an earlier event
+    uint64_t tick;
+    if (timer->m_list == OVERFLOW_LIST)
+    {
+        tick = ((m_now >> (SLOT_BITS * LEVELS)) + 1) << (SLOT_BITS * LEVELS);
+    }
+    else
+    {
+        uint32_t level = timer->m_list / SLOTS;
+        uint64_t prefix = m_now >> (SLOT_BITS * (level + 1)) << (SLOT_BITS * (level + 1));
+        tick = prefix | (static_cast<uint64_t>(timer->m_list % SLOTS) << (SLOT_BITS * level));
+    }
+    UpdateEvent(tick);
+}
+
+void
+TimerWheel::Stop(WheelTimer* timer)
+{
+    NS_LOG_FUNCTION(this << timer);
+    NS_ASSERT(timer->m_list != NO_LIST);
+    // The event of the wheel is left in place: if no longer needed, it will
+    // just find nothing to process
+    Unlink(timer);
+    --m_nTimers;
+}
+
+void
+TimerWheel::Place(WheelTimer* timer)
+{
+    if (timer->m_tick <= m_now)
+    {
+        Link(timer, DUE_LIST);
+        return;
+    }
+    // The level is given by the most significant digit in which the
+    // expiration tick differs from the current tick
+    uint64_t diff = timer->m_tick ^ m_now;
+    for (uint32_t level = 0; level < LEVELS; ++level)
+    {
+        if ((diff >> (SLOT_BITS * (level + 1))) == 0)
+        {
+            uint32_t slot = (timer->m_tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+            Link(timer, level * SLOTS + slot);
+            m_occupied[level] |= (uint64_t(1) << slot);
+            return;
+        }
+    }
+    Link(timer, OVERFLOW_LIST);
+}
+
+void
+TimerWheel::Link(WheelTimer* timer, uint32_t list)
+{
+    timer->m_list = list;
+    timer->m_next = nullptr;
+    timer->m_prev = m_tails[list];
+    if (m_tails[list] != nullptr)
+    {
+        m_tails[list]->m_next = timer;
+    }
+    else
+    {
+        m_heads[list] = timer;
+    }
+    m_tails[list] = timer;
+}
+
+void
+TimerWheel::Unlink(WheelTimer* timer)
+{
+    uint32_t list = timer->m_list;
+    if (timer->m_prev != nullptr)
+    {
+        timer->m_prev->m_next = timer->m_next;
+    }
+    else
+    {
+        m_heads[list] = timer->m_next;
+    }
+    if (timer->m_next != nullptr)
+    {
+        timer->m_next->m_prev = timer->m_prev;
+    }
+    else
+    {
+        m_tails[list] = timer->m_prev;
+    }
+    if (list < OVERFLOW_LIST && m_heads[list] == nullptr)
+    {
+        m_occupied[list / SLOTS] &= ~(uint64_t(1) << (list % SLOTS));
+    }
+    timer->m_prev = nullptr;
+    timer->m_next = nullptr;
+    timer->m_list = NO_LIST;
+}
+
+void
+TimerWheel::Cascade(uint32_t list)
+{
+    WheelTimer* timer = m_heads[list];
+    m_heads[list] = nullptr;
+    m_tails[list] = nullptr;
+    if (list < OVERFLOW_LIST)
+    {
+        m_occupied[list / SLOTS] &= ~(uint64_t(1) << (list % SLOTS));
+    }
+    while (timer != nullptr)
+    {
+        WheelTimer* next = timer->m_next;
+        Place(timer);
+        timer = next;
+    }
+}
+
+uint64_t
+TimerWheel::GetNextTick() const
+{
+    if (m_heads[DUE_LIST] != nullptr)
+    {
+        return m_now;
+    }
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (uint32_t level = 0; level < LEVELS; ++level)
+    {
+        // The occupied slots of a level always follow the current one
+        uint32_t digit = (m_now >> (SLOT_BITS * level)) & (SLOTS - 1);
+        uint64_t following = (digit + 1 < SLOTS) ? m_occupied[level] >> (digit + 1) : 0;
+        NS_ASSERT((m_occupied[level] & ((uint64_t(2) << digit) - 1)) == 0);
+        if (following == 0)
+        {
+            continue;
+        }
+        uint32_t slot = digit + 1;
+        while ((following & 1) == 0)
+        {
+            following >>= 1;
+            ++slot;
+        }
+        uint64_t prefix = m_now >> (SLOT_BITS * (level + 1)) << (SLOT_BITS * (level + 1));
+        next = std::min(next, prefix | (static_cast<uint64_t>(slot) << (SLOT_BITS * level)));
+    }
+    if (m_heads[OVERFLOW_LIST] != nullptr)
+    {
+        next = std::min(next, ((m_now >> (SLOT_BITS * LEVELS)) + 1) << (SLOT_BITS * LEVELS));
+    }
+    return next;
+}
+
+void
+TimerWheel::UpdateEvent(uint64_t tick)
+{
+    if (m_event.IsRunning())
+    {
+        if (m_eventTick <= tick)
+        {
+            return;
+        }
+        m_event.Cancel();
+    }
+    NS_LOG_LOGIC("Process the wheel at tick " << tick);
+    m_eventTick = tick;
+    Time at = TimeStep(tick * m_resolution.GetTimeStep());
+    m_event = Simulator::Schedule(at - Simulator::Now(), &TimerWheel::Expire, this);
+}
+
+void
+TimerWheel::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    m_now = m_eventTick;
+
+    // Move down the timers of the slots that start in this tick, from the
+    // top of the hierarchy, so that the due ones end up in the due list
+    if ((m_now & ((uint64_t(1) << (SLOT_BITS * LEVELS)) - 1)) == 0)
+    {
+        Cascade(OVERFLOW_LIST);
+    }
+    for (uint32_t level = LEVELS; level-- > 0;)
+    {
+        if ((m_now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0)
+        {
+            uint32_t slot = (m_now >> (SLOT_BITS * level)) & (SLOTS - 1);
+            Cascade(level * SLOTS + slot);
+        }
+    }
+
+    // The expire functions may start or cancel any timer, including the due ones
+    while (m_heads[DUE_LIST] != nullptr)
+    {
+        WheelTimer* timer = m_heads[DUE_LIST];
+        Unlink(timer);
+        --m_nTimers;
+        timer->Invoke();
+    }
+
+    if (m_nTimers > 0)
+    {
+        UpdateEvent(GetNextTick());
+    }
+}
+
+WheelTimer::WheelTimer()
+    : m_wheel(nullptr),
+      m_impl(nullptr),
+      m_tick(0),
+      m_list(TimerWheel::NO_LIST),
+      m_prev(nullptr),
+      m_next(nullptr)
+{
+}
+
+WheelTimer::~WheelTimer()
+{
+    Cancel();
+    delete m_impl;
+}
+
+void
+WheelTimer::SetWheel(Ptr<TimerWheel> wheel)
+{
+    NS_ASSERT_MSG(!IsRunning(), "Cannot change the wheel of a running timer");
+    m_wheel = wheel;
+}
+
+Ptr<TimerWheel>
+WheelTimer::GetWheel() const
+{
+    return m_wheel;
+}
+
+void
+WheelTimer::Schedule(Time delay)
+{
+    NS_ASSERT_MSG(m_wheel, "No wheel set for this timer");
+    NS_ASSERT_MSG(m_impl != nullptr, "You cannot schedule a WheelTimer before setting its function");
+    if (IsRunning())
+    {
+        m_wheel->Stop(this);
+    }
+    m_wheel->Start(this, delay);
+}
+
+void
+WheelTimer::Cancel()
+{
+    if (IsRunning())
+    {
+        m_wheel->Stop(this);
+    }
+}
+
+bool
+WheelTimer::IsRunning() const
+{
+    return m_list != TimerWheel::NO_LIST;
+}
+
+bool
+WheelTimer::IsExpired() const
+{
+    return !IsRunning();
+}
+
+Time
+WheelTimer::GetDelayLeft() const
+{
+    if (!IsRunning())
+    {
+        return Seconds(0);
+    }
+    Time at = TimeStep(m_tick * m_wheel->GetResolution().GetTimeStep());
+    return Max(at - Simulator::Now(), Seconds(0));
+}
+
+void
+WheelTimer::Invoke()
+{
+    m_impl->Invoke();
+}
+
+} // namespace ns3
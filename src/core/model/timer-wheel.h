@@ -0,0 +1,323 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "event-id.h"
+#include "nstime.h"
+#include "object.h"
+#include "ptr.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::TimerWheel and ns3::WheelTimer class declarations.
+ */
+
+namespace ns3
+{
+
+class TimerImpl;
+class WheelTimer;
+
+/**
+ * \ingroup timer
+ * \brief A hierarchical timing wheel for coarse-grained timers
+ *
+ * Protocols often arm a timer and then cancel or move it long before it
+ * expires: a TCP retransmission timer is restarted on nearly every ACK,
+ * a neighbor cache entry is refreshed on every packet.  Doing so with
+ * Simulator::Schedule and EventId::Cancel inserts a new event in the
+ * scheduler every time, while the cancelled ones are only removed when
+ * they reach the head of the event queue.
+ *
+ * A TimerWheel manages any number of WheelTimer instances with a single
+ * pending simulator event.  Time is divided in ticks of fixed Resolution,
+ * and each timer expires at the end of the tick containing its nominal
+ * expiration time, i.e., up to one Resolution late.  Timers are stored in
+ * the slots of a hierarchy of wheels (Varghese and Lauck, 1987): starting,
+ * cancelling and restarting a timer are O(1) operations which never touch
+ * the simulator event queue, unless the timer becomes the earliest one
+ * managed by the wheel.
+ *
+ * The simulator event of the wheel is scheduled in the context in which
+ * the first timer was started, hence a TimerWheel should only be shared by
+ * timers belonging to the same context (e.g., aggregated to a Node).
+ *
+ * \see WheelTimer
+ */
+class TimerWheel : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TimerWheel();
+    ~TimerWheel() override;
+
+    /**
+     * Set the duration of a tick of the wheel.  No timer must be running.
+     *
+     * \param resolution the duration of a tick
+     */
+    void SetResolution(Time resolution);
+
+    /**
+     * \return the duration of a tick of the wheel
+     */
+    Time GetResolution() const;
+
+    /**
+     * \return the number of timers currently running on this wheel
+     */
+    uint32_t GetNTimers() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    friend class WheelTimer;
+
+    /// Number of bits of the tick index used by each level of the hierarchy
+    static constexpr uint32_t SLOT_BITS = 6;
+    /// Number of slots per level of the hierarchy
+    static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+    /// Number of levels of the hierarchy
+    static constexpr uint32_t LEVELS = 4;
+    /// Index of the list of timers beyond the span of the hierarchy
+    static constexpr uint32_t OVERFLOW_LIST = LEVELS * SLOTS;
+    /// Index of the list of timers due in the current tick
+    static constexpr uint32_t DUE_LIST = OVERFLOW_LIST + 1;
+    /// Index meaning that the timer is not in any list
+    static constexpr uint32_t NO_LIST = DUE_LIST + 1;
+
+    /**
+     * Start a timer, which must not be running.
+     *
+     * \param timer the timer
+     * \param delay the delay after which the timer expires
+     */
+    void Start(WheelTimer* timer, const Time& delay);
+    /**
+     * Stop a running timer.
+     *
+     * \param timer the timer
+     */
+    void Stop(WheelTimer* timer);
+    /**
+     * Place a timer in the list matching its expiration tick.
+     *
+     * \param timer the timer
+     */
+    void Place(WheelTimer* timer);
+    /**
+     * Append a timer to a list.
+     *
+     * \param timer the timer
+     * \param list the index of the list
+     */
+    void Link(WheelTimer* timer, uint32_t list);
+    /**
+     * Remove a timer from the list it belongs to.
+     *
+     * \param timer the timer
+     */
+    void Unlink(WheelTimer* timer);
+    /**
+     * Move all the timers of a slot to the lists matching their expiration tick.
+     *
+     * \param list the index of the list
+     */
+    void Cascade(uint32_t list);
+    /**
+     * \return the next tick in which a slot needs to be processed
+     */
+    uint64_t GetNextTick() const;
+    /**
+     * Make sure that the simulator event of the wheel is scheduled no later
+     * than the given tick.
+     *
+     * \param tick the tick in which a slot needs to be processed
+     */
+    void UpdateEvent(uint64_t tick);
+    /**
+     * Process the slots of the current tick, and invoke the expired timers.
+     */
+    void Expire();
+
+    Time m_resolution;    //!< Duration of a tick
+    uint64_t m_now;       //!< Last tick processed
+    uint32_t m_nTimers;   //!< Number of running timers
+    EventId m_event;      //!< Event processing the next tick
+    uint64_t m_eventTick; //!< Tick of the pending event
+
+    std::array<uint64_t, LEVELS> m_occupied;  //!< Bitmap of the non-empty slots per level
+    std::array<WheelTimer*, NO_LIST> m_heads; //!< Head of each list
+    std::array<WheelTimer*, NO_LIST> m_tails; //!< Tail of each list
+};
+
+/**
+ * \ingroup timer
+ * \brief A timer managed by a TimerWheel
+ *
+ * A WheelTimer holds together a function to invoke and the arguments to pass
+ * to it, like a Timer, but its expiration is managed by a TimerWheel: it can
+ * be started, cancelled and restarted at any time without scheduling nor
+ * cancelling simulator events.  A timer expires at the end of the tick of the
+ * wheel containing its nominal expiration time.
+ *
+ * A running WheelTimer is cancelled when destroyed.
+ */
+class WheelTimer
+{
+  public:
+    WheelTimer();
+    /** Destructor, cancelling the timer if running. */
+    ~WheelTimer();
+
+    /** Copying a WheelTimer is not allowed. */
+    WheelTimer(const WheelTimer&) = delete;
+    /**
+     * Copying a WheelTimer is not allowed.
+     * \return a reference to this timer
+     */
+    WheelTimer& operator=(const WheelTimer&) = delete;
+
+    /**
+     * Set the wheel managing this timer.  The timer must not be running.
+     *
+     * \param [in] wheel The wheel
+     */
+    void SetWheel(Ptr<TimerWheel> wheel);
+
+    /**
+     * \return the wheel managing this timer
+     */
+    Ptr<TimerWheel> GetWheel() const;
+
+    /**
+     * Set the function to execute when the timer expires.
+     *
+     * \tparam FN \deduced The type of the function.
+     * \param [in] fn The function
+     */
+    template <typename FN>
+    void SetFunction(FN fn);
+
+    /**
+     * Set the function to execute when the timer expires.
+     *
+     * \tparam MEM_PTR \deduced Class method function type.
+     * \tparam OBJ_PTR \deduced Class type containing the function.
+     * \param [in] memPtr The member function pointer
+     * \param [in] objPtr The pointer to object
+     */
+    template <typename MEM_PTR, typename OBJ_PTR>
+    void SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr);
+
+    /**
+     * Set the arguments to be used when invoking the expire function.
+     *
+     * \tparam Ts \deduced Argument types.
+     * \param [in] args arguments
+     */
+    template <typename... Ts>
+    void SetArguments(Ts&&... args);
+
+    /**
+     * Start the timer, restarting it if already running.
+     *
+     * \param [in] delay The delay after which the timer expires
+     */
+    void Schedule(Time delay);
+
+    /** Cancel the timer, if running. */
+    void Cancel();
+
+    /** \return true if the timer is running */
+    bool IsRunning() const;
+
+    /** \return true if the timer is not running */
+    bool IsExpired() const;
+
+    /**
+     * \return the time left until the timer expires, or zero if the timer
+     * is not running
+     */
+    Time GetDelayLeft() const;
+
+  private:
+    friend class TimerWheel;
+
+    /** Invoke the expire function. */
+    void Invoke();
+
+    Ptr<TimerWheel> m_wheel; //!< The wheel managing this timer
+    TimerImpl* m_impl;       //!< The bound function and arguments
+    uint64_t m_tick;         //!< Expiration tick
+    uint32_t m_list;         //!< Index of the list of the wheel containing this timer
+    WheelTimer* m_prev;      //!< Previous timer in the list
+    WheelTimer* m_next;      //!< Next timer in the list
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+#include "timer-impl.h"
+
+namespace ns3
+{
+
+template <typename FN>
+void
+WheelTimer::SetFunction(FN fn)
+{
+    delete m_impl;
+    m_impl = MakeTimerImpl(fn);
+}
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+WheelTimer::SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+    delete m_impl;
+    m_impl = MakeTimerImpl(memPtr, objPtr);
+}
+
+template <typename... Ts>
+void
+WheelTimer::SetArguments(Ts&&... args)
+{
+    if (m_impl == nullptr)
+    {
+        NS_FATAL_ERROR("You cannot set the arguments of a WheelTimer before setting its function.");
+        return;
+    }
+    m_impl->SetArgs(std::forward<Ts>(args)...);
+}
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
@@ -0,0 +1,263 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/timer-wheel.h"
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup timer
+ * \ingroup timer-tests
+ * TimerWheel test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup timer-tests
+ *  Check the expiration times of wheel timers which are started, restarted
+ *  and cancelled.
+ */
+class TimerWheelBasicTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    TimerWheelBasicTestCase();
+    void DoRun() override;
+    /**
+     * Function to invoke when a timer expires.
+     * \param id The timer identifier.
+     */
+    void Expire(int id);
+
+  private:
+    std::map<int, std::vector<Time>> m_expirations; //!< Expiration times of each timer
+};
+
+TimerWheelBasicTestCase::TimerWheelBasicTestCase()
+    : TestCase("Check the expiration of wheel timers")
+{
+}
+
+void
+TimerWheelBasicTestCase::Expire(int id)
+{
+    m_expirations[id].push_back(Simulator::Now());
+}
+
+void
+TimerWheelBasicTestCase::DoRun()
+{
+    Ptr<TimerWheel> wheel = CreateObject<TimerWheel>();
+    wheel->SetAttribute("Resolution", TimeValue(MilliSeconds(1)));
+
+    WheelTimer a;
+    WheelTimer b;
+    WheelTimer c;
+    WheelTimer d;
+    for (auto timer : {&a, &b, &c, &d})
+    {
+        timer->SetWheel(wheel);
+        timer->SetFunction(&TimerWheelBasicTestCase::Expire, this);
+    }
+    a.SetArguments(1);
+    b.SetArguments(2);
+    c.SetArguments(3);
+    d.SetArguments(4);
+
+    // Expiration rounded up to the end of the tick
+    a.Schedule(MicroSeconds(2500));
+    // Restarted twice before expiring
+    b.Schedule(MilliSeconds(10));
+    Simulator::Schedule(MilliSeconds(5), &WheelTimer::Schedule, &b, MilliSeconds(10));
+    Simulator::Schedule(MilliSeconds(12), &WheelTimer::Schedule, &b, MilliSeconds(1));
+    // Cancelled
+    c.Schedule(MilliSeconds(7));
+    Simulator::Schedule(MilliSeconds(6), &WheelTimer::Cancel, &c);
+    // Started after the wheel went idle, then earlier than the pending event
+    Simulator::Schedule(MilliSeconds(20), &WheelTimer::Schedule, &d, Seconds(100));
+    Simulator::Schedule(MilliSeconds(30), &WheelTimer::Schedule, &d, MilliSeconds(4));
+
+    NS_TEST_ASSERT_MSG_EQ(wheel->GetNTimers(), 3, "Wrong number of running timers");
+    NS_TEST_ASSERT_MSG_EQ(a.GetDelayLeft(), MilliSeconds(3), "Wrong delay left");
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[1].size(), 1, "Timer 1 did not expire once");
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[1][0], MilliSeconds(3), "Timer 1 expired at wrong time");
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[2].size(), 1, "Timer 2 did not expire once");
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[2][0], MilliSeconds(13), "Timer 2 expired at wrong time");
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[3].size(), 0, "Timer 3 expired although cancelled");
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[4].size(), 1, "Timer 4 did not expire once");
+    NS_TEST_ASSERT_MSG_EQ(m_expirations[4][0], MilliSeconds(34), "Timer 4 expired at wrong time");
+    NS_TEST_ASSERT_MSG_EQ(wheel->GetNTimers(), 0, "Timers still running");
+    NS_TEST_ASSERT_MSG_EQ(a.IsExpired(), true, "Timer still running");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup timer-tests
+ *  Check that random sequences of operations on many wheel timers, with
+ *  delays spanning all the levels of the wheel, lead to the expected
+ *  expiration times.
+ */
+class TimerWheelRandomTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    TimerWheelRandomTestCase();
+    void DoRun() override;
+    /**
+     * Restart or cancel a random timer, then plan the next operation.
+     */
+    void Operate();
+    /**
+     * Function to invoke when a timer expires.
+     * \param id The timer identifier.
+     */
+    void Expire(uint32_t id);
+
+  private:
+    /// Number of timers
+    static constexpr uint32_t N_TIMERS = 100;
+    /// Number of operations
+    static constexpr uint32_t N_OPERATIONS = 5000;
+
+    Ptr<TimerWheel> m_wheel;                          //!< The wheel
+    std::vector<std::unique_ptr<WheelTimer>> m_timers; //!< The timers
+    std::vector<Time> m_expected;                     //!< Expected expiration, zero if none
+    Ptr<UniformRandomVariable> m_random;              //!< Random variable
+    uint32_t m_operations;                            //!< Number of operations performed
+    uint32_t m_expirations;                           //!< Number of expirations
+};
+
+TimerWheelRandomTestCase::TimerWheelRandomTestCase()
+    : TestCase("Check random operations on many wheel timers")
+{
+}
+
+void
+TimerWheelRandomTestCase::Operate()
+{
+    uint32_t id = m_random->GetInteger(0, N_TIMERS - 1);
+    if (m_random->GetValue() < 0.2)
+    {
+        m_timers[id]->Cancel();
+        m_expected[id] = Seconds(0);
+    }
+    else
+    {
+        // Delays, in microseconds, spanning all the levels and the overflow
+        double exponent = m_random->GetValue(0, 27);
+        auto delay = MicroSeconds(static_cast<uint64_t>(std::pow(2.0, exponent)));
+        m_timers[id]->Schedule(delay);
+        m_expected[id] = Simulator::Now() + delay;
+        NS_TEST_EXPECT_MSG_EQ(m_timers[id]->GetDelayLeft(), delay, "Wrong delay left");
+    }
+    if (++m_operations < N_OPERATIONS)
+    {
+        Simulator::Schedule(MicroSeconds(m_random->GetInteger(0, 1000)),
+                            &TimerWheelRandomTestCase::Operate,
+                            this);
+    }
+}
+
+void
+TimerWheelRandomTestCase::Expire(uint32_t id)
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), m_expected[id], "Timer expired at wrong time");
+    m_expected[id] = Seconds(0);
+    ++m_expirations;
+    // Restart some of the timers from within the expire function
+    if (id % 2 == 0 && m_operations < N_OPERATIONS)
+    {
+        m_timers[id]->Schedule(MilliSeconds(id + 1));
+        m_expected[id] = Simulator::Now() + MilliSeconds(id + 1);
+    }
+}
+
+void
+TimerWheelRandomTestCase::DoRun()
+{
+    m_wheel = CreateObject<TimerWheel>();
+    m_wheel->SetAttribute("Resolution", TimeValue(MicroSeconds(1)));
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(1);
+    m_operations = 0;
+    m_expirations = 0;
+
+    for (uint32_t id = 0; id < N_TIMERS; ++id)
+    {
+        m_timers.push_back(std::make_unique<WheelTimer>());
+        m_timers[id]->SetWheel(m_wheel);
+        m_timers[id]->SetFunction(&TimerWheelRandomTestCase::Expire, this);
+        m_timers[id]->SetArguments(id);
+    }
+    m_expected.assign(N_TIMERS, Seconds(0));
+
+    // Start from a time which is not aligned to the wheel slots
+    Simulator::Schedule(MicroSeconds(123456), &TimerWheelRandomTestCase::Operate, this);
+    Simulator::Stop(Seconds(200));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_GT(m_expirations, 0, "No timer expired");
+    for (uint32_t id = 0; id < N_TIMERS; ++id)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_expected[id], Seconds(0), "Timer did not expire");
+    }
+
+    m_timers.clear();
+    m_wheel->Dispose();
+    m_wheel = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup timer-tests
+ *  TimerWheel test suite
+ */
+class TimerWheelTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    TimerWheelTestSuite()
+        : TestSuite("timer-wheel", UNIT)
+    {
+        AddTestCase(new TimerWheelBasicTestCase(), TestCase::QUICK);
+        AddTestCase(new TimerWheelRandomTestCase(), TestCase::QUICK);
+    }
+};
+
+/**
+ * \ingroup timer-tests
+ * TimerWheelTestSuite instance variable.
+ */
+static TimerWheelTestSuite g_timerWheelTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,190 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the overhead of the FlowMonitor as the number of
+// flows grows.  'packets' UDP packets are sent along a chain of 'hops'
+// point-to-point links, spread over 10, 100, ... up to 'flows' UDP flows,
+// and the simulation is timed without FlowMonitor, then with a FlowMonitor
+// installed on every node.  The overhead of the FlowMonitor is reported in
+// ns per packet-hop, i.e., per packet seen by a FlowProbe.
+// Sample usage:  ./ns3 run 'bench-flow-monitor --flows=10000 --packets=200000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/udp-server.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Build the chain and run the simulation.
+ *
+ * \param hops number of links of the chain
+ * \param flows number of UDP flows
+ * \param packets number of packets sent by each flow
+ * \param flowMonitor whether to install a FlowMonitor on every node
+ * \param received the number of packets received at the end of the chain
+ * \return the time elapsed, in ms
+ */
+static int64_t
+Run(uint32_t hops, uint32_t flows, uint32_t packets, bool flowMonitor, uint64_t& received)
+{
+    NodeContainer nodes;
+    nodes.Create(hops + 1);
+    InternetStackHelper stack;
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces;
+    for (uint32_t i = 0; i < hops; i++)
+    {
+        NetDeviceContainer devices = p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+        interfaces = address.Assign(devices);
+        address.NewNetwork();
+    }
+
+    // The flows are interleaved so that the aggregate rate is one packet per us
+    ApplicationContainer servers;
+    for (uint32_t f = 0; f < flows; f++)
+    {
+        UdpServerHelper server(9 + f);
+        servers.Add(server.Install(nodes.Get(hops)));
+        UdpClientHelper client(interfaces.GetAddress(1), 9 + f);
+        client.SetAttribute("MaxPackets", UintegerValue(packets));
+        client.SetAttribute("Interval", TimeValue(MicroSeconds(flows)));
+        client.SetAttribute("PacketSize", UintegerValue(64));
+        ApplicationContainer app = client.Install(nodes.Get(0));
+        app.Start(Seconds(1) + MicroSeconds(f));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    servers.Start(Seconds(0));
+
+    // The FlowMonitor checks for lost packets periodically, so stop explicitly
+    FlowMonitorHelper flowMonitorHelper;
+    if (flowMonitor)
+    {
+        flowMonitorHelper.InstallAll();
+    }
+    Simulator::Stop(Seconds(2) + MicroSeconds(static_cast<uint64_t>(flows) * packets));
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t delay = time.End();
+
+    received = 0;
+    for (uint32_t f = 0; f < flows; f++)
+    {
+        received += DynamicCast<UdpServer>(servers.Get(f))->GetReceived();
+    }
+    if (flowMonitor)
+    {
+        NS_ABORT_MSG_UNLESS(flowMonitorHelper.GetMonitor()->GetFlowStats().size() == flows,
+                            "Flows not classified by the FlowMonitor");
+    }
+    Simulator::Destroy();
+    Ipv4AddressGenerator::Reset();
+    return delay;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t hops = 8;
+    uint32_t flows = 10000;
+    uint32_t packets = 200000;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the overhead of the FlowMonitor as the number of flows grows");
+    cmd.AddValue("hops", "number of links of the chain", hops);
+    cmd.AddValue("flows", "maximum number of UDP flows", flows);
+    cmd.AddValue("packets", "total number of packets sent", packets);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(hops < 1 || hops > 65000, "The number of hops must be in [1, 65000]");
+    NS_ABORT_MSG_IF(flows < 10 || flows > 65000, "The number of flows must be in [10, 65000]");
+    NS_ABORT_MSG_IF(packets < flows, "At least one packet must be sent by each flow");
+
+    std::cout << "Running bench-flow-monitor with hops=" << hops << " flows=" << flows
+              << " packets=" << packets << std::endl;
+
+    for (uint32_t n = 10; n <= flows; n *= 10)
+    {
+        int64_t minDelay[2];
+        uint64_t packetHops = 0;
+        for (bool flowMonitor : {false, true})
+        {
+            minDelay[flowMonitor] = std::numeric_limits<int64_t>::max();
+            uint64_t received = 0;
+            for (uint32_t i = 0; i < minIterations; i++)
+            {
+                int64_t delay = Run(hops, n, packets / n, flowMonitor, received);
+                minDelay[flowMonitor] = std::min(minDelay[flowMonitor], delay);
+            }
+            NS_ABORT_MSG_UNLESS(received == static_cast<uint64_t>(n) * (packets / n),
+                                "Packets lost along the chain");
+            // Every packet is seen by the probes of the hops + 1 nodes
+            packetHops = received * (hops + 1);
+            Report("flows=" + std::to_string(n) + (flowMonitor ? "-flowmon" : ""),
+                   packetHops,
+                   minDelay[flowMonitor]);
+        }
+        double overhead = (minDelay[1] - minDelay[0]) * 1e6 / packetHops;
+        std::cout << overhead << " ns per packet-hop\tflows=" << n << "-overhead" << std::endl;
+    }
+    return 0;
+}
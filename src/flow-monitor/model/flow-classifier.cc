@@ -37,4 +37,9 @@ FlowClassifier::GetNewFlowId()
     return ++m_lastNewFlowId;
 }
 
+void
+FlowClassifier::RemoveFlow(FlowId flowId)
+{
+}
+
 } // namespace ns3
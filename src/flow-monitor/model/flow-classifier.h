@@ -68,6 +68,13 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// \param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Forget the given flow, e.g., once the FlowMonitor dropped its statistics.
+    /// The packets classified afterwards with the same flow parameters are
+    /// assigned a new FlowId, as a new flow.  The default implementation does
+    /// nothing.
+    /// \param flowId the identifier of the flow
+    virtual void RemoveFlow(FlowId flowId);
+
   protected:
     /// Returns a new, unique Flow Identifier
     /// \returns a new FlowId
@@ -19,12 +19,22 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/attribute-container.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 
+#ifdef HAVE_SQLITE3
+#include "ns3/sqlite-output.h"
+#endif
+
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <unordered_set>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds(1))
 
@@ -35,6 +45,23 @@ NS_LOG_COMPONENT_DEFINE("FlowMonitor");
 
 NS_OBJECT_ENSURE_REGISTERED(FlowMonitor);
 
+/**
+ * \ingroup flow-monitor
+ * Get the name of the column of a quantile in the periodic export
+ * \param metric the name of the metric
+ * \param q the quantile
+ * \return the name of the column, e.g., delayP99_9 for the 0.999 quantile of the delay
+ */
+static std::string
+GetQuantileColumnName(const std::string& metric, double q)
+{
+    std::ostringstream oss;
+    oss << metric << "P" << q * 100;
+    std::string name = oss.str();
+    std::replace(name.begin(), name.end(), '.', '_');
+    return name;
+}
+
 TypeId
 FlowMonitor::GetTypeId()
 {
@@ -80,7 +107,56 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("ExportInterval",
+                          "The interval between two periodic exports of the per-interval deltas "
+                          "of the flow statistics.  Zero disables the periodic export.  "
+                          "Only effective when set at construction time.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_exportInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("ExportFilePrefix",
+                          "The prefix of the name of the file the flow statistics are "
+                          "periodically exported to.  The extension depends on ExportFormat.",
+                          StringValue("flowmon"),
+                          MakeStringAccessor(&FlowMonitor::m_exportFilePrefix),
+                          MakeStringChecker())
+            .AddAttribute("ExportFormat",
+                          "The format of the periodic export of the flow statistics.",
+                          EnumValue(FlowMonitor::EXPORT_CSV),
+                          MakeEnumAccessor(&FlowMonitor::m_exportFormat),
+                          MakeEnumChecker(FlowMonitor::EXPORT_CSV,
+                                          "Csv",
+                                          FlowMonitor::EXPORT_SQLITE,
+                                          "Sqlite"))
+            .AddAttribute("DropFinishedFlows",
+                          "If true, the statistics of the flows with no packet seen since the "
+                          "previous periodic export and no packet in flight are dropped from "
+                          "memory after each periodic export, by the FlowMonitor, its probes and "
+                          "its classifiers. The packets seen afterwards with the same 5-tuple "
+                          "as a dropped flow are assigned a new FlowId.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_dropFinishedFlows),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableQuantileSketches",
+                          "If true, the packet delays and jitters of each flow are also recorded "
+                          "in quantile sketches, which are serialized along with the flow "
+                          "statistics and whose quantiles are included in the periodic export.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_enableQuantileSketches),
+                          MakeBooleanChecker())
+            .AddAttribute("QuantileSketchAccuracy",
+                          "The relative accuracy of the quantiles of the quantile sketches.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FlowMonitor::m_quantileSketchAccuracy),
+                          MakeDoubleChecker<double>(1e-6, 0.5))
+            .AddAttribute("Quantiles",
+                          "The quantiles of the quantile sketches to output, in [0, 1].",
+                          AttributeContainerValue<DoubleValue>(
+                              std::list<double>{0.5, 0.9, 0.99, 0.999}),
+                          MakeAttributeContainerAccessor<DoubleValue>(&FlowMonitor::m_quantiles),
+                          MakeAttributeContainerChecker<DoubleValue>(
+                              MakeDoubleChecker<double>(0, 1)));
     return tid;
 }
 
@@ -91,7 +167,13 @@ FlowMonitor::GetInstanceTypeId() const
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_enabled(false),
+      m_lastExportTime(Time::Min())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FlowMonitor::~FlowMonitor()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -102,6 +184,14 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_exportEvent);
+    if (m_exportStream.is_open())
+    {
+        m_exportStream.close();
+    }
+#ifdef HAVE_SQLITE3
+    m_exportDatabase = nullptr;
+#endif
     for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
          iter != m_classifiers.end();
          iter++)
@@ -120,11 +210,11 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    FlowStatsContainerI iter;
-    iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    auto iter = m_flowStatsIndex.find(flowId);
+    if (iter == m_flowStatsIndex.end())
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        m_flowStatsIndex[flowId] = &ref;
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
@@ -138,11 +228,13 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+        ref.delaySketch.SetRelativeAccuracy(m_quantileSketchAccuracy);
+        ref.jitterSketch.SetRelativeAccuracy(m_quantileSketchAccuracy);
         return ref;
     }
     else
     {
-        return iter->second;
+        return *iter->second;
     }
 }
 
@@ -233,18 +325,18 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.delaySum += delay;
     stats.delayHistogram.AddValue(delay.GetSeconds());
+    if (m_enableQuantileSketches)
+    {
+        stats.delaySketch.AddValue(delay.GetSeconds());
+    }
     if (stats.rxPackets > 0)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter > Seconds(0))
-        {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
-        }
-        else
+        Time jitter = Abs(stats.lastDelay - delay);
+        stats.jitterSum += jitter;
+        stats.jitterHistogram.AddValue(jitter.GetSeconds());
+        if (m_enableQuantileSketches)
         {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            stats.jitterSketch.AddValue(jitter.GetSeconds());
         }
     }
     stats.lastDelay = delay;
@@ -331,12 +423,12 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
         if (now - iter->second.lastSeenTime >= maxDelay)
         {
             // packet is considered lost, add it to the loss statistics
-            FlowStatsContainerI flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+            auto flow = m_flowStatsIndex.find(iter->first.first);
+            NS_ASSERT(flow != m_flowStatsIndex.end());
+            flow->second->lostPackets++;
 
             // we won't track it anymore
-            m_trackedPackets.erase(iter++);
+            iter = m_trackedPackets.erase(iter);
         }
         else
         {
@@ -358,11 +450,220 @@ FlowMonitor::PeriodicCheckForLostPackets()
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+void
+FlowMonitor::PeriodicExport()
+{
+    ExportStats();
+    m_exportEvent = Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExport, this);
+}
+
+void
+FlowMonitor::OpenExport()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_exportFormat == EXPORT_CSV)
+    {
+        if (m_exportStream.is_open())
+        {
+            return;
+        }
+        std::string fileName = m_exportFilePrefix + ".csv";
+        m_exportStream.open(fileName, std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(m_exportStream.is_open(), "Could not open " << fileName);
+        m_exportStream << "time,flowId,txPackets,txBytes,rxPackets,rxBytes,lostPackets,"
+                          "delaySum,jitterSum,timesForwarded";
+        if (m_enableQuantileSketches)
+        {
+            for (const std::string metric : {"delay", "jitter"})
+            {
+                for (double q : m_quantiles)
+                {
+                    m_exportStream << ',' << GetQuantileColumnName(metric, q);
+                }
+            }
+        }
+        m_exportStream << '\n';
+        return;
+    }
+#ifdef HAVE_SQLITE3
+    if (m_exportDatabase)
+    {
+        return;
+    }
+    m_exportDatabase = Create<SQLiteOutput>(m_exportFilePrefix + ".db");
+    std::string cmd = "CREATE TABLE IF NOT EXISTS FlowStats (time DOUBLE, flowId INTEGER, "
+                      "txPackets INTEGER, txBytes INTEGER, rxPackets INTEGER, rxBytes INTEGER, "
+                      "lostPackets INTEGER, delaySum DOUBLE, jitterSum DOUBLE, "
+                      "timesForwarded INTEGER";
+    if (m_enableQuantileSketches)
+    {
+        for (const std::string metric : {"delay", "jitter"})
+        {
+            for (double q : m_quantiles)
+            {
+                cmd += ", " + GetQuantileColumnName(metric, q) + " DOUBLE";
+            }
+        }
+    }
+    bool ok = m_exportDatabase->SpinExec(cmd + ")");
+    NS_ABORT_UNLESS(ok);
+#else
+    NS_FATAL_ERROR("SQLite support is not available, use the Csv ExportFormat");
+#endif
+}
+
+void
+FlowMonitor::ExportStats()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    if (now == m_lastExportTime)
+    {
+        // flows exported a moment ago would otherwise be seen as finished
+        return;
+    }
+    m_lastExportTime = now;
+    OpenExport();
+    CheckForLostPackets();
+
+    // the flows with packets in flight are not finished
+    std::unordered_set<FlowId> inFlight;
+    if (m_dropFinishedFlows)
+    {
+        for (const auto& tracked : m_trackedPackets)
+        {
+            inFlight.insert(tracked.first.first);
+        }
+    }
+
+#ifdef HAVE_SQLITE3
+    sqlite3_stmt* stmt = nullptr;
+    if (m_exportFormat == EXPORT_SQLITE)
+    {
+        std::string cmd = "INSERT INTO FlowStats VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?";
+        for (uint32_t i = 0; m_enableQuantileSketches && i < 2 * m_quantiles.size(); i++)
+        {
+            cmd += ", ?";
+        }
+        bool ok = m_exportDatabase->SpinExec("BEGIN") &&
+                  m_exportDatabase->SpinPrepare(&stmt, cmd + ")");
+        NS_ABORT_UNLESS(ok);
+    }
+#endif
+
+    for (auto iter = m_flowStats.begin(); iter != m_flowStats.end();)
+    {
+        FlowId flowId = iter->first;
+        const FlowStats& stats = iter->second;
+        ExportedStats& last = m_exportedStats[flowId];
+        if (stats.txPackets == last.txPackets && stats.rxPackets == last.rxPackets &&
+            stats.lostPackets == last.lostPackets)
+        {
+            if (m_dropFinishedFlows && inFlight.find(flowId) == inFlight.end())
+            {
+                NS_LOG_DEBUG("Dropping the statistics of finished flow " << flowId);
+                for (auto& probe : m_flowProbes)
+                {
+                    probe->RemoveFlowStats(flowId);
+                }
+                for (auto& classifier : m_classifiers)
+                {
+                    classifier->RemoveFlow(flowId);
+                }
+                m_exportedStats.erase(flowId);
+                m_flowStatsIndex.erase(flowId);
+                iter = m_flowStats.erase(iter);
+                continue;
+            }
+            iter++;
+            continue;
+        }
+
+        if (m_exportFormat == EXPORT_CSV)
+        {
+            m_exportStream << now.GetSeconds() << ',' << flowId << ','
+                           << stats.txPackets - last.txPackets << ','
+                           << stats.txBytes - last.txBytes << ','
+                           << stats.rxPackets - last.rxPackets << ','
+                           << stats.rxBytes - last.rxBytes << ','
+                           << stats.lostPackets - last.lostPackets << ','
+                           << (stats.delaySum - last.delaySum).GetSeconds() << ','
+                           << (stats.jitterSum - last.jitterSum).GetSeconds() << ','
+                           << stats.timesForwarded - last.timesForwarded;
+            if (m_enableQuantileSketches)
+            {
+                for (const QuantileSketch* sketch : {&stats.delaySketch, &stats.jitterSketch})
+                {
+                    for (double q : m_quantiles)
+                    {
+                        m_exportStream << ',' << sketch->GetQuantile(q);
+                    }
+                }
+            }
+            m_exportStream << '\n';
+        }
+#ifdef HAVE_SQLITE3
+        else
+        {
+            m_exportDatabase->SpinReset(stmt);
+            m_exportDatabase->Bind(stmt, 1, now);
+            m_exportDatabase->Bind(stmt, 2, flowId);
+            m_exportDatabase->Bind(stmt, 3, stats.txPackets - last.txPackets);
+            m_exportDatabase->Bind(stmt, 4, static_cast<int64_t>(stats.txBytes - last.txBytes));
+            m_exportDatabase->Bind(stmt, 5, stats.rxPackets - last.rxPackets);
+            m_exportDatabase->Bind(stmt, 6, static_cast<int64_t>(stats.rxBytes - last.rxBytes));
+            m_exportDatabase->Bind(stmt, 7, stats.lostPackets - last.lostPackets);
+            m_exportDatabase->Bind(stmt, 8, stats.delaySum - last.delaySum);
+            m_exportDatabase->Bind(stmt, 9, stats.jitterSum - last.jitterSum);
+            m_exportDatabase->Bind(stmt, 10, stats.timesForwarded - last.timesForwarded);
+            int pos = 11;
+            if (m_enableQuantileSketches)
+            {
+                for (const QuantileSketch* sketch : {&stats.delaySketch, &stats.jitterSketch})
+                {
+                    for (double q : m_quantiles)
+                    {
+                        m_exportDatabase->Bind(stmt, pos++, sketch->GetQuantile(q));
+                    }
+                }
+            }
+            m_exportDatabase->SpinStep(stmt);
+        }
+#endif
+
+        last.delaySum = stats.delaySum;
+        last.jitterSum = stats.jitterSum;
+        last.txBytes = stats.txBytes;
+        last.rxBytes = stats.rxBytes;
+        last.txPackets = stats.txPackets;
+        last.rxPackets = stats.rxPackets;
+        last.lostPackets = stats.lostPackets;
+        last.timesForwarded = stats.timesForwarded;
+        iter++;
+    }
+
+#ifdef HAVE_SQLITE3
+    if (m_exportFormat == EXPORT_SQLITE)
+    {
+        SQLiteOutput::SpinFinalize(stmt);
+        m_exportDatabase->SpinExec("COMMIT");
+    }
+#endif
+    if (m_exportStream.is_open())
+    {
+        m_exportStream.flush();
+    }
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    if (m_exportInterval.IsStrictlyPositive())
+    {
+        m_exportEvent = Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExport, this);
+    }
 }
 
 void
@@ -423,6 +724,11 @@ FlowMonitor::StopRightNow()
     }
     m_enabled = false;
     CheckForLostPackets();
+    if (m_exportInterval.IsStrictlyPositive())
+    {
+        // export the last, partial interval
+        ExportStats();
+    }
 }
 
 void
@@ -485,6 +791,12 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
                 indent,
                 "flowInterruptionsHistogram");
         }
+        if (m_enableQuantileSketches)
+        {
+            std::vector<double> quantiles(m_quantiles.begin(), m_quantiles.end());
+            flowI->second.delaySketch.SerializeToXmlStream(os, indent, "delaySketch", quantiles);
+            flowI->second.jitterSketch.SerializeToXmlStream(os, indent, "jitterSketch", quantiles);
+        }
         indent -= 2;
 
         os << std::string(indent, ' ') << "</Flow>\n";
@@ -539,6 +851,7 @@ FlowMonitor::ResetAllStats()
 {
     NS_LOG_FUNCTION(this);
 
+    m_exportedStats.clear();
     for (auto& iter : m_flowStats)
     {
         auto& flowStat = iter.second;
@@ -558,6 +871,8 @@ FlowMonitor::ResetAllStats()
         flowStat.jitterHistogram.Clear();
         flowStat.packetSizeHistogram.Clear();
         flowStat.flowInterruptionsHistogram.Clear();
+        flowStat.delaySketch.Clear();
+        flowStat.jitterSketch.Clear();
     }
 }
 
@@ -27,13 +27,18 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/quantile-sketch.h"
 
+#include <fstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
 {
 
+class SQLiteOutput;
+
 /**
  * \defgroup flow-monitor Flow Monitor
  * \brief  Collect and store performance data from a simulation
@@ -46,10 +51,24 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * Besides the end-of-run XML output, the FlowMonitor can periodically
+ * export the per-interval deltas of the counters of the FlowStats of the
+ * active flows (see the ExportInterval attribute) to a CSV file or to an
+ * SQLite database, one row per flow and interval.  With the
+ * DropFinishedFlows attribute, the statistics of the flows that were idle
+ * during the last interval are then dropped from memory, so that long
+ * simulations with many short flows run with bounded memory.
  */
 class FlowMonitor : public Object
 {
   public:
+    /// Format of the periodic export of the flow statistics
+    enum ExportFormat
+    {
+        EXPORT_CSV,    //!< Comma-separated values, in a file named \<prefix\>.csv
+        EXPORT_SQLITE, //!< SQLite database, in a file named \<prefix\>.db
+    };
+
     /// \brief Structure that represents the measured metrics of an individual packet flow
     struct FlowStats
     {
@@ -135,6 +154,13 @@ class FlowMonitor : public Object
         /// comment in attribute packetsDropped.
         std::vector<uint64_t> bytesDropped;   // bytesDropped[reasonCode] => number of dropped bytes
         Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
+
+        /// Quantile sketch of the packet delays, filled only if the
+        /// EnableQuantileSketches attribute is set
+        QuantileSketch delaySketch;
+        /// Quantile sketch of the packet jitters, filled only if the
+        /// EnableQuantileSketches attribute is set
+        QuantileSketch jitterSketch;
     };
 
     // --- basic methods ---
@@ -145,6 +171,7 @@ class FlowMonitor : public Object
     static TypeId GetTypeId();
     TypeId GetInstanceTypeId() const override;
     FlowMonitor();
+    ~FlowMonitor() override;
 
     /// Add a FlowClassifier to be used by the flow monitor.
     /// \param classifier the FlowClassifier
@@ -242,7 +269,8 @@ class FlowMonitor : public Object
     /// Retrieve all collected the flow statistics.  Note, if the
     /// FlowMonitor has not stopped monitoring yet, you should call
     /// CheckForLostPackets() to make sure all possibly lost packets are
-    /// accounted for.
+    /// accounted for.  If the DropFinishedFlows attribute is set, the
+    /// flows dropped after a periodic export are not included.
     /// \returns the flows statistics
     const FlowStatsContainer& GetFlowStats() const;
 
@@ -281,6 +309,19 @@ class FlowMonitor : public Object
     void DoDispose() override;
 
   private:
+    /// Counters of the FlowStats of a flow, as of the last periodic export
+    struct ExportedStats
+    {
+        Time delaySum;           //!< sum of the end-to-end delays
+        Time jitterSum;          //!< sum of the jitters
+        uint64_t txBytes;        //!< number of transmitted bytes
+        uint64_t rxBytes;        //!< number of received bytes
+        uint32_t txPackets;      //!< number of transmitted packets
+        uint32_t rxPackets;      //!< number of received packets
+        uint32_t lostPackets;    //!< number of lost packets
+        uint32_t timesForwarded; //!< number of times the packets were forwarded
+    };
+
     /// Structure to represent a single tracked packet data
     struct TrackedPacket
     {
@@ -289,11 +330,25 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Hash function for the (FlowId,PacketId) keys of the tracked packets
+    struct TrackedPacketHash
+    {
+        /// \param key the (FlowId,PacketId) pair
+        /// \return the hash of the key
+        std::size_t operator()(const std::pair<FlowId, FlowPacketId>& key) const
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(key.first) << 32) | key.second);
+        }
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> FlowStats, hashed index of m_flowStats used when reporting packets
+    std::unordered_map<FlowId, FlowStats*> m_flowStatsIndex;
 
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+    typedef std::unordered_map<std::pair<FlowId, FlowPacketId>, TrackedPacket, TrackedPacketHash>
+        TrackedPacketMap;
     TrackedPacketMap m_trackedPackets; //!< Tracked packets
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
@@ -310,6 +365,22 @@ class FlowMonitor : public Object
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
 
+    Time m_exportInterval;              //!< Interval of the periodic export (zero if disabled)
+    std::string m_exportFilePrefix;     //!< Prefix of the name of the export file
+    ExportFormat m_exportFormat;        //!< Format of the periodic export
+    bool m_dropFinishedFlows;           //!< Drop the flows idle during the last interval
+    bool m_enableQuantileSketches;      //!< Fill the quantile sketches of the flows
+    double m_quantileSketchAccuracy;    //!< Relative accuracy of the quantile sketches
+    std::list<double> m_quantiles;      //!< Quantiles to output
+    EventId m_exportEvent;              //!< Next periodic export event
+    Time m_lastExportTime;              //!< Time of the last periodic export
+    std::ofstream m_exportStream;       //!< CSV export file
+#ifdef HAVE_SQLITE3
+    Ptr<SQLiteOutput> m_exportDatabase; //!< SQLite export database
+#endif
+    /// FlowId --> counters as of the last periodic export
+    std::unordered_map<FlowId, ExportedStats> m_exportedStats;
+
     /// Get the stats for a given flow
     /// \param flowId the Flow identification
     /// \returns the stats of the flow
@@ -317,6 +388,16 @@ class FlowMonitor : public Object
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Periodic function to export the per-interval deltas of the flow statistics
+    void PeriodicExport();
+
+    /// Export the deltas of the flow statistics since the last export and,
+    /// if DropFinishedFlows is set, drop the flows idle since then
+    void ExportStats();
+
+    /// Open the export file and write its header, if not done yet
+    void OpenExport();
 };
 
 } // namespace ns3
@@ -49,13 +49,26 @@ void
 FlowProbe::DoDispose()
 {
     m_flowMonitor = nullptr;
+    m_lastFlowStats = nullptr;
     Object::DoDispose();
 }
 
+FlowProbe::FlowStats&
+FlowProbe::GetFlowStats(FlowId flowId)
+{
+    if (m_lastFlowStats == nullptr || m_lastFlowId != flowId)
+    {
+        // std::map never invalidates pointers to its elements on insertion
+        m_lastFlowStats = &m_stats[flowId];
+        m_lastFlowId = flowId;
+    }
+    return *m_lastFlowStats;
+}
+
 void
 FlowProbe::AddPacketStats(FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe)
 {
-    FlowStats& flow = m_stats[flowId];
+    FlowStats& flow = GetFlowStats(flowId);
     flow.delayFromFirstProbeSum += delayFromFirstProbe;
     flow.bytes += packetSize;
     ++flow.packets;
@@ -64,7 +77,7 @@ FlowProbe::AddPacketStats(FlowId flowId, uint32_t packetSize, Time delayFromFirs
 void
 FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode)
 {
-    FlowStats& flow = m_stats[flowId];
+    FlowStats& flow = GetFlowStats(flowId);
 
     if (flow.packetsDropped.size() < reasonCode + 1)
     {
@@ -75,6 +88,16 @@ FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reaso
     flow.bytesDropped[reasonCode] += packetSize;
 }
 
+void
+FlowProbe::RemoveFlowStats(FlowId flowId)
+{
+    if (m_lastFlowId == flowId)
+    {
+        m_lastFlowStats = nullptr;
+    }
+    m_stats.erase(flowId);
+}
+
 FlowProbe::Stats
 FlowProbe::GetStats() const
 {
@@ -92,6 +92,11 @@ class FlowProbe : public Object
     /// \param reasonCode reason code for the drop
     void AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode);
 
+    /// Remove the statistics of a flow from this probe, e.g., because
+    /// the FlowMonitor dropped the flow after it finished.
+    /// \param flowId the flow Identifier
+    void RemoveFlowStats(FlowId flowId);
+
     /// Get the partial flow statistics stored in this probe.  With this
     /// information you can, for example, find out what is the delay
     /// from the first probe to this one.
@@ -107,6 +112,17 @@ class FlowProbe : public Object
   protected:
     Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
     Stats m_stats;                  //!< The flow stats
+
+  private:
+    /// Get the stats of a flow, creating them if needed.  Consecutive
+    /// packets of a probe very often belong to the same flow, so the
+    /// stats of the last flow looked up are cached.
+    /// \param flowId the flow Identifier
+    /// \returns the stats of the flow
+    FlowStats& GetFlowStats(FlowId flowId);
+
+    FlowId m_lastFlowId{0};              //!< flow Identifier of the last flow looked up
+    FlowStats* m_lastFlowStats{nullptr}; //!< stats of the last flow looked up
 };
 
 } // namespace ns3
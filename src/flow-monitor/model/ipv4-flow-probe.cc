@@ -22,12 +22,16 @@
 #include "ns3/config.h"
 #include "ns3/flow-id-tag.h"
 #include "ns3/flow-monitor.h"
+#include "ns3/gso-tag.h"
 #include "ns3/ipv4-flow-classifier.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -242,6 +246,44 @@ Ipv4FlowProbeTag::IsSrcDstValid(Ipv4Address src, Ipv4Address dst) const
     return ((m_src == src) && (m_dst == dst));
 }
 
+/**
+ * \ingroup flow-monitor
+ *
+ * \brief Get the flow probe tags carried by a packet
+ *
+ * A packet normally carries a single tag. A TCP super-segment built for
+ * segmentation offload carries one tag per segment, and keeps all of them
+ * when it is not split (e.g., when it is sent on a loopback device).
+ *
+ * \param packet the packet
+ * \return the tags carried by the packet, without duplicates
+ */
+static std::vector<Ipv4FlowProbeTag>
+GetFlowProbeTags(Ptr<const Packet> packet)
+{
+    std::vector<Ipv4FlowProbeTag> tags;
+    ByteTagIterator it = packet->GetByteTagIterator();
+    while (it.HasNext())
+    {
+        ByteTagIterator::Item item = it.Next();
+        if (item.GetTypeId() != Ipv4FlowProbeTag::GetTypeId())
+        {
+            continue;
+        }
+        Ipv4FlowProbeTag fTag;
+        item.GetTag(fTag);
+        // a tag may have been split in several pieces by IP fragmentation
+        if (std::none_of(tags.begin(), tags.end(), [&fTag](const Ipv4FlowProbeTag& t) {
+                return t.GetFlowId() == fTag.GetFlowId() &&
+                       t.GetPacketId() == fTag.GetPacketId();
+            }))
+        {
+            tags.push_back(fTag);
+        }
+    }
+    return tags;
+}
+
 ////////////////////////////////////////
 // Ipv4FlowProbe class implementation //
 ////////////////////////////////////////
@@ -341,6 +383,35 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
         return;
     }
 
+    GsoTag gsoTag;
+    if (ipPayload->PeekPacketTag(gsoTag))
+    {
+        // a TCP super-segment is sent as several segments: each of them is
+        // accounted as a packet of its own, and tagged over its byte range
+        uint32_t headerSize = ipHeader.GetSerializedSize() + gsoTag.GetHeaderSize();
+        uint32_t start = 0;
+        for (uint32_t end = gsoTag.GetHeaderSize(); end < ipPayload->GetSize(); start = end)
+        {
+            end = std::min(end + gsoTag.GetSegmentSize(), ipPayload->GetSize());
+            if (!m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId))
+            {
+                return;
+            }
+            uint32_t size = headerSize + end - std::max(start, uint32_t(gsoTag.GetHeaderSize()));
+            NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", "
+                                           << size << "); segment of " << ipHeader);
+            m_flowMonitor->ReportFirstTx(this, flowId, packetId, size);
+
+            Ipv4FlowProbeTag fTag(flowId,
+                                  packetId,
+                                  size,
+                                  ipHeader.GetSource(),
+                                  ipHeader.GetDestination());
+            ipPayload->AddByteTag(fTag, start, end);
+        }
+        return;
+    }
+
     if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId))
     {
         uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
@@ -364,10 +435,9 @@ Ipv4FlowProbe::ForwardLogger(const Ipv4Header& ipHeader,
                              Ptr<const Packet> ipPayload,
                              uint32_t interface)
 {
-    Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    std::vector<Ipv4FlowProbeTag> tags = GetFlowProbeTags(ipPayload);
 
-    if (found)
+    for (const auto& fTag : tags)
     {
         if (!ipHeader.IsLastFragment() || ipHeader.GetFragmentOffset() != 0)
         {
@@ -383,7 +453,8 @@ Ipv4FlowProbe::ForwardLogger(const Ipv4Header& ipHeader,
         FlowId flowId = fTag.GetFlowId();
         FlowPacketId packetId = fTag.GetPacketId();
 
-        uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
+        uint32_t size = (tags.size() == 1 ? ipPayload->GetSize() + ipHeader.GetSerializedSize()
+                                          : fTag.GetPacketSize());
         NS_LOG_DEBUG("ReportForwarding (" << this << ", " << flowId << ", " << packetId << ", "
                                           << size << ");");
         m_flowMonitor->ReportForwarding(this, flowId, packetId, size);
@@ -395,10 +466,9 @@ Ipv4FlowProbe::ForwardUpLogger(const Ipv4Header& ipHeader,
                                Ptr<const Packet> ipPayload,
                                uint32_t interface)
 {
-    Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    std::vector<Ipv4FlowProbeTag> tags = GetFlowProbeTags(ipPayload);
 
-    if (found)
+    for (const auto& fTag : tags)
     {
         if (!fTag.IsSrcDstValid(ipHeader.GetSource(), ipHeader.GetDestination()))
         {
@@ -409,7 +479,8 @@ Ipv4FlowProbe::ForwardUpLogger(const Ipv4Header& ipHeader,
         FlowId flowId = fTag.GetFlowId();
         FlowPacketId packetId = fTag.GetPacketId();
 
-        uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
+        uint32_t size = (tags.size() == 1 ? ipPayload->GetSize() + ipHeader.GetSerializedSize()
+                                          : fTag.GetPacketSize());
         NS_LOG_DEBUG("ReportLastRx (" << this << ", " << flowId << ", " << packetId << ", " << size
                                       << "); " << ipHeader << *ipPayload);
         m_flowMonitor->ReportLastRx(this, flowId, packetId, size);
@@ -441,15 +512,15 @@ Ipv4FlowProbe::DropLogger(const Ipv4Header& ipHeader,
     }
 #endif
 
-    Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    std::vector<Ipv4FlowProbeTag> tags = GetFlowProbeTags(ipPayload);
 
-    if (found)
+    for (const auto& fTag : tags)
     {
         FlowId flowId = fTag.GetFlowId();
         FlowPacketId packetId = fTag.GetPacketId();
 
-        uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
+        uint32_t size = (tags.size() == 1 ? ipPayload->GetSize() + ipHeader.GetSerializedSize()
+                                          : fTag.GetPacketSize());
         NS_LOG_DEBUG("Drop (" << this << ", " << flowId << ", " << packetId << ", " << size << ", "
                               << reason << ", destIp=" << ipHeader.GetDestination() << "); "
                               << "HDR: " << ipHeader << " PKT: " << *ipPayload);
@@ -495,43 +566,33 @@ Ipv4FlowProbe::DropLogger(const Ipv4Header& ipHeader,
 void
 Ipv4FlowProbe::QueueDropLogger(Ptr<const Packet> ipPayload)
 {
-    Ipv4FlowProbeTag fTag;
-    bool tagFound = ipPayload->FindFirstMatchingByteTag(fTag);
-
-    if (!tagFound)
+    for (const auto& fTag : GetFlowProbeTags(ipPayload))
     {
-        return;
-    }
-
-    FlowId flowId = fTag.GetFlowId();
-    FlowPacketId packetId = fTag.GetPacketId();
-    uint32_t size = fTag.GetPacketSize();
+        FlowId flowId = fTag.GetFlowId();
+        FlowPacketId packetId = fTag.GetPacketId();
+        uint32_t size = fTag.GetPacketSize();
 
-    NS_LOG_DEBUG("Drop (" << this << ", " << flowId << ", " << packetId << ", " << size << ", "
-                          << DROP_QUEUE << "); ");
+        NS_LOG_DEBUG("Drop (" << this << ", " << flowId << ", " << packetId << ", " << size
+                              << ", " << DROP_QUEUE << "); ");
 
-    m_flowMonitor->ReportDrop(this, flowId, packetId, size, DROP_QUEUE);
+        m_flowMonitor->ReportDrop(this, flowId, packetId, size, DROP_QUEUE);
+    }
 }
 
 void
 Ipv4FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
 {
-    Ipv4FlowProbeTag fTag;
-    bool tagFound = item->GetPacket()->FindFirstMatchingByteTag(fTag);
-
-    if (!tagFound)
+    for (const auto& fTag : GetFlowProbeTags(item->GetPacket()))
     {
-        return;
-    }
-
-    FlowId flowId = fTag.GetFlowId();
-    FlowPacketId packetId = fTag.GetPacketId();
-    uint32_t size = fTag.GetPacketSize();
+        FlowId flowId = fTag.GetFlowId();
+        FlowPacketId packetId = fTag.GetPacketId();
+        uint32_t size = fTag.GetPacketSize();
 
-    NS_LOG_DEBUG("Drop (" << this << ", " << flowId << ", " << packetId << ", " << size << ", "
-                          << DROP_QUEUE_DISC << "); ");
+        NS_LOG_DEBUG("Drop (" << this << ", " << flowId << ", " << packetId << ", " << size
+                              << ", " << DROP_QUEUE_DISC << "); ");
 
-    m_flowMonitor->ReportDrop(this, flowId, packetId, size, DROP_QUEUE_DISC);
+        m_flowMonitor->ReportDrop(this, flowId, packetId, size, DROP_QUEUE_DISC);
+    }
 }
 
 } // namespace ns3
@@ -26,6 +26,8 @@
 
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -92,13 +94,29 @@ class Ipv6FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    void RemoveFlow(FlowId flowId) override;
+
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Hash function for the FiveTuple of the flows
+    struct FiveTupleHash
+    {
+        /// \param t the FiveTuple
+        /// \return the hash of the FiveTuple
+        std::size_t operator()(const FiveTuple& t) const;
+    };
+
+    /// Information about a flow
+    struct FlowInfo
+    {
+        FiveTuple tuple;                                     //!< FiveTuple of the flow
+        FlowPacketId lastPacketId;                           //!< Last FlowPacketId assigned
+        std::map<Ipv6Header::DscpType, uint32_t> dscpCounts; //!< DSCP value -> packet count
+    };
+
+    /// Information about the flows, indexed by FlowId
+    std::map<FlowId, FlowInfo> m_flows;
+    /// Map of the FiveTuples of the flows to their entries in m_flows
+    std::unordered_map<FiveTuple, std::map<FlowId, FlowInfo>::iterator, FiveTupleHash> m_flowMap;
 };
 
 /**
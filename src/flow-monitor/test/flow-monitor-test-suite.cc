@@ -0,0 +1,663 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/error-model.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor
+ * \ingroup tests
+ * \defgroup flow-monitor-test Flow Monitor module tests
+ */
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Base class of the tests of the periodic export of the FlowMonitor: two
+ * nodes connected by a SimpleChannel, the first one sending UDP packets to the
+ * second one.
+ */
+class FlowMonitorExportTestBase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param name the name of the test case
+     */
+    FlowMonitorExportTestBase(std::string name);
+
+  protected:
+    /**
+     * Create the nodes, the sockets and the FlowMonitor.
+     * \param channelDelay the delay of the channel
+     * \param dropFinishedFlows the value of the DropFinishedFlows attribute
+     */
+    void Setup(Time channelDelay, bool dropFinishedFlows);
+    /// Send a packet of 100 bytes
+    void SendPacket();
+    /// Destroy the simulation objects
+    void Teardown();
+
+    std::string m_exportFilePrefix;    //!< prefix of the name of the export file
+    FlowMonitorHelper m_flowmonHelper; //!< the FlowMonitor helper
+    Ptr<FlowMonitor> m_flowMonitor;    //!< the FlowMonitor
+    Ptr<Socket> m_txSocket;            //!< the sending socket
+    Ptr<Socket> m_rxSocket;            //!< the receiving socket
+};
+
+FlowMonitorExportTestBase::FlowMonitorExportTestBase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+FlowMonitorExportTestBase::Setup(Time channelDelay, bool dropFinishedFlows)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetChannelAttribute("Delay", TimeValue(channelDelay));
+    simpleHelper.SetNetDevicePointToPointMode(true); // no ARP
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    m_exportFilePrefix = CreateTempDirFilename("flowmon-export");
+    m_flowmonHelper.SetMonitorAttribute("ExportInterval", TimeValue(Seconds(1)));
+    m_flowmonHelper.SetMonitorAttribute("ExportFilePrefix", StringValue(m_exportFilePrefix));
+    m_flowmonHelper.SetMonitorAttribute("ExportFormat", EnumValue(FlowMonitor::EXPORT_CSV));
+    m_flowmonHelper.SetMonitorAttribute("DropFinishedFlows", BooleanValue(dropFinishedFlows));
+    m_flowMonitor = m_flowmonHelper.Install(nodes);
+
+    m_rxSocket = Socket::CreateSocket(nodes.Get(1), UdpSocketFactory::GetTypeId());
+    m_rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    m_txSocket = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    m_txSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 4321));
+    m_txSocket->Connect(InetSocketAddress(interfaces.GetAddress(1), 1234));
+}
+
+void
+FlowMonitorExportTestBase::SendPacket()
+{
+    m_txSocket->Send(Create<Packet>(100));
+}
+
+void
+FlowMonitorExportTestBase::Teardown()
+{
+    m_txSocket->Close();
+    m_rxSocket->Close();
+    m_txSocket = nullptr;
+    m_rxSocket = nullptr;
+    m_flowMonitor = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Check that the per-interval deltas exported to the CSV file add up to
+ * the final FlowStats, and that no row is written for an idle interval.
+ */
+class FlowMonitorCsvExportTestCase : public FlowMonitorExportTestBase
+{
+  public:
+    FlowMonitorCsvExportTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorCsvExportTestCase::FlowMonitorCsvExportTestCase()
+    : FlowMonitorExportTestBase("Check the per-interval deltas exported to a CSV file")
+{
+}
+
+void
+FlowMonitorCsvExportTestCase::DoRun()
+{
+    Setup(Seconds(0), false);
+
+    // packets from 0.1 s to 2.9 s, none between 3 s and 5 s, then two more
+    for (uint32_t i = 0; i < 15; i++)
+    {
+        Simulator::Schedule(Seconds(0.1 + 0.2 * i),
+                            &FlowMonitorCsvExportTestCase::SendPacket,
+                            this);
+    }
+    Simulator::Schedule(Seconds(5.5), &FlowMonitorCsvExportTestCase::SendPacket, this);
+    Simulator::Schedule(Seconds(5.7), &FlowMonitorCsvExportTestCase::SendPacket, this);
+    Simulator::Stop(Seconds(6.5));
+    Simulator::Run();
+    m_flowMonitor->StopRightNow();
+
+    const FlowMonitor::FlowStatsContainer& stats = m_flowMonitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 1, "Unexpected number of flows");
+    const FlowMonitor::FlowStats& flowStats = stats.begin()->second;
+    NS_TEST_EXPECT_MSG_EQ(flowStats.txPackets, 17, "Unexpected number of transmitted packets");
+
+    std::ifstream csv(m_exportFilePrefix + ".csv");
+    NS_TEST_ASSERT_MSG_EQ(csv.is_open(), true, "Export file not written");
+    std::string line;
+    std::getline(csv, line); // header
+    uint64_t txPackets = 0;
+    uint64_t txBytes = 0;
+    uint64_t rxPackets = 0;
+    uint64_t rxBytes = 0;
+    uint64_t lostPackets = 0;
+    std::vector<double> times;
+    while (std::getline(csv, line))
+    {
+        std::vector<std::string> fields;
+        std::istringstream iss(line);
+        std::string field;
+        while (std::getline(iss, field, ','))
+        {
+            fields.push_back(field);
+        }
+        NS_TEST_ASSERT_MSG_EQ(fields.size(), 10, "Unexpected number of columns: " << line);
+        NS_TEST_EXPECT_MSG_EQ(std::stoul(fields[1]), stats.begin()->first, "Unexpected flow");
+        times.push_back(std::stod(fields[0]));
+        txPackets += std::stoul(fields[2]);
+        txBytes += std::stoul(fields[3]);
+        rxPackets += std::stoul(fields[4]);
+        rxBytes += std::stoul(fields[5]);
+        lostPackets += std::stoul(fields[6]);
+    }
+
+    // a row at 1 s, 2 s, 3 s and 6 s, none for the idle intervals ending at 4 s and 5 s
+    NS_TEST_ASSERT_MSG_EQ(times.size(), 4, "Unexpected number of rows");
+    NS_TEST_EXPECT_MSG_EQ(times[2], 3, "Unexpected time of the third row");
+    NS_TEST_EXPECT_MSG_EQ(times[3], 6, "Row written for an idle interval");
+    NS_TEST_EXPECT_MSG_EQ(txPackets, flowStats.txPackets, "Deltas do not add up to txPackets");
+    NS_TEST_EXPECT_MSG_EQ(txBytes, flowStats.txBytes, "Deltas do not add up to txBytes");
+    NS_TEST_EXPECT_MSG_EQ(rxPackets, flowStats.rxPackets, "Deltas do not add up to rxPackets");
+    NS_TEST_EXPECT_MSG_EQ(rxBytes, flowStats.rxBytes, "Deltas do not add up to rxBytes");
+    NS_TEST_EXPECT_MSG_EQ(lostPackets,
+                          flowStats.lostPackets,
+                          "Deltas do not add up to lostPackets");
+
+    Teardown();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Check that, with DropFinishedFlows, a flow with a packet in flight is
+ * kept, that a finished flow is dropped from the FlowMonitor and its classifier,
+ * and that a flow with the same 5-tuple is then assigned a new FlowId.
+ */
+class FlowMonitorDropFinishedFlowsTestCase : public FlowMonitorExportTestBase
+{
+  public:
+    FlowMonitorDropFinishedFlowsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the flows known by the FlowMonitor and its classifier.
+     * \param flowId the identifier of the expected flow, or zero if no flow is expected
+     * \param droppedFlowId the identifier of a flow that must not be known, if not zero
+     */
+    void CheckFlows(FlowId flowId, FlowId droppedFlowId);
+};
+
+FlowMonitorDropFinishedFlowsTestCase::FlowMonitorDropFinishedFlowsTestCase()
+    : FlowMonitorExportTestBase("Check the drop of the finished flows")
+{
+}
+
+void
+FlowMonitorDropFinishedFlowsTestCase::CheckFlows(FlowId flowId, FlowId droppedFlowId)
+{
+    const FlowMonitor::FlowStatsContainer& stats = m_flowMonitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.size(),
+                          (flowId == 0 ? 0 : 1),
+                          "Unexpected number of flows at " << Simulator::Now().As(Time::S));
+    if (flowId != 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ((stats.find(flowId) != stats.end()),
+                              true,
+                              "Flow " << flowId << " not found at "
+                                      << Simulator::Now().As(Time::S));
+    }
+
+    std::ostringstream oss;
+    m_flowmonHelper.GetClassifier()->SerializeToXmlStream(oss, 0);
+    if (droppedFlowId != 0)
+    {
+        std::ostringstream dropped;
+        dropped << "flowId=\"" << droppedFlowId << "\"";
+        NS_TEST_EXPECT_MSG_EQ((oss.str().find(dropped.str()) == std::string::npos),
+                              true,
+                              "Flow " << droppedFlowId << " not dropped from the classifier");
+    }
+}
+
+void
+FlowMonitorDropFinishedFlowsTestCase::DoRun()
+{
+    Setup(Seconds(2.5), true);
+
+    // a packet sent at 0.1 s is in flight until 2.6 s: the flow is idle during the
+    // interval ending at 2 s, but kept; it is idle again during the interval ending
+    // at 4 s, hence dropped
+    Simulator::Schedule(Seconds(0.1), &FlowMonitorDropFinishedFlowsTestCase::SendPacket, this);
+    Simulator::Schedule(Seconds(2.5),
+                        &FlowMonitorDropFinishedFlowsTestCase::CheckFlows,
+                        this,
+                        1,
+                        0);
+    Simulator::Schedule(Seconds(3.5),
+                        &FlowMonitorDropFinishedFlowsTestCase::CheckFlows,
+                        this,
+                        1,
+                        0);
+    Simulator::Schedule(Seconds(4.5),
+                        &FlowMonitorDropFinishedFlowsTestCase::CheckFlows,
+                        this,
+                        0,
+                        1);
+    // a packet with the same 5-tuple belongs to a new flow
+    Simulator::Schedule(Seconds(5), &FlowMonitorDropFinishedFlowsTestCase::SendPacket, this);
+    Simulator::Schedule(Seconds(5.5),
+                        &FlowMonitorDropFinishedFlowsTestCase::CheckFlows,
+                        this,
+                        2,
+                        1);
+    Simulator::Stop(Seconds(8));
+    Simulator::Run();
+
+    const FlowMonitor::FlowStatsContainer& stats = m_flowMonitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ((stats.find(2) != stats.end()), true, "Flow 2 not found");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).txPackets, 1, "Unexpected number of transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).rxPackets, 1, "Unexpected number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).lostPackets, 0, "Unexpected number of lost packets");
+
+    Teardown();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Base class of the tests of the FlowMonitor with TCP segmentation
+ * offload: a TCP connection whose sender builds super-segments of several
+ * 536-byte segments sends a bulk of data.
+ */
+class FlowMonitorGsoTestBase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param name the name of the test case
+     */
+    FlowMonitorGsoTestBase(std::string name);
+
+  protected:
+    /**
+     * Open the connection and send the data.
+     * \param sender the sending node
+     * \param receiver the receiving node
+     * \param address the address of the receiver
+     * \param gsoMaxSegments the max number of segments of a super-segment
+     * \param bytes the amount of data to send
+     */
+    void StartTransfer(Ptr<Node> sender,
+                       Ptr<Node> receiver,
+                       Ipv4Address address,
+                       uint16_t gsoMaxSegments,
+                       uint32_t bytes);
+    /**
+     * \return the statistics of the flow carrying the data
+     */
+    FlowMonitor::FlowStats GetDataFlowStats();
+    /// Destroy the simulation objects
+    void Teardown();
+
+    FlowMonitorHelper m_flowmonHelper; //!< the FlowMonitor helper
+    Ptr<FlowMonitor> m_flowMonitor;    //!< the FlowMonitor
+    uint32_t m_rxBytes{0};             //!< amount of data received by the receiver
+    uint32_t m_maxTxSize{0};           //!< size of the largest packet sent by IPv4
+    uint32_t m_maxRxSize{0};           //!< size of the largest packet received by IPv4
+
+  private:
+    /**
+     * Accept a connection.
+     * \param socket the connected socket
+     * \param from the address of the peer
+     */
+    void Accept(Ptr<Socket> socket, const Address& from);
+    /**
+     * Read the data received.
+     * \param socket the connected socket
+     */
+    void Receive(Ptr<Socket> socket);
+    /**
+     * Record the size of the largest packet sent by IPv4.
+     * \param packet the packet
+     * \param ipv4 the IPv4 object
+     * \param interface the interface
+     */
+    void Ipv4Tx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+    /**
+     * Record the size of the largest packet received by IPv4.
+     * \param packet the packet
+     * \param ipv4 the IPv4 object
+     * \param interface the interface
+     */
+    void Ipv4Rx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+    Ptr<Socket> m_txSocket;        //!< the sending socket
+    Ptr<Socket> m_listeningSocket; //!< the listening socket
+};
+
+FlowMonitorGsoTestBase::FlowMonitorGsoTestBase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+FlowMonitorGsoTestBase::StartTransfer(Ptr<Node> sender,
+                                      Ptr<Node> receiver,
+                                      Ipv4Address address,
+                                      uint16_t gsoMaxSegments,
+                                      uint32_t bytes)
+{
+    sender->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&FlowMonitorGsoTestBase::Ipv4Tx, this));
+    receiver->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&FlowMonitorGsoTestBase::Ipv4Rx, this));
+
+    m_listeningSocket = Socket::CreateSocket(receiver, TcpSocketFactory::GetTypeId());
+    m_listeningSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    m_listeningSocket->Listen();
+    m_listeningSocket->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                         MakeCallback(&FlowMonitorGsoTestBase::Accept, this));
+
+    m_txSocket = Socket::CreateSocket(sender, TcpSocketFactory::GetTypeId());
+    m_txSocket->SetAttribute("GsoMaxSegments", UintegerValue(gsoMaxSegments));
+    m_txSocket->SetAttribute("SegmentSize", UintegerValue(536));
+    m_txSocket->SetAttribute("SndBufSize", UintegerValue(bytes));
+    // no TCP option in the data segments
+    m_txSocket->SetAttribute("Timestamp", BooleanValue(false));
+    m_txSocket->Bind();
+    m_txSocket->Connect(InetSocketAddress(address, 1234));
+    m_txSocket->Send(Create<Packet>(bytes));
+}
+
+void
+FlowMonitorGsoTestBase::Accept(Ptr<Socket> socket, const Address& from)
+{
+    socket->SetRecvCallback(MakeCallback(&FlowMonitorGsoTestBase::Receive, this));
+}
+
+void
+FlowMonitorGsoTestBase::Receive(Ptr<Socket> socket)
+{
+    while (Ptr<Packet> packet = socket->Recv())
+    {
+        m_rxBytes += packet->GetSize();
+    }
+}
+
+void
+FlowMonitorGsoTestBase::Ipv4Tx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    m_maxTxSize = std::max(m_maxTxSize, packet->GetSize());
+}
+
+void
+FlowMonitorGsoTestBase::Ipv4Rx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    m_maxRxSize = std::max(m_maxRxSize, packet->GetSize());
+}
+
+FlowMonitor::FlowStats
+FlowMonitorGsoTestBase::GetDataFlowStats()
+{
+    Ptr<Ipv4FlowClassifier> classifier =
+        DynamicCast<Ipv4FlowClassifier>(m_flowmonHelper.GetClassifier());
+    for (const auto& [flowId, flowStats] : m_flowMonitor->GetFlowStats())
+    {
+        if (classifier->FindFlow(flowId).destinationPort == 1234)
+        {
+            return flowStats;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(true, false, "Data flow not found");
+    return FlowMonitor::FlowStats();
+}
+
+void
+FlowMonitorGsoTestBase::Teardown()
+{
+    m_txSocket->Close();
+    m_listeningSocket->Close();
+    m_txSocket = nullptr;
+    m_listeningSocket = nullptr;
+    m_flowMonitor = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Check that each segment of a super-segment is accounted as a packet
+ * of its own, and that the loss of a segment other than the first one is
+ * detected.
+ */
+class FlowMonitorGsoTestCase : public FlowMonitorGsoTestBase
+{
+  public:
+    FlowMonitorGsoTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorGsoTestCase::FlowMonitorGsoTestCase()
+    : FlowMonitorGsoTestBase("Check the accounting of the segments of TCP super-segments")
+{
+}
+
+void
+FlowMonitorGsoTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true); // no ARP
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    devices.Get(0)->SetMtu(1500);
+    devices.Get(1)->SetMtu(1500);
+    // the receiver gets the SYN, the ACK ending the handshake, then the first
+    // super-segment: drop its second segment
+    Ptr<ReceiveListErrorModel> errorModel = CreateObject<ReceiveListErrorModel>();
+    errorModel->SetList({3});
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    m_flowMonitor = m_flowmonHelper.Install(nodes);
+
+    Simulator::Schedule(Seconds(0.1),
+                        &FlowMonitorGsoTestCase::StartTransfer,
+                        this,
+                        nodes.Get(0),
+                        nodes.Get(1),
+                        interfaces.GetAddress(1),
+                        8,
+                        20000);
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    m_flowMonitor->CheckForLostPackets(Seconds(0));
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxBytes, 20000, "Data not fully received");
+    NS_TEST_EXPECT_MSG_GT(m_maxTxSize, 1500, "Segmentation offload not used");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxRxSize, 1500, "Super-segment not split");
+
+    FlowMonitor::FlowStats flowStats = GetDataFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(flowStats.lostPackets, 1, "Unexpected number of lost packets");
+    NS_TEST_EXPECT_MSG_EQ(flowStats.rxPackets + 1,
+                          flowStats.txPackets,
+                          "Segments not accounted as packets");
+    // the lost segment is made of 536 bytes of data and of the IP and TCP headers
+    NS_TEST_EXPECT_MSG_EQ(flowStats.txBytes - flowStats.rxBytes,
+                          536 + 20 + 20,
+                          "Unexpected number of bytes lost");
+
+    Teardown();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief Check that a super-segment larger than the MTU is not delivered as a
+ * whole when sent on the loopback device or to a local address, and that the
+ * FlowMonitor accounts for its segments.
+ */
+class FlowMonitorGsoLocalTestCase : public FlowMonitorGsoTestBase
+{
+  public:
+    /**
+     * Constructor
+     * \param loopback whether the data is sent to the loopback address rather
+     *        than to the address of a SimpleNetDevice of the node
+     */
+    FlowMonitorGsoLocalTestCase(bool loopback);
+
+  private:
+    void DoRun() override;
+
+    bool m_loopback; //!< whether the data is sent to the loopback address
+};
+
+FlowMonitorGsoLocalTestCase::FlowMonitorGsoLocalTestCase(bool loopback)
+    : FlowMonitorGsoTestBase(std::string("Check TCP super-segments sent to ") +
+                             (loopback ? "the loopback address" : "a local address")),
+      m_loopback(loopback)
+{
+}
+
+void
+FlowMonitorGsoLocalTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(node);
+    devices.Get(0)->SetMtu(1500);
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    m_flowMonitor = m_flowmonHelper.Install(node);
+
+    Ipv4Address address = interfaces.GetAddress(0);
+    uint32_t mtu = devices.Get(0)->GetMtu();
+    if (m_loopback)
+    {
+        // the MTU of the loopback device of Linux, below the size of the super-segments
+        address = Ipv4Address::GetLoopback();
+        mtu = 16436;
+        node->GetObject<Ipv4>()->GetNetDevice(0)->SetMtu(mtu);
+    }
+
+    // super-segments of up to 64 * 536 bytes
+    Simulator::Schedule(Seconds(0.1),
+                        &FlowMonitorGsoLocalTestCase::StartTransfer,
+                        this,
+                        node,
+                        node,
+                        address,
+                        64,
+                        200000);
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxBytes, 200000, "Data not fully received");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxRxSize, mtu, "Packet larger than the MTU received");
+
+    FlowMonitor::FlowStats flowStats = GetDataFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(flowStats.lostPackets, 0, "Unexpected number of lost packets");
+    NS_TEST_EXPECT_MSG_EQ(flowStats.rxPackets,
+                          flowStats.txPackets,
+                          "Unexpected number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(flowStats.rxBytes,
+                          flowStats.txBytes,
+                          "Unexpected number of received bytes");
+
+    Teardown();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", UNIT)
+{
+    AddTestCase(new FlowMonitorCsvExportTestCase, TestCase::QUICK);
+    AddTestCase(new FlowMonitorDropFinishedFlowsTestCase, TestCase::QUICK);
+    AddTestCase(new FlowMonitorGsoTestCase, TestCase::QUICK);
+    AddTestCase(new FlowMonitorGsoLocalTestCase(true), TestCase::QUICK);
+    AddTestCase(new FlowMonitorGsoLocalTestCase(false), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static FlowMonitorTestSuite g_flowMonitorTestSuite;
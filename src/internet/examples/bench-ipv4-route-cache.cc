@@ -0,0 +1,163 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the forwarding of IPv4 packets along a chain of
+// 'hops' point-to-point links, with global routing.  'flows' UDP flows are
+// sent from the first node of the chain to the last one, and the simulation
+// is timed with the route cache of Ipv4L3Protocol disabled, then enabled.
+// Sample usage:  ./ns3 run 'bench-ipv4-route-cache --hops=64 --packets=20000'
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/udp-server.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Build the chain and run the simulation.
+ *
+ * \param hops number of links of the chain
+ * \param flows number of UDP flows
+ * \param packets number of packets sent by each flow
+ * \param received the number of packets received at the end of the chain
+ * \return the time elapsed, in ms
+ */
+static int64_t
+Run(uint32_t hops, uint32_t flows, uint32_t packets, uint64_t& received)
+{
+    NodeContainer nodes;
+    nodes.Create(hops + 1);
+    InternetStackHelper stack;
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces;
+    for (uint32_t i = 0; i < hops; i++)
+    {
+        NetDeviceContainer devices = p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+        interfaces = address.Assign(devices);
+        address.NewNetwork();
+    }
+
+    ApplicationContainer servers;
+    ApplicationContainer clients;
+    for (uint32_t f = 0; f < flows; f++)
+    {
+        UdpServerHelper server(9 + f);
+        servers.Add(server.Install(nodes.Get(hops)));
+        UdpClientHelper client(interfaces.GetAddress(1), 9 + f);
+        client.SetAttribute("MaxPackets", UintegerValue(packets));
+        client.SetAttribute("Interval", TimeValue(MicroSeconds(10)));
+        client.SetAttribute("PacketSize", UintegerValue(64));
+        clients.Add(client.Install(nodes.Get(0)));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    servers.Start(Seconds(0));
+    clients.Start(Seconds(1));
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t delay = time.End();
+
+    received = 0;
+    for (uint32_t f = 0; f < flows; f++)
+    {
+        received += DynamicCast<UdpServer>(servers.Get(f))->GetReceived();
+    }
+    Simulator::Destroy();
+    Ipv4AddressGenerator::Reset();
+    return delay;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t hops = 64;
+    uint32_t flows = 4;
+    uint32_t packets = 20000;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the IPv4 route cache on a chain of point-to-point links");
+    cmd.AddValue("hops", "number of links of the chain", hops);
+    cmd.AddValue("flows", "number of UDP flows", flows);
+    cmd.AddValue("packets", "number of packets sent by each flow", packets);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(hops < 2 || hops > 65000, "The number of hops must be in [2, 65000]");
+    NS_ABORT_MSG_IF(flows < 1 || flows > 65000, "The number of flows must be in [1, 65000]");
+
+    std::cout << "Running bench-ipv4-route-cache with hops=" << hops << " flows=" << flows
+              << " packets=" << packets << std::endl;
+
+    for (bool enable : {false, true})
+    {
+        Config::SetDefault("ns3::Ipv4L3Protocol::EnableRouteCache", BooleanValue(enable));
+        int64_t minDelay = std::numeric_limits<int64_t>::max();
+        uint64_t received = 0;
+        for (uint32_t i = 0; i < minIterations; i++)
+        {
+            minDelay = std::min(minDelay, Run(hops, flows, packets, received));
+        }
+        NS_ABORT_MSG_UNLESS(received == static_cast<uint64_t>(flows) * packets,
+                            "Packets lost along the chain");
+        // Every packet is forwarded by the hops - 1 intermediate nodes
+        Report(enable ? "forward-cache" : "forward", received * (hops - 1), minDelay);
+    }
+    return 0;
+}
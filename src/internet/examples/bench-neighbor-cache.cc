@@ -0,0 +1,167 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the ARP caches on a large broadcast domain: 'n'
+// hosts are attached to a single SimpleChannel and the following operations
+// are timed:
+//  - populate: NeighborCacheHelper fills the ARP cache of every host with
+//    the other n - 1 hosts (n * (n - 1) entries);
+//  - lookup: lookups of the IPv4 addresses of the neighbors in the cache of a host;
+//  - lookup-inverse: lookups of the MAC addresses of the neighbors, as done
+//    for every packet received from an off-link source;
+//  - remove-add: removal and re-insertion of the entries of the neighbors.
+// Sample usage:  ./ns3 run 'bench-neighbor-cache --n=1000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000;
+    uint32_t rounds = 100;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the ARP caches on a large broadcast domain");
+    cmd.AddValue("n", "number of hosts on the broadcast domain", n);
+    cmd.AddValue("rounds", "number of rounds of lookups over all the neighbors", rounds);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(n < 2 || n > 65000, "The number of hosts must be in [2, 65000]");
+
+    NodeContainer nodes;
+    nodes.Create(n);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes, channel);
+
+    InternetStackHelper stack;
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.0.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    std::cout << "Running bench-neighbor-cache with n=" << n << std::endl;
+
+    NeighborCacheHelper neighborCache;
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        neighborCache.PopulateNeighborCache(channel);
+        minDelay = std::min(minDelay, time.End());
+        neighborCache.FlushAutoGenerated();
+    }
+    Report("populate", static_cast<uint64_t>(n) * (n - 1), minDelay);
+    neighborCache.PopulateNeighborCache(channel);
+
+    Ptr<Ipv4Interface> ipv4Interface =
+        nodes.Get(0)->GetObject<Ipv4L3Protocol>()->GetInterface(interfaces.Get(0).second);
+    Ptr<ArpCache> arpCache = ipv4Interface->GetArpCache();
+
+    minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t found = 0;
+        SystemWallClockMs time;
+        time.Start();
+        for (uint32_t r = 0; r < rounds; r++)
+        {
+            for (uint32_t j = 1; j < n; j++)
+            {
+                found += (arpCache->Lookup(interfaces.GetAddress(j)) != nullptr);
+            }
+        }
+        minDelay = std::min(minDelay, time.End());
+        NS_ABORT_MSG_UNLESS(found == static_cast<uint64_t>(rounds) * (n - 1), "Entries missing");
+    }
+    Report("lookup", static_cast<uint64_t>(rounds) * (n - 1), minDelay);
+
+    minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t found = 0;
+        SystemWallClockMs time;
+        time.Start();
+        for (uint32_t r = 0; r < rounds; r++)
+        {
+            for (uint32_t j = 1; j < n; j++)
+            {
+                found += arpCache->LookupInverse(devices.Get(j)->GetAddress()).size();
+            }
+        }
+        minDelay = std::min(minDelay, time.End());
+        NS_ABORT_MSG_UNLESS(found == static_cast<uint64_t>(rounds) * (n - 1), "Entries missing");
+    }
+    Report("lookup-inverse", static_cast<uint64_t>(rounds) * (n - 1), minDelay);
+
+    minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        for (uint32_t j = 1; j < n; j++)
+        {
+            Ipv4Address ipv4Address = interfaces.GetAddress(j);
+            arpCache->Remove(arpCache->Lookup(ipv4Address));
+            ArpCache::Entry* entry = arpCache->Add(ipv4Address);
+            entry->SetMacAddress(devices.Get(j)->GetAddress());
+            entry->MarkAutoGenerated();
+        }
+        minDelay = std::min(minDelay, time.End());
+    }
+    Report("remove-add", n - 1, minDelay);
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the segmentation offload mode of TCP: a
+// BulkSendApplication transfers 'bytes' bytes over a point-to-point link,
+// then over a CSMA link, and the simulation is timed with GsoMaxSegments
+// set to 1 (segmentation offload disabled), then to 'segments'. The number
+// of simulator events executed is reported along with the time elapsed.
+// Sample usage:  ./ns3 run 'bench-tcp-gso --bytes=100000000 --segments=44'
+
+#include "ns3/abort.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/csma-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Build the link and run the transfer.
+ *
+ * \param csma whether to use a CSMA link rather than a point-to-point link
+ * \param bytes number of bytes to transfer
+ * \param received the number of bytes received
+ * \param events the number of simulator events executed
+ * \return the time elapsed, in ms
+ */
+static int64_t
+Run(bool csma, uint64_t bytes, uint64_t& received, uint64_t& events)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    NetDeviceContainer devices;
+    if (csma)
+    {
+        CsmaHelper csmaHelper;
+        csmaHelper.SetChannelAttribute("DataRate", StringValue("10Gbps"));
+        csmaHelper.SetChannelAttribute("Delay", StringValue("10us"));
+        devices = csmaHelper.Install(nodes);
+    }
+    else
+    {
+        PointToPointHelper p2p;
+        p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+        p2p.SetChannelAttribute("Delay", StringValue("10us"));
+        devices = p2p.Install(nodes);
+    }
+    InternetStackHelper stack;
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    uint16_t port = 9;
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApp = sink.Install(nodes.Get(1));
+    BulkSendHelper source("ns3::TcpSocketFactory",
+                          InetSocketAddress(interfaces.GetAddress(1), port));
+    source.SetAttribute("MaxBytes", UintegerValue(bytes));
+    source.Install(nodes.Get(0));
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t delay = time.End();
+
+    received = DynamicCast<PacketSink>(sinkApp.Get(0))->GetTotalRx();
+    events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    Ipv4AddressGenerator::Reset();
+    return delay;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t bytes = 100000000;
+    uint32_t segments = 44;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the segmentation offload mode of TCP on a bulk transfer");
+    cmd.AddValue("bytes", "number of bytes to transfer", bytes);
+    cmd.AddValue("segments", "max number of segments sent at once with offload", segments);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(segments < 2 || segments > 65535, "The segments must be in [2, 65535]");
+
+    std::cout << "Running bench-tcp-gso with bytes=" << bytes << " segments=" << segments
+              << std::endl;
+
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1 << 22));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1 << 22));
+    for (bool csma : {false, true})
+    {
+        for (uint32_t gsoMaxSegments : {1U, segments})
+        {
+            Config::SetDefault("ns3::TcpSocketBase::GsoMaxSegments",
+                               UintegerValue(gsoMaxSegments));
+            int64_t minDelay = std::numeric_limits<int64_t>::max();
+            uint64_t received = 0;
+            uint64_t events = 0;
+            for (uint32_t i = 0; i < minIterations; i++)
+            {
+                minDelay = std::min(minDelay, Run(csma, bytes, received, events));
+            }
+            NS_ABORT_MSG_UNLESS(received == bytes, "Bytes lost during the transfer");
+            std::string name = std::string(csma ? "csma" : "p2p") +
+                               (gsoMaxSegments > 1 ? "-gso" : "") +
+                               " (events: " + std::to_string(events) + ")";
+            // One operation per segment of payload
+            Report(name, (bytes + 1447) / 1448, minDelay);
+        }
+    }
+    return 0;
+}
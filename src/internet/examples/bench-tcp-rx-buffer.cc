@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the TcpRxBuffer reassembly of 'n' segments, received
+// with a synthetic reordering distribution:
+//  - inorder: segments are received in sender order;
+//  - uniform: each segment is displaced by up to 'displacement' positions;
+//  - exponential: each segment is displaced by an exponentially distributed
+//    number of positions, with mean 'displacement';
+//  - spray: segments are sprayed round-robin over 'paths' paths, whose delays
+//    differ by 'displacement' positions each (as with ECMP packet spraying).
+// The receiving application reads all the in-order data after each segment.
+// Sample usage:  ./ns3 run 'bench-tcp-rx-buffer --n=100000 --displacement=64'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-rx-buffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Compute the order in which the segments are received.
+ *
+ * \param n number of segments
+ * \param distribution reordering distribution
+ * \param displacement mean (or maximum) displacement, in segments
+ * \param paths number of paths for the spray distribution
+ * \return the indexes of the segments, in order of reception
+ */
+static std::vector<uint32_t>
+ReceptionOrder(uint32_t n, const std::string& distribution, double displacement, uint32_t paths)
+{
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    Ptr<ExponentialRandomVariable> exponential = CreateObject<ExponentialRandomVariable>();
+    exponential->SetAttribute("Mean", DoubleValue(displacement));
+    exponential->SetAttribute("Bound", DoubleValue(displacement * 20));
+
+    std::vector<std::pair<double, uint32_t>> arrivals;
+    arrivals.reserve(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        double delay = 0;
+        if (distribution == "uniform")
+        {
+            delay = uniform->GetValue(0, displacement);
+        }
+        else if (distribution == "exponential")
+        {
+            delay = exponential->GetValue();
+        }
+        else if (distribution == "spray")
+        {
+            delay = (i % paths) * displacement + uniform->GetValue(0, 1);
+        }
+        arrivals.emplace_back(i + delay, i);
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end());
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    for (const auto& arrival : arrivals)
+    {
+        order.push_back(arrival.second);
+    }
+    return order;
+}
+
+/**
+ * Feed a TcpRxBuffer with the segments in the given order.
+ *
+ * \param order indexes of the segments, in order of reception
+ * \param segmentSize segment size
+ * \return the time elapsed, in ms
+ */
+static uint64_t
+RunBench(const std::vector<uint32_t>& order, uint32_t segmentSize)
+{
+    Ptr<Packet> p = Create<Packet>(segmentSize);
+    TcpRxBuffer rxBuf;
+    TcpHeader h;
+    uint64_t extracted = 0;
+
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+    rxBuf.SetMaxBufferSize(1U << 30);
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t index : order)
+    {
+        h.SetSequenceNumber(SequenceNumber32(1 + index * segmentSize));
+        rxBuf.Add(p, h);
+        if (rxBuf.Available() > 0)
+        {
+            extracted += rxBuf.Extract(rxBuf.Available())->GetSize();
+        }
+    }
+    uint64_t deltaMs = time.End();
+
+    NS_ABORT_MSG_UNLESS(extracted == static_cast<uint64_t>(order.size()) * segmentSize,
+                        "Data lost in reassembly");
+    return deltaMs;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100000;
+    uint32_t segmentSize = 1448;
+    double displacement = 64;
+    uint32_t paths = 4;
+    uint32_t minIterations = 1;
+    std::string distribution = "all";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark TcpRxBuffer reassembly under reordering");
+    cmd.AddValue("n", "number of segments", n);
+    cmd.AddValue("segmentSize", "segment size, in bytes", segmentSize);
+    cmd.AddValue("distribution",
+                 "reordering distribution (inorder, uniform, exponential, spray or all)",
+                 distribution);
+    cmd.AddValue("displacement", "reordering displacement, in segments", displacement);
+    cmd.AddValue("paths", "number of paths for the spray distribution", paths);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    std::vector<std::string> distributions{"inorder", "uniform", "exponential", "spray"};
+    if (distribution != "all")
+    {
+        NS_ABORT_MSG_IF(std::find(distributions.begin(), distributions.end(), distribution) ==
+                            distributions.end(),
+                        "Unknown distribution " << distribution);
+        distributions = {distribution};
+    }
+
+    std::cout << "Running bench-tcp-rx-buffer with n=" << n << " displacement=" << displacement
+              << std::endl;
+    for (const auto& d : distributions)
+    {
+        std::vector<uint32_t> order = ReceptionOrder(n, d, displacement, paths);
+        uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+        for (uint32_t i = 0; i < minIterations; i++)
+        {
+            minDelay = std::min(minDelay, RunBench(order, segmentSize));
+        }
+        double ps = n;
+        ps *= 1000;
+        ps /= std::max<uint64_t>(minDelay, 1);
+        std::cout << ps << " segments/s"
+                  << " (" << minDelay << " ms elapsed)\t" << d << std::endl;
+    }
+
+    return 0;
+}
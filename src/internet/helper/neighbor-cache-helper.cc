@@ -29,6 +29,8 @@
 #include "ns3/ptr.h"
 #include "ns3/simulator.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -60,66 +62,14 @@ void
 NeighborCacheHelper::PopulateNeighborCache(Ptr<Channel> channel) const
 {
     NS_LOG_FUNCTION(this << channel);
-    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    std::vector<DeviceInterfaces> interfaces = GetChannelInterfaces(channel);
+    for (std::size_t i = 0; i < interfaces.size(); ++i)
     {
-        Ptr<NetDevice> netDevice = channel->GetDevice(i);
-        Ptr<Node> node = netDevice->GetNode();
-
-        int32_t ipv4InterfaceIndex = -1;
-        if (node->GetObject<Ipv4>())
-        {
-            ipv4InterfaceIndex = node->GetObject<Ipv4>()->GetInterfaceForDevice(netDevice);
-        }
-        int32_t ipv6InterfaceIndex = -1;
-        if (node->GetObject<Ipv6>())
+        for (std::size_t j = 0; j < interfaces.size(); ++j)
         {
-            ipv6InterfaceIndex = node->GetObject<Ipv6>()->GetInterfaceForDevice(netDevice);
-        }
-
-        for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
-        {
-            Ptr<NetDevice> neighborDevice = channel->GetDevice(j);
-            Ptr<Node> neighborNode = neighborDevice->GetNode();
-
-            int32_t ipv4NeighborInterfaceIndex = -1;
-            if (neighborNode->GetObject<Ipv4>())
-            {
-                ipv4NeighborInterfaceIndex =
-                    neighborNode->GetObject<Ipv4>()->GetInterfaceForDevice(neighborDevice);
-            }
-            int32_t ipv6NeighborInterfaceIndex = -1;
-            if (neighborNode->GetObject<Ipv6>())
+            if (j != i)
             {
-                ipv6NeighborInterfaceIndex =
-                    neighborNode->GetObject<Ipv6>()->GetInterfaceForDevice(neighborDevice);
-            }
-
-            if (neighborDevice != netDevice)
-            {
-                if (ipv4InterfaceIndex != -1)
-                {
-                    Ptr<Ipv4Interface> ipv4Interface =
-                        node->GetObject<Ipv4L3Protocol>()->GetInterface(ipv4InterfaceIndex);
-                    if (ipv4NeighborInterfaceIndex != -1)
-                    {
-                        Ptr<Ipv4Interface> ipv4NeighborInterface =
-                            neighborNode->GetObject<Ipv4L3Protocol>()->GetInterface(
-                                ipv4NeighborInterfaceIndex);
-                        PopulateNeighborEntriesIpv4(ipv4Interface, ipv4NeighborInterface);
-                    }
-                }
-                if (ipv6InterfaceIndex != -1)
-                {
-                    Ptr<Ipv6Interface> ipv6Interface =
-                        node->GetObject<Ipv6L3Protocol>()->GetInterface(ipv6InterfaceIndex);
-                    if (ipv6NeighborInterfaceIndex != -1)
-                    {
-                        Ptr<Ipv6Interface> ipv6NeighborInterface =
-                            neighborNode->GetObject<Ipv6L3Protocol>()->GetInterface(
-                                ipv6NeighborInterfaceIndex);
-                        PopulateNeighborEntriesIpv6(ipv6Interface, ipv6NeighborInterface);
-                    }
-                }
+                PopulateNeighborEntries(interfaces[i], interfaces[j]);
             }
         }
     }
@@ -129,67 +79,23 @@ void
 NeighborCacheHelper::PopulateNeighborCache(const NetDeviceContainer& c) const
 {
     NS_LOG_FUNCTION(this);
+    std::map<Ptr<Channel>, std::vector<DeviceInterfaces>> channelInterfaces;
     for (uint32_t i = 0; i < c.GetN(); ++i)
     {
         Ptr<NetDevice> netDevice = c.Get(i);
         Ptr<Channel> channel = netDevice->GetChannel();
-        Ptr<Node> node = netDevice->GetNode();
-
-        int32_t ipv4InterfaceIndex = -1;
-        if (node->GetObject<Ipv4>())
+        auto it = channelInterfaces.find(channel);
+        if (it == channelInterfaces.end())
         {
-            ipv4InterfaceIndex = node->GetObject<Ipv4>()->GetInterfaceForDevice(netDevice);
-        }
-        int32_t ipv6InterfaceIndex = -1;
-        if (node->GetObject<Ipv6>())
-        {
-            ipv6InterfaceIndex = node->GetObject<Ipv6>()->GetInterfaceForDevice(netDevice);
+            it = channelInterfaces.emplace(channel, GetChannelInterfaces(channel)).first;
         }
 
+        DeviceInterfaces interfaces = GetDeviceInterfaces(netDevice);
         for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
         {
-            Ptr<NetDevice> neighborDevice = channel->GetDevice(j);
-            Ptr<Node> neighborNode = neighborDevice->GetNode();
-
-            int32_t ipv4NeighborInterfaceIndex = -1;
-            if (neighborNode->GetObject<Ipv4>())
+            if (channel->GetDevice(j) != netDevice)
             {
-                ipv4NeighborInterfaceIndex =
-                    neighborNode->GetObject<Ipv4>()->GetInterfaceForDevice(neighborDevice);
-            }
-            int32_t ipv6NeighborInterfaceIndex = -1;
-            if (neighborNode->GetObject<Ipv6>())
-            {
-                ipv6NeighborInterfaceIndex =
-                    neighborNode->GetObject<Ipv6>()->GetInterfaceForDevice(neighborDevice);
-            }
-
-            if (neighborDevice != netDevice)
-            {
-                if (ipv4InterfaceIndex != -1)
-                {
-                    Ptr<Ipv4Interface> ipv4Interface =
-                        node->GetObject<Ipv4L3Protocol>()->GetInterface(ipv4InterfaceIndex);
-                    if (ipv4NeighborInterfaceIndex != -1)
-                    {
-                        Ptr<Ipv4Interface> ipv4NeighborInterface =
-                            neighborNode->GetObject<Ipv4L3Protocol>()->GetInterface(
-                                ipv4NeighborInterfaceIndex);
-                        PopulateNeighborEntriesIpv4(ipv4Interface, ipv4NeighborInterface);
-                    }
-                }
-                if (ipv6InterfaceIndex != -1)
-                {
-                    Ptr<Ipv6Interface> ipv6Interface =
-                        node->GetObject<Ipv6L3Protocol>()->GetInterface(ipv6InterfaceIndex);
-                    if (ipv6NeighborInterfaceIndex != -1)
-                    {
-                        Ptr<Ipv6Interface> ipv6NeighborInterface =
-                            neighborNode->GetObject<Ipv6L3Protocol>()->GetInterface(
-                                ipv6NeighborInterfaceIndex);
-                        PopulateNeighborEntriesIpv6(ipv6Interface, ipv6NeighborInterface);
-                    }
-                }
+                PopulateNeighborEntries(interfaces, it->second[j]);
             }
         }
     }
@@ -199,6 +105,7 @@ void
 NeighborCacheHelper::PopulateNeighborCache(const Ipv4InterfaceContainer& c) const
 {
     NS_LOG_FUNCTION(this);
+    std::map<Ptr<Channel>, std::vector<DeviceInterfaces>> channelInterfaces;
     for (uint32_t i = 0; i < c.GetN(); ++i)
     {
         std::pair<Ptr<Ipv4>, uint32_t> returnValue = c.Get(i);
@@ -209,21 +116,17 @@ NeighborCacheHelper::PopulateNeighborCache(const Ipv4InterfaceContainer& c) cons
         {
             Ptr<NetDevice> netDevice = ipv4Interface->GetDevice();
             Ptr<Channel> channel = netDevice->GetChannel();
+            auto it = channelInterfaces.find(channel);
+            if (it == channelInterfaces.end())
+            {
+                it = channelInterfaces.emplace(channel, GetChannelInterfaces(channel)).first;
+            }
             for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
             {
-                Ptr<NetDevice> neighborDevice = channel->GetDevice(j);
-                if (neighborDevice != netDevice)
+                Ptr<Ipv4Interface> ipv4NeighborInterface = it->second[j].first;
+                if (channel->GetDevice(j) != netDevice && ipv4NeighborInterface)
                 {
-                    Ptr<Node> neighborNode = neighborDevice->GetNode();
-                    int32_t ipv4NeighborInterfaceIndex =
-                        neighborNode->GetObject<Ipv4>()->GetInterfaceForDevice(neighborDevice);
-                    if (ipv4NeighborInterfaceIndex != -1)
-                    {
-                        Ptr<Ipv4Interface> ipv4NeighborInterface =
-                            neighborNode->GetObject<Ipv4L3Protocol>()->GetInterface(
-                                ipv4NeighborInterfaceIndex);
-                        PopulateNeighborEntriesIpv4(ipv4Interface, ipv4NeighborInterface);
-                    }
+                    PopulateNeighborEntriesIpv4(ipv4Interface, ipv4NeighborInterface);
                 }
             }
         }
@@ -234,6 +137,7 @@ void
 NeighborCacheHelper::PopulateNeighborCache(const Ipv6InterfaceContainer& c) const
 {
     NS_LOG_FUNCTION(this);
+    std::map<Ptr<Channel>, std::vector<DeviceInterfaces>> channelInterfaces;
     for (uint32_t i = 0; i < c.GetN(); ++i)
     {
         std::pair<Ptr<Ipv6>, uint32_t> returnValue = c.Get(i);
@@ -244,27 +148,78 @@ NeighborCacheHelper::PopulateNeighborCache(const Ipv6InterfaceContainer& c) cons
         {
             Ptr<NetDevice> netDevice = ipv6Interface->GetDevice();
             Ptr<Channel> channel = netDevice->GetChannel();
+            auto it = channelInterfaces.find(channel);
+            if (it == channelInterfaces.end())
+            {
+                it = channelInterfaces.emplace(channel, GetChannelInterfaces(channel)).first;
+            }
             for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
             {
-                Ptr<NetDevice> neighborDevice = channel->GetDevice(j);
-                if (neighborDevice != netDevice)
+                Ptr<Ipv6Interface> ipv6NeighborInterface = it->second[j].second;
+                if (channel->GetDevice(j) != netDevice && ipv6NeighborInterface)
                 {
-                    Ptr<Node> neighborNode = neighborDevice->GetNode();
-                    int32_t ipv6NeighborInterfaceIndex =
-                        neighborNode->GetObject<Ipv6>()->GetInterfaceForDevice(neighborDevice);
-                    if (ipv6NeighborInterfaceIndex != -1)
-                    {
-                        Ptr<Ipv6Interface> ipv6NeighborInterface =
-                            neighborNode->GetObject<Ipv6L3Protocol>()->GetInterface(
-                                ipv6NeighborInterfaceIndex);
-                        PopulateNeighborEntriesIpv6(ipv6Interface, ipv6NeighborInterface);
-                    }
+                    PopulateNeighborEntriesIpv6(ipv6Interface, ipv6NeighborInterface);
                 }
             }
         }
     }
 }
 
+NeighborCacheHelper::DeviceInterfaces
+NeighborCacheHelper::GetDeviceInterfaces(Ptr<NetDevice> device) const
+{
+    NS_LOG_FUNCTION(this << device);
+    DeviceInterfaces interfaces;
+    Ptr<Node> node = device->GetNode();
+
+    Ptr<Ipv4L3Protocol> ipv4 = node->GetObject<Ipv4L3Protocol>();
+    if (ipv4)
+    {
+        int32_t ipv4InterfaceIndex = ipv4->GetInterfaceForDevice(device);
+        if (ipv4InterfaceIndex != -1)
+        {
+            interfaces.first = ipv4->GetInterface(ipv4InterfaceIndex);
+        }
+    }
+    Ptr<Ipv6L3Protocol> ipv6 = node->GetObject<Ipv6L3Protocol>();
+    if (ipv6)
+    {
+        int32_t ipv6InterfaceIndex = ipv6->GetInterfaceForDevice(device);
+        if (ipv6InterfaceIndex != -1)
+        {
+            interfaces.second = ipv6->GetInterface(ipv6InterfaceIndex);
+        }
+    }
+    return interfaces;
+}
+
+std::vector<NeighborCacheHelper::DeviceInterfaces>
+NeighborCacheHelper::GetChannelInterfaces(Ptr<Channel> channel) const
+{
+    NS_LOG_FUNCTION(this << channel);
+    std::vector<DeviceInterfaces> interfaces;
+    interfaces.reserve(channel->GetNDevices());
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        interfaces.push_back(GetDeviceInterfaces(channel->GetDevice(i)));
+    }
+    return interfaces;
+}
+
+void
+NeighborCacheHelper::PopulateNeighborEntries(const DeviceInterfaces& interfaces,
+                                             const DeviceInterfaces& neighborInterfaces) const
+{
+    if (interfaces.first && neighborInterfaces.first)
+    {
+        PopulateNeighborEntriesIpv4(interfaces.first, neighborInterfaces.first);
+    }
+    if (interfaces.second && neighborInterfaces.second)
+    {
+        PopulateNeighborEntriesIpv6(interfaces.second, neighborInterfaces.second);
+    }
+}
+
 void
 NeighborCacheHelper::PopulateNeighborEntriesIpv4(Ptr<Ipv4Interface> ipv4Interface,
                                                  Ptr<Ipv4Interface> neighborDeviceInterface) const
@@ -409,25 +364,19 @@ NeighborCacheHelper::FlushAutoGenerated() const
         Ptr<Node> node = NodeList::GetNode(i);
         for (uint32_t j = 0; j < node->GetNDevices(); ++j)
         {
-            Ptr<NetDevice> netDevice = node->GetDevice(j);
-            int32_t ipv4InterfaceIndex = node->GetObject<Ipv4>()->GetInterfaceForDevice(netDevice);
-            int32_t ipv6InterfaceIndex = node->GetObject<Ipv6>()->GetInterfaceForDevice(netDevice);
-            if (ipv4InterfaceIndex != -1)
+            DeviceInterfaces interfaces = GetDeviceInterfaces(node->GetDevice(j));
+            if (interfaces.first)
             {
-                Ptr<Ipv4Interface> ipv4Interface =
-                    node->GetObject<Ipv4L3Protocol>()->GetInterface(ipv4InterfaceIndex);
-                Ptr<ArpCache> arpCache = ipv4Interface->GetArpCache();
+                Ptr<ArpCache> arpCache = interfaces.first->GetArpCache();
                 if (arpCache)
                 {
                     NS_LOG_FUNCTION("Remove an ARP entry");
                     arpCache->RemoveAutoGeneratedEntries();
                 }
             }
-            if (ipv6InterfaceIndex != -1)
+            if (interfaces.second)
             {
-                Ptr<Ipv6Interface> ipv6Interface =
-                    node->GetObject<Ipv6L3Protocol>()->GetInterface(ipv6InterfaceIndex);
-                Ptr<NdiscCache> ndiscCache = ipv6Interface->GetNdiscCache();
+                Ptr<NdiscCache> ndiscCache = interfaces.second->GetNdiscCache();
                 if (ndiscCache)
                 {
                     NS_LOG_FUNCTION("Remove a NDISC entry");
@@ -35,6 +35,9 @@
 #include "ns3/net-device-container.h"
 #include "ns3/node-list.h"
 
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -45,6 +48,8 @@ namespace ns3
  *
  * This class is used to populate neighbor cache. Permanent entries will be added
  * on the scope of a channel, a NetDeviceContainer, an InterfaceContainer or globally.
+ * The IP interfaces of the devices of a channel are only looked up once, so that
+ * the time taken to populate the caches is linear in the number of entries added.
  */
 class NeighborCacheHelper
 {
@@ -104,6 +109,33 @@ class NeighborCacheHelper
     void SetDynamicNeighborCache(bool enable);
 
   private:
+    /**
+     * \brief The IPv4 and IPv6 interfaces of a NetDevice, null if not configured.
+     */
+    typedef std::pair<Ptr<Ipv4Interface>, Ptr<Ipv6Interface>> DeviceInterfaces;
+
+    /**
+     * \brief Get the IPv4 and IPv6 interfaces of a NetDevice.
+     * \param device the NetDevice
+     * \return the interfaces of the NetDevice
+     */
+    DeviceInterfaces GetDeviceInterfaces(Ptr<NetDevice> device) const;
+
+    /**
+     * \brief Get the IPv4 and IPv6 interfaces of all the NetDevices of a Channel.
+     * \param channel the Channel
+     * \return the interfaces of each NetDevice, in the order of the Channel devices
+     */
+    std::vector<DeviceInterfaces> GetChannelInterfaces(Ptr<Channel> channel) const;
+
+    /**
+     * \brief Populate neighbor ARP and NDISC entries for the given interfaces.
+     * \param interfaces the interfaces to process
+     * \param neighborInterfaces the interfaces of the potential neighbor
+     */
+    void PopulateNeighborEntries(const DeviceInterfaces& interfaces,
+                                 const DeviceInterfaces& neighborInterfaces) const;
+
     /**
      * \brief Populate neighbor ARP entries for given IPv4 interface.
      * \param ipv4Interface the Ipv4Interface to process
@@ -30,6 +30,8 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -199,37 +201,43 @@ ArpCache::HandleWaitReplyTimeout()
     NS_LOG_FUNCTION(this);
     ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    for (auto i = m_waitReplyEntries.begin(); i != m_waitReplyEntries.end();)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        CacheI it = m_arpCache.find(*i);
+        entry = (it != m_arpCache.end()) ? it->second : nullptr;
+        if (entry == nullptr || !entry->IsWaitReply())
         {
-            if (entry->GetRetries() < m_maxRetries)
-            {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- retransmitting arp request since retries = "
-                                     << entry->GetRetries());
-                m_arpRequestCallback(this, entry->GetIpv4Address());
-                restartWaitReplyTimer = true;
-                entry->IncrementRetries();
-            }
-            else
+            // the entry has been resolved or removed since it was marked WaitReply
+            i = m_waitReplyEntries.erase(i);
+            continue;
+        }
+        if (entry->GetRetries() < m_maxRetries)
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- retransmitting arp request since retries = "
+                                 << entry->GetRetries());
+            m_arpRequestCallback(this, entry->GetIpv4Address());
+            restartWaitReplyTimer = true;
+            entry->IncrementRetries();
+            i++;
+        }
+        else
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- drop since max retries exceeded: "
+                                 << entry->GetRetries());
+            entry->MarkDead();
+            entry->ClearRetries();
+            i = m_waitReplyEntries.erase(i);
+            Ipv4PayloadHeaderPair pending = entry->DequeuePending();
+            while (pending.first)
             {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- drop since max retries exceeded: "
-                                     << entry->GetRetries());
-                entry->MarkDead();
-                entry->ClearRetries();
-                Ipv4PayloadHeaderPair pending = entry->DequeuePending();
-                while (pending.first)
-                {
-                    // add the Ipv4 header for tracing purposes
-                    pending.first->AddHeader(pending.second);
-                    m_dropTrace(pending.first);
-                    pending = entry->DequeuePending();
-                }
+                // add the Ipv4 header for tracing purposes
+                pending.first->AddHeader(pending.second);
+                m_dropTrace(pending.first);
+                pending = entry->DequeuePending();
             }
         }
     }
@@ -250,6 +258,8 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_macIndex.clear();
+    m_waitReplyEntries.clear();
     if (m_waitReplyTimer.IsRunning())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -264,7 +274,9 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries sorted by IPv4 address
+    std::map<Ipv4Address, ArpCache::Entry*> sorted(m_arpCache.begin(), m_arpCache.end());
+    for (auto i = sorted.begin(); i != sorted.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -311,8 +323,9 @@ ArpCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            UpdateMacIndex(i->second, i->second->GetMacAddress(), Address());
             delete i->second;
-            m_arpCache.erase(i++);
+            i = m_arpCache.erase(i);
             continue;
         }
         i++;
@@ -325,14 +338,15 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto range = m_macIndex.equal_range(to);
+    for (auto i = range.first; i != range.second; i++)
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
-        {
-            entryList.push_back(entry);
-        }
+        entryList.push_back(i->second);
     }
+    // return the entries sorted by IPv4 address, regardless of the hashing
+    entryList.sort([](ArpCache::Entry* a, ArpCache::Entry* b) {
+        return a->GetIpv4Address() < b->GetIpv4Address();
+    });
     return entryList;
 }
 
@@ -365,17 +379,38 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    CacheI i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
+        m_arpCache.erase(i);
+        UpdateMacIndex(entry, entry->GetMacAddress(), Address());
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
+    }
+    NS_LOG_WARN("Entry not found in this ARP Cache");
+}
+
+void
+ArpCache::UpdateMacIndex(ArpCache::Entry* entry, const Address& oldMac, const Address& newMac)
+{
+    NS_LOG_FUNCTION(this << entry << oldMac << newMac);
+    if (!oldMac.IsInvalid())
+    {
+        auto range = m_macIndex.equal_range(oldMac);
+        for (auto i = range.first; i != range.second; i++)
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
-            return;
+            if (i->second == entry)
+            {
+                m_macIndex.erase(i);
+                break;
+            }
         }
     }
-    NS_LOG_WARN("Entry not found in this ARP Cache");
+    if (!newMac.IsInvalid())
+    {
+        m_macIndex.emplace(newMac, entry);
+    }
 }
 
 ArpCache::Entry::Entry(ArpCache* arp)
@@ -436,6 +471,7 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
+    m_arp->UpdateMacIndex(this, m_macAddress, macAddress);
     m_macAddress = macAddress;
     m_state = ALIVE;
     ClearRetries();
@@ -492,6 +528,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     m_state = WAIT_REPLY;
     m_pending.push_back(waiting);
     UpdateSeen();
+    m_arp->m_waitReplyEntries.insert(m_ipv4Address);
     m_arp->StartWaitReplyTimer();
 }
 
@@ -506,6 +543,7 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    m_arp->UpdateMacIndex(this, m_macAddress, macAddress);
     m_macAddress = macAddress;
 }
 
@@ -32,8 +32,9 @@
 #include "ns3/traced-callback.h"
 
 #include <list>
-#include <map>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -48,6 +49,11 @@ class Ipv4Header;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * Entries are hashed by IPv4 address, and also indexed by MAC address, so
+ * that lookups, inverse lookups and removals take constant time even on
+ * large broadcast domains.  The WaitReply timer only visits the entries
+ * waiting for an ARP reply.
  */
 class ArpCache : public Object
 {
@@ -321,14 +327,26 @@ class ArpCache : public Object
     /**
      * \brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * \brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash>::iterator CacheI;
+    /**
+     * \brief Container of the entries indexed by MAC address
+     */
+    typedef std::unordered_multimap<Address, ArpCache::Entry*, AddressHash> MacIndex;
 
     void DoDispose() override;
 
+    /**
+     * \brief Update the MAC address index when the MAC address of an entry changes
+     * \param entry the entry
+     * \param oldMac the previous MAC address of the entry
+     * \param newMac the new MAC address of the entry
+     */
+    void UpdateMacIndex(ArpCache::Entry* entry, const Address& oldMac, const Address& newMac);
+
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
     Time m_aliveTimeout;            //!< cache alive state timeout
@@ -347,6 +365,8 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    MacIndex m_macIndex;         //!< the entries with a valid MAC address, by MAC address
+    std::set<Ipv4Address> m_waitReplyEntries; //!< addresses of the entries (possibly) in WaitReply
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
@@ -0,0 +1,89 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef GSO_TAG_H
+#define GSO_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Packet tag marking a TCP super-segment for generic segmentation offload
+ *
+ * When the GsoMaxSegments attribute of TcpSocketBase is greater than one,
+ * the socket may send several MSS worth of data in a single packet, which
+ * crosses the IP and traffic control layers as one object. This tag
+ * records the size of the segments the super-segment is made of, so that
+ * it can be split into regular TCP segments right before being handed to
+ * the NetDevice (see Ipv4QueueDiscItem::PopSegment).
+ */
+class GsoTag : public Tag
+{
+  public:
+    GsoTag();
+
+    /**
+     * \brief Constructor
+     *
+     * \param segmentSize the payload size of each segment
+     * \param headerSize the size of the TCP header, options included
+     */
+    GsoTag(uint16_t segmentSize, uint16_t headerSize);
+
+    /**
+     * \brief Set the payload size of each segment
+     * \param segmentSize the payload size of each segment
+     */
+    void SetSegmentSize(uint16_t segmentSize);
+    /**
+     * \brief Get the payload size of each segment
+     * \returns the payload size of each segment
+     */
+    uint16_t GetSegmentSize() const;
+
+    /**
+     * \brief Set the size of the TCP header
+     * \param headerSize the size of the TCP header, options included
+     */
+    void SetHeaderSize(uint16_t headerSize);
+    /**
+     * \brief Get the size of the TCP header
+     * \returns the size of the TCP header, options included
+     */
+    uint16_t GetHeaderSize() const;
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint16_t m_segmentSize; //!< Payload size of each segment
+    uint16_t m_headerSize;  //!< Size of the TCP header
+};
+
+} // namespace ns3
+
+#endif /* GSO_TAG_H */
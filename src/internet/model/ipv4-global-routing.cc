@@ -83,6 +83,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    NotifyRouteChange();
 }
 
 void
@@ -92,6 +93,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    NotifyRouteChange();
 }
 
 void
@@ -104,6 +106,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    NotifyRouteChange();
 }
 
 void
@@ -113,6 +116,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    NotifyRouteChange();
 }
 
 void
@@ -125,6 +129,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    NotifyRouteChange();
 }
 
 Ptr<Ipv4Route>
@@ -301,6 +306,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
+                NotifyRouteChange();
                 return;
             }
             tmp++;
@@ -317,6 +323,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
+            NotifyRouteChange();
             return;
         }
         tmp++;
@@ -332,6 +339,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
+            NotifyRouteChange();
             return;
         }
         tmp++;
@@ -527,6 +535,13 @@ Ipv4GlobalRouting::RouteInput(Ptr<const Packet> p,
     }
 }
 
+bool
+Ipv4GlobalRouting::IsRouteCacheable() const
+{
+    // Randomly spread packets cannot be pinned to a cached route
+    return !m_randomEcmpRouting;
+}
+
 void
 Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
 {
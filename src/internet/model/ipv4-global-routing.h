@@ -107,6 +107,7 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     void SetIpv4(Ptr<Ipv4> ipv4) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    bool IsRouteCacheable() const override;
 
     /**
      * \brief Add a host route to the global routing table.
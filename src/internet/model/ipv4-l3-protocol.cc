@@ -21,6 +21,7 @@
 
 #include "arp-cache.h"
 #include "arp-l3-protocol.h"
+#include "gso-tag.h"
 #include "icmpv4-l4-protocol.h"
 #include "ipv4-header.h"
 #include "ipv4-interface.h"
@@ -87,6 +88,20 @@ Ipv4L3Protocol::GetTypeId()
                           TimeValue(Seconds(1)),
                           MakeTimeAccessor(&Ipv4L3Protocol::m_purge),
                           MakeTimeChecker(Seconds(0)))
+            .AddAttribute("EnableRouteCache",
+                          "Cache the routes of the forwarded unicast packets, per destination "
+                          "and input interface, and bypass the routing protocol for the "
+                          "following packets. Only used with routing protocols whose routes "
+                          "can be cached.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ipv4L3Protocol::SetRouteCacheEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxRouteCacheSize",
+                          "The maximum number of routes in the route cache. The cache is "
+                          "flushed when full.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&Ipv4L3Protocol::m_maxRouteCacheSize),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddTraceSource("Tx",
                             "Send ipv4 packet to outgoing interface.",
                             MakeTraceSourceAccessor(&Ipv4L3Protocol::m_txTrace),
@@ -125,12 +140,24 @@ Ipv4L3Protocol::GetTypeId()
                             "and it is being forward up the stack",
                             MakeTraceSourceAccessor(&Ipv4L3Protocol::m_localDeliverTrace),
                             "ns3::Ipv4L3Protocol::SentTracedCallback")
+            .AddTraceSource("RouteCacheHit",
+                            "A unicast IPv4 packet is being forwarded with "
+                            "a route found in the route cache",
+                            MakeTraceSourceAccessor(&Ipv4L3Protocol::m_routeCacheHitTrace),
+                            "ns3::Ipv4L3Protocol::SentTracedCallback")
+            .AddTraceSource("RouteCacheMiss",
+                            "A unicast IPv4 packet is being forwarded with a route "
+                            "returned by the routing protocol, which is added to the route cache",
+                            MakeTraceSourceAccessor(&Ipv4L3Protocol::m_routeCacheMissTrace),
+                            "ns3::Ipv4L3Protocol::SentTracedCallback")
 
         ;
     return tid;
 }
 
 Ipv4L3Protocol::Ipv4L3Protocol()
+    : m_enableRouteCache(false),
+      m_maxRouteCacheSize(1024)
 {
     NS_LOG_FUNCTION(this);
     m_ucb = MakeCallback(&Ipv4L3Protocol::IpForward, this);
@@ -301,8 +328,29 @@ void
 Ipv4L3Protocol::SetRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol)
 {
     NS_LOG_FUNCTION(this << routingProtocol);
+    if (m_routingProtocol)
+    {
+        m_routingProtocol->SetRouteChangeCallback(MakeNullCallback<void>());
+    }
     m_routingProtocol = routingProtocol;
     m_routingProtocol->SetIpv4(this);
+    m_routingProtocol->SetRouteChangeCallback(MakeCallback(&Ipv4L3Protocol::FlushRouteCache, this));
+    FlushRouteCache();
+}
+
+void
+Ipv4L3Protocol::SetRouteCacheEnabled(bool enable)
+{
+    NS_LOG_FUNCTION(this << enable);
+    m_enableRouteCache = enable;
+    FlushRouteCache();
+}
+
+void
+Ipv4L3Protocol::FlushRouteCache()
+{
+    NS_LOG_FUNCTION(this);
+    m_routeCache.clear();
 }
 
 Ptr<Ipv4RoutingProtocol>
@@ -331,6 +379,11 @@ Ipv4L3Protocol::DoDispose()
 
     m_sockets.clear();
     m_node = nullptr;
+    m_routeCache.clear();
+    if (m_routingProtocol)
+    {
+        m_routingProtocol->SetRouteChangeCallback(MakeNullCallback<void>());
+    }
     m_routingProtocol = nullptr;
 
     for (MapFragments_t::iterator it = m_fragments.begin(); it != m_fragments.end(); it++)
@@ -676,7 +729,22 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
     }
 
     NS_ASSERT_MSG(m_routingProtocol, "Need a routing protocol object to process packets");
-    if (!m_routingProtocol->RouteInput(packet, ipHeader, device, m_ucb, m_mcb, m_lcb, m_ecb))
+    Ipv4RoutingProtocol::UnicastForwardCallback ucb = m_ucb;
+    if (m_enableRouteCache && !ipHeader.GetDestination().IsMulticast() &&
+        !ipHeader.GetDestination().IsBroadcast() && m_routingProtocol->IsRouteCacheable())
+    {
+        auto it = m_routeCache.find(GetRouteCacheKey(ipHeader.GetDestination(), interface));
+        if (it != m_routeCache.end())
+        {
+            NS_LOG_LOGIC("Route cache hit for " << ipHeader.GetDestination());
+            m_routeCacheHitTrace(ipHeader, packet, interface);
+            IpForward(it->second, packet, ipHeader);
+            return;
+        }
+        ucb = MakeCallback(&Ipv4L3Protocol::IpForwardAndCache, this)
+                  .Bind(static_cast<uint32_t>(interface));
+    }
+    if (!m_routingProtocol->RouteInput(packet, ipHeader, device, ucb, m_mcb, m_lcb, m_ecb))
     {
         NS_LOG_WARN("No route found for forwarding packet.  Drop.");
         m_dropTrace(ipHeader, packet, DROP_NO_ROUTE, this, interface);
@@ -1015,10 +1083,44 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (outInterface->IsUp())
     {
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
-        if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
+        uint16_t mtu = outInterface->GetDevice()->GetMtu();
+        GsoTag gsoTag;
+        if (packet->PeekPacketTag(gsoTag))
+        {
+            // A packet built for segmentation offload is not fragmented: it is
+            // split into TCP segments before being handed to the device, unless
+            // it fits the MTU or its segments do not. Packets sent on a loopback
+            // device or to a local address do not cross the traffic control layer,
+            // where the split happens, hence they fall back to IP fragmentation.
+            bool local = DynamicCast<LoopbackNetDevice>(outDev) != nullptr;
+            for (uint32_t i = 0; !local && i < outInterface->GetNAddresses(); i++)
+            {
+                local = (target == outInterface->GetAddress(i).GetLocal());
+            }
+            uint32_t headerSize = ipHeader.GetSerializedSize() + gsoTag.GetHeaderSize();
+            uint32_t payloadSize = packet->GetSize() - gsoTag.GetHeaderSize();
+            if (local || packet->GetSize() + ipHeader.GetSerializedSize() <= mtu ||
+                headerSize + gsoTag.GetSegmentSize() > mtu)
+            {
+                packet->RemovePacketTag(gsoTag);
+            }
+            else
+            {
+                // Each segment takes its own identification
+                uint32_t nSegments =
+                    (payloadSize + gsoTag.GetSegmentSize() - 1) / gsoTag.GetSegmentSize();
+                uint64_t srcDst = ipHeader.GetDestination().Get() |
+                                  (uint64_t(ipHeader.GetSource().Get()) << 32);
+                m_identification[std::make_pair(srcDst, ipHeader.GetProtocol())] += nSegments - 1;
+                CallTxTrace(ipHeader, packet, this, interface);
+                outInterface->Send(packet, ipHeader, target);
+                return;
+            }
+        }
+        if (packet->GetSize() + ipHeader.GetSerializedSize() > mtu)
         {
             std::list<Ipv4PayloadHeaderPair> listFragments;
-            DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
+            DoFragmentation(packet, ipHeader, mtu, listFragments);
             for (std::list<Ipv4PayloadHeaderPair>::iterator it = listFragments.begin();
                  it != listFragments.end();
                  it++)
@@ -1112,6 +1214,29 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
     SendRealOut(rtentry, packet, ipHeader);
 }
 
+void
+Ipv4L3Protocol::IpForwardAndCache(uint32_t iif,
+                                  Ptr<Ipv4Route> rtentry,
+                                  Ptr<const Packet> p,
+                                  const Ipv4Header& header)
+{
+    NS_LOG_FUNCTION(this << iif << rtentry << p << header);
+    m_routeCacheMissTrace(header, p, iif);
+    if (m_routeCache.size() >= m_maxRouteCacheSize)
+    {
+        NS_LOG_LOGIC("Route cache full, flushing it");
+        m_routeCache.clear();
+    }
+    m_routeCache[GetRouteCacheKey(header.GetDestination(), iif)] = rtentry;
+    IpForward(rtentry, p, header);
+}
+
+uint64_t
+Ipv4L3Protocol::GetRouteCacheKey(Ipv4Address dest, uint32_t iif)
+{
+    return (static_cast<uint64_t>(dest.Get()) << 32) | iif;
+}
+
 void
 Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uint32_t iif)
 {
@@ -1181,6 +1306,7 @@ Ipv4L3Protocol::AddAddress(uint32_t i, Ipv4InterfaceAddress address)
     NS_LOG_FUNCTION(this << i << address);
     Ptr<Ipv4Interface> interface = GetInterface(i);
     bool retVal = interface->AddAddress(address);
+    FlushRouteCache();
     if (m_routingProtocol)
     {
         m_routingProtocol->NotifyAddAddress(i, address);
@@ -1212,6 +1338,7 @@ Ipv4L3Protocol::RemoveAddress(uint32_t i, uint32_t addressIndex)
     Ipv4InterfaceAddress address = interface->RemoveAddress(addressIndex);
     if (address != Ipv4InterfaceAddress())
     {
+        FlushRouteCache();
         if (m_routingProtocol)
         {
             m_routingProtocol->NotifyRemoveAddress(i, address);
@@ -1235,6 +1362,7 @@ Ipv4L3Protocol::RemoveAddress(uint32_t i, Ipv4Address address)
     Ipv4InterfaceAddress ifAddr = interface->RemoveAddress(address);
     if (ifAddr != Ipv4InterfaceAddress())
     {
+        FlushRouteCache();
         if (m_routingProtocol)
         {
             m_routingProtocol->NotifyRemoveAddress(i, ifAddr);
@@ -1378,6 +1506,7 @@ Ipv4L3Protocol::SetUp(uint32_t i)
     if (interface->GetDevice()->GetMtu() >= 68)
     {
         interface->SetUp();
+        FlushRouteCache();
 
         if (m_routingProtocol)
         {
@@ -1399,6 +1528,7 @@ Ipv4L3Protocol::SetDown(uint32_t ifaceIndex)
     NS_LOG_FUNCTION(this << ifaceIndex);
     Ptr<Ipv4Interface> interface = GetInterface(ifaceIndex);
     interface->SetDown();
+    FlushRouteCache();
 
     if (m_routingProtocol)
     {
@@ -1421,6 +1551,7 @@ Ipv4L3Protocol::SetForwarding(uint32_t i, bool val)
     NS_LOG_FUNCTION(this << i);
     Ptr<Ipv4Interface> interface = GetInterface(i);
     interface->SetForwarding(val);
+    FlushRouteCache();
 }
 
 Ptr<NetDevice>
@@ -1439,6 +1570,7 @@ Ipv4L3Protocol::SetIpForward(bool forward)
     {
         (*i)->SetForwarding(forward);
     }
+    FlushRouteCache();
 }
 
 bool
@@ -1453,6 +1585,7 @@ Ipv4L3Protocol::SetWeakEsModel(bool model)
 {
     NS_LOG_FUNCTION(this << model);
     m_weakEsModel = model;
+    FlushRouteCache();
 }
 
 bool
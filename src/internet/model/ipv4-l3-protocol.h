@@ -33,6 +33,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class Ipv4L3ProtocolTestCase;
@@ -121,6 +122,15 @@ class Ipv4L3Protocol : public Ipv4
     void SetRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol) override;
     Ptr<Ipv4RoutingProtocol> GetRoutingProtocol() const override;
 
+    /**
+     * \brief Remove all the routes from the route cache.
+     *
+     * The cache is flushed automatically when the routing protocol notifies
+     * a change of its routes, and when the addresses, the state or the
+     * forwarding setting of the interfaces are changed through this class.
+     */
+    void FlushRouteCache();
+
     Ptr<Socket> CreateRawSocket() override;
     void DeleteRawSocket(Ptr<Socket> socket) override;
 
@@ -297,6 +307,12 @@ class Ipv4L3Protocol : public Ipv4
     void SetWeakEsModel(bool model) override;
     bool GetWeakEsModel() const override;
 
+    /**
+     * \brief Enable or disable the route cache.
+     * \param enable true to enable the route cache
+     */
+    void SetRouteCacheEnabled(bool enable);
+
     /**
      * \brief Decrease the identification value for a dropped or recursed packet
      * \param source source IPv4 address
@@ -340,6 +356,27 @@ class Ipv4L3Protocol : public Ipv4
      */
     void IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv4Header& header);
 
+    /**
+     * \brief Add a route returned by the routing protocol to the route cache,
+     * then forward the packet.
+     * \param iif input interface
+     * \param rtentry route
+     * \param p packet to forward
+     * \param header IPv4 header to add to the packet
+     */
+    void IpForwardAndCache(uint32_t iif,
+                           Ptr<Ipv4Route> rtentry,
+                           Ptr<const Packet> p,
+                           const Ipv4Header& header);
+
+    /**
+     * \brief Get the key of a route in the route cache.
+     * \param dest destination address
+     * \param iif input interface
+     * \return the key of the route
+     */
+    static uint64_t GetRouteCacheKey(Ipv4Address dest, uint32_t iif);
+
     /**
      * \brief Forward a multicast packet.
      * \param mrtentry route
@@ -477,6 +514,10 @@ class Ipv4L3Protocol : public Ipv4
     TracedCallback<const Ipv4Header&, Ptr<const Packet>, uint32_t> m_multicastForwardTrace;
     /// Trace of locally delivered packets
     TracedCallback<const Ipv4Header&, Ptr<const Packet>, uint32_t> m_localDeliverTrace;
+    /// Trace of unicast packets forwarded with a cached route
+    TracedCallback<const Ipv4Header&, Ptr<const Packet>, uint32_t> m_routeCacheHitTrace;
+    /// Trace of unicast packets forwarded with a route added to the route cache
+    TracedCallback<const Ipv4Header&, Ptr<const Packet>, uint32_t> m_routeCacheMissTrace;
 
     // The following two traces pass a packet with an IP header
     /// Trace of transmitted packets
@@ -496,6 +537,11 @@ class Ipv4L3Protocol : public Ipv4
 
     Ptr<Ipv4RoutingProtocol> m_routingProtocol; //!< Routing protocol associated with the stack
 
+    bool m_enableRouteCache;      //!< Whether the route cache is enabled
+    uint32_t m_maxRouteCacheSize; //!< Maximum number of routes in the route cache
+    /// Routes of the forwarded packets, indexed by destination address and input interface
+    std::unordered_map<uint64_t, Ptr<Ipv4Route>> m_routeCache;
+
     SocketList m_sockets; //!< List of IPv4 raw sockets.
 
     /// Key identifying a fragmented packet
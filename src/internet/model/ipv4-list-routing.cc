@@ -63,6 +63,7 @@ Ipv4ListRouting::DoDispose()
         // Note:  Calling dispose on these protocols causes memory leak
         //        The routing protocols should not maintain a pointer to
         //        this object, so Dispose() shouldn't be necessary.
+        (*rprotoIter).second->SetRouteChangeCallback(MakeNullCallback<void>());
         (*rprotoIter).second = nullptr;
     }
     m_routingProtocols.clear();
@@ -259,6 +260,19 @@ Ipv4ListRouting::SetIpv4(Ptr<Ipv4> ipv4)
     m_ipv4 = ipv4;
 }
 
+bool
+Ipv4ListRouting::IsRouteCacheable() const
+{
+    for (const auto& rproto : m_routingProtocols)
+    {
+        if (!rproto.second->IsRouteCacheable())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 Ipv4ListRouting::AddRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol, int16_t priority)
 {
@@ -269,6 +283,9 @@ Ipv4ListRouting::AddRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol, in
     {
         routingProtocol->SetIpv4(m_ipv4);
     }
+    routingProtocol->SetRouteChangeCallback(
+        MakeCallback(&Ipv4ListRouting::NotifyRouteChange, this));
+    NotifyRouteChange();
 }
 
 uint32_t
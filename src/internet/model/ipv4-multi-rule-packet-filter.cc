@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ipv4-multi-rule-packet-filter.h"
+
+#include "ipv4-queue-disc-item.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ipv4MultiRulePacketFilter");
+
+NS_OBJECT_ENSURE_REGISTERED(Ipv4MultiRulePacketFilter);
+
+TypeId
+Ipv4MultiRulePacketFilter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::Ipv4MultiRulePacketFilter")
+            .SetParent<Ipv4PacketFilter>()
+            .SetGroupName("Internet")
+            .AddConstructor<Ipv4MultiRulePacketFilter>()
+            .AddAttribute("FlowCacheSize",
+                          "The maximum number of flows whose class is cached (0 disables "
+                          "the cache). The cache is flushed when it is full",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&Ipv4MultiRulePacketFilter::m_flowCacheSize),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+Ipv4MultiRulePacketFilter::Ipv4MultiRulePacketFilter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ipv4MultiRulePacketFilter::~Ipv4MultiRulePacketFilter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+Ipv4MultiRulePacketFilter::FiveTuple::operator==(const FiveTuple& other) const
+{
+    return source == other.source && destination == other.destination &&
+           sourcePort == other.sourcePort && destinationPort == other.destinationPort &&
+           protocol == other.protocol;
+}
+
+uint32_t
+Ipv4MultiRulePacketFilter::AddRule(const Rule& rule)
+{
+    NS_LOG_FUNCTION(this << rule.classId);
+
+    NS_ABORT_MSG_IF(rule.sourcePortMin > rule.sourcePortMax ||
+                        rule.destinationPortMin > rule.destinationPortMax,
+                    "Invalid port range");
+
+    CompiledRule compiled;
+    compiled.sourceMask = rule.sourceMask.Get();
+    compiled.source = rule.source.Get() & compiled.sourceMask;
+    compiled.destinationMask = rule.destinationMask.Get();
+    compiled.destination = rule.destination.Get() & compiled.destinationMask;
+    compiled.sourcePortMin = rule.sourcePortMin;
+    compiled.sourcePortSpan = rule.sourcePortMax - rule.sourcePortMin;
+    compiled.destinationPortMin = rule.destinationPortMin;
+    compiled.destinationPortSpan = rule.destinationPortMax - rule.destinationPortMin;
+    compiled.protocol = rule.protocol;
+    compiled.classId = rule.classId;
+    m_rules.push_back(compiled);
+
+    // the cached classes may not be the ones given by the new rules
+    m_flowCache.clear();
+    return m_rules.size() - 1;
+}
+
+uint32_t
+Ipv4MultiRulePacketFilter::GetNRules() const
+{
+    return m_rules.size();
+}
+
+int32_t
+Ipv4MultiRulePacketFilter::Match(const FiveTuple& tuple) const
+{
+    // the fields of a rule are compared without branches, so that a rule costs
+    // a handful of integer operations
+    for (const auto& rule : m_rules)
+    {
+        uint32_t addresses = ((tuple.source & rule.sourceMask) ^ rule.source) |
+                             ((tuple.destination & rule.destinationMask) ^ rule.destination);
+        bool ports =
+            static_cast<uint16_t>(tuple.sourcePort - rule.sourcePortMin) <= rule.sourcePortSpan &&
+            static_cast<uint16_t>(tuple.destinationPort - rule.destinationPortMin) <=
+                rule.destinationPortSpan;
+        bool protocol = (rule.protocol == 0) | (rule.protocol == tuple.protocol);
+        if ((addresses == 0) & ports & protocol)
+        {
+            return rule.classId;
+        }
+    }
+    return PF_NO_MATCH;
+}
+
+int32_t
+Ipv4MultiRulePacketFilter::DoClassify(Ptr<QueueDiscItem> item) const
+{
+    NS_LOG_FUNCTION(this << item);
+
+    Ptr<Ipv4QueueDiscItem> ipv4Item = StaticCast<Ipv4QueueDiscItem>(item);
+    const Ipv4Header& header = ipv4Item->GetHeader();
+
+    FiveTuple tuple;
+    tuple.source = header.GetSource().Get();
+    tuple.destination = header.GetDestination().Get();
+    tuple.protocol = header.GetProtocol();
+    ipv4Item->GetPorts(tuple.sourcePort, tuple.destinationPort);
+
+    if (m_flowCacheSize == 0)
+    {
+        return Match(tuple);
+    }
+
+    uint32_t hash = item->GetFlowHash();
+    auto it = m_flowCache.find(hash);
+    if (it != m_flowCache.end() && it->second.tuple == tuple)
+    {
+        NS_LOG_LOGIC("Class " << it->second.classId << " found in the flow cache");
+        return it->second.classId;
+    }
+
+    int32_t classId = Match(tuple);
+    if (it != m_flowCache.end())
+    {
+        // hash collision, the entry is taken over by the flow of this packet
+        it->second = {tuple, classId};
+    }
+    else
+    {
+        if (m_flowCache.size() >= m_flowCacheSize)
+        {
+            NS_LOG_LOGIC("Flushing the flow cache");
+            m_flowCache.clear();
+        }
+        m_flowCache.emplace(hash, CacheEntry{tuple, classId});
+    }
+    return classId;
+}
+
+} // namespace ns3
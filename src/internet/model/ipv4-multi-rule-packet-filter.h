@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_MULTI_RULE_PACKET_FILTER_H
+#define IPV4_MULTI_RULE_PACKET_FILTER_H
+
+#include "ipv4-packet-filter.h"
+
+#include "ns3/ipv4-address.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4
+ * \ingroup traffic-control
+ *
+ * Ipv4MultiRulePacketFilter classifies IPv4 packets against an ordered list
+ * of match rules on the 5-tuple of the packets, and returns the class of the
+ * first matching rule (or PF_NO_MATCH if no rule matches). Hence, it replaces
+ * a chain of packet filters, each parsing the headers of the packet again,
+ * with a single filter parsing the headers once and evaluating all the rules
+ * in one pass.
+ *
+ * Since the class of a packet only depends on its 5-tuple, the class of the
+ * recently seen flows is cached in a table indexed by the flow hash of the
+ * packets (see QueueDiscItem::GetFlowHash), which is computed once per packet
+ * and shared with the queue discs hashing the packet. Hence, the rules are
+ * only evaluated for the first packet of a flow.
+ */
+class Ipv4MultiRulePacketFilter : public Ipv4PacketFilter
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    Ipv4MultiRulePacketFilter();
+    ~Ipv4MultiRulePacketFilter() override;
+
+    /**
+     * \brief A match rule
+     *
+     * A packet matches a rule if all the fields of the rule match. The ports of
+     * the packets that are neither TCP nor UDP packets, or are fragments other
+     * than the first one, are considered to be 0.
+     */
+    struct Rule
+    {
+        Ipv4Address source{Ipv4Address::GetAny()};      //!< source address
+        Ipv4Mask sourceMask{Ipv4Mask::GetZero()};       //!< source address mask
+        Ipv4Address destination{Ipv4Address::GetAny()}; //!< destination address
+        Ipv4Mask destinationMask{Ipv4Mask::GetZero()};  //!< destination address mask
+        uint8_t protocol{0};                            //!< protocol, 0 for any protocol
+        uint16_t sourcePortMin{0};                      //!< minimum source port
+        uint16_t sourcePortMax{65535};                  //!< maximum source port
+        uint16_t destinationPortMin{0};                 //!< minimum destination port
+        uint16_t destinationPortMax{65535};             //!< maximum destination port
+        int32_t classId{0};                             //!< class of the matching packets
+    };
+
+    /**
+     * \brief Add a rule, evaluated after the rules already added
+     * \param rule the rule
+     * \return the index of the rule
+     */
+    uint32_t AddRule(const Rule& rule);
+
+    /**
+     * \brief Get the number of rules
+     * \return the number of rules
+     */
+    uint32_t GetNRules() const;
+
+  private:
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override;
+
+    /// The 5-tuple of a packet
+    struct FiveTuple
+    {
+        uint32_t source;          //!< source address
+        uint32_t destination;     //!< destination address
+        uint16_t sourcePort;      //!< source port
+        uint16_t destinationPort; //!< destination port
+        uint8_t protocol;         //!< protocol
+
+        /**
+         * \param other the 5-tuple to compare to
+         * \return true if the 5-tuples are equal
+         */
+        bool operator==(const FiveTuple& other) const;
+    };
+
+    /// A rule, in the format evaluated by the filter
+    struct CompiledRule
+    {
+        uint32_t source;              //!< masked source address
+        uint32_t sourceMask;          //!< source address mask
+        uint32_t destination;         //!< masked destination address
+        uint32_t destinationMask;     //!< destination address mask
+        uint16_t sourcePortMin;       //!< minimum source port
+        uint16_t sourcePortSpan;      //!< maximum minus minimum source port
+        uint16_t destinationPortMin;  //!< minimum destination port
+        uint16_t destinationPortSpan; //!< maximum minus minimum destination port
+        uint8_t protocol;             //!< protocol, 0 for any protocol
+        int32_t classId;              //!< class of the matching packets
+    };
+
+    /// An entry of the flow cache
+    struct CacheEntry
+    {
+        FiveTuple tuple; //!< the 5-tuple of the flow
+        int32_t classId; //!< the class of the flow
+    };
+
+    /**
+     * \brief Evaluate the rules
+     * \param tuple the 5-tuple of the packet
+     * \return the class of the first matching rule, or PF_NO_MATCH
+     */
+    int32_t Match(const FiveTuple& tuple) const;
+
+    std::vector<CompiledRule> m_rules; //!< the rules
+    uint32_t m_flowCacheSize;          //!< maximum number of entries of the flow cache
+    /// The class of the recently seen flows, by flow hash
+    mutable std::unordered_map<uint32_t, CacheEntry> m_flowCache;
+};
+
+} // namespace ns3
+
+#endif /* IPV4_MULTI_RULE_PACKET_FILTER_H */
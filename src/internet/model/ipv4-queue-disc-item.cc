@@ -17,10 +17,12 @@
 
 #include "ipv4-queue-disc-item.h"
 
+#include "gso-tag.h"
 #include "tcp-header.h"
 #include "udp-header.h"
 
 #include "ns3/log.h"
+#include "ns3/node.h"
 
 namespace ns3
 {
@@ -123,25 +125,10 @@ Ipv4QueueDiscItem::Hash(uint32_t perturbation) const
     Ipv4Address src = m_header.GetSource();
     Ipv4Address dest = m_header.GetDestination();
     uint8_t prot = m_header.GetProtocol();
-    uint16_t fragOffset = m_header.GetFragmentOffset();
+    uint16_t srcPort;
+    uint16_t destPort;
 
-    TcpHeader tcpHdr;
-    UdpHeader udpHdr;
-    uint16_t srcPort = 0;
-    uint16_t destPort = 0;
-
-    if (prot == 6 && fragOffset == 0) // TCP
-    {
-        GetPacket()->PeekHeader(tcpHdr);
-        srcPort = tcpHdr.GetSourcePort();
-        destPort = tcpHdr.GetDestinationPort();
-    }
-    else if (prot == 17 && fragOffset == 0) // UDP
-    {
-        GetPacket()->PeekHeader(udpHdr);
-        srcPort = udpHdr.GetSourcePort();
-        destPort = udpHdr.GetDestinationPort();
-    }
+    GetPorts(srcPort, destPort);
     if (prot != 6 && prot != 17)
     {
         NS_LOG_WARN("Unknown transport protocol, no port number included in hash computation");
@@ -170,4 +157,103 @@ Ipv4QueueDiscItem::Hash(uint32_t perturbation) const
     return hash;
 }
 
+bool
+Ipv4QueueDiscItem::GetPorts(uint16_t& srcPort, uint16_t& destPort) const
+{
+    NS_LOG_FUNCTION(this);
+
+    uint8_t prot = m_header.GetProtocol();
+    srcPort = 0;
+    destPort = 0;
+
+    if (m_header.GetFragmentOffset() != 0)
+    {
+        return false;
+    }
+    if (prot == 6) // TCP
+    {
+        TcpHeader tcpHdr;
+        GetPacket()->PeekHeader(tcpHdr);
+        srcPort = tcpHdr.GetSourcePort();
+        destPort = tcpHdr.GetDestinationPort();
+        return true;
+    }
+    if (prot == 17) // UDP
+    {
+        UdpHeader udpHdr;
+        GetPacket()->PeekHeader(udpHdr);
+        srcPort = udpHdr.GetSourcePort();
+        destPort = udpHdr.GetDestinationPort();
+        return true;
+    }
+    return false;
+}
+
+Ptr<QueueDiscItem>
+Ipv4QueueDiscItem::PopSegment()
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<Packet> p = GetPacket();
+    GsoTag gsoTag;
+    if (!p->PeekPacketTag(gsoTag))
+    {
+        return nullptr;
+    }
+    NS_ASSERT(m_header.GetProtocol() == 6); // TCP
+
+    if (m_headerAdded)
+    {
+        Ipv4Header ipHeader;
+        p->RemoveHeader(ipHeader);
+    }
+    TcpHeader tcpHeader;
+    p->RemoveHeader(tcpHeader);
+    if (Node::ChecksumEnabled())
+    {
+        tcpHeader.EnableChecksums();
+        tcpHeader.InitializeChecksum(m_header.GetSource(), m_header.GetDestination(), 6);
+    }
+
+    Ptr<Ipv4QueueDiscItem> item;
+    uint32_t segmentSize = gsoTag.GetSegmentSize();
+    if (p->GetSize() > segmentSize)
+    {
+        Ptr<Packet> segment = p->CreateFragment(0, segmentSize);
+        p->RemoveAtStart(segmentSize);
+        segment->RemovePacketTag(gsoTag);
+
+        TcpHeader segmentTcpHeader = tcpHeader;
+        segmentTcpHeader.SetFlags(tcpHeader.GetFlags() & ~(TcpHeader::FIN | TcpHeader::PSH));
+        segment->AddHeader(segmentTcpHeader);
+        Ipv4Header segmentIpHeader = m_header;
+        segmentIpHeader.SetPayloadSize(segment->GetSize());
+
+        item = Create<Ipv4QueueDiscItem>(segment, GetAddress(), GetProtocol(), segmentIpHeader);
+        item->SetTxQueueIndex(GetTxQueueIndex());
+        item->SetTimeStamp(GetTimeStamp());
+        if (m_headerAdded)
+        {
+            item->AddHeader();
+        }
+
+        tcpHeader.SetSequenceNumber(tcpHeader.GetSequenceNumber() + SequenceNumber32(segmentSize));
+        tcpHeader.SetFlags(tcpHeader.GetFlags() & ~TcpHeader::CWR);
+        m_header.SetIdentification(m_header.GetIdentification() + 1);
+    }
+    if (p->GetSize() <= segmentSize)
+    {
+        p->RemovePacketTag(gsoTag);
+    }
+
+    p->AddHeader(tcpHeader);
+    m_header.SetPayloadSize(p->GetSize());
+    if (m_headerAdded)
+    {
+        p->AddHeader(m_header);
+    }
+    NS_LOG_LOGIC("Detached segment " << item << ", " << p->GetSize() << " bytes left");
+    return item;
+}
+
 } // namespace ns3
@@ -105,6 +105,31 @@ class Ipv4QueueDiscItem : public QueueDiscItem
      */
     uint32_t Hash(uint32_t perturbation) const override;
 
+    /**
+     * \brief Get the transport ports of the packet
+     *
+     * The ports are read from the TCP or UDP header of the packet, unless the
+     * packet is a fragment other than the first one.
+     *
+     * \param srcPort the source port, or 0 if the packet carries no port
+     * \param destPort the destination port, or 0 if the packet carries no port
+     * \return true if the ports were read from the packet, false otherwise
+     */
+    bool GetPorts(uint16_t& srcPort, uint16_t& destPort) const;
+
+    /**
+     * \brief Detach the first TCP segment of a packet carrying a GsoTag
+     *
+     * The TCP header of the detached segment is a copy of that of the packet,
+     * with the FIN and PSH flags cleared. The remaining packet is given the
+     * sequence number of the following segment, the CWR flag cleared and the
+     * next IPv4 identification.
+     *
+     * \return the item holding the first segment, or a null pointer if the
+     *         packet carries no GsoTag or is made of a single segment
+     */
+    Ptr<QueueDiscItem> PopSegment() override;
+
   private:
     Ipv4Header m_header; //!< The IPv4 header.
     bool m_headerAdded;  //!< True if the header has already been added to the packet.
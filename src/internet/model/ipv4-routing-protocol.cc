@@ -35,4 +35,27 @@ Ipv4RoutingProtocol::GetTypeId()
     return tid;
 }
 
+void
+Ipv4RoutingProtocol::SetRouteChangeCallback(RouteChangeCallback cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_routeChangeCallback = cb;
+}
+
+bool
+Ipv4RoutingProtocol::IsRouteCacheable() const
+{
+    return false;
+}
+
+void
+Ipv4RoutingProtocol::NotifyRouteChange()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_routeChangeCallback.IsNull())
+    {
+        m_routeChangeCallback();
+    }
+}
+
 } // namespace ns3
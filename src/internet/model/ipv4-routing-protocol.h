@@ -77,6 +77,9 @@ class Ipv4RoutingProtocol : public Object
     /// Callback for routing errors (e.g., no route found)
     typedef Callback<void, Ptr<const Packet>, const Ipv4Header&, Socket::SocketErrno> ErrorCallback;
 
+    /// Callback for changes of the routes (e.g., to invalidate cached routes)
+    typedef Callback<void> RouteChangeCallback;
+
     /**
      * \brief Query routing cache for an existing route, for an outbound packet
      *
@@ -181,6 +184,34 @@ class Ipv4RoutingProtocol : public Object
      */
     virtual void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                                    Time::Unit unit = Time::S) const = 0;
+
+    /**
+     * \brief Set the callback to invoke whenever the routes of this protocol change
+     *
+     * \param cb the callback
+     */
+    virtual void SetRouteChangeCallback(RouteChangeCallback cb);
+
+    /**
+     * \brief Whether the routes returned by RouteInput() can be cached
+     *
+     * A protocol whose routes only depend on the destination address and on
+     * the input interface, and which calls NotifyRouteChange() whenever its
+     * routes change, can return true, and let Ipv4L3Protocol cache the routes
+     * of the forwarded packets.  The default implementation returns false.
+     *
+     * \return true if the routes of this protocol can be cached
+     */
+    virtual bool IsRouteCacheable() const;
+
+  protected:
+    /**
+     * \brief Notify that the routes of this protocol have changed
+     */
+    void NotifyRouteChange();
+
+  private:
+    RouteChangeCallback m_routeChangeCallback; //!< Callback for changes of the routes
 };
 
 } // namespace ns3
@@ -80,6 +80,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         Ipv4RoutingTableEntry* routePtr = new Ipv4RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        NotifyRouteChange();
     }
 }
 
@@ -98,6 +99,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry* routePtr = new Ipv4RoutingTableEntry(route);
 
         m_networkRoutes.emplace_back(routePtr, metric);
+        NotifyRouteChange();
     }
 }
 
@@ -459,6 +461,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
         {
             delete j->first;
             m_networkRoutes.erase(j);
+            NotifyRouteChange();
             return;
         }
         tmp++;
@@ -602,6 +605,12 @@ Ipv4StaticRouting::DoDispose()
     Ipv4RoutingProtocol::DoDispose();
 }
 
+bool
+Ipv4StaticRouting::IsRouteCacheable() const
+{
+    return true;
+}
+
 void
 Ipv4StaticRouting::NotifyInterfaceUp(uint32_t i)
 {
@@ -640,6 +649,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
             it++;
         }
     }
+    NotifyRouteChange();
 }
 
 void
@@ -685,6 +695,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it++;
         }
     }
+    NotifyRouteChange();
 }
 
 void
@@ -28,6 +28,8 @@
 #include "ns3/node.h"
 #include "ns3/uinteger.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -101,9 +103,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    CacheI it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -118,15 +121,16 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto range = m_macIndex.equal_range(dst);
+    for (auto i = range.first; i != range.second; i++)
     {
-        NdiscCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == dst)
-        {
-            NS_LOG_LOGIC("Found an entry:" << (*entry));
-            entryList.push_back(entry);
-        }
+        NS_LOG_LOGIC("Found an entry:" << (*i->second));
+        entryList.push_back(i->second);
     }
+    // return the entries sorted by IPv6 address, regardless of the hashing
+    entryList.sort([](NdiscCache::Entry* a, NdiscCache::Entry* b) {
+        return a->GetIpv6Address() < b->GetIpv6Address();
+    });
     return entryList;
 }
 
@@ -147,16 +151,36 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    CacheI i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
+        m_ndCache.erase(i);
+        UpdateMacIndex(entry, entry->GetMacAddress(), Address());
+        entry->ClearWaitingPacket();
+        delete entry;
+    }
+}
+
+void
+NdiscCache::UpdateMacIndex(NdiscCache::Entry* entry, const Address& oldMac, const Address& newMac)
+{
+    NS_LOG_FUNCTION(this << entry << oldMac << newMac);
+    if (!oldMac.IsInvalid())
+    {
+        auto range = m_macIndex.equal_range(oldMac);
+        for (auto i = range.first; i != range.second; i++)
         {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
+            if (i->second == entry)
+            {
+                m_macIndex.erase(i);
+                break;
+            }
         }
     }
+    if (!newMac.IsInvalid())
+    {
+        m_macIndex.emplace(newMac, entry);
+    }
 }
 
 void
@@ -170,6 +194,7 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_macIndex.clear();
 }
 
 void
@@ -192,7 +217,9 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries sorted by IPv6 address
+    std::map<Ipv6Address, NdiscCache::Entry*> sorted(m_ndCache.begin(), m_ndCache.end());
+    for (auto i = sorted.begin(); i != sorted.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -563,6 +590,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
+    m_ndCache->UpdateMacIndex(this, m_macAddress, mac);
     m_macAddress = mac;
     return m_waiting;
 }
@@ -593,6 +621,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
+    m_ndCache->UpdateMacIndex(this, m_macAddress, mac);
     m_macAddress = mac;
     return m_waiting;
 }
@@ -680,6 +709,7 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    m_ndCache->UpdateMacIndex(this, m_macAddress, mac);
     m_macAddress = mac;
 }
 
@@ -722,8 +752,9 @@ NdiscCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearWaitingPacket();
+            UpdateMacIndex(i->second, i->second->GetMacAddress(), Address());
             delete i->second;
-            m_ndCache.erase(i++);
+            i = m_ndCache.erase(i);
             continue;
         }
         i++;
@@ -29,8 +29,8 @@
 #include "ns3/timer.h"
 
 #include <list>
-#include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -44,6 +44,10 @@ class Icmpv6L4Protocol;
  * \ingroup ipv6
  *
  * \brief IPv6 Neighbor Discovery cache.
+ *
+ * Entries are hashed by IPv6 address, and also indexed by MAC address, so
+ * that lookups, inverse lookups and removals take constant time even on
+ * large broadcast domains.
  */
 class NdiscCache : public Object
 {
@@ -457,11 +461,11 @@ class NdiscCache : public Object
     /**
      * \brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * \brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash>::iterator CacheI;
 
     /**
      * \brief A list of Entry.
@@ -469,6 +473,24 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * \brief Container of the entries indexed by MAC address
+     */
+    typedef std::unordered_multimap<Address, NdiscCache::Entry*, AddressHash> MacIndex;
+
+    /**
+     * \brief Update the MAC address index when the MAC address of an entry changes
+     * \param entry the entry
+     * \param oldMac the previous MAC address of the entry
+     * \param newMac the new MAC address of the entry
+     */
+    void UpdateMacIndex(NdiscCache::Entry* entry, const Address& oldMac, const Address& newMac);
+
+    /**
+     * \brief The entries with a valid MAC address, indexed by MAC address.
+     */
+    MacIndex m_macIndex;
+
     /**
      * \brief The NetDevice.
      */
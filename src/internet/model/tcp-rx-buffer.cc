@@ -171,29 +171,28 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    BufIterator i = m_data.begin();
-    while (i != m_data.end() && i->first <= tailSeq)
+    // Remove overlapped bytes from packet. Blocks are disjoint, hence only the
+    // block preceding headSeq can overlap the head of the incoming packet
+    BufIterator i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
     {
-        SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
-        if (lastByteSeq > headSeq)
-        {
-            if (i->first > headSeq && lastByteSeq < tailSeq)
-            { // Rare case: Existing packet is embedded fully in the new packet
-                m_size -= i->second->GetSize();
-                m_data.erase(i++);
-                continue;
-            }
-            if (i->first <= headSeq)
-            { // Incoming head is overlapped
-                headSeq = lastByteSeq;
-            }
-            if (lastByteSeq >= tailSeq)
-            { // Incoming tail is overlapped
-                tailSeq = i->first;
-            }
+        SequenceNumber32 prevTail = std::prev(i)->second.tail;
+        if (prevTail > headSeq)
+        { // Incoming head is overlapped
+            headSeq = prevTail;
         }
-        ++i;
+    }
+    while (i != m_data.end() && i->first < tailSeq)
+    {
+        if (i->second.tail < tailSeq)
+        { // Rare case: Existing block is embedded fully in the new packet
+            m_size -= static_cast<uint32_t>(i->second.tail - i->first);
+            i = m_data.erase(i);
+            continue;
+        }
+        // Incoming tail is overlapped
+        tailSeq = i->first;
+        break;
     }
     // We now know how much we are going to store, trim the packet
     if (headSeq >= tailSeq)
@@ -208,31 +207,39 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
         p = p->CreateFragment(start, length);
         NS_ASSERT(length == p->GetSize());
     }
-    // Insert packet into buffer
-    NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
-    m_data[headSeq] = p;
-
-    if (headSeq > m_nextRxSeq)
+    // Insert packet into buffer, merging it with the adjacent blocks
+    BufIterator next = i;
+    BufIterator block;
+    if (next != m_data.begin() && std::prev(next)->second.tail == headSeq)
+    { // Extend the block ending where the packet starts
+        block = std::prev(next);
+        block->second.chain.push_back(p);
+        block->second.tail = tailSeq;
+    }
+    else
     {
-        // Generate a new SACK block
-        UpdateSackList(headSeq, tailSeq);
+        NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
+        block = m_data.emplace_hint(next, headSeq, Block{tailSeq, {p}});
+    }
+    if (next != m_data.end() && next->first == tailSeq)
+    { // Absorb the block starting where the packet ends
+        block->second.chain.splice(block->second.chain.end(), next->second.chain);
+        block->second.tail = next->second.tail;
+        m_data.erase(next);
     }
 
     NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
     // Update variables
     m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    if (block->first > m_nextRxSeq)
     {
-        if (i->first < m_nextRxSeq)
-        {
-            continue;
-        }
-        else if (i->first > m_nextRxSeq)
-        {
-            break;
-        };
-        m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
-        m_availBytes += i->second->GetSize();
+        // Generate a new SACK block
+        UpdateSackList(block->first, block->second.tail);
+    }
+    else if (block->second.tail > m_nextRxSeq)
+    { // The in-sequence block grew
+        m_availBytes += static_cast<uint32_t>(block->second.tail - m_nextRxSeq.Get());
+        m_nextRxSeq = block->second.tail;
         ClearSackList(m_nextRxSeq);
     }
     NS_LOG_LOGIC("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -287,65 +294,30 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
     //     following SACK blocks in the SACK option may be listed in
     //     arbitrary order.
 
-    m_sackList.push_front(current);
-
-    // We have inserted the block at the beginning of the list. Now, we should
-    // check if any existing blocks overlap with that.
-    bool updated = false;
-    TcpOptionSack::SackList::iterator it = m_sackList.begin();
-    TcpOptionSack::SackBlock begin = *it;
-    TcpOptionSack::SackBlock merged;
-    ++it;
-
-    // Iterates until we examined all blocks in the list (maximum 4)
-    while (it != m_sackList.end())
+    // The block "current" is the whole contiguous block of buffered data
+    // containing the segment just received: the blocks previously reported
+    // that have been merged into it are now subsets, and must be removed.
+    for (auto it = m_sackList.begin(); it != m_sackList.end();)
     {
-        current = *it;
-
-        // This is a left merge:
-        // [current_first; current_second] [beg_first; beg_second]
-        if (begin.first == current.second)
-        {
-            NS_ASSERT(current.first < begin.second);
-            merged = TcpOptionSack::SackBlock(current.first, begin.second);
-            updated = true;
-        }
-        // while this is a right merge
-        // [begin_first; begin_second] [current_first; current_second]
-        else if (begin.second == current.first)
+        if (current.first <= it->first && it->second <= current.second)
         {
-            NS_ASSERT(begin.first < current.second);
-            merged = TcpOptionSack::SackBlock(begin.first, current.second);
-            updated = true;
+            it = m_sackList.erase(it);
         }
-
-        // If we have merged the blocks (and the result is in merged) we should
-        // delete the current block (it), the first block, and insert the merged
-        // one at the beginning.
-        if (updated)
+        else
         {
-            m_sackList.erase(it);
-            m_sackList.pop_front();
-            m_sackList.push_front(merged);
-            it = m_sackList.begin();
-            begin = *it;
-            updated = false;
+            NS_ASSERT(it->second < current.first || current.second < it->first);
+            ++it;
         }
-
-        ++it;
     }
 
+    m_sackList.push_front(current);
+
     // Since the maximum blocks that fits into a TCP header are 4, there's no
     // point on maintaining the others.
     if (m_sackList.size() > 4)
     {
         m_sackList.pop_back();
     }
-
-    // Please note that, if a block b is discarded and then a block contiguous
-    // to b is received, only that new block (without the b part) is reported.
-    // This is perfectly fine for the RFC point (a), given that we do not report any
-    // overlapping blocks shortly after.
 }
 
 void
@@ -390,39 +362,49 @@ TcpRxBuffer::Extract(uint32_t maxSize)
     }
     NS_ASSERT(!m_data.empty());            // At least we have something to extract
     Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
-    BufIterator i;
-    while (extractSize)
-    { // Check the buffered data for delivery
-        i = m_data.begin();
-        NS_ASSERT(i->first <= m_nextRxSeq); // in-sequence data expected
-        // Check if we send the whole pkt or just a partial
-        uint32_t pktSize = i->second->GetSize();
-        if (pktSize <= extractSize)
-        { // Whole packet is extracted
-            outPkt->AddAtEnd(i->second);
-            m_data.erase(i);
-            m_size -= pktSize;
-            m_availBytes -= pktSize;
-            extractSize -= pktSize;
+    // All the available bytes belong to the in-sequence block at the head
+    BufIterator i = m_data.begin();
+    NS_ASSERT(i->first <= m_nextRxSeq); // in-sequence data expected
+    std::list<Ptr<Packet>>& chain = i->second.chain;
+    uint32_t extracted = 0;
+    while (extracted < extractSize)
+    { // Check the buffered fragments for delivery
+        Ptr<Packet> frag = chain.front();
+        // Check if we send the whole fragment or just a partial
+        uint32_t fragSize = frag->GetSize();
+        if (fragSize <= extractSize - extracted)
+        { // Whole fragment is extracted
+            outPkt->AddAtEnd(frag);
+            chain.pop_front();
+            extracted += fragSize;
         }
         else
         { // Partial is extracted and done
-            outPkt->AddAtEnd(i->second->CreateFragment(0, extractSize));
-            m_data[i->first + SequenceNumber32(extractSize)] =
-                i->second->CreateFragment(extractSize, pktSize - extractSize);
-            m_data.erase(i);
-            m_size -= extractSize;
-            m_availBytes -= extractSize;
-            extractSize = 0;
+            uint32_t partSize = extractSize - extracted;
+            outPkt->AddAtEnd(frag->CreateFragment(0, partSize));
+            chain.front() = frag->CreateFragment(partSize, fragSize - partSize);
+            extracted += partSize;
         }
     }
+    m_size -= extracted;
+    m_availBytes -= extracted;
+    if (chain.empty())
+    {
+        m_data.erase(i);
+    }
+    else
+    { // Re-index the remainder of the block
+        auto node = m_data.extract(i);
+        node.key() = node.key() + SequenceNumber32(extracted);
+        m_data.insert(std::move(node));
+    }
     if (outPkt->GetSize() == 0)
     {
         NS_LOG_LOGIC("Nothing extracted.");
         return nullptr;
     }
     NS_LOG_LOGIC("Extracted " << outPkt->GetSize() << " bytes, bufsize=" << m_size
-                              << ", num pkts in buffer=" << m_data.size());
+                              << ", num blocks in buffer=" << m_data.size());
     return outPkt;
 }
 
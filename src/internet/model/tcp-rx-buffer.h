@@ -27,6 +27,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-value.h"
 
+#include <list>
 #include <map>
 
 namespace ns3
@@ -54,6 +55,12 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * Buffered data is kept as a set of disjoint intervals of sequence numbers,
+ * indexed by their first sequence number. Adjacent segments are merged into
+ * the same interval as soon as they arrive, keeping the original fragments
+ * chained in order, so that the cost of an Add depends on the number of
+ * holes in the sequence space rather than on the number of buffered segments.
+ *
  * SACK list
  * ---------
  *
@@ -201,6 +208,10 @@ class TcpRxBuffer : public Object
      * (or other) options, it is even less. For more detail about this function,
      * please see the source code and in-line comments.
      *
+     * The block passed is the whole contiguous block of buffered data
+     * containing the segment just received, so any block already in the list
+     * is either disjoint from it or included in it.
+     *
      * \param head sequence number of the block at the beginning
      * \param tail sequence number of the block at the end
      */
@@ -221,8 +232,20 @@ class TcpRxBuffer : public Object
 
     TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
+    /**
+     * \brief A contiguous interval of buffered data
+     *
+     * The interval starts at the sequence number used as key in m_data; its
+     * payload is the in-order chain of the fragments received for it.
+     */
+    struct Block
+    {
+        SequenceNumber32 tail;        //!< Sequence number following the last byte of the block
+        std::list<Ptr<Packet>> chain; //!< Fragments composing the block, in sequence order
+    };
+
     /// container for data stored in the buffer
-    typedef std::map<SequenceNumber32, Ptr<Packet>>::iterator BufIterator;
+    typedef std::map<SequenceNumber32, Block>::iterator BufIterator;
     TracedValue<SequenceNumber32>
         m_nextRxSeq;           //!< Seqnum of the first missing byte in data (RCV.NXT)
     SequenceNumber32 m_finSeq; //!< Seqnum of the FIN packet
@@ -230,7 +253,7 @@ class TcpRxBuffer : public Object
     uint32_t m_size;       //!< Number of total data bytes in the buffer, not necessarily contiguous
     uint32_t m_maxBuffer;  //!< Upper bound of the number of data bytes in buffer (RCV.WND)
     uint32_t m_availBytes; //!< Number of bytes available to read, i.e. contiguous block at head
-    std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Corresponding data (may be null)
+    std::map<SequenceNumber32, Block> m_data; //!< Disjoint, non-adjacent blocks of data
 };
 
 } // namespace ns3
@@ -26,6 +26,7 @@
 
 #include "tcp-socket-base.h"
 
+#include "gso-tag.h"
 #include "ipv4-end-point.h"
 #include "ipv4-route.h"
 #include "ipv4-routing-protocol.h"
@@ -156,11 +157,27 @@ TcpSocketBase::GetTypeId()
                 UintegerValue(3),
                 MakeUintegerAccessor(&TcpSocketBase::SetRetxThresh, &TcpSocketBase::GetRetxThresh),
                 MakeUintegerChecker<uint32_t>())
+            .AddAttribute("UseTimerWheel",
+                          "Manage the retransmission and delayed ACK timers with the "
+                          "TimerWheel aggregated to the node, which does not need to "
+                          "schedule a simulator event each time they are restarted. "
+                          "The timers then expire at the end of a tick of the wheel.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpSocketBase::m_useTimerWheel),
+                          MakeBooleanChecker())
             .AddAttribute("LimitedTransmit",
                           "Enable limited transmit",
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("GsoMaxSegments",
+                          "Maximum number of full segments of new data sent at once as a "
+                          "single packet, which is split into regular segments right before "
+                          "being handed to the NetDevice (segmentation offload). IPv4 only; "
+                          "a value of 1 disables segmentation offload.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_gsoMaxSegments),
+                          MakeUintegerChecker<uint16_t>(1))
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -277,6 +294,8 @@ TcpSocketBase::TcpSocketBase()
 
     m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
     m_pacingTimer.SetFunction(&TcpSocketBase::NotifyPacingPerformed, this);
+    m_retxTimer.SetFunction(&TcpSocketBase::ReTxTimeout, this);
+    m_delAckTimer.SetFunction(&TcpSocketBase::DelAckTimeout, this);
 
     m_tcb->m_sendEmptyPacketCallback = MakeCallback(&TcpSocketBase::SendEmptyPacket, this);
 
@@ -327,6 +346,7 @@ TcpSocketBase::TcpSocketBase()
 TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
     : TcpSocket(sock),
       // copy object::m_tid and socket::callbacks
+      m_useTimerWheel(sock.m_useTimerWheel),
       m_dupAckCount(sock.m_dupAckCount),
       m_delAckCount(0),
       m_delAckMaxCount(sock.m_delAckMaxCount),
@@ -368,6 +388,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_gsoMaxSegments(sock.m_gsoMaxSegments),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -399,6 +420,8 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
 
     m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
     m_pacingTimer.SetFunction(&TcpSocketBase::NotifyPacingPerformed, this);
+    m_retxTimer.SetFunction(&TcpSocketBase::ReTxTimeout, this);
+    m_delAckTimer.SetFunction(&TcpSocketBase::DelAckTimeout, this);
 
     if (sock.m_congestionControl)
     {
@@ -1414,8 +1437,8 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         NS_LOG_LOGIC(this << " Enter zerowindow persist state");
         NS_LOG_LOGIC(
             this << " Cancelled ReTxTimeout event which was set to expire at "
-                 << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
-        m_retxEvent.Cancel();
+                 << (Simulator::Now() + GetRetxTimerDelayLeft()).GetSeconds());
+        CancelRetxTimer();
         NS_LOG_LOGIC("Schedule persist timeout at time "
                      << Simulator::Now().GetSeconds() << " to expire at time "
                      << (Simulator::Now() + m_persistTimeout).GetSeconds());
@@ -2277,7 +2300,7 @@ TcpSocketBase::ProcessSynSent(Ptr<Packet> packet, const TcpHeader& tcpHeader)
         m_tcb->m_congState = TcpSocketState::CA_OPEN;
         m_state = ESTABLISHED;
         m_connected = true;
-        m_retxEvent.Cancel();
+        CancelRetxTimer();
         m_delAckCount = m_delAckMaxCount;
         ReceivedData(packet, tcpHeader);
         Simulator::ScheduleNow(&TcpSocketBase::ConnectionSucceeded, this);
@@ -2317,7 +2340,7 @@ TcpSocketBase::ProcessSynSent(Ptr<Packet> packet, const TcpHeader& tcpHeader)
         m_tcb->m_congState = TcpSocketState::CA_OPEN;
         m_state = ESTABLISHED;
         m_connected = true;
-        m_retxEvent.Cancel();
+        CancelRetxTimer();
         m_tcb->m_rxBuffer->SetNextRxSequence(tcpHeader.GetSequenceNumber() + SequenceNumber32(1));
         m_tcb->m_highTxMark = ++m_tcb->m_nextTxSequence;
         m_txBuffer->SetHeadSequence(m_tcb->m_nextTxSequence);
@@ -2382,7 +2405,7 @@ TcpSocketBase::ProcessSynRcvd(Ptr<Packet> packet,
         m_tcb->m_congState = TcpSocketState::CA_OPEN;
         m_state = ESTABLISHED;
         m_connected = true;
-        m_retxEvent.Cancel();
+        CancelRetxTimer();
         m_tcb->m_highTxMark = ++m_tcb->m_nextTxSequence;
         m_txBuffer->SetHeadSequence(m_tcb->m_nextTxSequence);
         if (m_endPoint)
@@ -2434,7 +2457,7 @@ TcpSocketBase::ProcessSynRcvd(Ptr<Packet> packet,
         if (tcpHeader.GetSequenceNumber() == m_tcb->m_rxBuffer->NextRxSequence())
         { // In-sequence FIN before connection complete. Set up connection and close.
             m_connected = true;
-            m_retxEvent.Cancel();
+            CancelRetxTimer();
             m_tcb->m_highTxMark = ++m_tcb->m_nextTxSequence;
             m_txBuffer->SetHeadSequence(m_tcb->m_nextTxSequence);
             if (m_endPoint)
@@ -2707,7 +2730,7 @@ TcpSocketBase::Destroy()
         m_tcp->RemoveSocket(this);
     }
     NS_LOG_LOGIC(this << " Cancelled ReTxTimeout event which was set to expire at "
-                      << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                      << (Simulator::Now() + GetRetxTimerDelayLeft()).GetSeconds());
     CancelAllTimers();
 }
 
@@ -2723,7 +2746,7 @@ TcpSocketBase::Destroy6()
         m_tcp->RemoveSocket(this);
     }
     NS_LOG_LOGIC(this << " Cancelled ReTxTimeout event which was set to expire at "
-                      << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                      << (Simulator::Now() + GetRetxTimerDelayLeft()).GetSeconds());
     CancelAllTimers();
 }
 
@@ -2820,7 +2843,7 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
 
     if (flags & TcpHeader::ACK)
     { // If sending an ACK, cancel the delay ACK as well
-        m_delAckEvent.Cancel();
+        CancelDelAckTimer();
         m_delAckCount = 0;
         if (m_highTxAck < header.GetAckNumber())
         {
@@ -2852,7 +2875,7 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
                           m_boundnetdevice);
     }
 
-    if (m_retxEvent.IsExpired() && (hasSyn || hasFin) && !isAck)
+    if (!IsRetxTimerRunning() && (hasSyn || hasFin) && !isAck)
     { // Retransmit SYN / SYN+ACK / FIN / FIN+ACK to guard against lost
         NS_LOG_LOGIC("Schedule retransmission timeout at time "
                      << Simulator::Now().GetSeconds() << " to expire at time "
@@ -3120,13 +3143,30 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     NS_LOG_FUNCTION(this << seq << maxSize << withAck);
 
     bool isStartOfTransmission = BytesInFlight() == 0U;
-    TcpTxItem* outItem = m_txBuffer->CopyFromSequence(maxSize, seq);
+    bool gso = m_gsoMaxSegments > 1 && maxSize > m_tcb->m_segmentSize;
+    TcpTxItem* outItem = m_txBuffer->CopyFromSequence(gso ? m_tcb->m_segmentSize : maxSize, seq);
 
     m_rateOps->SkbSent(outItem, isStartOfTransmission);
 
     bool isRetransmission = outItem->IsRetrans();
     Ptr<Packet> p = outItem->GetPacketCopy();
     uint32_t sz = p->GetSize(); // Size of packet
+
+    // Segmentation offload: append the following segments, which are kept as
+    // separate items in the TxBuffer for the sake of retransmissions and SACK
+    uint32_t nSegments = 1;
+    while (gso && sz == nSegments * m_tcb->m_segmentSize &&
+           sz + m_tcb->m_segmentSize <= maxSize &&
+           m_txBuffer->SizeFromSequence(seq + SequenceNumber32(sz)) >= m_tcb->m_segmentSize)
+    {
+        TcpTxItem* item =
+            m_txBuffer->CopyFromSequence(m_tcb->m_segmentSize, seq + SequenceNumber32(sz));
+        NS_ASSERT(!item->IsRetrans());
+        m_rateOps->SkbSent(item, false);
+        p->AddAtEnd(item->GetPacketCopy());
+        sz = p->GetSize();
+        ++nSegments;
+    }
     uint8_t flags = withAck ? TcpHeader::ACK : 0;
     uint32_t remainingData = m_txBuffer->SizeFromSequence(seq + SequenceNumber32(sz));
 
@@ -3157,7 +3197,7 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
 
     if (withAck)
     {
-        m_delAckEvent.Cancel();
+        CancelDelAckTimer();
         m_delAckCount = 0;
     }
 
@@ -3204,14 +3244,19 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     header.SetWindowSize(AdvertisedWindowSize());
     AddOptions(header);
 
-    if (m_retxEvent.IsExpired())
+    if (nSegments > 1)
+    {
+        p->AddPacketTag(GsoTag(m_tcb->m_segmentSize, header.GetSerializedSize()));
+    }
+
+    if (!IsRetxTimerRunning())
     {
         // Schedules retransmit timeout. m_rto should be already doubled.
 
         NS_LOG_LOGIC(this << " SendDataPacket Schedule ReTxTimeout at time "
                           << Simulator::Now().GetSeconds() << " to expire at time "
                           << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+        StartRetxTimer();
     }
 
     m_txTrace(p, header, this);
@@ -3373,6 +3418,25 @@ TcpSocketBase::SendPendingData(bool withAck)
             uint32_t maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            // With segmentation offload, send several full segments of new data
+            // at once. Retransmissions are still sent one segment at a time
+            if (m_gsoMaxSegments > 1 && m_endPoint != nullptr && !IsPacingEnabled() &&
+                s == m_tcb->m_segmentSize && next == m_tcb->m_highTxMark)
+            {
+                SequenceNumber32 rWndEdge = m_highRxAckMark.Get() + SequenceNumber32(m_rWnd);
+                uint32_t rWndLeft = rWndEdge > next ? static_cast<uint32_t>(rWndEdge - next) : 0;
+                uint32_t maxSegments =
+                    std::min<uint32_t>(m_gsoMaxSegments, GSO_MAX_SIZE / m_tcb->m_segmentSize);
+                uint32_t gsoSize = std::min({availableWindow,
+                                             availableData,
+                                             rWndLeft,
+                                             maxSegments * m_tcb->m_segmentSize});
+                if (gsoSize >= 2 * m_tcb->m_segmentSize)
+                {
+                    s = gsoSize - gsoSize % m_tcb->m_segmentSize;
+                }
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -3584,7 +3648,7 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     { // In-sequence packet: ACK if delayed ack count allows
         if (++m_delAckCount >= m_delAckMaxCount)
         {
-            m_delAckEvent.Cancel();
+            CancelDelAckTimer();
             m_delAckCount = 0;
             m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_NON_DELAYED_ACK);
             if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
@@ -3601,18 +3665,17 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
                 SendEmptyPacket(TcpHeader::ACK);
             }
         }
-        else if (!m_delAckEvent.IsExpired())
+        else if (IsDelAckTimerRunning())
         {
             m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
         }
-        else if (m_delAckEvent.IsExpired())
+        else
         {
             m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
-            m_delAckEvent =
-                Simulator::Schedule(m_delAckTimeout, &TcpSocketBase::DelAckTimeout, this);
+            StartDelAckTimer();
             NS_LOG_LOGIC(
                 this << " scheduled delayed ACK at "
-                     << (Simulator::Now() + Simulator::GetDelayLeft(m_delAckEvent)).GetSeconds());
+                     << (Simulator::Now() + m_delAckTimeout).GetSeconds());
         }
     }
 }
@@ -3688,8 +3751,8 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
     { // Set RTO unless the ACK is received in SYN_RCVD state
         NS_LOG_LOGIC(
             this << " Cancelled ReTxTimeout event which was set to expire at "
-                 << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
-        m_retxEvent.Cancel();
+                 << (Simulator::Now() + GetRetxTimerDelayLeft()).GetSeconds());
+        CancelRetxTimer();
         // On receiving a "New" ack we restart retransmission timer .. RFC 6298
         // RFC 6298, clause 2.4
         m_rto = Max(m_rtt->GetEstimate() + Max(m_clockGranularity, m_rtt->GetVariation() * 4),
@@ -3698,7 +3761,7 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
         NS_LOG_LOGIC(this << " Schedule ReTxTimeout at time " << Simulator::Now().GetSeconds()
                           << " to expire at time "
                           << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+        StartRetxTimer();
     }
 
     // Note the highest ACK and tell app to send more
@@ -3717,8 +3780,8 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
     { // No retransmit timer if no data to retransmit
         NS_LOG_LOGIC(
             this << " Cancelled ReTxTimeout event which was set to expire at "
-                 << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
-        m_retxEvent.Cancel();
+                 << (Simulator::Now() + GetRetxTimerDelayLeft()).GetSeconds());
+        CancelRetxTimer();
     }
 }
 
@@ -3993,15 +4056,99 @@ TcpSocketBase::DoRetransmit()
 void
 TcpSocketBase::CancelAllTimers()
 {
-    m_retxEvent.Cancel();
+    CancelRetxTimer();
     m_persistEvent.Cancel();
-    m_delAckEvent.Cancel();
+    CancelDelAckTimer();
     m_lastAckEvent.Cancel();
     m_timewaitEvent.Cancel();
     m_sendPendingDataEvent.Cancel();
     m_pacingTimer.Cancel();
 }
 
+void
+TcpSocketBase::StartRetxTimer()
+{
+    if (m_useTimerWheel)
+    {
+        if (!m_retxTimer.GetWheel())
+        {
+            m_retxTimer.SetWheel(GetNodeTimerWheel());
+        }
+        m_retxTimer.Schedule(m_rto);
+    }
+    else
+    {
+        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+    }
+}
+
+void
+TcpSocketBase::CancelRetxTimer()
+{
+    // SYN and FIN retransmissions always use m_retxEvent
+    m_retxEvent.Cancel();
+    m_retxTimer.Cancel();
+}
+
+bool
+TcpSocketBase::IsRetxTimerRunning() const
+{
+    return m_retxEvent.IsRunning() || m_retxTimer.IsRunning();
+}
+
+Time
+TcpSocketBase::GetRetxTimerDelayLeft() const
+{
+    if (m_retxTimer.IsRunning())
+    {
+        return m_retxTimer.GetDelayLeft();
+    }
+    return Simulator::GetDelayLeft(m_retxEvent);
+}
+
+void
+TcpSocketBase::StartDelAckTimer()
+{
+    if (m_useTimerWheel)
+    {
+        if (!m_delAckTimer.GetWheel())
+        {
+            m_delAckTimer.SetWheel(GetNodeTimerWheel());
+        }
+        m_delAckTimer.Schedule(m_delAckTimeout);
+    }
+    else
+    {
+        m_delAckEvent = Simulator::Schedule(m_delAckTimeout, &TcpSocketBase::DelAckTimeout, this);
+    }
+}
+
+void
+TcpSocketBase::CancelDelAckTimer()
+{
+    m_delAckEvent.Cancel();
+    m_delAckTimer.Cancel();
+}
+
+bool
+TcpSocketBase::IsDelAckTimerRunning() const
+{
+    return m_delAckEvent.IsRunning() || m_delAckTimer.IsRunning();
+}
+
+Ptr<TimerWheel>
+TcpSocketBase::GetNodeTimerWheel() const
+{
+    NS_ASSERT_MSG(m_node, "No node associated with the socket");
+    Ptr<TimerWheel> wheel = m_node->GetObject<TimerWheel>();
+    if (!wheel)
+    {
+        wheel = CreateObject<TimerWheel>();
+        m_node->AggregateObject(wheel);
+    }
+    return wheel;
+}
+
 /* Move TCP to Time_Wait state and schedule a transition to Closed state */
 void
 TcpSocketBase::TimeWait()
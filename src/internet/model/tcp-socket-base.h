@@ -27,6 +27,7 @@
 #include "ns3/sequence-number.h"
 #include "ns3/tcp-socket-state.h"
 #include "ns3/tcp-socket.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/timer.h"
 #include "ns3/traced-value.h"
 
@@ -883,6 +884,56 @@ class TcpSocketBase : public TcpSocket
      */
     void CancelAllTimers();
 
+    /**
+     * \brief Start the retransmission timer, to expire after the current RTO
+     *
+     * The timer is managed by the TimerWheel of the node if the UseTimerWheel
+     * attribute is set, and by m_retxEvent otherwise.
+     */
+    void StartRetxTimer();
+
+    /**
+     * \brief Cancel the retransmission timer
+     */
+    void CancelRetxTimer();
+
+    /**
+     * \brief Check if the retransmission timer is running
+     * \return true if the retransmission timer is running
+     */
+    bool IsRetxTimerRunning() const;
+
+    /**
+     * \brief Get the time left until the retransmission timer expires
+     * \return the time left, or zero if the timer is not running
+     */
+    Time GetRetxTimerDelayLeft() const;
+
+    /**
+     * \brief Start the delayed ACK timer
+     *
+     * The timer is managed by the TimerWheel of the node if the UseTimerWheel
+     * attribute is set, and by m_delAckEvent otherwise.
+     */
+    void StartDelAckTimer();
+
+    /**
+     * \brief Cancel the delayed ACK timer
+     */
+    void CancelDelAckTimer();
+
+    /**
+     * \brief Check if the delayed ACK timer is running
+     * \return true if the delayed ACK timer is running
+     */
+    bool IsDelAckTimerRunning() const;
+
+    /**
+     * \brief Get the TimerWheel aggregated to the node, aggregating one if needed
+     * \return the timer wheel of the node
+     */
+    Ptr<TimerWheel> GetNodeTimerWheel() const;
+
     /**
      * \brief Move from CLOSING or FIN_WAIT_2 to TIME_WAIT state
      */
@@ -1281,6 +1332,11 @@ class TcpSocketBase : public TcpSocket
     EventId m_persistEvent{};  //!< Persist event: Send 1 byte to probe for a non-zero Rx window
     EventId m_timewaitEvent{}; //!< TIME_WAIT expiration event: Move this socket to CLOSED state
 
+    // Timers managed by the timer wheel of the node
+    WheelTimer m_retxTimer;      //!< Retransmission timer
+    WheelTimer m_delAckTimer;    //!< Delayed ACK timer
+    bool m_useTimerWheel{false}; //!< Use the wheel for the retransmission and delayed ACK timers
+
     // ACK management
     uint32_t m_dupAckCount{0};    //!< Dupack counter
     uint32_t m_delAckCount{0};    //!< Delayed ACK counter
@@ -1361,6 +1417,11 @@ class TcpSocketBase : public TcpSocket
     uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
     bool m_limitedTx{true};      //!< perform limited transmit
 
+    // Segmentation offload
+    /// Max data sent at once: the largest IPv4 datagram minus the IPv4 and TCP headers
+    static constexpr uint32_t GSO_MAX_SIZE = 65535 - 20 - 60;
+    uint16_t m_gsoMaxSegments{1}; //!< Max number of segments sent at once (1: disabled)
+
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
     Ptr<TcpCongestionOps> m_congestionControl; //!< Congestion control
@@ -224,6 +224,214 @@ Ipv4ForwardingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 route cache Test
+ *
+ * Packets are forwarded by a node whose route cache is enabled, before and
+ * after the route towards their destination is changed.
+ */
+class Ipv4RouteCacheTest : public TestCase
+{
+    uint32_t m_received[2]; //!< Number of packets received by each receiver
+    uint32_t m_hits;        //!< Number of route cache hits
+    uint32_t m_misses;      //!< Number of route cache misses
+
+    /**
+     * \brief Add an interface to a node.
+     * \param node The node.
+     * \param channel The channel to attach the interface to.
+     * \param address The address of the interface.
+     * \return the index of the interface
+     */
+    uint32_t AddInterface(Ptr<Node> node, Ptr<SimpleChannel> channel, std::string address);
+    /**
+     * \brief Send data.
+     * \param socket The sending socket.
+     * \param to Destination address.
+     */
+    void DoSendData(Ptr<Socket> socket, std::string to);
+    /**
+     * \brief Send data.
+     * \param socket The sending socket.
+     * \param to Destination address.
+     */
+    void SendData(Ptr<Socket> socket, std::string to);
+
+  public:
+    void DoRun() override;
+    Ipv4RouteCacheTest();
+
+    /**
+     * \brief Receive data.
+     * \param index The index of the receiver.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(uint32_t index, Ptr<Socket> socket);
+    /**
+     * \brief Count the route cache hits.
+     * \param header The IPv4 header.
+     * \param packet The packet.
+     * \param interface The input interface.
+     */
+    void CacheHit(const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface);
+    /**
+     * \brief Count the route cache misses.
+     * \param header The IPv4 header.
+     * \param packet The packet.
+     * \param interface The input interface.
+     */
+    void CacheMiss(const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface);
+};
+
+Ipv4RouteCacheTest::Ipv4RouteCacheTest()
+    : TestCase("IPv4 route cache")
+{
+}
+
+void
+Ipv4RouteCacheTest::ReceivePkt(uint32_t index, Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_received[index]++;
+    }
+}
+
+void
+Ipv4RouteCacheTest::CacheHit(const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface)
+{
+    m_hits++;
+}
+
+void
+Ipv4RouteCacheTest::CacheMiss(const Ipv4Header& header,
+                              Ptr<const Packet> packet,
+                              uint32_t interface)
+{
+    m_misses++;
+}
+
+uint32_t
+Ipv4RouteCacheTest::AddInterface(Ptr<Node> node, Ptr<SimpleChannel> channel, std::string address)
+{
+    Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+    dev->SetAddress(Mac48Address::ConvertFrom(Mac48Address::Allocate()));
+    dev->SetChannel(channel);
+    node->AddDevice(dev);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t netdev_idx = ipv4->AddInterface(dev);
+    Ipv4InterfaceAddress ipv4Addr =
+        Ipv4InterfaceAddress(Ipv4Address(address.c_str()), Ipv4Mask(0xffff0000U));
+    ipv4->AddAddress(netdev_idx, ipv4Addr);
+    ipv4->SetUp(netdev_idx);
+    return netdev_idx;
+}
+
+void
+Ipv4RouteCacheTest::DoSendData(Ptr<Socket> socket, std::string to)
+{
+    Address realTo = InetSocketAddress(Ipv4Address(to.c_str()), 1234);
+    NS_TEST_EXPECT_MSG_EQ(socket->SendTo(Create<Packet>(123), 0, realTo), 123, "100");
+}
+
+void
+Ipv4RouteCacheTest::SendData(Ptr<Socket> socket, std::string to)
+{
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(),
+                                   Seconds(0),
+                                   &Ipv4RouteCacheTest::DoSendData,
+                                   this,
+                                   socket,
+                                   to);
+    Simulator::Run();
+}
+
+void
+Ipv4RouteCacheTest::DoRun()
+{
+    m_received[0] = 0;
+    m_received[1] = 0;
+    m_hits = 0;
+    m_misses = 0;
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    NodeContainer nodes;
+    nodes.Create(4);
+    internet.Install(nodes);
+    Ptr<Node> txNode = nodes.Get(0);
+    Ptr<Node> fwNode = nodes.Get(1);
+
+    // The two receivers share the 10.5.0.1 address, which is only reachable
+    // through the host route of the forwarding node
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    Ptr<SimpleChannel> channel2 = CreateObject<SimpleChannel>();
+    uint32_t fwIf = AddInterface(fwNode, channel1, "10.0.0.1");
+    AddInterface(fwNode, channel2, "10.1.0.1");
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<Node> rxNode = nodes.Get(2 + i);
+        uint32_t rxIf = AddInterface(rxNode, channel1, i == 0 ? "10.0.0.2" : "10.0.0.3");
+        rxNode->GetObject<Ipv4>()->AddAddress(
+            rxIf,
+            Ipv4InterfaceAddress(Ipv4Address("10.5.0.1"), Ipv4Mask::GetOnes()));
+
+        Ptr<Socket> rxSocket = rxNode->GetObject<UdpSocketFactory>()->CreateSocket();
+        NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234)),
+                              0,
+                              "trivial");
+        rxSocket->SetRecvCallback(MakeCallback(&Ipv4RouteCacheTest::ReceivePkt, this).Bind(i));
+    }
+    uint32_t txIf = AddInterface(txNode, channel2, "10.1.0.2");
+    Ptr<Ipv4StaticRouting> txRouting = Ipv4RoutingHelper::GetRouting<Ipv4StaticRouting>(
+        txNode->GetObject<Ipv4>()->GetRoutingProtocol());
+    txRouting->SetDefaultRoute(Ipv4Address("10.1.0.1"), txIf);
+
+    Ptr<Ipv4L3Protocol> fwIpv4 = fwNode->GetObject<Ipv4L3Protocol>();
+    fwIpv4->SetAttribute("EnableRouteCache", BooleanValue(true));
+    fwIpv4->TraceConnectWithoutContext("RouteCacheHit",
+                                       MakeCallback(&Ipv4RouteCacheTest::CacheHit, this));
+    fwIpv4->TraceConnectWithoutContext("RouteCacheMiss",
+                                       MakeCallback(&Ipv4RouteCacheTest::CacheMiss, this));
+    Ptr<Ipv4StaticRouting> fwRouting =
+        Ipv4RoutingHelper::GetRouting<Ipv4StaticRouting>(fwIpv4->GetRoutingProtocol());
+    fwRouting->AddHostRouteTo(Ipv4Address("10.5.0.1"), Ipv4Address("10.0.0.2"), fwIf);
+
+    Ptr<Socket> txSocket = txNode->GetObject<UdpSocketFactory>()->CreateSocket();
+
+    // ------ Now the tests ------------
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        SendData(txSocket, "10.5.0.1");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_received[0], 3, "Packets not forwarded to the first receiver");
+    NS_TEST_EXPECT_MSG_EQ(m_misses, 1, "Only the first packet should miss the cache");
+    NS_TEST_EXPECT_MSG_EQ(m_hits, 2, "The following packets should hit the cache");
+
+    // The route change must invalidate the cached route
+    fwRouting->RemoveRoute(fwRouting->GetNRoutes() - 1);
+    fwRouting->AddHostRouteTo(Ipv4Address("10.5.0.1"), Ipv4Address("10.0.0.3"), fwIf);
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        SendData(txSocket, "10.5.0.1");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_received[0], 3, "Packets forwarded with a stale route");
+    NS_TEST_EXPECT_MSG_EQ(m_received[1], 2, "Packets not forwarded to the second receiver");
+    NS_TEST_EXPECT_MSG_EQ(m_misses, 2, "The route change did not flush the cache");
+    NS_TEST_EXPECT_MSG_EQ(m_hits, 3, "The new route was not cached");
+
+    // Disabling forwarding must invalidate the cached route as well
+    fwIpv4->SetAttribute("IpForward", BooleanValue(false));
+    SendData(txSocket, "10.5.0.1");
+    NS_TEST_EXPECT_MSG_EQ(m_received[1], 2, "Packet forwarded with forwarding disabled");
+    NS_TEST_EXPECT_MSG_EQ(m_hits, 3, "Cached route used with forwarding disabled");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -241,6 +449,7 @@ Ipv4ForwardingTestSuite::Ipv4ForwardingTestSuite()
     : TestSuite("ipv4-forwarding", UNIT)
 {
     AddTestCase(new Ipv4ForwardingTest, TestCase::QUICK);
+    AddTestCase(new Ipv4RouteCacheTest, TestCase::QUICK);
 }
 
 static Ipv4ForwardingTestSuite
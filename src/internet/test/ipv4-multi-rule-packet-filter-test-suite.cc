@@ -0,0 +1,228 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ipv4-multi-rule-packet-filter.h"
+#include "ns3/ipv4-queue-disc-item.h"
+#include "ns3/object-factory.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/tcp-header.h"
+#include "ns3/test.h"
+#include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * Create an IPv4 queue disc item
+ *
+ * \param src the source address
+ * \param dst the destination address
+ * \param protocol the protocol (6 for TCP, 17 for UDP)
+ * \param srcPort the source port
+ * \param dstPort the destination port
+ * \return the item
+ */
+static Ptr<Ipv4QueueDiscItem>
+CreateItem(Ipv4Address src, Ipv4Address dst, uint8_t protocol, uint16_t srcPort, uint16_t dstPort)
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    if (protocol == 6)
+    {
+        TcpHeader tcpHeader;
+        tcpHeader.SetSourcePort(srcPort);
+        tcpHeader.SetDestinationPort(dstPort);
+        p->AddHeader(tcpHeader);
+    }
+    else if (protocol == 17)
+    {
+        UdpHeader udpHeader;
+        udpHeader.SetSourcePort(srcPort);
+        udpHeader.SetDestinationPort(dstPort);
+        p->AddHeader(udpHeader);
+    }
+    Ipv4Header header;
+    header.SetSource(src);
+    header.SetDestination(dst);
+    header.SetProtocol(protocol);
+    header.SetPayloadSize(p->GetSize());
+    return Create<Ipv4QueueDiscItem>(p, Address(), 0x0800, header);
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * Check the rules of the multi-rule packet filter and the flow hash cached by
+ * the queue disc items.
+ */
+class Ipv4MultiRulePacketFilterRulesTest : public TestCase
+{
+  public:
+    Ipv4MultiRulePacketFilterRulesTest();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4MultiRulePacketFilterRulesTest::Ipv4MultiRulePacketFilterRulesTest()
+    : TestCase("Check the rules of the multi-rule packet filter")
+{
+}
+
+void
+Ipv4MultiRulePacketFilterRulesTest::DoRun()
+{
+    Ptr<Ipv4QueueDiscItem> item = CreateItem("10.1.2.3", "10.9.0.1", 6, 5000, 80);
+    NS_TEST_EXPECT_MSG_EQ(item->GetFlowHash(), item->Hash(0), "Unexpected flow hash");
+    NS_TEST_EXPECT_MSG_EQ(item->GetFlowHash(7), item->Hash(7), "Unexpected perturbed flow hash");
+    NS_TEST_EXPECT_MSG_EQ(item->GetFlowHash(), item->Hash(0), "Unexpected flow hash");
+
+    Ptr<Ipv4MultiRulePacketFilter> filter = CreateObject<Ipv4MultiRulePacketFilter>();
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(item), PacketFilter::PF_NO_MATCH, "No rule yet");
+
+    // TCP packets to port 80 of the 10.9.0.0/16 subnet
+    Ipv4MultiRulePacketFilter::Rule web;
+    web.destination = Ipv4Address("10.9.0.0");
+    web.destinationMask = Ipv4Mask("255.255.0.0");
+    web.protocol = 6;
+    web.destinationPortMin = 80;
+    web.destinationPortMax = 80;
+    web.classId = 1;
+    filter->AddRule(web);
+    // packets from the 10.1.2.0/24 subnet with source port in [4000, 4999]
+    Ipv4MultiRulePacketFilter::Rule subnet;
+    subnet.source = Ipv4Address("10.1.2.0");
+    subnet.sourceMask = Ipv4Mask("255.255.255.0");
+    subnet.sourcePortMin = 4000;
+    subnet.sourcePortMax = 4999;
+    subnet.classId = 2;
+    filter->AddRule(subnet);
+    // any packet from 10.1.0.0/16
+    Ipv4MultiRulePacketFilter::Rule any;
+    any.source = Ipv4Address("10.1.0.0");
+    any.sourceMask = Ipv4Mask("255.255.0.0");
+    any.classId = 3;
+    NS_TEST_EXPECT_MSG_EQ(filter->AddRule(any), 2, "Unexpected index of the rule");
+    NS_TEST_EXPECT_MSG_EQ(filter->GetNRules(), 3, "Unexpected number of rules");
+
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(item), 1, "The first matching rule must be used");
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(item), 1, "The cached class must be used");
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(CreateItem("10.1.2.3", "10.9.0.1", 17, 4500, 80)),
+                          2,
+                          "UDP packets do not match the first rule");
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(CreateItem("10.1.2.3", "10.9.0.1", 17, 5000, 80)),
+                          3,
+                          "The source port does not match the second rule");
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(CreateItem("10.1.2.3", "10.8.0.1", 1, 0, 0)),
+                          3,
+                          "Packets with no port must match the third rule");
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(CreateItem("10.2.2.3", "10.8.0.1", 6, 4500, 80)),
+                          PacketFilter::PF_NO_MATCH,
+                          "No rule matches the packet");
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(CreateItem("10.2.2.3", "10.9.1.1", 6, 4500, 80)),
+                          1,
+                          "Unexpected class of the packet");
+
+    // a new rule invalidates the cached classes
+    Ipv4MultiRulePacketFilter::Rule all;
+    all.classId = 4;
+    filter->AddRule(all);
+    NS_TEST_EXPECT_MSG_EQ(filter->Classify(CreateItem("10.2.2.3", "10.8.0.1", 6, 4500, 80)),
+                          4,
+                          "The new rule must match the packet");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * Check that the classes returned with and without the flow cache are the
+ * same, when a small flow cache is flushed repeatedly.
+ */
+class Ipv4MultiRulePacketFilterCacheTest : public TestCase
+{
+  public:
+    Ipv4MultiRulePacketFilterCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4MultiRulePacketFilterCacheTest::Ipv4MultiRulePacketFilterCacheTest()
+    : TestCase("Check the flow cache of the multi-rule packet filter")
+{
+}
+
+void
+Ipv4MultiRulePacketFilterCacheTest::DoRun()
+{
+    Ptr<Ipv4MultiRulePacketFilter> cached =
+        CreateObjectWithAttributes<Ipv4MultiRulePacketFilter>("FlowCacheSize", UintegerValue(16));
+    Ptr<Ipv4MultiRulePacketFilter> uncached =
+        CreateObjectWithAttributes<Ipv4MultiRulePacketFilter>("FlowCacheSize", UintegerValue(0));
+    for (uint16_t i = 0; i < 32; i++)
+    {
+        Ipv4MultiRulePacketFilter::Rule rule;
+        rule.source = Ipv4Address(0x0a000000 | (i << 8));
+        rule.sourceMask = Ipv4Mask("255.255.255.0");
+        rule.protocol = (i % 2 ? 17 : 6);
+        rule.destinationPortMin = 1000 + i * 10;
+        rule.destinationPortMax = 1000 + i * 10 + 19;
+        rule.classId = i;
+        cached->AddRule(rule);
+        uncached->AddRule(rule);
+    }
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    uint32_t matches = 0;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        // 64 flows, so that the flow cache is hit and flushed
+        uint32_t flow = rng->GetInteger(0, 63);
+        Ptr<Ipv4QueueDiscItem> item = CreateItem(Ipv4Address(0x0a000000 | ((flow % 40) << 8) | 1),
+                                                 Ipv4Address("10.255.0.1"),
+                                                 (flow % 3 ? 17 : 6),
+                                                 9,
+                                                 1000 + flow * 5);
+        int32_t classId = uncached->Classify(item);
+        NS_TEST_EXPECT_MSG_EQ(cached->Classify(item),
+                              classId,
+                              "The cached class differs from the class given by the rules");
+        matches += (classId != PacketFilter::PF_NO_MATCH);
+    }
+    NS_TEST_EXPECT_MSG_GT(matches, 0, "No packet matched a rule");
+    NS_TEST_EXPECT_MSG_LT(matches, 2000, "All the packets matched a rule");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * Multi-rule packet filter TestSuite
+ */
+class Ipv4MultiRulePacketFilterTestSuite : public TestSuite
+{
+  public:
+    Ipv4MultiRulePacketFilterTestSuite()
+        : TestSuite("ipv4-multi-rule-packet-filter", UNIT)
+    {
+        AddTestCase(new Ipv4MultiRulePacketFilterRulesTest(), TestCase::QUICK);
+        AddTestCase(new Ipv4MultiRulePacketFilterCacheTest(), TestCase::QUICK);
+    }
+};
+
+static Ipv4MultiRulePacketFilterTestSuite
+    g_ipv4MultiRulePacketFilterTestSuite; //!< Static variable for test initialization
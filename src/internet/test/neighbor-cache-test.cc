@@ -1221,6 +1221,111 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief Neighbor Cache Inverse Lookup Test
+ */
+class InverseLookupTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    InverseLookupTest();
+
+  private:
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+InverseLookupTest::InverseLookupTest()
+    : TestCase("The InverseLookupTest checks that the inverse lookups of the ARP and NDISC "
+               "caches follow the changes of the MAC address of the entries.")
+{
+}
+
+void
+InverseLookupTest::DoRun()
+{
+    m_nodes.Create(1);
+
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(0));
+
+    InternetStackHelper internet;
+    internet.Install(m_nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(net);
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:0::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer icv6 = ipv6.Assign(net);
+
+    Ptr<Ipv4Interface> iface = DynamicCast<Ipv4L3Protocol>(i.Get(0).first)->GetInterface(1);
+    Ptr<ArpCache> arpCache = iface->GetArpCache();
+    Ptr<Ipv6Interface> ifacev6 = DynamicCast<Ipv6L3Protocol>(icv6.Get(0).first)->GetInterface(1);
+    Ptr<NdiscCache> ndiscCache = ifacev6->GetNdiscCache();
+
+    Mac48Address mac1("04-06-00:00:00:00:00:01");
+    Mac48Address mac2("04-06-00:00:00:00:00:02");
+
+    // Two addresses (e.g., of a router) with the same MAC address, added in reverse order
+    ArpCache::Entry* arpEntry2 = arpCache->Add(Ipv4Address("10.1.1.20"));
+    arpEntry2->SetMacAddress(mac1);
+    arpEntry2->MarkPermanent();
+    ArpCache::Entry* arpEntry1 = arpCache->Add(Ipv4Address("10.1.1.10"));
+    arpEntry1->SetMacAddress(mac1);
+    arpEntry1->MarkPermanent();
+    // An entry without MAC address
+    arpCache->Add(Ipv4Address("10.1.1.30"));
+
+    std::list<ArpCache::Entry*> arpEntries = arpCache->LookupInverse(mac1);
+    NS_TEST_ASSERT_MSG_EQ(arpEntries.size(), 2, "Wrong number of ARP entries");
+    NS_TEST_EXPECT_MSG_EQ(arpEntries.front(), arpEntry1, "ARP entries not sorted by address");
+    NS_TEST_EXPECT_MSG_EQ(arpEntries.back(), arpEntry2, "ARP entries not sorted by address");
+
+    arpEntry1->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).size(), 1, "Wrong number of ARP entries");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).front(), arpEntry1, "Wrong ARP entry");
+
+    arpCache->Remove(arpEntry2);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).size(), 0, "Removed ARP entry found");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(Ipv4Address("10.1.1.20")),
+                          nullptr,
+                          "Removed ARP entry found");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(Ipv4Address("10.1.1.10")),
+                          arpEntry1,
+                          "ARP entry not found");
+
+    // Same checks on the NDISC cache
+    NdiscCache::Entry* ndiscEntry2 = ndiscCache->Add(Ipv6Address("2001::2"));
+    ndiscEntry2->SetMacAddress(mac1);
+    ndiscEntry2->MarkPermanent();
+    NdiscCache::Entry* ndiscEntry1 = ndiscCache->Add(Ipv6Address("2001::1"));
+    ndiscEntry1->SetMacAddress(mac1);
+    ndiscEntry1->MarkPermanent();
+
+    std::list<NdiscCache::Entry*> ndiscEntries = ndiscCache->LookupInverse(mac1);
+    NS_TEST_ASSERT_MSG_EQ(ndiscEntries.size(), 2, "Wrong number of NDISC entries");
+    NS_TEST_EXPECT_MSG_EQ(ndiscEntries.front(), ndiscEntry1, "NDISC entries not sorted by address");
+    NS_TEST_EXPECT_MSG_EQ(ndiscEntries.back(), ndiscEntry2, "NDISC entries not sorted by address");
+
+    ndiscEntry1->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).size(),
+                          1,
+                          "Wrong number of NDISC entries");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).front(),
+                          ndiscEntry1,
+                          "Wrong NDISC entry");
+
+    ndiscCache->Remove(ndiscEntry2);
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).size(), 0, "Removed NDISC entry found");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->Lookup(Ipv6Address("2001::2")),
+                          nullptr,
+                          "Removed NDISC entry found");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1239,6 +1344,7 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::QUICK);
         AddTestCase(new DuplicateTest, TestCase::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::QUICK);
+        AddTestCase(new InverseLookupTest, TestCase::QUICK);
     }
 };
 
@@ -42,6 +42,12 @@ class TcpRxBufferTestCase : public TestCase
      * \brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * \brief Test the merge of overlapping and adjacent segments, and the
+     * extraction of data spanning multiple segments.
+     */
+    void TestMergeAndExtract();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -53,6 +59,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestMergeAndExtract();
 }
 
 void
@@ -289,6 +296,82 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestMergeAndExtract()
+{
+    TcpRxBuffer rxBuf;
+    TcpOptionSack::SackList sackList;
+    TcpHeader h;
+
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+
+    // Two out-of-order blocks
+    h.SetSequenceNumber(SequenceNumber32(201));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(100), h), true, "Segment not buffered");
+    h.SetSequenceNumber(SequenceNumber32(501));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(100), h), true, "Segment not buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 200, "Buffer occupancy differs from expected");
+
+    // Duplicate of a buffered segment: nothing to store
+    h.SetSequenceNumber(SequenceNumber32(201));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(100), h), false, "Duplicate was buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 200, "Buffer occupancy differs from expected");
+
+    // Segment overlapping the tail of the first block and the head of the second
+    h.SetSequenceNumber(SequenceNumber32(251));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(300), h), true, "Segment not buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 400, "Buffer occupancy differs from expected");
+    sackList = rxBuf.GetSackList();
+    NS_TEST_ASSERT_MSG_EQ(sackList.size(), 1, "SACK list should contain one element");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().first,
+                          SequenceNumber32(201),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().second,
+                          SequenceNumber32(601),
+                          "SACK block different than expected");
+
+    // Segment fully embedding a later block
+    h.SetSequenceNumber(SequenceNumber32(701));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(50), h), true, "Segment not buffered");
+    h.SetSequenceNumber(SequenceNumber32(651));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(200), h), true, "Segment not buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 600, "Buffer occupancy differs from expected");
+    sackList = rxBuf.GetSackList();
+    NS_TEST_ASSERT_MSG_EQ(sackList.size(), 2, "SACK list should contain two elements");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().first,
+                          SequenceNumber32(651),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().second,
+                          SequenceNumber32(851),
+                          "SACK block different than expected");
+
+    // Fill the holes: everything becomes available at once
+    h.SetSequenceNumber(SequenceNumber32(601));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(50), h), true, "Segment not buffered");
+    h.SetSequenceNumber(SequenceNumber32(1));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(200), h), true, "Segment not buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(851),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 850, "Available bytes differ from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "SACK list should be empty");
+
+    // Extract across fragment boundaries
+    Ptr<Packet> out = rxBuf.Extract(275);
+    NS_TEST_ASSERT_MSG_EQ(out->GetSize(), 275, "Extracted size differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 575, "Available bytes differ from expected");
+
+    // A segment contiguous with the partially extracted block
+    h.SetSequenceNumber(SequenceNumber32(851));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(100), h), true, "Segment not buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 675, "Available bytes differ from expected");
+
+    out = rxBuf.Extract(1000);
+    NS_TEST_ASSERT_MSG_EQ(out->GetSize(), 675, "Extracted size differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "Buffer should be empty");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(1000), nullptr, "Nothing should be extracted");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
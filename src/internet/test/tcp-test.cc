@@ -20,6 +20,7 @@
  */
 
 #include "ns3/arp-l3-protocol.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
@@ -66,13 +67,17 @@ class TcpTestCase : public TestCase
      * \param serverWriteSize Server data size when sending.
      * \param serverReadSize Server data size when receiving.
      * \param useIpv6 Use IPv6 instead of IPv4.
+     * \param useTimerWheel Use the timer wheel of the nodes for the TCP timers.
+     * \param gsoMaxSegments Max number of segments sent at once (segmentation offload).
      */
     TcpTestCase(uint32_t totalStreamSize,
                 uint32_t sourceWriteSize,
                 uint32_t sourceReadSize,
                 uint32_t serverWriteSize,
                 uint32_t serverReadSize,
-                bool useIpv6);
+                bool useIpv6,
+                bool useTimerWheel = false,
+                uint16_t gsoMaxSegments = 1);
 
   private:
     void DoRun() override;
@@ -145,6 +150,20 @@ class TcpTestCase : public TestCase
      * \param sock The socket.
      */
     void SourceHandleRecv(Ptr<Socket> sock);
+    /**
+     * \brief Count the packets carrying several segments sent by IPv4.
+     * \param p The packet.
+     * \param ipv4 The IPv4 object.
+     * \param interface The interface.
+     */
+    void Ipv4Tx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
+    /**
+     * \brief Record the size of the largest packet received by IPv4.
+     * \param p The packet.
+     * \param ipv4 The IPv4 object.
+     * \param interface The interface.
+     */
+    void Ipv4Rx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
 
     uint32_t m_totalBytes;           //!< Total stream size (in bytes).
     uint32_t m_sourceWriteSize;      //!< Client data size when sending.
@@ -159,7 +178,11 @@ class TcpTestCase : public TestCase
     uint8_t* m_sourceRxPayload;      //!< Client Rx payload.
     uint8_t* m_serverRxPayload;      //!< Server Rx payload.
 
-    bool m_useIpv6; //!< Use IPv6 instead of IPv4.
+    bool m_useIpv6;            //!< Use IPv6 instead of IPv4.
+    bool m_useTimerWheel;      //!< Use the timer wheel of the nodes for the TCP timers.
+    uint16_t m_gsoMaxSegments; //!< Max number of segments sent at once.
+    uint32_t m_gsoPackets;     //!< Number of packets carrying several segments sent.
+    uint32_t m_maxRxSize;      //!< Size of the largest packet received.
 };
 
 static std::string
@@ -169,12 +192,15 @@ Name(std::string str,
      uint32_t serverReadSize,
      uint32_t serverWriteSize,
      uint32_t sourceReadSize,
-     bool useIpv6)
+     bool useIpv6,
+     bool useTimerWheel,
+     uint16_t gsoMaxSegments)
 {
     std::ostringstream oss;
     oss << str << " total=" << totalStreamSize << " sourceWrite=" << sourceWriteSize
         << " sourceRead=" << sourceReadSize << " serverRead=" << serverReadSize
-        << " serverWrite=" << serverWriteSize << " useIpv6=" << useIpv6;
+        << " serverWrite=" << serverWriteSize << " useIpv6=" << useIpv6
+        << " useTimerWheel=" << useTimerWheel << " gsoMaxSegments=" << gsoMaxSegments;
     return oss.str();
 }
 
@@ -191,20 +217,26 @@ TcpTestCase::TcpTestCase(uint32_t totalStreamSize,
                          uint32_t sourceReadSize,
                          uint32_t serverWriteSize,
                          uint32_t serverReadSize,
-                         bool useIpv6)
+                         bool useIpv6,
+                         bool useTimerWheel,
+                         uint16_t gsoMaxSegments)
     : TestCase(Name("Send string data from client to server and back",
                     totalStreamSize,
                     sourceWriteSize,
                     serverReadSize,
                     serverWriteSize,
                     sourceReadSize,
-                    useIpv6)),
+                    useIpv6,
+                    useTimerWheel,
+                    gsoMaxSegments)),
       m_totalBytes(totalStreamSize),
       m_sourceWriteSize(sourceWriteSize),
       m_sourceReadSize(sourceReadSize),
       m_serverWriteSize(serverWriteSize),
       m_serverReadSize(serverReadSize),
-      m_useIpv6(useIpv6)
+      m_useIpv6(useIpv6),
+      m_useTimerWheel(useTimerWheel),
+      m_gsoMaxSegments(gsoMaxSegments)
 {
 }
 
@@ -215,6 +247,8 @@ TcpTestCase::DoRun()
     m_currentSourceRxBytes = 0;
     m_currentServerRxBytes = 0;
     m_currentServerTxBytes = 0;
+    m_gsoPackets = 0;
+    m_maxRxSize = 0;
     m_sourceTxPayload = new uint8_t[m_totalBytes];
     m_sourceRxPayload = new uint8_t[m_totalBytes];
     m_serverRxPayload = new uint8_t[m_totalBytes];
@@ -226,6 +260,9 @@ TcpTestCase::DoRun()
     memset(m_sourceRxPayload, 0, m_totalBytes);
     memset(m_serverRxPayload, 0, m_totalBytes);
 
+    Config::SetDefault("ns3::TcpSocketBase::UseTimerWheel", BooleanValue(m_useTimerWheel));
+    Config::SetDefault("ns3::TcpSocketBase::GsoMaxSegments", UintegerValue(m_gsoMaxSegments));
+
     if (m_useIpv6)
     {
         SetupDefaultSim6();
@@ -246,6 +283,11 @@ TcpTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(memcmp(m_sourceTxPayload, m_sourceRxPayload, m_totalBytes),
                           0,
                           "Source received back expected data buffers");
+    if (m_gsoMaxSegments > 1)
+    {
+        NS_TEST_EXPECT_MSG_GT(m_gsoPackets, 0, "No packet carrying several segments sent");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxRxSize, 1500, "Packet larger than the MTU received");
+    }
 }
 
 void
@@ -254,6 +296,8 @@ TcpTestCase::DoTeardown()
     delete[] m_sourceTxPayload;
     delete[] m_sourceRxPayload;
     delete[] m_serverRxPayload;
+    Config::SetDefault("ns3::TcpSocketBase::UseTimerWheel", BooleanValue(false));
+    Config::SetDefault("ns3::TcpSocketBase::GsoMaxSegments", UintegerValue(1));
     Simulator::Destroy();
 }
 
@@ -345,6 +389,21 @@ TcpTestCase::SourceHandleRecv(Ptr<Socket> sock)
     }
 }
 
+void
+TcpTestCase::Ipv4Tx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    if (p->GetSize() > ipv4->GetMtu(interface))
+    {
+        m_gsoPackets++;
+    }
+}
+
+void
+TcpTestCase::Ipv4Rx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    m_maxRxSize = std::max(m_maxRxSize, p->GetSize());
+}
+
 Ptr<Node>
 TcpTestCase::CreateInternetNode()
 {
@@ -405,6 +464,19 @@ TcpTestCase::SetupDefaultSim()
     dev0->SetChannel(channel);
     dev1->SetChannel(channel);
 
+    if (m_gsoMaxSegments > 1)
+    {
+        // Packets carrying several segments must be split to fit the MTU
+        dev0->SetMtu(1500);
+        dev1->SetMtu(1500);
+        for (auto node : {node0, node1})
+        {
+            Ptr<Ipv4L3Protocol> ipv4 = node->GetObject<Ipv4L3Protocol>();
+            ipv4->TraceConnectWithoutContext("Tx", MakeCallback(&TcpTestCase::Ipv4Tx, this));
+            ipv4->TraceConnectWithoutContext("Rx", MakeCallback(&TcpTestCase::Ipv4Rx, this));
+        }
+    }
+
     Ptr<SocketFactory> sockFactory0 = node0->GetObject<TcpSocketFactory>();
     Ptr<SocketFactory> sockFactory1 = node1->GetObject<TcpSocketFactory>();
 
@@ -556,6 +628,13 @@ class TcpTestSuite : public TestSuite
         AddTestCase(new TcpTestCase(13, 200, 200, 200, 200, true), TestCase::QUICK);
         AddTestCase(new TcpTestCase(13, 1, 1, 1, 1, true), TestCase::QUICK);
         AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, true), TestCase::QUICK);
+
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, false, true), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, true, true), TestCase::QUICK);
+
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, false, false, 8), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(100000, 1000, 1000, 1000, 1000, false, false, 44),
+                    TestCase::QUICK);
     }
 };
 
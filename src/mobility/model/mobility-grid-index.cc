@@ -0,0 +1,212 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mobility-grid-index.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityGridIndex");
+
+MobilityGridIndex::MobilityGridIndex()
+    : m_cellSize(100),
+      m_updating(false),
+      m_n(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MobilityGridIndex::~MobilityGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+MobilityGridIndex::SetCellSize(double size)
+{
+    NS_LOG_FUNCTION(this << size);
+    NS_ASSERT_MSG(size > 0, "The size of the cells must be positive");
+    NS_ASSERT_MSG(m_entries.empty(), "The size of the cells cannot change in a non-empty index");
+    m_cellSize = size;
+}
+
+double
+MobilityGridIndex::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+std::size_t
+MobilityGridIndex::CellHash::operator()(const Cell& cell) const
+{
+    return std::hash<int64_t>()(cell.first * 0x9e3779b97f4a7c15ULL ^ cell.second);
+}
+
+MobilityGridIndex::Cell
+MobilityGridIndex::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_cellSize)),
+            static_cast<int64_t>(std::floor(position.y / m_cellSize))};
+}
+
+void
+MobilityGridIndex::Insert(Entry& entry)
+{
+    entry.moving = (entry.mobility->GetVelocity().GetLength() != 0);
+    std::vector<uint32_t>* ids = &m_moving;
+    if (!entry.moving)
+    {
+        entry.cell = GetCell(entry.mobility->GetPosition());
+        ids = &m_cells[entry.cell];
+    }
+    ids->insert(ids->end(), entry.ids.begin(), entry.ids.end());
+}
+
+void
+MobilityGridIndex::Erase(const Entry& entry)
+{
+    std::vector<uint32_t>* ids = &m_moving;
+    auto cellIt = m_cells.end();
+    if (!entry.moving)
+    {
+        cellIt = m_cells.find(entry.cell);
+        NS_ASSERT(cellIt != m_cells.end());
+        ids = &cellIt->second;
+    }
+    for (auto id : entry.ids)
+    {
+        auto it = std::find(ids->begin(), ids->end(), id);
+        NS_ASSERT(it != ids->end());
+        *it = ids->back();
+        ids->pop_back();
+    }
+    if (cellIt != m_cells.end() && ids->empty())
+    {
+        m_cells.erase(cellIt);
+    }
+}
+
+void
+MobilityGridIndex::Add(Ptr<MobilityModel> mobility, uint32_t id)
+{
+    NS_LOG_FUNCTION(this << mobility << id);
+    NS_ASSERT_MSG(mobility, "The mobility model of the object is null");
+
+    auto [it, inserted] = m_entries.emplace(PeekPointer(mobility), Entry{mobility, {}, false, {}});
+    m_updating = true;
+    if (inserted)
+    {
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGridIndex::CourseChanged, this));
+    }
+    else
+    {
+        Erase(it->second);
+    }
+    it->second.ids.push_back(id);
+    Insert(it->second);
+    m_updating = false;
+    m_n++;
+}
+
+void
+MobilityGridIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [ptr, entry] : m_entries)
+    {
+        entry.mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGridIndex::CourseChanged, this));
+    }
+    m_entries.clear();
+    m_cells.clear();
+    m_moving.clear();
+    m_n = 0;
+}
+
+std::size_t
+MobilityGridIndex::GetN() const
+{
+    return m_n;
+}
+
+void
+MobilityGridIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_entries.find(PeekPointer(mobility));
+    if (it == m_entries.end() || m_updating)
+    {
+        // querying the position and velocity of a mobility model may update it
+        // and notify a course change, while the object is being moved
+        return;
+    }
+    m_updating = true;
+    Erase(it->second);
+    Insert(it->second);
+    m_updating = false;
+}
+
+void
+MobilityGridIndex::GetCandidates(const Vector& position,
+                                 double range,
+                                 std::vector<uint32_t>& ids) const
+{
+    NS_LOG_FUNCTION(this << position << range);
+
+    ids.assign(m_moving.begin(), m_moving.end());
+    Cell min = GetCell(Vector(position.x - range, position.y - range, 0));
+    Cell max = GetCell(Vector(position.x + range, position.y + range, 0));
+    double nCells = double(max.first - min.first + 1) * double(max.second - min.second + 1);
+
+    if (nCells > m_cells.size())
+    {
+        // fewer occupied cells than cells overlapping the range
+        for (const auto& [cell, cellIds] : m_cells)
+        {
+            if (cell.first >= min.first && cell.first <= max.first &&
+                cell.second >= min.second && cell.second <= max.second)
+            {
+                ids.insert(ids.end(), cellIds.begin(), cellIds.end());
+            }
+        }
+    }
+    else
+    {
+        for (int64_t x = min.first; x <= max.first; x++)
+        {
+            for (int64_t y = min.second; y <= max.second; y++)
+            {
+                auto it = m_cells.find({x, y});
+                if (it != m_cells.end())
+                {
+                    ids.insert(ids.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+}
+
+} // namespace ns3
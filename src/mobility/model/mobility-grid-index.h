@@ -0,0 +1,154 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOBILITY_GRID_INDEX_H
+#define MOBILITY_GRID_INDEX_H
+
+#include "mobility-model.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ * \brief A spatial index of mobility models, based on a uniform grid.
+ *
+ * The index partitions the plane into square cells and keeps track of the
+ * objects (identified by an integer chosen by the user, e.g., their index in
+ * a list) whose mobility model is in each cell. It is used to find the
+ * objects that may be within a given distance of a position (e.g., the
+ * receivers that may detect a signal) without computing the distance to all
+ * the objects.
+ *
+ * The index is updated upon the CourseChange notifications of the mobility
+ * models. Since the position of a moving object changes without
+ * notifications, the objects whose velocity is not null are not placed in a
+ * cell, and are always returned as candidates. Hence, the index is accurate
+ * as long as the mobility models notify the changes of position and velocity
+ * (e.g., the LazyNotify attribute of WaypointMobilityModel must be false).
+ */
+class MobilityGridIndex
+{
+  public:
+    MobilityGridIndex();
+    ~MobilityGridIndex();
+
+    // Delete copy constructor and assignment operator, the index being
+    // connected to the traces of the mobility models
+    MobilityGridIndex(const MobilityGridIndex&) = delete;
+    MobilityGridIndex& operator=(const MobilityGridIndex&) = delete;
+
+    /**
+     * \brief Set the size of the side of the cells, which must be positive.
+     *        This method must be called when the index is empty.
+     * \param size the size of the side of the cells, in meters
+     */
+    void SetCellSize(double size);
+    /**
+     * \return the size of the side of the cells, in meters
+     */
+    double GetCellSize() const;
+
+    /**
+     * \brief Add an object to the index. Several objects may share the same
+     *        mobility model (e.g., the devices of a node).
+     * \param mobility the mobility model of the object
+     * \param id the identifier of the object
+     */
+    void Add(Ptr<MobilityModel> mobility, uint32_t id);
+    /**
+     * \brief Remove all the objects from the index
+     */
+    void Clear();
+    /**
+     * \return the number of objects in the index
+     */
+    std::size_t GetN() const;
+
+    /**
+     * \brief Get the objects that may be within a distance of a position
+     *
+     * The candidates are the stationary objects in the cells overlapping the
+     * square of side 2 * range centered at the position (the z coordinate is
+     * ignored) and all the moving objects. The caller is expected to check the
+     * actual distance of the candidates.
+     *
+     * \param position the position
+     * \param range the distance, in meters
+     * \param ids the identifiers of the candidates, in increasing order
+     */
+    void GetCandidates(const Vector& position, double range, std::vector<uint32_t>& ids) const;
+
+  private:
+    /// The coordinates of a cell
+    using Cell = std::pair<int64_t, int64_t>;
+
+    /// Hash function of the coordinates of a cell
+    struct CellHash
+    {
+        /**
+         * \param cell the coordinates of a cell
+         * \return the hash of the coordinates
+         */
+        std::size_t operator()(const Cell& cell) const;
+    };
+
+    /// The objects of the index sharing a mobility model
+    struct Entry
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model of the objects
+        std::vector<uint32_t> ids;   //!< the identifiers of the objects
+        bool moving;                 //!< whether the objects are moving
+        Cell cell;                   //!< the cell of the objects, if not moving
+    };
+
+    /**
+     * \param position a position
+     * \return the cell of the position
+     */
+    Cell GetCell(const Vector& position) const;
+    /**
+     * \brief Place objects in a cell or in the list of moving objects
+     * \param entry the objects
+     */
+    void Insert(Entry& entry);
+    /**
+     * \brief Remove objects from their cell or from the list of moving objects
+     * \param entry the objects
+     */
+    void Erase(const Entry& entry);
+    /**
+     * \brief Update the place of an object whose course changed
+     * \param mobility the mobility model of the object
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize; //!< the size of the side of the cells
+    bool m_updating;   //!< whether an object is being placed
+    std::size_t m_n;   //!< the number of objects in the index
+    /// The objects of the index, by mobility model
+    std::unordered_map<const MobilityModel*, Entry> m_entries;
+    /// The stationary objects, by cell
+    std::unordered_map<Cell, std::vector<uint32_t>, CellHash> m_cells;
+    std::vector<uint32_t> m_moving; //!< the moving objects
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_INDEX_H */
@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/mobility-grid-index.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Mobility grid index test
+ *
+ * Stationary and moving objects, some of them sharing the same mobility model,
+ * are placed at random positions and some of the stationary objects are moved
+ * over time. At regular intervals, the objects within a distance of random
+ * positions, found by computing the distance to all the objects, must be among
+ * the candidates returned by the index.
+ */
+class MobilityGridIndexTest : public TestCase
+{
+  public:
+    MobilityGridIndexTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Check that the candidates include the objects within range of random positions
+     */
+    void CheckCandidates();
+
+    std::vector<Ptr<MobilityModel>> m_objects; ///< the mobility models of the objects
+    MobilityGridIndex m_index;                 ///< the index
+    Ptr<UniformRandomVariable> m_rng;          ///< random variable for the positions
+    std::size_t m_inRange;                     ///< number of objects found within range
+    std::size_t m_candidates;                  ///< number of candidates
+};
+
+MobilityGridIndexTest::MobilityGridIndexTest()
+    : TestCase("Check the candidates returned by the mobility grid index"),
+      m_inRange(0),
+      m_candidates(0)
+{
+}
+
+void
+MobilityGridIndexTest::CheckCandidates()
+{
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        Vector position(m_rng->GetValue(-1000, 1000), m_rng->GetValue(-1000, 1000), 0);
+        double range = m_rng->GetValue(10, 400);
+        m_index.GetCandidates(position, range, ids);
+        NS_TEST_ASSERT_MSG_EQ(std::is_sorted(ids.begin(), ids.end()),
+                              true,
+                              "The candidates must be sorted");
+        m_candidates += ids.size();
+        for (uint32_t id = 0; id < m_objects.size(); id++)
+        {
+            Vector other = m_objects[id]->GetPosition();
+            other.z = position.z;
+            if (CalculateDistance(position, other) <= range)
+            {
+                m_inRange++;
+                NS_TEST_ASSERT_MSG_EQ(std::binary_search(ids.begin(), ids.end(), id),
+                                      true,
+                                      "Object " << id << " within range is not a candidate");
+            }
+        }
+    }
+}
+
+void
+MobilityGridIndexTest::DoRun()
+{
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+    m_index.SetCellSize(50);
+
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        Ptr<MobilityModel> mobility;
+        if (i % 10 == 0)
+        {
+            Ptr<ConstantVelocityMobilityModel> moving =
+                CreateObject<ConstantVelocityMobilityModel>();
+            moving->SetVelocity(Vector(m_rng->GetValue(-50, 50), m_rng->GetValue(-50, 50), 0));
+            mobility = moving;
+        }
+        else
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        mobility->SetPosition(
+            Vector(m_rng->GetValue(-1000, 1000), m_rng->GetValue(-1000, 1000), 0));
+        m_objects.push_back(mobility);
+        m_index.Add(mobility, i);
+    }
+    // objects sharing the mobility model of a stationary and of a moving object
+    for (uint32_t i : {3, 10})
+    {
+        m_objects.push_back(m_objects[i]);
+        m_index.Add(m_objects[i], m_objects.size() - 1);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_index.GetN(), 502, "Unexpected number of objects in the index");
+
+    for (uint32_t t = 0; t < 10; t++)
+    {
+        Simulator::Schedule(Seconds(t), &MobilityGridIndexTest::CheckCandidates, this);
+        // relocate some stationary objects and stop or start some moving objects
+        for (uint32_t i = 1; i < m_objects.size(); i += 37)
+        {
+            Ptr<MobilityModel> mobility = m_objects[(i + t) % m_objects.size()];
+            Simulator::Schedule(Seconds(t + 0.5), [this, mobility]() {
+                mobility->SetPosition(
+                    Vector(m_rng->GetValue(-1000, 1000), m_rng->GetValue(-1000, 1000), 0));
+                if (auto moving = DynamicCast<ConstantVelocityMobilityModel>(mobility))
+                {
+                    moving->SetVelocity(moving->GetVelocity().GetLength() == 0
+                                            ? Vector(10, 0, 0)
+                                            : Vector(0, 0, 0));
+                }
+            });
+        }
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_GT(m_inRange, 0, "No object found within range");
+    NS_TEST_EXPECT_MSG_LT(m_candidates,
+                          200 * m_objects.size(),
+                          "The index must not return all the objects as candidates");
+
+    m_index.Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_index.GetN(), 0, "The index must be empty");
+    m_objects.clear();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Mobility grid index test suite
+ */
+class MobilityGridIndexTestSuite : public TestSuite
+{
+  public:
+    MobilityGridIndexTestSuite();
+};
+
+MobilityGridIndexTestSuite::MobilityGridIndexTestSuite()
+    : TestSuite("mobility-grid-index", UNIT)
+{
+    AddTestCase(new MobilityGridIndexTest, TestCase::QUICK);
+}
+
+static MobilityGridIndexTestSuite g_mobilityGridIndexTestSuite; ///< the test suite
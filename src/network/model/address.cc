@@ -25,6 +25,7 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <string_view>
 
 namespace ns3
 {
@@ -298,4 +299,13 @@ operator>>(std::istream& is, Address& address)
     return is;
 }
 
+size_t
+AddressHash::operator()(const Address& x) const
+{
+    uint8_t buffer[Address::MAX_SIZE];
+    uint32_t len = x.CopyTo(buffer);
+    return std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(buffer), len));
+}
+
 } // namespace ns3
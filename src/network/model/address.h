@@ -290,6 +290,25 @@ bool operator<(const Address& a, const Address& b);
 std::ostream& operator<<(std::ostream& os, const Address& address);
 std::istream& operator>>(std::istream& is, Address& address);
 
+/**
+ * \ingroup address
+ *
+ * \brief Class providing an hash for Address instances
+ *
+ * Only the address value is hashed: addresses of different types compare
+ * equal when either type is unknown.
+ */
+class AddressHash
+{
+  public:
+    /**
+     * \brief Returns the hash of an address.
+     * \param x the address
+     * \return the hash
+     */
+    size_t operator()(const Address& x) const;
+};
+
 } // namespace ns3
 
 #endif /* ADDRESS_H */
@@ -78,7 +78,10 @@ QueueDiscItem::QueueDiscItem(Ptr<Packet> p, const Address& addr, uint16_t protoc
     : QueueItem(p),
       m_address(addr),
       m_protocol(protocol),
-      m_txq(0)
+      m_txq(0),
+      m_flowHash(0),
+      m_flowHashPerturbation(0),
+      m_flowHashValid(false)
 {
     NS_LOG_FUNCTION(this << p << addr << protocol);
 }
@@ -146,4 +149,24 @@ QueueDiscItem::Hash(uint32_t perturbation) const
     return 0;
 }
 
+uint32_t
+QueueDiscItem::GetFlowHash(uint32_t perturbation) const
+{
+    NS_LOG_FUNCTION(this << perturbation);
+
+    if (!m_flowHashValid || m_flowHashPerturbation != perturbation)
+    {
+        m_flowHash = Hash(perturbation);
+        m_flowHashPerturbation = perturbation;
+        m_flowHashValid = true;
+    }
+    return m_flowHash;
+}
+
+Ptr<QueueDiscItem>
+QueueDiscItem::PopSegment()
+{
+    return nullptr;
+}
+
 } // namespace ns3
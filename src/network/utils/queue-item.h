@@ -217,11 +217,45 @@ class QueueDiscItem : public QueueItem
      */
     virtual uint32_t Hash(uint32_t perturbation = 0) const;
 
+    /**
+     * \brief Get the hash of the flow of the packet
+     *
+     * The hash is computed by the Hash method the first time it is requested
+     * (for a given perturbation value) and then cached in this item, so that the
+     * packet filters and the queue discs handling this item do not parse the
+     * packet headers again. Hence, the fields of the packet header used by the
+     * Hash method must not be modified after the hash is computed.
+     *
+     * \param perturbation hash perturbation value
+     * \return the hash of the flow of the packet
+     */
+    uint32_t GetFlowHash(uint32_t perturbation = 0) const;
+
+    /**
+     * \brief Detach the first segment of a packet built for segmentation offload
+     *
+     * A transport protocol may hand down a packet carrying several segments
+     * (see GsoTag), which is split right before being sent to the device. This
+     * method removes the first segment from the packet of this item and returns
+     * it as a new item, ready to be sent to the device. When the remaining
+     * packet is made of a single segment, a null pointer is returned and this
+     * item holds the last segment.
+     *
+     * This method just returns a null pointer. Subclasses should implement it
+     * if their protocol type supports segmentation offload.
+     *
+     * \return the item holding the first segment, or a null pointer
+     */
+    virtual Ptr<QueueDiscItem> PopSegment();
+
   private:
-    Address m_address;   //!< MAC destination address
-    uint16_t m_protocol; //!< L3 Protocol number
-    uint8_t m_txq;       //!< Transmission queue index
-    Time m_tstamp;       //!< timestamp when the packet was enqueued
+    Address m_address;                       //!< MAC destination address
+    uint16_t m_protocol;                     //!< L3 Protocol number
+    uint8_t m_txq;                           //!< Transmission queue index
+    Time m_tstamp;                           //!< timestamp when the packet was enqueued
+    mutable uint32_t m_flowHash;             //!< cached hash of the flow
+    mutable uint32_t m_flowHashPerturbation; //!< perturbation of the cached hash
+    mutable bool m_flowHashValid;            //!< whether the hash of the flow is cached
 };
 
 } // namespace ns3
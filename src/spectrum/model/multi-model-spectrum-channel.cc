@@ -38,7 +38,9 @@
 #include <ns3/spectrum-transmit-filter.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <utility>
 
 namespace ns3
@@ -81,7 +83,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_indexValid{false}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,6 +95,8 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_index.Clear();
+    m_rxMobility.clear();
     SpectrumChannel::DoDispose();
 }
 
@@ -102,8 +107,37 @@ MultiModelSpectrumChannel::GetTypeId()
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
                             .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+            .AddAttribute("MaxRange",
+                          "The maximum distance (in meters) between the transmitter and the "
+                          "receivers of a signal. If 0, the signal is considered for all the "
+                          "receivers. Otherwise, the receivers within this distance are found "
+                          "by means of a spatial index of the receivers, and the other receivers "
+                          "are culled without computing their path loss.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&MultiModelSpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("RxPowerFloor",
+                          "The minimum received power (in dBm) of the receivers of a signal. "
+                          "The received power is computed from the power of the signal, the "
+                          "antenna gains and the single-frequency PropagationLossModel, before "
+                          "the signal is converted to the SpectrumModel of the receiver. The "
+                          "receivers whose received power is below this value are culled.",
+                          DoubleValue(-std::numeric_limits<double>::infinity()),
+                          MakeDoubleAccessor(&MultiModelSpectrumChannel::m_rxPowerFloorDbm),
+                          MakeDoubleChecker<double>(-std::numeric_limits<double>::infinity()))
+            .AddTraceSource("CulledReceivers",
+                            "This trace is fired whenever a signal is transmitted, with the "
+                            "number of receivers culled because of their distance (MaxRange), "
+                            "their received power (RxPowerFloor) or their loss (MaxLossDb).",
+                            MakeTraceSourceAccessor(
+                                &MultiModelSpectrumChannel::m_culledReceiversTrace),
+                            "ns3::MultiModelSpectrumChannel::ReceiversTracedCallback")
+            .AddTraceSource("EvaluatedReceivers",
+                            "This trace is fired whenever a signal is transmitted, with the "
+                            "number of receivers to which the signal is delivered.",
+                            MakeTraceSourceAccessor(
+                                &MultiModelSpectrumChannel::m_evaluatedReceiversTrace),
+                            "ns3::MultiModelSpectrumChannel::ReceiversTracedCallback");
     return tid;
 }
 
@@ -127,6 +161,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            m_indexValid = false;
             break; // there should be at most one entry
         }
     }
@@ -148,6 +183,7 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     RemoveRx(phy);
 
     ++m_numDevices;
+    m_indexValid = false;
 
     auto [rxInfoIterator, inserted] =
         m_rxSpectrumModelInfoMap.emplace(rxSpectrumModelUid, RxSpectrumModelInfo(rxSpectrumModel));
@@ -257,23 +293,45 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
 
+    // the receivers out of range are flagged by means of the spatial index
+    bool cull = (m_maxRange > 0 && txMobility);
+    if (cull)
+    {
+        if (!m_indexValid || m_index.GetCellSize() != m_maxRange)
+        {
+            UpdateIndex();
+        }
+        m_index.GetCandidates(txMobility->GetPosition(), m_maxRange, m_candidates);
+        for (auto id : m_candidates)
+        {
+            if (txMobility->GetDistanceFrom(m_rxMobility[id]) <= m_maxRange)
+            {
+                m_rxInRange[id] = true;
+            }
+        }
+    }
+
+    double txPowerDbm = 0;
+    bool checkRxPower = (m_rxPowerFloorDbm > -std::numeric_limits<double>::infinity());
+    if (checkRxPower)
+    {
+        txPowerDbm = 10 * std::log10(Integral(*txParams->psd)) + 30;
+    }
+
+    uint32_t culled = 0;
+    uint32_t evaluated = 0;
+    // the receivers are identified by their position in m_rxSpectrumModelInfoMap
+    uint32_t rxId = 0;
     for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
-         ++rxInfoIterator)
+         rxId += rxInfoIterator->second.m_rxPhys.size(), ++rxInfoIterator)
     {
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
-        Ptr<SpectrumValue> convertedTxPowerSpectrum;
-        if (txSpectrumModelUid == rxSpectrumModelUid)
+        const SpectrumConverter* converter = nullptr;
+        if (txSpectrumModelUid != rxSpectrumModelUid)
         {
-            NS_LOG_LOGIC("no spectrum conversion needed");
-            convertedTxPowerSpectrum = txParams->psd;
-        }
-        else
-        {
-            NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
-                         << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
             SpectrumConverterMap_t::const_iterator rxConverterIterator =
                 txInfoIteratorerator->second.m_spectrumConverterMap.find(rxSpectrumModelUid);
             if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end())
@@ -281,12 +339,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
                 continue;
             }
-            convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
+            converter = &rxConverterIterator->second;
         }
+        // the TX power spectrum is converted when a receiver is found within range
+        Ptr<SpectrumValue> convertedTxPowerSpectrum;
 
+        uint32_t id = rxId;
         for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
              rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+             ++rxPhyIterator, ++id)
         {
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
@@ -294,6 +355,12 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
             if ((*rxPhyIterator) != txParams->txPhy)
             {
+                if (cull && !m_rxInRange[id])
+                {
+                    culled++;
+                    continue;
+                }
+
                 Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
                 Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
@@ -314,10 +381,8 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     continue;
                 }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
                 Time delay = MicroSeconds(0);
+                double pathGainLinear = 1;
 
                 Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
 
@@ -327,10 +392,10 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     double rxAntennaGain = 0;
                     double propagationGainDb = 0;
                     double pathLossDb = 0;
-                    if (rxParams->txAntenna)
+                    if (txParams->txAntenna)
                     {
                         Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                        txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
                         NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
                         pathLossDb -= txAntennaGain;
                     }
@@ -360,13 +425,14 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                                 pathLossDb);
                     // Pathloss trace
                     m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                    if (pathLossDb > m_maxLossDb)
+                    if (pathLossDb > m_maxLossDb ||
+                        (checkRxPower && txPowerDbm - pathLossDb < m_rxPowerFloorDbm))
                     {
                         // beyond range
+                        culled++;
                         continue;
                     }
-                    double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                    *(rxParams->psd) *= pathGainLinear;
+                    pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
 
                     if (m_propagationDelay)
                     {
@@ -374,6 +440,30 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
+                if (!convertedTxPowerSpectrum)
+                {
+                    if (converter)
+                    {
+                        NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
+                                     << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
+                        convertedTxPowerSpectrum = converter->Convert(txParams->psd);
+                    }
+                    else
+                    {
+                        NS_LOG_LOGIC("no spectrum conversion needed");
+                        convertedTxPowerSpectrum = txParams->psd;
+                    }
+                }
+
+                NS_LOG_LOGIC("copying signal parameters " << txParams);
+                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
+                if (txMobility && receiverMobility)
+                {
+                    *(rxParams->psd) *= pathGainLinear;
+                }
+                evaluated++;
+
                 if (rxNetDevice)
                 {
                     // the receiver has a NetDevice, so we expect that it is attached to a Node
@@ -398,6 +488,41 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             }
         }
     }
+
+    if (cull)
+    {
+        for (auto id : m_candidates)
+        {
+            m_rxInRange[id] = false;
+        }
+    }
+    m_culledReceiversTrace(txParams->txPhy, culled);
+    m_evaluatedReceiversTrace(txParams->txPhy, evaluated);
+}
+
+void
+MultiModelSpectrumChannel::UpdateIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_index.Clear();
+    m_index.SetCellSize(m_maxRange);
+    m_rxMobility.clear();
+    m_rxInRange.clear();
+    for (const auto& [uid, rxInfo] : m_rxSpectrumModelInfoMap)
+    {
+        for (const auto& phy : rxInfo.m_rxPhys)
+        {
+            // the receivers without mobility model are always within range
+            Ptr<MobilityModel> mobility = phy->GetMobility();
+            if (mobility)
+            {
+                m_index.Add(mobility, m_rxMobility.size());
+            }
+            m_rxInRange.push_back(!mobility);
+            m_rxMobility.push_back(mobility);
+        }
+    }
+    m_indexValid = true;
 }
 
 void
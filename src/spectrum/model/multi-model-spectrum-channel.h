@@ -20,6 +20,7 @@
 #ifndef MULTI_MODEL_SPECTRUM_CHANNEL_H
 #define MULTI_MODEL_SPECTRUM_CHANNEL_H
 
+#include <ns3/mobility-grid-index.h>
 #include <ns3/propagation-delay-model.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-converter.h>
@@ -98,6 +99,19 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * In dense deployments, the receivers that cannot detect a signal can be
+ * culled before the signal is converted to their SpectrumModel and scaled
+ * by the propagation loss, by means of two attributes:
+ * - MaxRange: the receivers farther than this distance from the transmitter,
+ *   found by means of a spatial index of the receivers (see
+ *   ns3::MobilityGridIndex), are culled without computing their path loss;
+ * - RxPowerFloor: the receivers whose received power, computed with the
+ *   single-frequency propagation loss model and the antenna gains, is below
+ *   this value are culled, like the receivers whose loss is above MaxLossDb.
+ * The CulledReceivers and EvaluatedReceivers trace sources report, for each
+ * signal, the number of receivers culled and the number of receivers to
+ * which the signal is delivered.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -119,6 +133,14 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     std::size_t GetNDevices() const override;
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
+    /**
+     * TracedCallback signature for the number of receivers of a signal.
+     *
+     * \param [in] txPhy The TX SpectrumPhy instance.
+     * \param [in] count The number of receivers.
+     */
+    typedef void (*ReceiversTracedCallback)(Ptr<const SpectrumPhy> txPhy, uint32_t count);
+
   protected:
     void DoDispose() override;
 
@@ -144,6 +166,12 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      */
     virtual void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+    /**
+     * Rebuild the spatial index of the receivers, which are identified by
+     * their position in m_rxSpectrumModelInfoMap.
+     */
+    void UpdateIndex();
+
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
      * converters to any RX SpectrumModel, and all the corresponding
@@ -162,6 +190,21 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    double m_maxRange;         //!< maximum distance of the receivers, or 0
+    double m_rxPowerFloorDbm;  //!< minimum received power of the receivers
+    bool m_indexValid;         //!< whether the spatial index matches the receivers
+    MobilityGridIndex m_index; //!< spatial index of the receivers, if m_maxRange > 0
+    /// The mobility model of each receiver, by identifier
+    std::vector<Ptr<MobilityModel>> m_rxMobility;
+    /// Whether each receiver is within range of the transmitter, by identifier
+    std::vector<bool> m_rxInRange;
+    std::vector<uint32_t> m_candidates; //!< receivers returned by the spatial index
+
+    /// The `CulledReceivers` trace source
+    TracedCallback<Ptr<const SpectrumPhy>, uint32_t> m_culledReceiversTrace;
+    /// The `EvaluatedReceivers` trace source
+    TracedCallback<Ptr<const SpectrumPhy>, uint32_t> m_evaluatedReceiversTrace;
 };
 
 } // namespace ns3
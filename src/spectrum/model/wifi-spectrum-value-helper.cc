@@ -30,6 +30,7 @@
 #include <cmath>
 #include <map>
 #include <sstream>
+#include <tuple>
 
 namespace ns3
 {
@@ -123,6 +124,96 @@ WifiSpectrumValueHelper::GetSpectrumModel(uint32_t centerFrequency,
     return ret;
 }
 
+/// The methods of WifiSpectrumValueHelper building a transmit PSD from a spectrum mask
+enum WifiTxPsdType : uint8_t
+{
+    WIFI_TX_PSD_OFDM = 0,
+    WIFI_TX_PSD_DUPLICATED_20MHZ,
+    WIFI_TX_PSD_HT_OFDM,
+    WIFI_TX_PSD_HE_OFDM,
+};
+
+/// Wifi transmit PSD structure
+struct WifiTxPsdId
+{
+    WifiTxPsdType m_type;                     ///< the method building the PSD
+    uint32_t m_centerFrequency;               ///< center frequency (in MHz)
+    uint16_t m_channelWidth;                  ///< channel width (in MHz)
+    double m_txPowerW;                        ///< transmit power (in W)
+    uint16_t m_guardBandwidth;                ///< guard band width (in MHz)
+    double m_minInnerBandDbr;                 ///< minimum power of the inner band (in dBr)
+    double m_minOuterBandDbr;                 ///< minimum power of the outer band (in dBr)
+    double m_lowestPointDbr;                  ///< maximum power of the outer band (in dBr)
+    std::vector<bool> m_puncturedSubchannels; ///< the punctured 20 MHz subchannels
+};
+
+/**
+ * Less than operator
+ * \param a the first transmit PSD to compare
+ * \param b the second transmit PSD to compare
+ * \returns true if the first transmit PSD is less than the second transmit PSD
+ */
+bool
+operator<(const WifiTxPsdId& a, const WifiTxPsdId& b)
+{
+    return std::tie(a.m_type,
+                    a.m_centerFrequency,
+                    a.m_channelWidth,
+                    a.m_txPowerW,
+                    a.m_guardBandwidth,
+                    a.m_minInnerBandDbr,
+                    a.m_minOuterBandDbr,
+                    a.m_lowestPointDbr,
+                    a.m_puncturedSubchannels) < std::tie(b.m_type,
+                                                         b.m_centerFrequency,
+                                                         b.m_channelWidth,
+                                                         b.m_txPowerW,
+                                                         b.m_guardBandwidth,
+                                                         b.m_minInnerBandDbr,
+                                                         b.m_minOuterBandDbr,
+                                                         b.m_lowestPointDbr,
+                                                         b.m_puncturedSubchannels);
+}
+
+static std::map<WifiTxPsdId, Ptr<const SpectrumValue>>
+    g_wifiTxPsdMap; ///< the transmit PSDs built so far, used as templates
+
+/// The maximum number of transmit PSDs in g_wifiTxPsdMap. The map is emptied when
+/// it is full, which only happens if the transmit power takes many different values
+static constexpr std::size_t WIFI_TX_PSD_MAP_MAX_SIZE = 256;
+
+/**
+ * \param id the parameters of a transmit PSD
+ * \return a copy of the transmit PSD previously built with the given parameters, if any
+ */
+static Ptr<SpectrumValue>
+FindTxPsd(const WifiTxPsdId& id)
+{
+    auto it = g_wifiTxPsdMap.find(id);
+    if (it == g_wifiTxPsdMap.end())
+    {
+        return nullptr;
+    }
+    NS_LOG_LOGIC("Copying the transmit PSD built for the same parameters");
+    return Copy<SpectrumValue>(it->second);
+}
+
+/**
+ * Store a copy of a transmit PSD, to be returned by FindTxPsd.
+ *
+ * \param id the parameters of the transmit PSD
+ * \param psd the transmit PSD
+ */
+static void
+AddTxPsd(WifiTxPsdId&& id, Ptr<const SpectrumValue> psd)
+{
+    if (g_wifiTxPsdMap.size() >= WIFI_TX_PSD_MAP_MAX_SIZE)
+    {
+        g_wifiTxPsdMap.clear();
+    }
+    g_wifiTxPsdMap.emplace(std::move(id), Copy<SpectrumValue>(psd));
+}
+
 // Power allocated to 71 center subbands out of 135 total subbands in the band
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(uint32_t centerFrequency,
@@ -163,6 +254,19 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(uint32_t centerFrequen
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId id{WIFI_TX_PSD_OFDM,
+                   centerFrequency,
+                   channelWidth,
+                   txPowerW,
+                   guardBandwidth,
+                   minInnerBandDbr,
+                   minOuterBandDbr,
+                   lowestPointDbr,
+                   {}};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     uint32_t carrierSpacing = 0;
     uint32_t innerSlopeWidth = 0;
     switch (channelWidth)
@@ -221,6 +325,7 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(uint32_t centerFrequen
                               lowestPointDbr);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddTxPsd(std::move(id), c);
     return c;
 }
 
@@ -237,6 +342,19 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId id{WIFI_TX_PSD_DUPLICATED_20MHZ,
+                   centerFrequency,
+                   channelWidth,
+                   txPowerW,
+                   guardBandwidth,
+                   minInnerBandDbr,
+                   minOuterBandDbr,
+                   lowestPointDbr,
+                   puncturedSubchannels};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     uint32_t carrierSpacing = 312500;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, carrierSpacing, guardBandwidth));
@@ -298,6 +416,7 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
                               lowestPointDbr);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddTxPsd(std::move(id), c);
     return c;
 }
 
@@ -312,6 +431,19 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(uint32_t centerFrequ
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId id{WIFI_TX_PSD_HT_OFDM,
+                   centerFrequency,
+                   channelWidth,
+                   txPowerW,
+                   guardBandwidth,
+                   minInnerBandDbr,
+                   minOuterBandDbr,
+                   lowestPointDbr,
+                   {}};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     uint32_t carrierSpacing = 312500;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, carrierSpacing, guardBandwidth));
@@ -364,6 +496,7 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(uint32_t centerFrequ
                               lowestPointDbr);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddTxPsd(std::move(id), c);
     return c;
 }
 
@@ -380,6 +513,19 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId id{WIFI_TX_PSD_HE_OFDM,
+                   centerFrequency,
+                   channelWidth,
+                   txPowerW,
+                   guardBandwidth,
+                   minInnerBandDbr,
+                   minOuterBandDbr,
+                   lowestPointDbr,
+                   puncturedSubchannels};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     uint32_t carrierSpacing = 78125;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, carrierSpacing, guardBandwidth));
@@ -499,6 +645,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddTxPsd(std::move(id), c);
     return c;
 }
 
@@ -796,15 +943,26 @@ WifiSpectrumValueHelper::DbmToW(double dBm)
 double
 WifiSpectrumValueHelper::GetBandPowerW(Ptr<SpectrumValue> psd, const WifiSpectrumBandIndices& band)
 {
-    double powerWattPerHertz = 0.0;
-    auto valueIt = psd->ConstValuesBegin() + band.first;
-    auto end = psd->ConstValuesBegin() + band.second;
-    auto bandIt = psd->ConstBandsBegin() + band.first;
-    while (valueIt <= end)
+    const double* values = &(*(psd->ConstValuesBegin() + band.first));
+    const std::size_t n = band.second - band.first + 1;
+    // sum the values in four independent partial sums, which lets the compiler
+    // vectorize the loop (a single sum imposes the order of the additions)
+    double partialSums[4] = {0.0, 0.0, 0.0, 0.0};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
     {
-        powerWattPerHertz += *valueIt;
-        ++valueIt;
+        partialSums[0] += values[i];
+        partialSums[1] += values[i + 1];
+        partialSums[2] += values[i + 2];
+        partialSums[3] += values[i + 3];
     }
+    double powerWattPerHertz =
+        (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+    for (; i < n; i++)
+    {
+        powerWattPerHertz += values[i];
+    }
+    auto bandIt = psd->ConstBandsBegin() + band.first;
     return powerWattPerHertz * (bandIt->fh - bandIt->fl);
 }
 
@@ -0,0 +1,358 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumPhy recording the signals it receives
+ */
+class RecordingSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    // inherited from SpectrumPhy
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    uint32_t m_id{0};                           ///< identifier of the PHY
+    Ptr<MobilityModel> m_mobility;              ///< mobility model
+    Ptr<const SpectrumModel> m_rxSpectrumModel; ///< RX spectrum model
+    /// The received power (W) and the distance (m) of the signals, by transmitter
+    std::map<uint32_t, std::pair<double, double>> m_receptions;
+};
+
+TypeId
+RecordingSpectrumPhy::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::RecordingSpectrumPhy")
+                            .SetParent<SpectrumPhy>()
+                            .SetGroupName("Spectrum")
+                            .AddConstructor<RecordingSpectrumPhy>();
+    return tid;
+}
+
+void
+RecordingSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+RecordingSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+RecordingSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+RecordingSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+RecordingSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+RecordingSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+RecordingSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+RecordingSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    Ptr<RecordingSpectrumPhy> tx = DynamicCast<RecordingSpectrumPhy>(params->txPhy);
+    m_receptions[tx->m_id] = {Integral(*params->psd),
+                              tx->m_mobility->GetDistanceFrom(m_mobility)};
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the culling of the receivers by MultiModelSpectrumChannel
+ *
+ * Each of 100 PHYs, half of them using a SpectrumModel different from the
+ * SpectrumModel of the transmitted signals and some of them moving, transmits
+ * a signal. The signals received when the receivers are culled by means of the
+ * MaxRange and RxPowerFloor attributes must be the signals received without
+ * culling, except those from transmitters farther than MaxRange or received
+ * with a power lower than RxPowerFloor.
+ */
+class MultiModelSpectrumChannelCullingTestCase : public TestCase
+{
+  public:
+    MultiModelSpectrumChannelCullingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// The received power (W) and the distance (m) of the signals, by receiver and transmitter
+    using Receptions = std::vector<std::map<uint32_t, std::pair<double, double>>>;
+
+    /**
+     * Run the simulation
+     * \param maxRange the value of the MaxRange attribute
+     * \param rxPowerFloorDbm the value of the RxPowerFloor attribute
+     * \param culled the number of culled receivers reported by the channel
+     * \param evaluated the number of evaluated receivers reported by the channel
+     * \return the signals received
+     */
+    Receptions Run(double maxRange,
+                   double rxPowerFloorDbm,
+                   uint64_t& culled,
+                   uint64_t& evaluated);
+    /**
+     * Check the signals received when the receivers are culled
+     * \param reference the signals received without culling
+     * \param receptions the signals received with culling
+     * \param maxRange the value of the MaxRange attribute
+     * \param rxPowerFloorDbm the value of the RxPowerFloor attribute
+     */
+    void Check(const Receptions& reference,
+               const Receptions& receptions,
+               double maxRange,
+               double rxPowerFloorDbm);
+};
+
+MultiModelSpectrumChannelCullingTestCase::MultiModelSpectrumChannelCullingTestCase()
+    : TestCase("Check the culling of the receivers by MultiModelSpectrumChannel")
+{
+}
+
+MultiModelSpectrumChannelCullingTestCase::Receptions
+MultiModelSpectrumChannelCullingTestCase::Run(double maxRange,
+                                              double rxPowerFloorDbm,
+                                              uint64_t& culled,
+                                              uint64_t& evaluated)
+{
+    const uint32_t nPhys = 100;
+
+    // the signals are transmitted on 20 bands of 1 MHz, which the RX spectrum
+    // model of half of the PHYs covers with 10 MHz bands
+    std::vector<double> txFrequencies;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        txFrequencies.push_back(2400.5e6 + i * 1e6);
+    }
+    Ptr<SpectrumModel> txModel = Create<SpectrumModel>(txFrequencies);
+    std::vector<double> rxFrequencies;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        rxFrequencies.push_back(2405e6 + i * 10e6);
+    }
+    Ptr<SpectrumModel> rxModel = Create<SpectrumModel>(rxFrequencies);
+    Ptr<SpectrumValue> psd = Create<SpectrumValue>(txModel);
+    for (uint32_t i = 10; i < 30; i++)
+    {
+        (*psd)[i] = 1e-9; // 13 dBm over 20 MHz
+    }
+
+    Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    channel->SetAttribute("RxPowerFloor", DoubleValue(rxPowerFloorDbm));
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    culled = 0;
+    evaluated = 0;
+    channel->TraceConnectWithoutContext(
+        "CulledReceivers",
+        Callback<void, Ptr<const SpectrumPhy>, uint32_t>(
+            [&culled](Ptr<const SpectrumPhy>, uint32_t count) { culled += count; }));
+    channel->TraceConnectWithoutContext(
+        "EvaluatedReceivers",
+        Callback<void, Ptr<const SpectrumPhy>, uint32_t>(
+            [&evaluated](Ptr<const SpectrumPhy>, uint32_t count) { evaluated += count; }));
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::vector<Ptr<RecordingSpectrumPhy>> phys;
+    for (uint32_t i = 0; i < nPhys; i++)
+    {
+        Ptr<RecordingSpectrumPhy> phy = CreateObject<RecordingSpectrumPhy>();
+        phy->m_id = i;
+        phy->m_rxSpectrumModel = (i % 2 ? rxModel : txModel);
+        if (i % 5 == 0)
+        {
+            Ptr<ConstantVelocityMobilityModel> mobility =
+                CreateObject<ConstantVelocityMobilityModel>();
+            mobility->SetVelocity(Vector(rng->GetValue(-50, 50), rng->GetValue(-50, 50), 0));
+            phy->m_mobility = mobility;
+        }
+        else
+        {
+            phy->m_mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        phy->m_mobility->SetPosition(Vector(rng->GetValue(0, 1000), rng->GetValue(0, 1000), 0));
+        channel->AddRx(phy);
+        phys.push_back(phy);
+
+        Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+        params->txPhy = phy;
+        params->psd = psd;
+        params->duration = MicroSeconds(100);
+        Simulator::Schedule(MilliSeconds(10 * i), &SpectrumChannel::StartTx, channel, params);
+    }
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Receptions receptions;
+    for (const auto& phy : phys)
+    {
+        receptions.push_back(phy->m_receptions);
+    }
+    return receptions;
+}
+
+void
+MultiModelSpectrumChannelCullingTestCase::Check(const Receptions& reference,
+                                                const Receptions& receptions,
+                                                double maxRange,
+                                                double rxPowerFloorDbm)
+{
+    for (std::size_t rx = 0; rx < reference.size(); rx++)
+    {
+        for (const auto& [tx, reception] : receptions[rx])
+        {
+            auto it = reference[rx].find(tx);
+            NS_TEST_ASSERT_MSG_EQ((it != reference[rx].end()),
+                                  true,
+                                  "Unexpected signal from " << tx << " received by " << rx);
+            NS_TEST_EXPECT_MSG_EQ_TOL(reception.first,
+                                      it->second.first,
+                                      it->second.first * 1e-9,
+                                      "Unexpected power of the signal from " << tx << " to "
+                                                                             << rx);
+        }
+        for (const auto& [tx, reception] : reference[rx])
+        {
+            double rxPowerDbm = 10 * std::log10(reception.first) + 30;
+            bool inRange = (maxRange == 0 || reception.second < maxRange - 1e-3) &&
+                           rxPowerDbm > rxPowerFloorDbm + 1e-3;
+            bool outOfRange = (maxRange > 0 && reception.second > maxRange + 1e-3) ||
+                              rxPowerDbm < rxPowerFloorDbm - 1e-3;
+            bool received = (receptions[rx].count(tx) != 0);
+            if (inRange)
+            {
+                NS_TEST_EXPECT_MSG_EQ(received,
+                                      true,
+                                      "Signal from " << tx << " not received by " << rx);
+            }
+            else if (outOfRange)
+            {
+                NS_TEST_EXPECT_MSG_EQ(received,
+                                      false,
+                                      "Signal from " << tx << " received by " << rx);
+            }
+        }
+    }
+}
+
+void
+MultiModelSpectrumChannelCullingTestCase::DoRun()
+{
+    const double noFloor = -std::numeric_limits<double>::infinity();
+    uint64_t culled;
+    uint64_t evaluated;
+    Receptions reference = Run(0, noFloor, culled, evaluated);
+    NS_TEST_EXPECT_MSG_EQ(culled, 0, "No receiver must be culled");
+    NS_TEST_EXPECT_MSG_EQ(evaluated, 100 * 99, "All the receivers must be evaluated");
+
+    struct Config
+    {
+        double maxRange;        //!< the value of the MaxRange attribute
+        double rxPowerFloorDbm; //!< the value of the RxPowerFloor attribute
+    };
+
+    for (const auto& config : std::vector<Config>{{300, noFloor}, {0, -90}, {500, -85}})
+    {
+        Receptions receptions = Run(config.maxRange, config.rxPowerFloorDbm, culled, evaluated);
+        uint64_t received = 0;
+        for (const auto& rxReceptions : receptions)
+        {
+            received += rxReceptions.size();
+        }
+        NS_TEST_EXPECT_MSG_GT(culled, 0, "Some receivers must be culled");
+        NS_TEST_EXPECT_MSG_EQ(evaluated, received, "Unexpected number of evaluated receivers");
+        NS_TEST_EXPECT_MSG_EQ(culled + evaluated,
+                              100 * 99,
+                              "Unexpected number of culled and evaluated receivers");
+        Check(reference, receptions, config.maxRange, config.rxPowerFloorDbm);
+    }
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief MultiModelSpectrumChannel test suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelTestSuite();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite()
+    : TestSuite("multi-model-spectrum-channel", UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelCullingTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
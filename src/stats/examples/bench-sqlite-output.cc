@@ -0,0 +1,170 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the insertion of per-packet rows in an SQLite
+// database: the rows are inserted one statement step at a time, either
+// with a transaction per row (the default of SQLite) or with all the rows
+// in a single transaction, then with an SQLiteBatchWriter, writing the
+// rows in the simulation thread or in a background thread.  Since a
+// transaction per row is very slow, 'row-rows' rows are inserted in that
+// case only.
+// Sample usage:  ./ns3 run 'bench-sqlite-output --rows=1000000 --batch=10000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/nstime.h"
+#include "ns3/sqlite-batch-writer.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/// The ways of inserting the rows
+enum Mode
+{
+    ROW_TRANSACTIONS,   //!< One statement step and one transaction per row
+    SINGLE_TRANSACTION, //!< One statement step per row, in a single transaction
+    BATCH_WRITER,       //!< SQLiteBatchWriter
+    BACKGROUND_WRITER,  //!< SQLiteBatchWriter with a background thread
+};
+
+/**
+ * Insert the rows in a new database.
+ *
+ * \param file the database file
+ * \param mode the way of inserting the rows
+ * \param rows the number of rows
+ * \param batch the number of rows per transaction of the batch writer
+ * \return the time elapsed, in ms
+ */
+static int64_t
+Run(const std::string& file, Mode mode, uint32_t rows, uint32_t batch)
+{
+    std::remove(file.c_str());
+    Ptr<SQLiteOutput> db = Create<SQLiteOutput>(file);
+    db->SpinExec("CREATE TABLE Packets (time, flow, node, size, event)");
+    std::string insert = "INSERT INTO Packets VALUES (?, ?, ?, ?, ?)";
+    std::string event = "rx";
+
+    SystemWallClockMs time;
+    time.Start();
+    if (mode == ROW_TRANSACTIONS || mode == SINGLE_TRANSACTION)
+    {
+        sqlite3_stmt* stmt;
+        NS_ABORT_MSG_UNLESS(db->SpinPrepare(&stmt, insert), "Failed to prepare " << insert);
+        if (mode == SINGLE_TRANSACTION)
+        {
+            db->SpinExec("BEGIN");
+        }
+        for (uint32_t i = 0; i < rows; i++)
+        {
+            SQLiteOutput::SpinReset(stmt);
+            db->Bind(stmt, 1, MicroSeconds(i));
+            db->Bind(stmt, 2, i % 1000);
+            db->Bind(stmt, 3, i % 64);
+            db->Bind(stmt, 4, 1500U);
+            db->Bind(stmt, 5, event);
+            SQLiteOutput::SpinStep(stmt);
+        }
+        if (mode == SINGLE_TRANSACTION)
+        {
+            db->SpinExec("COMMIT");
+        }
+        SQLiteOutput::SpinFinalize(stmt);
+    }
+    else
+    {
+        Ptr<SQLiteBatchWriter> writer =
+            Create<SQLiteBatchWriter>(db, batch, mode == BACKGROUND_WRITER);
+        uint32_t stmt = writer->Prepare(insert);
+        for (uint32_t i = 0; i < rows; i++)
+        {
+            writer->Insert(stmt, MicroSeconds(i), i % 1000, i % 64, 1500U, event);
+        }
+        writer->Flush();
+    }
+    int64_t delay = time.End();
+
+    sqlite3_stmt* stmt;
+    db->WaitPrepare(&stmt, "SELECT COUNT(*) FROM Packets");
+    SQLiteOutput::SpinStep(stmt);
+    NS_ABORT_MSG_UNLESS(db->RetrieveColumn<uint32_t>(stmt, 0) == rows, "Rows not inserted");
+    SQLiteOutput::SpinFinalize(stmt);
+    return delay;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t rows = 1000000;
+    uint32_t rowRows = 1000;
+    uint32_t batch = 10000;
+    std::string file = "bench-sqlite-output.db";
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the insertion of rows in an SQLite database");
+    cmd.AddValue("rows", "number of rows inserted", rows);
+    cmd.AddValue("row-rows", "number of rows inserted with a transaction per row", rowRows);
+    cmd.AddValue("batch", "number of rows per transaction of the batch writer", batch);
+    cmd.AddValue("file", "database file, overwritten", file);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(rows == 0 || rowRows == 0, "At least one row must be inserted");
+    NS_ABORT_MSG_IF(batch == 0, "The batches must hold at least one row");
+
+    std::cout << "Running bench-sqlite-output with rows=" << rows << " row-rows=" << rowRows
+              << " batch=" << batch << std::endl;
+
+    for (Mode mode : {ROW_TRANSACTIONS, SINGLE_TRANSACTION, BATCH_WRITER, BACKGROUND_WRITER})
+    {
+        uint32_t n = (mode == ROW_TRANSACTIONS ? rowRows : rows);
+        int64_t minDelay = std::numeric_limits<int64_t>::max();
+        for (uint32_t i = 0; i < minIterations; i++)
+        {
+            minDelay = std::min(minDelay, Run(file, mode, n, batch));
+        }
+        const char* names[] = {"row-transactions", "single-transaction", "batch", "background"};
+        Report(names[mode], n, minDelay);
+    }
+    std::remove(file.c_str());
+    return 0;
+}
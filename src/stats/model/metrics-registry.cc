@@ -0,0 +1,542 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "metrics-registry.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MetricsRegistry");
+
+NS_OBJECT_ENSURE_REGISTERED(MetricsRegistry);
+
+namespace internal
+{
+
+uint32_t
+AllocateMetricsThreadIndex()
+{
+    static std::atomic<uint32_t> nextIndex{1};
+    return nextIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace internal
+
+namespace
+{
+
+/**
+ * \ingroup stats
+ * Statistical summary of a histogram, to export it with
+ * DataOutputCallback::OutputStatistic.
+ */
+class HistogramSummary : public StatisticalSummary
+{
+  public:
+    /**
+     * Constructor
+     * \param histogram the histogram
+     */
+    HistogramSummary(const MetricHistogram& histogram)
+        : m_count(histogram.GetCount()),
+          m_sum(histogram.GetSum()),
+          m_sumSquares(histogram.GetSumSquares()),
+          m_min(histogram.GetMin()),
+          m_max(histogram.GetMax())
+    {
+    }
+
+    long getCount() const override
+    {
+        return m_count;
+    }
+
+    double getSum() const override
+    {
+        return m_sum;
+    }
+
+    double getSqrSum() const override
+    {
+        return m_sumSquares;
+    }
+
+    double getMin() const override
+    {
+        return m_min;
+    }
+
+    double getMax() const override
+    {
+        return m_max;
+    }
+
+    double getMean() const override
+    {
+        return m_count > 0 ? m_sum / m_count : NaN;
+    }
+
+    double getStddev() const override
+    {
+        return std::sqrt(getVariance());
+    }
+
+    double getVariance() const override
+    {
+        if (m_count < 2)
+        {
+            return NaN;
+        }
+        return std::max(0.0, (m_sumSquares - m_sum * m_sum / m_count) / (m_count - 1));
+    }
+
+  private:
+    uint64_t m_count;    //!< Number of observations
+    double m_sum;        //!< Sum of the observations
+    double m_sumSquares; //!< Sum of the squared observations
+    double m_min;        //!< Minimum observation
+    double m_max;        //!< Maximum observation
+};
+
+/**
+ * \ingroup stats
+ * Reset a shard of a histogram.
+ * \param shard the shard
+ * \param nLines the number of lines of the bucket counts
+ */
+void
+ResetHistogramShard(internal::MetricHistogramShard& shard, uint32_t nLines)
+{
+    shard.sum.store(0, std::memory_order_relaxed);
+    shard.sumSquares.store(0, std::memory_order_relaxed);
+    shard.min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+    shard.max.store(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+    for (uint32_t i = 0; i < nLines; i++)
+    {
+        for (auto& word : shard.buckets[i].words)
+        {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * \ingroup stats
+ * \param storage the storage of a histogram
+ * \return the number of lines of the bucket counts of each shard
+ */
+uint32_t
+GetNBucketLines(const internal::MetricHistogramStorage& storage)
+{
+    return (storage.boundaries.size() + 1 + 7) / 8;
+}
+
+/**
+ * \ingroup stats
+ * Output a count.  The callbacks have no 64-bit integer flavor, hence the
+ * counts that do not fit in 32 bits are output as doubles.
+ * \param callback the callback
+ * \param context the context
+ * \param variable the name of the count
+ * \param count the count
+ */
+void
+OutputCount(DataOutputCallback& callback,
+            const std::string& context,
+            const std::string& variable,
+            uint64_t count)
+{
+    if (count <= std::numeric_limits<uint32_t>::max())
+    {
+        callback.OutputSingleton(context, variable, static_cast<uint32_t>(count));
+    }
+    else
+    {
+        callback.OutputSingleton(context, variable, static_cast<double>(count));
+    }
+}
+
+} // namespace
+
+MetricCounter::MetricCounter(std::shared_ptr<internal::MetricCounterStorage> storage)
+    : m_storage(storage)
+{
+}
+
+uint64_t
+MetricCounter::GetValue() const
+{
+    NS_ASSERT(m_storage);
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < m_storage->nShards; i++)
+    {
+        value += m_storage->shards[i].words[0].load(std::memory_order_relaxed);
+    }
+    return value;
+}
+
+MetricGauge::MetricGauge(std::shared_ptr<internal::MetricGaugeStorage> storage)
+    : m_storage(storage)
+{
+}
+
+double
+MetricGauge::GetValue() const
+{
+    NS_ASSERT(m_storage);
+    return m_storage->value.load(std::memory_order_relaxed);
+}
+
+MetricHistogram::MetricHistogram(std::shared_ptr<internal::MetricHistogramStorage> storage)
+    : m_storage(storage)
+{
+}
+
+const std::vector<double>&
+MetricHistogram::GetBoundaries() const
+{
+    NS_ASSERT(m_storage);
+    return m_storage->boundaries;
+}
+
+uint32_t
+MetricHistogram::GetNBuckets() const
+{
+    NS_ASSERT(m_storage);
+    return m_storage->boundaries.size() + 1;
+}
+
+uint64_t
+MetricHistogram::GetBucketCount(uint32_t index) const
+{
+    NS_ASSERT(m_storage);
+    NS_ASSERT_MSG(index <= m_storage->boundaries.size(), "Bucket index out of range");
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < m_storage->nShards; i++)
+    {
+        count += m_storage->shards[i].buckets[index / 8].words[index % 8].load(
+            std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t
+MetricHistogram::GetCount() const
+{
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < GetNBuckets(); i++)
+    {
+        count += GetBucketCount(i);
+    }
+    return count;
+}
+
+double
+MetricHistogram::GetSum() const
+{
+    NS_ASSERT(m_storage);
+    double sum = 0;
+    for (uint32_t i = 0; i < m_storage->nShards; i++)
+    {
+        sum += m_storage->shards[i].sum.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+double
+MetricHistogram::GetSumSquares() const
+{
+    NS_ASSERT(m_storage);
+    double sumSquares = 0;
+    for (uint32_t i = 0; i < m_storage->nShards; i++)
+    {
+        sumSquares += m_storage->shards[i].sumSquares.load(std::memory_order_relaxed);
+    }
+    return sumSquares;
+}
+
+double
+MetricHistogram::GetMin() const
+{
+    NS_ASSERT(m_storage);
+    double min = std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < m_storage->nShards; i++)
+    {
+        min = std::min(min, m_storage->shards[i].min.load(std::memory_order_relaxed));
+    }
+    return std::isinf(min) && min > 0 ? NaN : min;
+}
+
+double
+MetricHistogram::GetMax() const
+{
+    NS_ASSERT(m_storage);
+    double max = -std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < m_storage->nShards; i++)
+    {
+        max = std::max(max, m_storage->shards[i].max.load(std::memory_order_relaxed));
+    }
+    return std::isinf(max) && max < 0 ? NaN : max;
+}
+
+TypeId
+MetricsRegistry::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MetricsRegistry")
+            .SetParent<DataCalculator>()
+            .SetGroupName("Stats")
+            .AddConstructor<MetricsRegistry>()
+            .AddAttribute("Shards",
+                          "The number of threads, minus one, that update the new metrics "
+                          "without atomic operations (the other threads share the last copy "
+                          "of the metrics).",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&MetricsRegistry::m_nShards),
+                          MakeUintegerChecker<uint32_t>(1, 1024));
+    return tid;
+}
+
+MetricsRegistry::MetricsRegistry()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ptr<MetricsRegistry>
+MetricsRegistry::GetDefault()
+{
+    static Ptr<MetricsRegistry> registry = CreateObject<MetricsRegistry>();
+    return registry;
+}
+
+void
+MetricsRegistry::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    StopExport();
+    DataCalculator::DoDispose();
+}
+
+void
+MetricsRegistry::CheckName(const std::string& name) const
+{
+    NS_ABORT_MSG_IF(m_counters.count(name) || m_gauges.count(name) || m_histograms.count(name),
+                    "The metric " << name << " already exists with another type");
+}
+
+MetricCounter
+MetricsRegistry::GetCounter(const std::string& name)
+{
+    NS_LOG_FUNCTION(this << name);
+    auto it = m_counters.find(name);
+    if (it == m_counters.end())
+    {
+        CheckName(name);
+        auto storage = std::make_shared<internal::MetricCounterStorage>();
+        storage->nShards = m_nShards;
+        storage->shards.reset(new internal::MetricLine[m_nShards]);
+        for (uint32_t i = 0; i < m_nShards; i++)
+        {
+            storage->shards[i].words[0].store(0, std::memory_order_relaxed);
+        }
+        it = m_counters.emplace(name, storage).first;
+    }
+    return MetricCounter(it->second);
+}
+
+MetricGauge
+MetricsRegistry::GetGauge(const std::string& name)
+{
+    NS_LOG_FUNCTION(this << name);
+    auto it = m_gauges.find(name);
+    if (it == m_gauges.end())
+    {
+        CheckName(name);
+        auto storage = std::make_shared<internal::MetricGaugeStorage>();
+        storage->value.store(0, std::memory_order_relaxed);
+        it = m_gauges.emplace(name, storage).first;
+    }
+    return MetricGauge(it->second);
+}
+
+MetricHistogram
+MetricsRegistry::GetHistogram(const std::string& name, const std::vector<double>& boundaries)
+{
+    NS_LOG_FUNCTION(this << name);
+    auto it = m_histograms.find(name);
+    if (it != m_histograms.end())
+    {
+        NS_ABORT_MSG_IF(it->second->boundaries != boundaries,
+                        "The histogram " << name << " already exists with other boundaries");
+        return MetricHistogram(it->second);
+    }
+    CheckName(name);
+    NS_ABORT_MSG_UNLESS(std::is_sorted(boundaries.begin(), boundaries.end()) &&
+                            std::adjacent_find(boundaries.begin(), boundaries.end()) ==
+                                boundaries.end(),
+                        "The boundaries of the histogram " << name << " are not increasing");
+    auto storage = std::make_shared<internal::MetricHistogramStorage>();
+    storage->boundaries = boundaries;
+    storage->nShards = m_nShards;
+    storage->shards.reset(new internal::MetricHistogramShard[m_nShards]);
+    uint32_t nLines = GetNBucketLines(*storage);
+    for (uint32_t i = 0; i < m_nShards; i++)
+    {
+        storage->shards[i].buckets.reset(new internal::MetricLine[nLines]);
+        ResetHistogramShard(storage->shards[i], nLines);
+    }
+    m_histograms.emplace(name, storage);
+    return MetricHistogram(storage);
+}
+
+void
+MetricsRegistry::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [name, storage] : m_counters)
+    {
+        for (uint32_t i = 0; i < storage->nShards; i++)
+        {
+            storage->shards[i].words[0].store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto& [name, storage] : m_histograms)
+    {
+        for (uint32_t i = 0; i < storage->nShards; i++)
+        {
+            ResetHistogramShard(storage->shards[i], GetNBucketLines(*storage));
+        }
+    }
+}
+
+void
+MetricsRegistry::StartExport(Ptr<DataCollector> dc, Ptr<DataOutputInterface> output, Time interval)
+{
+    NS_LOG_FUNCTION(this << dc << output << interval);
+    NS_ABORT_MSG_UNLESS(dc && output, "A DataCollector and an output are needed");
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "The export interval must be positive");
+    bool added = false;
+    for (auto it = dc->DataCalculatorBegin(); it != dc->DataCalculatorEnd(); it++)
+    {
+        added = added || (PeekPointer(*it) == this);
+    }
+    if (!added)
+    {
+        dc->AddDataCalculator(this);
+    }
+    m_exportCollector = dc;
+    m_exportOutput = output;
+    m_exportInterval = interval;
+    m_exportEvent.Cancel();
+    m_exportEvent = Simulator::Schedule(interval, &MetricsRegistry::PeriodicExport, this);
+}
+
+void
+MetricsRegistry::StopExport()
+{
+    NS_LOG_FUNCTION(this);
+    m_exportEvent.Cancel();
+    m_exportCollector = nullptr;
+    m_exportOutput = nullptr;
+}
+
+void
+MetricsRegistry::PeriodicExport()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_enabled)
+    {
+        // Each snapshot is a run of its own, whose label is suffixed with the
+        // snapshot time, so that an output writing a file per run (or rows
+        // keyed by the run) does not overwrite or mix up the snapshots
+        Time now = Simulator::Now();
+        std::ostringstream run;
+        run << m_exportCollector->GetRunLabel() << "-" << now.GetSeconds() << "s";
+        Ptr<DataCollector> snapshot = CreateObject<DataCollector>();
+        snapshot->DescribeRun(m_exportCollector->GetExperimentLabel(),
+                              m_exportCollector->GetStrategyLabel(),
+                              m_exportCollector->GetInputLabel(),
+                              run.str(),
+                              m_exportCollector->GetDescription());
+        for (auto it = m_exportCollector->MetadataBegin(); it != m_exportCollector->MetadataEnd();
+             it++)
+        {
+            snapshot->AddMetadata(it->first, it->second);
+        }
+        snapshot->AddMetadata("snapshot-time", now.GetSeconds());
+        for (auto it = m_exportCollector->DataCalculatorBegin();
+             it != m_exportCollector->DataCalculatorEnd();
+             it++)
+        {
+            snapshot->AddDataCalculator(*it);
+        }
+        m_exportOutput->Output(*snapshot);
+        snapshot->Dispose();
+    }
+    m_exportEvent = Simulator::Schedule(m_exportInterval, &MetricsRegistry::PeriodicExport, this);
+}
+
+void
+MetricsRegistry::Output(DataOutputCallback& callback) const
+{
+    NS_LOG_FUNCTION(this << &callback);
+
+    for (const auto& [name, storage] : m_counters)
+    {
+        OutputCount(callback, m_context, name, MetricCounter(storage).GetValue());
+    }
+    for (const auto& [name, storage] : m_gauges)
+    {
+        callback.OutputSingleton(m_context, name, MetricGauge(storage).GetValue());
+    }
+    for (const auto& [name, storage] : m_histograms)
+    {
+        MetricHistogram histogram(storage);
+        HistogramSummary summary(histogram);
+        callback.OutputStatistic(m_context, name, &summary);
+        uint64_t cumulativeCount = 0;
+        for (uint32_t i = 0; i < histogram.GetNBuckets(); i++)
+        {
+            cumulativeCount += histogram.GetBucketCount(i);
+            std::ostringstream variable;
+            variable << name << "-le-";
+            if (i < storage->boundaries.size())
+            {
+                variable << storage->boundaries[i];
+            }
+            else
+            {
+                variable << "inf";
+            }
+            OutputCount(callback, m_context, variable.str(), cumulativeCount);
+        }
+    }
+}
+
+} // namespace ns3
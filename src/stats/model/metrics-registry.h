@@ -0,0 +1,495 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include "data-calculator.h"
+#include "data-collector.h"
+#include "data-output-interface.h"
+
+#include "ns3/assert.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+namespace internal
+{
+
+/**
+ * \ingroup stats
+ * A cache line of 64-bit words.  The storage of the metrics of each thread
+ * is made of whole cache lines, so that the threads never write to the
+ * same cache line.
+ */
+struct alignas(64) MetricLine
+{
+    std::atomic<uint64_t> words[8]; //!< The words of the cache line
+};
+
+/**
+ * \ingroup stats
+ * Storage of a counter: one cache line per shard.
+ */
+struct MetricCounterStorage
+{
+    uint32_t nShards;                     //!< Number of shards
+    std::unique_ptr<MetricLine[]> shards; //!< Shards, one per line (first word only)
+};
+
+/**
+ * \ingroup stats
+ * Storage of a gauge: a single value in its own cache line.
+ */
+struct alignas(64) MetricGaugeStorage
+{
+    std::atomic<double> value; //!< Value of the gauge
+};
+
+/**
+ * \ingroup stats
+ * Storage of the observations of a histogram made by a thread.
+ */
+struct alignas(64) MetricHistogramShard
+{
+    std::atomic<double> sum;               //!< Sum of the observations
+    std::atomic<double> sumSquares;        //!< Sum of the squared observations
+    std::atomic<double> min;               //!< Minimum observation
+    std::atomic<double> max;               //!< Maximum observation
+    std::unique_ptr<MetricLine[]> buckets; //!< Bucket counts, packed 8 per line
+};
+
+/**
+ * \ingroup stats
+ * Storage of a histogram.
+ */
+struct MetricHistogramStorage
+{
+    std::vector<double> boundaries;                 //!< Upper bounds of the buckets
+    uint32_t nShards;                               //!< Number of shards
+    std::unique_ptr<MetricHistogramShard[]> shards; //!< Shards
+};
+
+/**
+ * \ingroup stats
+ * \return a new index for the calling thread, starting at 1
+ */
+uint32_t AllocateMetricsThreadIndex();
+
+/// Index of the calling thread plus one, or zero if not allocated yet
+inline thread_local uint32_t g_metricsThreadIndex = 0;
+
+/**
+ * \ingroup stats
+ * Get the shard of the calling thread.  The first nShards - 1 threads
+ * (normally, the simulation thread first) own a shard, which they update
+ * with plain loads and stores; the other threads share the last shard,
+ * which they update with atomic read-modify-write operations.
+ *
+ * \param nShards the number of shards
+ * \param [out] shared whether the shard is shared by several threads
+ * \return the index of the shard
+ */
+inline uint32_t
+GetMetricsShard(uint32_t nShards, bool& shared)
+{
+    if (g_metricsThreadIndex == 0)
+    {
+        g_metricsThreadIndex = AllocateMetricsThreadIndex();
+    }
+    uint32_t shard = std::min(g_metricsThreadIndex - 1, nShards - 1);
+    shared = (shard == nShards - 1);
+    return shard;
+}
+
+/**
+ * \ingroup stats
+ * Add to a metric word.
+ * \param word the word
+ * \param value the value to add
+ * \param shared whether the word may be written by several threads
+ */
+inline void
+MetricAdd(std::atomic<uint64_t>& word, uint64_t value, bool shared)
+{
+    if (shared)
+    {
+        word.fetch_add(value, std::memory_order_relaxed);
+    }
+    else
+    {
+        word.store(word.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * \ingroup stats
+ * Update a floating point metric word.
+ * \param word the word
+ * \param value the operand
+ * \param shared whether the word may be written by several threads
+ * \param op the operation
+ */
+template <typename Op>
+inline void
+MetricUpdate(std::atomic<double>& word, double value, bool shared, Op op)
+{
+    double old = word.load(std::memory_order_relaxed);
+    if (!shared)
+    {
+        word.store(op(old, value), std::memory_order_relaxed);
+        return;
+    }
+    while (!word.compare_exchange_weak(old, op(old, value), std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace internal
+
+/**
+ * \ingroup stats
+ *
+ * \brief Handle to a counter of a MetricsRegistry.
+ *
+ * A counter is a monotonically increasing integer, e.g., a number of
+ * packets or bytes.  Incrementing a counter costs a few instructions:
+ * each thread increments its own copy of the counter, in its own cache
+ * line, and the copies are only summed when the counter is read.
+ *
+ * The handle is a cheap, copyable reference to the counter, which stays
+ * valid even if the registry is destroyed.  A default-constructed handle
+ * refers to no counter and must not be used.
+ */
+class MetricCounter
+{
+  public:
+    MetricCounter() = default;
+
+    /**
+     * \brief Increment the counter
+     * \param value the increment
+     */
+    void Increment(uint64_t value = 1)
+    {
+        NS_ASSERT(m_storage);
+        bool shared;
+        uint32_t shard = internal::GetMetricsShard(m_storage->nShards, shared);
+        internal::MetricAdd(m_storage->shards[shard].words[0], value, shared);
+    }
+
+    /**
+     * \return the value of the counter, summed over all the threads
+     */
+    uint64_t GetValue() const;
+
+  private:
+    friend class MetricsRegistry;
+
+    /**
+     * \brief Constructor
+     * \param storage the storage of the counter
+     */
+    MetricCounter(std::shared_ptr<internal::MetricCounterStorage> storage);
+
+    std::shared_ptr<internal::MetricCounterStorage> m_storage; //!< Storage of the counter
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Handle to a gauge of a MetricsRegistry.
+ *
+ * A gauge is a value that goes up and down, e.g., a queue length.  Unlike
+ * counters, gauges are not replicated per thread: setting a gauge is a
+ * single store, while adding to a gauge is an atomic operation.
+ */
+class MetricGauge
+{
+  public:
+    MetricGauge() = default;
+
+    /**
+     * \brief Set the value of the gauge
+     * \param value the value
+     */
+    void Set(double value)
+    {
+        NS_ASSERT(m_storage);
+        m_storage->value.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Add to the value of the gauge
+     * \param value the value to add, possibly negative
+     */
+    void Add(double value)
+    {
+        NS_ASSERT(m_storage);
+        internal::MetricUpdate(m_storage->value, value, true, std::plus<double>());
+    }
+
+    /**
+     * \return the value of the gauge
+     */
+    double GetValue() const;
+
+  private:
+    friend class MetricsRegistry;
+
+    /**
+     * \brief Constructor
+     * \param storage the storage of the gauge
+     */
+    MetricGauge(std::shared_ptr<internal::MetricGaugeStorage> storage);
+
+    std::shared_ptr<internal::MetricGaugeStorage> m_storage; //!< Storage of the gauge
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Handle to a histogram of a MetricsRegistry.
+ *
+ * A histogram counts observations in buckets with fixed upper bounds: the
+ * bucket \a i counts the observations not greater than the boundary \a i
+ * (and greater than the previous boundary), and the last bucket counts the
+ * observations greater than all the boundaries.  The sum, the sum of the
+ * squares, the minimum and the maximum of the observations are also
+ * tracked.  As for counters, each thread updates its own copy of the
+ * histogram.
+ */
+class MetricHistogram
+{
+  public:
+    MetricHistogram() = default;
+
+    /**
+     * \brief Add an observation to the histogram
+     * \param value the observation
+     */
+    void Observe(double value)
+    {
+        NS_ASSERT(m_storage);
+        bool shared;
+        uint32_t index = internal::GetMetricsShard(m_storage->nShards, shared);
+        internal::MetricHistogramShard& shard = m_storage->shards[index];
+        const std::vector<double>& boundaries = m_storage->boundaries;
+        std::size_t bucket = std::lower_bound(boundaries.begin(), boundaries.end(), value) -
+                             boundaries.begin();
+        internal::MetricAdd(shard.buckets[bucket / 8].words[bucket % 8], 1, shared);
+        internal::MetricUpdate(shard.sum, value, shared, std::plus<double>());
+        internal::MetricUpdate(shard.sumSquares, value * value, shared, std::plus<double>());
+        if (value < shard.min.load(std::memory_order_relaxed))
+        {
+            internal::MetricUpdate(shard.min, value, shared, [](double a, double b) {
+                return std::min(a, b);
+            });
+        }
+        if (value > shard.max.load(std::memory_order_relaxed))
+        {
+            internal::MetricUpdate(shard.max, value, shared, [](double a, double b) {
+                return std::max(a, b);
+            });
+        }
+    }
+
+    /**
+     * \return the upper bounds of the buckets
+     */
+    const std::vector<double>& GetBoundaries() const;
+    /**
+     * \return the number of buckets, i.e., the number of boundaries plus one
+     */
+    uint32_t GetNBuckets() const;
+    /**
+     * \param index the index of the bucket
+     * \return the number of observations in the bucket
+     */
+    uint64_t GetBucketCount(uint32_t index) const;
+    /**
+     * \return the number of observations
+     */
+    uint64_t GetCount() const;
+    /**
+     * \return the sum of the observations
+     */
+    double GetSum() const;
+    /**
+     * \return the sum of the squared observations
+     */
+    double GetSumSquares() const;
+    /**
+     * \return the minimum observation, or NaN if none
+     */
+    double GetMin() const;
+    /**
+     * \return the maximum observation, or NaN if none
+     */
+    double GetMax() const;
+
+  private:
+    friend class MetricsRegistry;
+
+    /**
+     * \brief Constructor
+     * \param storage the storage of the histogram
+     */
+    MetricHistogram(std::shared_ptr<internal::MetricHistogramStorage> storage);
+
+    std::shared_ptr<internal::MetricHistogramStorage> m_storage; //!< Storage of the histogram
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Registry of named counters, gauges and histograms.
+ *
+ * Unlike the other DataCalculator classes, which are fed through trace
+ * sources, the metrics of a registry are updated directly by the models,
+ * through the handles returned by GetCounter, GetGauge and GetHistogram:
+ * an update costs no virtual call and no lookup, so that the metrics can
+ * be left enabled in the models.  Each metric is replicated in up to
+ * "Shards" threads, in distinct cache lines, and the replicas are summed
+ * when the metric is read or exported.
+ *
+ * The registry is a DataCalculator: once added to a DataCollector, its
+ * metrics are exported along with the other calculators by any
+ * DataOutputInterface, e.g., SqliteDataOutput or OmnetDataOutput.  The
+ * counters and the gauges are exported as singletons, the histograms as
+ * statistics followed by the cumulative counts of their buckets, as in
+ * Prometheus: "<name>-le-<boundary>" is the number of observations less than
+ * or equal to the boundary, and "<name>-le-inf" the number of observations.
+ * StartExport exports a snapshot of the registry periodically.
+ *
+ * The registration of the metrics is not thread-safe, and should be done
+ * when the models are configured.
+ */
+class MetricsRegistry : public DataCalculator
+{
+  public:
+    MetricsRegistry();
+    ~MetricsRegistry() override;
+
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \return the registry shared by the models by default
+     */
+    static Ptr<MetricsRegistry> GetDefault();
+
+    /**
+     * \brief Get a counter, creating it if needed.
+     * \param name the name of the counter
+     * \return the counter
+     */
+    MetricCounter GetCounter(const std::string& name);
+    /**
+     * \brief Get a gauge, creating it if needed.
+     * \param name the name of the gauge
+     * \return the gauge
+     */
+    MetricGauge GetGauge(const std::string& name);
+    /**
+     * \brief Get a histogram, creating it if needed.
+     *
+     * An existing histogram must have been created with the same boundaries.
+     *
+     * \param name the name of the histogram
+     * \param boundaries the upper bounds of the buckets, in increasing order
+     * \return the histogram
+     */
+    MetricHistogram GetHistogram(const std::string& name, const std::vector<double>& boundaries);
+
+    /**
+     * \brief Reset the counters and the histograms to zero.
+     *
+     * The gauges are left unchanged.
+     */
+    void Reset();
+
+    /**
+     * \brief Export the DataCollector periodically.
+     *
+     * Every interval, while the registry is enabled, the output exports the
+     * DataCollector, which the registry is added to if needed.  Each snapshot
+     * is exported as a run of its own, labeled "<run>-<time>s" after the run
+     * label of the DataCollector and the snapshot time in seconds, which is
+     * also added to the metadata of the run as "snapshot-time".  Hence
+     * OmnetDataOutput writes a file per snapshot, and the rows written by
+     * SqliteDataOutput are keyed by the snapshot through their run column.
+     *
+     * \param dc the DataCollector
+     * \param output the output
+     * \param interval the export interval
+     */
+    void StartExport(Ptr<DataCollector> dc, Ptr<DataOutputInterface> output, Time interval);
+    /**
+     * \brief Stop the periodic export.
+     */
+    void StopExport();
+
+    /**
+     * Outputs the metrics based on the provided callback
+     * \param callback
+     */
+    void Output(DataOutputCallback& callback) const override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Check that a name is not used by a metric of another type.
+     * \param name the name of the new metric
+     */
+    void CheckName(const std::string& name) const;
+    /**
+     * \brief Export a snapshot and schedule the next one.
+     */
+    void PeriodicExport();
+
+    uint32_t m_nShards; //!< Number of shards of the new metrics
+    std::map<std::string, std::shared_ptr<internal::MetricCounterStorage>>
+        m_counters; //!< Counters
+    std::map<std::string, std::shared_ptr<internal::MetricGaugeStorage>> m_gauges; //!< Gauges
+    std::map<std::string, std::shared_ptr<internal::MetricHistogramStorage>>
+        m_histograms; //!< Histograms
+
+    Ptr<DataCollector> m_exportCollector;    //!< DataCollector exported periodically
+    Ptr<DataOutputInterface> m_exportOutput; //!< Output of the periodic export
+    Time m_exportInterval;                   //!< Interval of the periodic export
+    EventId m_exportEvent;                   //!< Next periodic export
+};
+
+} // namespace ns3
+
+#endif /* METRICS_REGISTRY_H */
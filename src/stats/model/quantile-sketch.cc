@@ -0,0 +1,326 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "quantile-sketch.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#define DEFAULT_RELATIVE_ACCURACY 0.01
+#define DEFAULT_MAX_BINS 2048
+#define MIN_INDEXABLE_VALUE 1e-12
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QuantileSketch");
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, uint32_t maxBins)
+    : m_maxBins(maxBins),
+      m_offset(0),
+      m_zeroCount(0),
+      m_count(0),
+      m_min(0),
+      m_max(0),
+      m_sum(0)
+{
+    NS_ABORT_MSG_IF(maxBins == 0, "A QuantileSketch needs at least one bin");
+    SetRelativeAccuracy(relativeAccuracy);
+}
+
+QuantileSketch::QuantileSketch()
+    : QuantileSketch(DEFAULT_RELATIVE_ACCURACY, DEFAULT_MAX_BINS)
+{
+}
+
+void
+QuantileSketch::SetRelativeAccuracy(double relativeAccuracy)
+{
+    NS_ASSERT(m_count == 0); // we can only change the accuracy if no values were added
+    NS_ABORT_MSG_IF(relativeAccuracy <= 0 || relativeAccuracy >= 1,
+                    "The relative accuracy must be in (0, 1)");
+    m_relativeAccuracy = relativeAccuracy;
+    m_logGamma = std::log((1 + relativeAccuracy) / (1 - relativeAccuracy));
+}
+
+double
+QuantileSketch::GetRelativeAccuracy() const
+{
+    return m_relativeAccuracy;
+}
+
+int32_t
+QuantileSketch::GetKey(double value) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) / m_logGamma));
+}
+
+double
+QuantileSketch::GetValue(int32_t key) const
+{
+    // the bin holds (gamma^(key-1), gamma^key]: return 2 gamma^key / (gamma + 1)
+    return 2 * std::exp(key * m_logGamma) / (std::exp(m_logGamma) + 1);
+}
+
+void
+QuantileSketch::AddToBin(int32_t key, uint64_t count)
+{
+    if (m_bins.empty())
+    {
+        m_offset = key;
+        m_bins.assign(1, 0);
+    }
+    else if (key < m_offset)
+    {
+        // the lowest bins are collapsed if the range would exceed the maximum
+        int32_t highest = m_offset + static_cast<int32_t>(m_bins.size()) - 1;
+        key = std::max<int64_t>(key, static_cast<int64_t>(highest) - m_maxBins + 1);
+        if (key < m_offset)
+        {
+            m_bins.insert(m_bins.begin(), m_offset - key, 0);
+            m_offset = key;
+        }
+    }
+    else if (key >= m_offset + static_cast<int32_t>(m_bins.size()))
+    {
+        m_bins.resize(key - m_offset + 1, 0);
+        if (m_bins.size() > m_maxBins)
+        {
+            uint32_t collapsed = m_bins.size() - m_maxBins;
+            NS_LOG_DEBUG("Collapsing the " << collapsed << " lowest bins");
+            for (uint32_t i = 0; i < collapsed; i++)
+            {
+                m_bins[collapsed] += m_bins[i];
+            }
+            m_bins.erase(m_bins.begin(), m_bins.begin() + collapsed);
+            m_offset += collapsed;
+        }
+    }
+    m_bins[std::max(key, m_offset) - m_offset] += count;
+}
+
+void
+QuantileSketch::AddValue(double value)
+{
+    NS_ASSERT_MSG(value >= 0, "Negative values are not supported");
+    if (m_count == 0)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    m_count++;
+    m_sum += value;
+
+    if (value < MIN_INDEXABLE_VALUE)
+    {
+        m_zeroCount++;
+        return;
+    }
+    AddToBin(GetKey(value), 1);
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch& other)
+{
+    NS_ABORT_MSG_IF(std::abs(m_logGamma - other.m_logGamma) > 1e-12,
+                    "Cannot merge sketches with different relative accuracies");
+    if (other.m_count == 0)
+    {
+        return;
+    }
+    if (m_count == 0)
+    {
+        m_min = other.m_min;
+        m_max = other.m_max;
+    }
+    else
+    {
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_zeroCount += other.m_zeroCount;
+
+    // add the highest bins first, so that the bins are allocated only once
+    for (uint32_t i = other.m_bins.size(); i > 0; i--)
+    {
+        if (other.m_bins[i - 1] > 0)
+        {
+            AddToBin(other.m_offset + static_cast<int32_t>(i - 1), other.m_bins[i - 1]);
+        }
+    }
+}
+
+double
+QuantileSketch::GetQuantile(double q) const
+{
+    NS_ASSERT_MSG(q >= 0 && q <= 1, "The quantile must be in [0, 1]");
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    if (q == 0)
+    {
+        return m_min;
+    }
+    if (q == 1)
+    {
+        return m_max;
+    }
+
+    double rank = q * (m_count - 1);
+    uint64_t n = m_zeroCount;
+    if (rank < n)
+    {
+        return 0;
+    }
+    for (uint32_t i = 0; i < m_bins.size(); i++)
+    {
+        n += m_bins[i];
+        if (rank < n)
+        {
+            double value = GetValue(m_offset + static_cast<int32_t>(i));
+            return std::min(std::max(value, m_min), m_max);
+        }
+    }
+    return m_max;
+}
+
+uint64_t
+QuantileSketch::GetCount() const
+{
+    return m_count;
+}
+
+double
+QuantileSketch::GetMin() const
+{
+    return m_min;
+}
+
+double
+QuantileSketch::GetMax() const
+{
+    return m_max;
+}
+
+double
+QuantileSketch::GetSum() const
+{
+    return m_sum;
+}
+
+uint32_t
+QuantileSketch::GetNBins() const
+{
+    return m_bins.size();
+}
+
+void
+QuantileSketch::Clear()
+{
+    m_bins.clear();
+    m_offset = 0;
+    m_zeroCount = 0;
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0;
+}
+
+void
+QuantileSketch::SerializeToXmlStream(std::ostream& os,
+                                     uint16_t indent,
+                                     std::string elementName,
+                                     const std::vector<double>& quantiles) const
+{
+    os << std::string(indent, ' ') << "<" << elementName << " count=\"" << m_count << "\""
+       << " min=\"" << m_min << "\""
+       << " max=\"" << m_max << "\""
+       << " relativeAccuracy=\"" << m_relativeAccuracy << "\""
+       << " >\n";
+    indent += 2;
+    for (double q : quantiles)
+    {
+        os << std::string(indent, ' ');
+        os << "<quantile"
+           << " q=\"" << q << "\""
+           << " value=\"" << GetQuantile(q) << "\""
+           << " />\n";
+    }
+    os << std::string(indent, ' ') << "<sketch>" << *this << "</sketch>\n";
+    indent -= 2;
+    os << std::string(indent, ' ') << "</" << elementName << ">\n";
+}
+
+std::ostream&
+operator<<(std::ostream& os, const QuantileSketch& sketch)
+{
+    std::streamsize precision = os.precision(17);
+    os << sketch.m_relativeAccuracy << " " << sketch.m_maxBins << " " << sketch.m_count << " "
+       << sketch.m_min << " " << sketch.m_max << " " << sketch.m_sum << " " << sketch.m_zeroCount
+       << " " << sketch.m_offset << " " << sketch.m_bins.size();
+    for (uint64_t count : sketch.m_bins)
+    {
+        os << " " << count;
+    }
+    os.precision(precision);
+    return os;
+}
+
+std::istream&
+operator>>(std::istream& is, QuantileSketch& sketch)
+{
+    double relativeAccuracy;
+    uint32_t maxBins;
+    std::size_t nBins;
+    is >> relativeAccuracy >> maxBins;
+    if (!is || maxBins == 0 || relativeAccuracy <= 0 || relativeAccuracy >= 1)
+    {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
+    QuantileSketch result(relativeAccuracy, maxBins);
+    is >> result.m_count >> result.m_min >> result.m_max >> result.m_sum >> result.m_zeroCount >>
+        result.m_offset >> nBins;
+    if (!is || nBins > maxBins)
+    {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
+    result.m_bins.resize(nBins);
+    for (std::size_t i = 0; i < nBins; i++)
+    {
+        is >> result.m_bins[i];
+    }
+    if (is)
+    {
+        sketch = result;
+    }
+    return is;
+}
+
+} // namespace ns3
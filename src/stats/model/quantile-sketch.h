@@ -0,0 +1,201 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_QUANTILE_SKETCH_H
+#define NS3_QUANTILE_SKETCH_H
+
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Compact and mergeable sketch of a distribution, to estimate its quantiles.
+ *
+ * The sketch follows the DDSketch algorithm: the values are counted in
+ * bins whose boundaries grow geometrically, i.e., bin \a k holds the values
+ * in (gamma^(k-1), gamma^k], with gamma = (1 + alpha) / (1 - alpha).  Any
+ * quantile is then estimated with a relative error of at most \a alpha,
+ * the relative accuracy of the sketch, whatever the range of the values:
+ * unlike Histogram, the tail of a distribution spanning several orders of
+ * magnitude is resolved as accurately as its body, in a few hundred bins.
+ *
+ * The number of bins is bounded by a maximum; when it is exceeded, the
+ * lowest bins are collapsed, which only affects the accuracy of the lowest
+ * quantiles.  Two sketches with the same relative accuracy can be merged,
+ * e.g., to aggregate the sketches of several flows or replications, and a
+ * sketch can be written to and read back from a stream with the << and >>
+ * operators.
+ *
+ * This class only handles non-negative values.  Values below 1e-12 are
+ * counted as zero.
+ */
+class QuantileSketch
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param relativeAccuracy the relative accuracy of the quantiles, in (0, 1)
+     * \param maxBins the maximum number of bins
+     */
+    QuantileSketch(double relativeAccuracy, uint32_t maxBins = 2048);
+    QuantileSketch();
+
+    /**
+     * \brief Set the relative accuracy.
+     *
+     * Note that you can change the relative accuracy only if the sketch is empty.
+     *
+     * \param relativeAccuracy the relative accuracy of the quantiles, in (0, 1)
+     */
+    void SetRelativeAccuracy(double relativeAccuracy);
+    /**
+     * \brief Returns the relative accuracy.
+     * \return the relative accuracy of the quantiles
+     */
+    double GetRelativeAccuracy() const;
+
+    /**
+     * \brief Add a value to the sketch
+     * \param value the value to add
+     */
+    void AddValue(double value);
+
+    /**
+     * \brief Merge another sketch into this one.
+     *
+     * Both sketches must have the same relative accuracy.
+     *
+     * \param other the sketch to merge
+     */
+    void Merge(const QuantileSketch& other);
+
+    /**
+     * \brief Returns the estimate of a quantile.
+     * \param q the quantile, in [0, 1]
+     * \return the estimate of the quantile, or zero if the sketch is empty
+     */
+    double GetQuantile(double q) const;
+
+    /**
+     * \brief Returns the number of values added to the sketch.
+     * \return the number of values
+     */
+    uint64_t GetCount() const;
+    /**
+     * \brief Returns the minimum of the values added to the sketch.
+     * \return the minimum value, or zero if the sketch is empty
+     */
+    double GetMin() const;
+    /**
+     * \brief Returns the maximum of the values added to the sketch.
+     * \return the maximum value, or zero if the sketch is empty
+     */
+    double GetMax() const;
+    /**
+     * \brief Returns the sum of the values added to the sketch.
+     * \return the sum of the values
+     */
+    double GetSum() const;
+    /**
+     * \brief Returns the number of bins currently allocated.
+     * \return the number of bins
+     */
+    uint32_t GetNBins() const;
+
+    /**
+     * Clear the sketch content.
+     */
+    void Clear();
+
+    /**
+     * \brief Serializes the estimates of the given quantiles to an std::ostream in XML
+     * format, along with the sketch itself (see operator<<).
+     * \param os the output stream
+     * \param indent number of spaces to use as base indentation level
+     * \param elementName name of the element to serialize.
+     * \param quantiles the quantiles to serialize, in [0, 1]
+     */
+    void SerializeToXmlStream(std::ostream& os,
+                              uint16_t indent,
+                              std::string elementName,
+                              const std::vector<double>& quantiles) const;
+
+  private:
+    friend std::ostream& operator<<(std::ostream& os, const QuantileSketch& sketch);
+    friend std::istream& operator>>(std::istream& is, QuantileSketch& sketch);
+
+    /**
+     * \brief Returns the key of the bin of a value
+     * \param value the value, not lower than the minimum indexable value
+     * \return the key of the bin
+     */
+    int32_t GetKey(double value) const;
+    /**
+     * \brief Returns the value representing the bin of a key
+     * \param key the key of the bin
+     * \return the value with the least relative error to the values of the bin
+     */
+    double GetValue(int32_t key) const;
+    /**
+     * \brief Add a count to a bin, allocating (and collapsing) bins as needed
+     * \param key the key of the bin
+     * \param count the count to add
+     */
+    void AddToBin(int32_t key, uint64_t count);
+
+    double m_relativeAccuracy;    //!< Relative accuracy
+    double m_logGamma;            //!< Logarithm of the growth factor of the bins
+    uint32_t m_maxBins;           //!< Maximum number of bins
+    std::vector<uint64_t> m_bins; //!< Counts of the bins, starting at key m_offset
+    int32_t m_offset;             //!< Key of the first bin
+    uint64_t m_zeroCount;         //!< Number of values counted as zero
+    uint64_t m_count;             //!< Number of values
+    double m_min;                 //!< Minimum value
+    double m_max;                 //!< Maximum value
+    double m_sum;                 //!< Sum of the values
+};
+
+/**
+ * \brief Output streamer for QuantileSketch.
+ *
+ * The sketch is written as a single line of space-separated numbers.
+ *
+ * \param os the output stream
+ * \param sketch the sketch
+ * \returns the output stream
+ */
+std::ostream& operator<<(std::ostream& os, const QuantileSketch& sketch);
+
+/**
+ * \brief Input streamer for QuantileSketch.
+ *
+ * Reads a sketch written by operator<<.
+ *
+ * \param is the input stream
+ * \param sketch the sketch
+ * \returns the input stream
+ */
+std::istream& operator>>(std::istream& is, QuantileSketch& sketch);
+
+} // namespace ns3
+
+#endif /* NS3_QUANTILE_SKETCH_H */
@@ -0,0 +1,195 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "sqlite-batch-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SQLiteBatchWriter");
+
+/// Maximum number of full batches waiting to be written by the writing thread
+static const std::size_t MAX_PENDING_BATCHES = 2;
+
+SQLiteBatchWriter::SQLiteBatchWriter(Ptr<SQLiteOutput> db, uint32_t batchSize, bool background)
+    : m_db(db),
+      m_batchSize(batchSize),
+      m_nRows(0),
+      m_nTransactions(0),
+      m_background(background),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this << db << batchSize << background);
+    NS_ABORT_MSG_UNLESS(db, "No database to write to");
+    NS_ABORT_MSG_IF(batchSize == 0, "The batches must hold at least one row");
+    if (m_background)
+    {
+        m_thread = std::thread(&SQLiteBatchWriter::Run, this);
+    }
+}
+
+SQLiteBatchWriter::~SQLiteBatchWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    if (m_background)
+    {
+        {
+            std::unique_lock lock{m_mutex};
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+    for (sqlite3_stmt* stmt : m_statements)
+    {
+        SQLiteOutput::SpinFinalize(stmt);
+    }
+}
+
+uint32_t
+SQLiteBatchWriter::Prepare(const std::string& cmd)
+{
+    NS_LOG_FUNCTION(this << cmd);
+    // the writing thread must not use the statements while they are added
+    Flush();
+    sqlite3_stmt* stmt;
+    bool ok = m_db->SpinPrepare(&stmt, cmd);
+    NS_ABORT_MSG_UNLESS(ok, "Failed to prepare " << cmd);
+    m_statements.push_back(stmt);
+    return m_statements.size() - 1;
+}
+
+void
+SQLiteBatchWriter::Submit()
+{
+    NS_LOG_FUNCTION(this << m_batch.rows.size());
+    if (m_batch.rows.empty())
+    {
+        return;
+    }
+    if (!m_background)
+    {
+        Write(m_batch);
+        m_batch.rows.clear();
+        m_batch.fields.clear();
+        m_batch.text.clear();
+        return;
+    }
+
+    Batch batch;
+    batch.rows.reserve(m_batch.rows.capacity());
+    batch.fields.reserve(m_batch.fields.capacity());
+    std::swap(batch, m_batch);
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [this] { return m_pending.size() < MAX_PENDING_BATCHES; });
+    m_pending.push_back(std::move(batch));
+    lock.unlock();
+    m_cv.notify_all();
+}
+
+void
+SQLiteBatchWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    Submit();
+    if (m_background)
+    {
+        std::unique_lock lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_pending.empty(); });
+    }
+}
+
+uint64_t
+SQLiteBatchWriter::GetNRows() const
+{
+    std::unique_lock lock{m_mutex};
+    return m_nRows;
+}
+
+uint64_t
+SQLiteBatchWriter::GetNTransactions() const
+{
+    std::unique_lock lock{m_mutex};
+    return m_nTransactions;
+}
+
+void
+SQLiteBatchWriter::Write(const Batch& batch)
+{
+    bool ok = m_db->SpinExec("BEGIN");
+    NS_ABORT_MSG_UNLESS(ok, "Failed to begin a transaction");
+    std::size_t field = 0;
+    for (const Row& row : batch.rows)
+    {
+        sqlite3_stmt* stmt = m_statements[row.statement];
+        SQLiteOutput::SpinReset(stmt);
+        for (uint32_t i = 1; i <= row.nFields; i++, field++)
+        {
+            const Field& value = batch.fields[field];
+            switch (value.type)
+            {
+            case Field::INTEGER:
+                sqlite3_bind_int64(stmt, i, value.integer);
+                break;
+            case Field::REAL:
+                sqlite3_bind_double(stmt, i, value.real);
+                break;
+            case Field::TEXT:
+                // the batch is not modified until the transaction is committed
+                sqlite3_bind_text(stmt,
+                                  i,
+                                  batch.text.data() + value.offset,
+                                  value.length,
+                                  SQLITE_STATIC);
+                break;
+            }
+        }
+        int rc = SQLiteOutput::SpinStep(stmt);
+        NS_ABORT_MSG_UNLESS(rc == SQLITE_DONE,
+                            "Failed to insert a row: " << sqlite3_errmsg(sqlite3_db_handle(stmt)));
+    }
+    ok = m_db->SpinExec("COMMIT");
+    NS_ABORT_MSG_UNLESS(ok, "Failed to commit a transaction");
+
+    std::unique_lock lock{m_mutex};
+    m_nRows += batch.rows.size();
+    m_nTransactions++;
+}
+
+void
+SQLiteBatchWriter::Run()
+{
+    std::unique_lock lock{m_mutex};
+    while (true)
+    {
+        m_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            return;
+        }
+        // the batch stays in m_pending while it is written, so that Flush waits for it
+        const Batch& batch = m_pending.front();
+        lock.unlock();
+        Write(batch);
+        lock.lock();
+        m_pending.pop_front();
+        m_cv.notify_all();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,250 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SQLITE_BATCH_WRITER_H
+#define SQLITE_BATCH_WRITER_H
+
+#include "sqlite-output.h"
+
+#include "ns3/assert.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Buffered writer of the rows inserted in an SQLite database.
+ *
+ * Stepping a statement per row, with a transaction per row, makes the
+ * export of large amounts of data (e.g., per-packet data) dominated by
+ * the overhead of SQLite and by the synchronization of the database file.
+ * The writer instead accumulates the rows in memory, and writes them in
+ * batches of BatchSize rows, each in a single transaction, with statements
+ * prepared once.
+ *
+ * The rows are inserted with statements registered with Prepare:
+ *
+ * \code
+ *   uint32_t insert = writer->Prepare("INSERT INTO Packets (time, flow, size) VALUES (?, ?, ?)");
+ *   writer->Insert(insert, Simulator::Now(), flowId, packet->GetSize());
+ * \endcode
+ *
+ * In background mode, the batches are written by a thread of the writer,
+ * while the simulation goes on; at most two full batches are pending, so
+ * that the memory used by the writer is bounded.  In this mode, the
+ * database must not be used, other than through the writer, until Flush
+ * is called.
+ *
+ * The rows are written when a batch is full, and when Flush is called
+ * (including by the destructor).
+ */
+class SQLiteBatchWriter : public SimpleRefCount<SQLiteBatchWriter>
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param db the database
+     * \param batchSize the number of rows written per transaction
+     * \param background whether to write the rows in a background thread
+     */
+    SQLiteBatchWriter(Ptr<SQLiteOutput> db, uint32_t batchSize = 10000, bool background = false);
+
+    /**
+     * Destructor: write the pending rows.
+     */
+    ~SQLiteBatchWriter();
+
+    /**
+     * \brief Prepare a statement to insert rows.
+     * \param cmd the SQL statement, with a parameter per column
+     * \return the identifier of the statement
+     */
+    uint32_t Prepare(const std::string& cmd);
+
+    /**
+     * \brief Insert a row.
+     *
+     * The values can be integers, floating-point numbers, strings, or Time
+     * values (stored in seconds, as SQLiteOutput::Bind does).  They are
+     * copied, hence they do not need to outlive the call.
+     *
+     * \param statement the identifier of the statement returned by Prepare
+     * \param values the values of the parameters of the statement
+     */
+    template <typename... Ts>
+    void Insert(uint32_t statement, const Ts&... values)
+    {
+        NS_ASSERT_MSG(statement < m_statements.size(), "Unknown statement " << statement);
+        (Append(values), ...);
+        m_batch.rows.push_back({statement, static_cast<uint32_t>(sizeof...(Ts))});
+        if (m_batch.rows.size() >= m_batchSize)
+        {
+            Submit();
+        }
+    }
+
+    /**
+     * \brief Write all the rows inserted so far, and wait until they are written.
+     */
+    void Flush();
+
+    /**
+     * \return the number of rows written so far
+     */
+    uint64_t GetNRows() const;
+    /**
+     * \return the number of transactions committed so far
+     */
+    uint64_t GetNTransactions() const;
+
+  private:
+    /// A value of a row
+    struct Field
+    {
+        /// Type of the value
+        enum Type : uint8_t
+        {
+            INTEGER,
+            REAL,
+            TEXT,
+        };
+
+        Type type; //!< Type of the value
+
+        union {
+            int64_t integer; //!< Integer value
+            double real;     //!< Floating-point value
+            uint32_t offset; //!< Offset of the string value in the text of the batch
+        };
+
+        uint32_t length; //!< Length of the string value
+    };
+
+    /// A row of a batch
+    struct Row
+    {
+        uint32_t statement; //!< Identifier of the statement
+        uint32_t nFields;   //!< Number of values
+    };
+
+    /// A batch of rows, written in a transaction
+    struct Batch
+    {
+        std::vector<Row> rows;     //!< Rows
+        std::vector<Field> fields; //!< Values of the rows, in order
+        std::string text;          //!< Concatenation of the string values
+    };
+
+    /**
+     * \brief Append an integer value to the current row
+     * \param value the value
+     */
+    template <typename T>
+    std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>> Append(const T& value)
+    {
+        Field field;
+        field.type = Field::INTEGER;
+        field.integer = static_cast<int64_t>(value);
+        m_batch.fields.push_back(field);
+    }
+
+    /**
+     * \brief Append a floating-point value to the current row
+     * \param value the value
+     */
+    void Append(double value)
+    {
+        Field field;
+        field.type = Field::REAL;
+        field.real = value;
+        m_batch.fields.push_back(field);
+    }
+
+    /**
+     * \brief Append a Time value, in seconds, to the current row
+     * \param value the value
+     */
+    void Append(const Time& value)
+    {
+        Append(value.GetSeconds());
+    }
+
+    /**
+     * \brief Append a string value to the current row
+     * \param value the value
+     */
+    void Append(const std::string& value)
+    {
+        Field field;
+        field.type = Field::TEXT;
+        field.offset = m_batch.text.size();
+        field.length = value.size();
+        m_batch.text.append(value);
+        m_batch.fields.push_back(field);
+    }
+
+    /**
+     * \brief Append a string value to the current row
+     * \param value the value
+     */
+    void Append(const char* value)
+    {
+        Append(std::string(value));
+    }
+
+    /**
+     * \brief Hand the current batch over to the writing thread, or write it.
+     */
+    void Submit();
+    /**
+     * \brief Write a batch in a transaction.
+     * \param batch the batch
+     */
+    void Write(const Batch& batch);
+    /**
+     * \brief Main loop of the writing thread.
+     */
+    void Run();
+
+    Ptr<SQLiteOutput> m_db;                  //!< Database
+    uint32_t m_batchSize;                    //!< Number of rows written per transaction
+    std::vector<sqlite3_stmt*> m_statements; //!< Prepared statements
+    Batch m_batch;                           //!< Batch being filled
+    uint64_t m_nRows;                        //!< Number of rows written
+    uint64_t m_nTransactions;                //!< Number of transactions committed
+
+    bool m_background;            //!< Whether the batches are written by m_thread
+    std::thread m_thread;         //!< Writing thread
+    mutable std::mutex m_mutex;   //!< Mutex protecting the state shared with m_thread
+    std::condition_variable m_cv; //!< Condition variable signaling changes of m_pending
+    std::deque<Batch> m_pending;  //!< Batches waiting to be written, the first being written
+    bool m_stop;                  //!< Whether m_thread should exit
+};
+
+} // namespace ns3
+
+#endif /* SQLITE_BATCH_WRITER_H */
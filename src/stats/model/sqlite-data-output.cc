@@ -21,11 +21,13 @@
 
 #include "data-calculator.h"
 #include "data-collector.h"
+#include "sqlite-batch-writer.h"
 #include "sqlite-output.h"
 
 #include "ns3/log.h"
 #include "ns3/nstime.h"
 
+#include <limits>
 #include <sstream>
 
 namespace ns3
@@ -72,94 +74,62 @@ SqliteDataOutput::Output(DataCollector& dc)
     res = m_sqliteOut->SpinExec("CREATE TABLE IF NOT EXISTS Experiments (run, experiment, "
                                 "strategy, input, description text)");
     NS_ASSERT(res);
-
-    sqlite3_stmt* stmt;
-    res = m_sqliteOut->WaitPrepare(&stmt,
-                                   "INSERT INTO Experiments "
-                                   "(run, experiment, strategy, input, description)"
-                                   "values (?, ?, ?, ?, ?)");
-    NS_ASSERT(res);
-
-    // Create temporary strings to hold their value
-    // throughout the lifetime of the Bind and Step
-    // procedures
-    //
-    // DataCollector could return const std::string&,
-    // but that could break the python bindings
-    res = m_sqliteOut->Bind(stmt, 1, run);
-    NS_ASSERT(res);
-    std::string experimentLabel = dc.GetExperimentLabel();
-    res = m_sqliteOut->Bind(stmt, 2, experimentLabel);
-    NS_ASSERT(res);
-    std::string strategyLabel = dc.GetStrategyLabel();
-    res = m_sqliteOut->Bind(stmt, 3, strategyLabel);
-    NS_ASSERT(res);
-    std::string inputLabel = dc.GetInputLabel();
-    res = m_sqliteOut->Bind(stmt, 4, inputLabel);
-    NS_ASSERT(res);
-    std::string description = dc.GetDescription();
-    res = m_sqliteOut->Bind(stmt, 5, description);
-    NS_ASSERT(res);
-
-    res = m_sqliteOut->SpinStep(stmt);
-    NS_ASSERT(res);
-    res = m_sqliteOut->SpinFinalize(stmt);
-    NS_ASSERT(res == 0);
-
     res = m_sqliteOut->WaitExec("CREATE TABLE IF NOT EXISTS "
                                 "Metadata ( run text, key text, value)");
     NS_ASSERT(res);
-
-    res = m_sqliteOut->WaitPrepare(&stmt,
-                                   "INSERT INTO Metadata "
-                                   "(run, key, value)"
-                                   "values (?, ?, ?)");
+    res = m_sqliteOut->WaitExec("CREATE TABLE IF NOT EXISTS Singletons "
+                                "( run text, name text, variable text, value )");
     NS_ASSERT(res);
 
+    // All the rows are written in a single transaction, when the writer is flushed
+    Ptr<SQLiteBatchWriter> writer =
+        Create<SQLiteBatchWriter>(m_sqliteOut, std::numeric_limits<uint32_t>::max());
+    uint32_t insertExperiment = writer->Prepare("INSERT INTO Experiments "
+                                                "(run, experiment, strategy, input, description)"
+                                                "values (?, ?, ?, ?, ?)");
+    uint32_t insertMetadata = writer->Prepare("INSERT INTO Metadata "
+                                              "(run, key, value)"
+                                              "values (?, ?, ?)");
+    uint32_t insertSingleton = writer->Prepare("INSERT INTO Singletons "
+                                               "(run, name, variable, value)"
+                                               "values (?, ?, ?, ?)");
+
+    writer->Insert(insertExperiment,
+                   run,
+                   dc.GetExperimentLabel(),
+                   dc.GetStrategyLabel(),
+                   dc.GetInputLabel(),
+                   dc.GetDescription());
+
     for (MetadataList::iterator i = dc.MetadataBegin(); i != dc.MetadataEnd(); i++)
     {
         std::pair<std::string, std::string> blob = (*i);
-        m_sqliteOut->SpinReset(stmt);
-        m_sqliteOut->Bind(stmt, 1, run);
-        m_sqliteOut->Bind(stmt, 2, blob.first);
-        m_sqliteOut->Bind(stmt, 3, blob.second);
-        m_sqliteOut->SpinStep(stmt);
+        writer->Insert(insertMetadata, run, blob.first, blob.second);
     }
 
-    m_sqliteOut->SpinFinalize(stmt);
-
-    m_sqliteOut->SpinExec("BEGIN");
-    SqliteOutputCallback callback(m_sqliteOut, run);
+    SqliteOutputCallback callback(writer, insertSingleton, run);
     for (DataCalculatorList::iterator i = dc.DataCalculatorBegin(); i != dc.DataCalculatorEnd();
          i++)
     {
         (*i)->Output(callback);
     }
-    m_sqliteOut->SpinExec("COMMIT");
+    writer->Flush();
     // end SqliteDataOutput::Output
     m_sqliteOut->Unref();
 }
 
-SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback(const Ptr<SQLiteOutput>& db,
+SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback(const Ptr<SQLiteBatchWriter>& writer,
+                                                             uint32_t insertSingleton,
                                                              std::string run)
-    : m_db(db),
+    : m_writer(writer),
+      m_insertSingleton(insertSingleton),
       m_runLabel(run)
 {
-    NS_LOG_FUNCTION(this << db << run);
-
-    m_db->WaitExec("CREATE TABLE IF NOT EXISTS Singletons "
-                   "( run text, name text, variable text, value )");
-
-    m_db->WaitPrepare(&m_insertSingletonStatement,
-                      "INSERT INTO Singletons "
-                      "(run, name, variable, value)"
-                      "values (?, ?, ?, ?)");
-    m_db->Bind(m_insertSingletonStatement, 1, m_runLabel);
+    NS_LOG_FUNCTION(this << writer << run);
 }
 
 SqliteDataOutput::SqliteOutputCallback::~SqliteOutputCallback()
 {
-    m_db->SpinFinalize(m_insertSingletonStatement);
 }
 
 void
@@ -199,11 +169,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_writer->Insert(m_insertSingleton, m_runLabel, key, variable, val);
 }
 
 void
@@ -213,11 +179,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_writer->Insert(m_insertSingleton, m_runLabel, key, variable, val);
 }
 
 void
@@ -227,11 +189,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_writer->Insert(m_insertSingleton, m_runLabel, key, variable, val);
 }
 
 void
@@ -241,11 +199,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_writer->Insert(m_insertSingleton, m_runLabel, key, variable, val);
 }
 
 void
@@ -255,11 +209,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val.GetTimeStep());
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_writer->Insert(m_insertSingleton, m_runLabel, key, variable, val.GetTimeStep());
 }
 
 } // namespace ns3
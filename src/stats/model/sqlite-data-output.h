@@ -24,12 +24,11 @@
 
 #include "ns3/nstime.h"
 
-struct sqlite3_stmt;
-
 namespace ns3
 {
 
 class SQLiteOutput;
+class SQLiteBatchWriter;
 
 //------------------------------------------------------------
 //--------------------------------------------
@@ -63,10 +62,13 @@ class SqliteDataOutput : public DataOutputInterface
       public:
         /**
          * Constructor
-         * \param db pointer to the instance this object belongs to
+         * \param writer the writer of the rows
+         * \param insertSingleton the writer statement inserting a singleton
          * \param run experiment descriptor
          */
-        SqliteOutputCallback(const Ptr<SQLiteOutput>& db, std::string run);
+        SqliteOutputCallback(const Ptr<SQLiteBatchWriter>& writer,
+                             uint32_t insertSingleton,
+                             std::string run);
 
         /**
          * Destructor
@@ -124,11 +126,9 @@ class SqliteDataOutput : public DataOutputInterface
         void OutputSingleton(std::string key, std::string variable, Time val) override;
 
       private:
-        Ptr<SQLiteOutput> m_db; //!< Db
-        std::string m_runLabel; //!< Run label
-
-        /// Pointer to a Sqlite3 singleton statement
-        sqlite3_stmt* m_insertSingletonStatement;
+        Ptr<SQLiteBatchWriter> m_writer; //!< Writer of the rows
+        uint32_t m_insertSingleton;      //!< Writer statement inserting a singleton
+        std::string m_runLabel;          //!< Run label
     };
 
     Ptr<SQLiteOutput> m_sqliteOut; //!< Database
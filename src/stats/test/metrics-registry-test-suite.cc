@@ -0,0 +1,384 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/data-collector.h"
+#include "ns3/data-output-interface.h"
+#include "ns3/metrics-registry.h"
+#include "ns3/omnet-data-output.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#ifdef HAVE_SQLITE3
+#include "ns3/sqlite-data-output.h"
+#include "ns3/sqlite-output.h"
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief DataOutputCallback recording the values output.
+ */
+class RecordingOutputCallback : public DataOutputCallback
+{
+  public:
+    void OutputStatistic(std::string key,
+                         std::string variable,
+                         const StatisticalSummary* statSum) override
+    {
+        m_values[variable + "-count"] = statSum->getCount();
+        m_values[variable + "-mean"] = statSum->getMean();
+        m_values[variable + "-min"] = statSum->getMin();
+        m_values[variable + "-max"] = statSum->getMax();
+    }
+
+    void OutputSingleton(std::string key, std::string variable, int val) override
+    {
+        m_values[variable] = val;
+    }
+
+    void OutputSingleton(std::string key, std::string variable, uint32_t val) override
+    {
+        m_values[variable] = val;
+    }
+
+    void OutputSingleton(std::string key, std::string variable, double val) override
+    {
+        m_values[variable] = val;
+    }
+
+    void OutputSingleton(std::string key, std::string variable, std::string val) override
+    {
+    }
+
+    void OutputSingleton(std::string key, std::string variable, Time val) override
+    {
+        m_values[variable] = val.GetSeconds();
+    }
+
+    std::map<std::string, double> m_values; //!< Values output, by variable
+};
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief DataOutputInterface recording the snapshots of the DataCollector.
+ */
+class RecordingDataOutput : public DataOutputInterface
+{
+  public:
+    void Output(DataCollector& dc) override
+    {
+        RecordingOutputCallback callback;
+        for (auto it = dc.DataCalculatorBegin(); it != dc.DataCalculatorEnd(); it++)
+        {
+            (*it)->Output(callback);
+        }
+        m_snapshots.push_back(callback.m_values);
+        m_runs.push_back(dc.GetRunLabel());
+    }
+
+    std::vector<std::map<std::string, double>> m_snapshots; //!< Snapshots output
+    std::vector<std::string> m_runs;                        //!< Run labels of the snapshots
+};
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief MetricsRegistry Test
+ */
+class MetricsRegistryTestCase : public TestCase
+{
+  public:
+    MetricsRegistryTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MetricsRegistryTestCase::MetricsRegistryTestCase()
+    : TestCase("MetricsRegistry")
+{
+}
+
+void
+MetricsRegistryTestCase::DoRun()
+{
+    Ptr<MetricsRegistry> registry = CreateObjectWithAttributes<MetricsRegistry>("Shards",
+                                                                               UintegerValue(3));
+
+    {
+        // Testing the counters updated by more threads than shards
+        MetricCounter counter = registry->GetCounter("packets");
+        counter.Increment();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 6; t++)
+        {
+            threads.emplace_back([counter]() mutable {
+                for (int i = 0; i < 10000; i++)
+                {
+                    counter.Increment(2);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        NS_TEST_EXPECT_MSG_EQ(counter.GetValue(), 120001, "Increments lost");
+        NS_TEST_EXPECT_MSG_EQ(registry->GetCounter("packets").GetValue(),
+                              120001,
+                              "Not the same counter");
+    }
+
+    {
+        // Testing the gauges
+        MetricGauge gauge = registry->GetGauge("queue");
+        gauge.Set(10);
+        gauge.Add(-2.5);
+        NS_TEST_EXPECT_MSG_EQ(gauge.GetValue(), 7.5, "");
+    }
+
+    {
+        // Testing the histograms
+        MetricHistogram histogram = registry->GetHistogram("delay", {1, 2, 4});
+        NS_TEST_EXPECT_MSG_EQ(isNaN(histogram.GetMin()), true, "Min not NaN");
+        for (double value : {0.5, 1.0, 1.5, 3.0, 3.5, 10.0})
+        {
+            histogram.Observe(value);
+        }
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetNBuckets(), 4, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetBucketCount(0), 2, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetBucketCount(1), 1, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetBucketCount(2), 2, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetBucketCount(3), 1, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetCount(), 6, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetSum(), 19.5, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetMin(), 0.5, "");
+        NS_TEST_EXPECT_MSG_EQ(histogram.GetMax(), 10, "");
+    }
+
+    {
+        // Testing the output
+        RecordingOutputCallback callback;
+        registry->Output(callback);
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["packets"], 120001, "");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["queue"], 7.5, "");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["delay-count"], 6, "");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["delay-mean"], 3.25, "");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["delay-le-1"], 2, "");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["delay-le-2"], 3, "Counts not cumulative");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["delay-le-4"], 5, "Counts not cumulative");
+        NS_TEST_EXPECT_MSG_EQ(callback.m_values["delay-le-inf"], 6, "Counts not cumulative");
+
+        registry->Reset();
+        NS_TEST_EXPECT_MSG_EQ(registry->GetCounter("packets").GetValue(), 0, "");
+        NS_TEST_EXPECT_MSG_EQ(registry->GetHistogram("delay", {1, 2, 4}).GetCount(), 0, "");
+        NS_TEST_EXPECT_MSG_EQ(registry->GetGauge("queue").GetValue(), 7.5, "Gauge reset");
+    }
+
+    {
+        // Testing the periodic export
+        Ptr<DataCollector> dc = CreateObject<DataCollector>();
+        dc->DescribeRun("experiment", "strategy", "input", "run");
+        Ptr<RecordingDataOutput> output = CreateObject<RecordingDataOutput>();
+        MetricCounter counter = registry->GetCounter("packets");
+        registry->StartExport(dc, output, Seconds(1));
+        for (int i = 0; i < 3; i++)
+        {
+            Simulator::Schedule(Seconds(i + 0.5), &MetricCounter::Increment, &counter, 5);
+        }
+        Simulator::Stop(Seconds(3.5));
+        Simulator::Run();
+        registry->StopExport();
+        Simulator::Destroy();
+
+        NS_TEST_ASSERT_MSG_EQ(output->m_snapshots.size(), 3, "Snapshots not exported");
+        for (int i = 0; i < 3; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(output->m_runs[i],
+                                  "run-" + std::to_string(i + 1) + "s",
+                                  "Unexpected run label");
+            NS_TEST_EXPECT_MSG_EQ(output->m_snapshots[i]["packets"], 5 * (i + 1), "");
+        }
+        registry->Dispose();
+    }
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Test of the periodic export of a MetricsRegistry through the
+ * OmnetDataOutput and the SqliteDataOutput, checking that the snapshots are
+ * all written and can be told apart.
+ */
+class MetricsRegistryExportTestCase : public TestCase
+{
+  public:
+    MetricsRegistryExportTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Export the snapshots taken at 1 s and 2 s of a counter incremented
+     * by 5 at 0.5 s and 1.5 s.
+     * \param output the output
+     */
+    void Export(Ptr<DataOutputInterface> output);
+#ifdef HAVE_SQLITE3
+    /**
+     * \param db the database
+     * \param query a query returning a single value
+     * \return the value returned by the query
+     */
+    double Query(Ptr<SQLiteOutput> db, const std::string& query);
+#endif
+};
+
+MetricsRegistryExportTestCase::MetricsRegistryExportTestCase()
+    : TestCase("MetricsRegistry export through the DataOutputInterfaces")
+{
+}
+
+void
+MetricsRegistryExportTestCase::Export(Ptr<DataOutputInterface> output)
+{
+    Ptr<MetricsRegistry> registry = CreateObject<MetricsRegistry>();
+    MetricCounter counter = registry->GetCounter("packets");
+    Ptr<DataCollector> dc = CreateObject<DataCollector>();
+    dc->DescribeRun("experiment", "strategy", "input", "run");
+    registry->StartExport(dc, output, Seconds(1));
+    for (int i = 0; i < 2; i++)
+    {
+        Simulator::Schedule(Seconds(i + 0.5), &MetricCounter::Increment, &counter, 5);
+    }
+    Simulator::Stop(Seconds(2.5));
+    Simulator::Run();
+    registry->StopExport();
+    Simulator::Destroy();
+    registry->Dispose();
+}
+
+#ifdef HAVE_SQLITE3
+double
+MetricsRegistryExportTestCase::Query(Ptr<SQLiteOutput> db, const std::string& query)
+{
+    sqlite3_stmt* stmt;
+    NS_TEST_EXPECT_MSG_EQ(db->WaitPrepare(&stmt, query), true, "Failed to prepare " << query);
+    NS_TEST_EXPECT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "No row returned by " << query);
+    double value = db->RetrieveColumn<double>(stmt, 0);
+    SQLiteOutput::SpinFinalize(stmt);
+    return value;
+}
+#endif
+
+void
+MetricsRegistryExportTestCase::DoRun()
+{
+    std::string prefix = CreateTempDirFilename("metrics-export");
+
+    {
+        // Testing the OmnetDataOutput: a file per snapshot
+        Ptr<OmnetDataOutput> output = CreateObject<OmnetDataOutput>();
+        output->SetFilePrefix(prefix);
+        Export(output);
+
+        for (int i = 1; i <= 2; i++)
+        {
+            std::string run = "run-" + std::to_string(i) + "s";
+            std::ifstream sca(prefix + "-" + run + ".sca");
+            NS_TEST_ASSERT_MSG_EQ(sca.is_open(), true, "Snapshot " << run << " not written");
+            std::ostringstream content;
+            content << sca.rdbuf();
+            std::ostringstream counter;
+            counter << "scalar . packets " << 5 * i << "\n";
+            NS_TEST_EXPECT_MSG_NE(content.str().find("run " + run + "\n"),
+                                  std::string::npos,
+                                  "Run label not written in " << run);
+            NS_TEST_EXPECT_MSG_NE(content.str().find("attr \"snapshot-time\" \"" +
+                                                     std::to_string(i) + "\""),
+                                  std::string::npos,
+                                  "Snapshot time not written in " << run);
+            NS_TEST_EXPECT_MSG_NE(content.str().find(counter.str()),
+                                  std::string::npos,
+                                  "Counter not written in " << run);
+            sca.close();
+            std::remove((prefix + "-" + run + ".sca").c_str());
+        }
+    }
+
+#ifdef HAVE_SQLITE3
+    {
+        // Testing the SqliteDataOutput: rows keyed by the snapshot
+        std::remove((prefix + ".db").c_str());
+        Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput>();
+        output->SetFilePrefix(prefix);
+        Export(output);
+
+        Ptr<SQLiteOutput> db = Create<SQLiteOutput>(prefix + ".db");
+        NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT COUNT(DISTINCT run) FROM Experiments"),
+                              2,
+                              "Unexpected number of snapshots");
+        for (int i = 1; i <= 2; i++)
+        {
+            std::string run = "'run-" + std::to_string(i) + "s'";
+            NS_TEST_EXPECT_MSG_EQ(Query(db,
+                                        "SELECT value FROM Singletons WHERE run = " + run +
+                                            " AND variable = 'packets'"),
+                                  5 * i,
+                                  "Unexpected counter in snapshot " << run);
+            NS_TEST_EXPECT_MSG_EQ(Query(db,
+                                        "SELECT value FROM Metadata WHERE run = " + run +
+                                            " AND key = 'snapshot-time'"),
+                                  i,
+                                  "Unexpected snapshot time in snapshot " << run);
+        }
+        db = nullptr;
+        std::remove((prefix + ".db").c_str());
+    }
+#endif
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief MetricsRegistry TestSuite
+ */
+class MetricsRegistryTestSuite : public TestSuite
+{
+  public:
+    MetricsRegistryTestSuite();
+};
+
+MetricsRegistryTestSuite::MetricsRegistryTestSuite()
+    : TestSuite("metrics-registry", UNIT)
+{
+    AddTestCase(new MetricsRegistryTestCase, TestCase::QUICK);
+    AddTestCase(new MetricsRegistryExportTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static MetricsRegistryTestSuite g_metricsRegistryTestSuite;
@@ -0,0 +1,201 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/quantile-sketch.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief QuantileSketch Test
+ */
+class QuantileSketchTestCase : public TestCase
+{
+  public:
+    QuantileSketchTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the quantiles estimated by a sketch against the exact quantiles
+     * of the (sorted) values added to it.
+     *
+     * \param sketch the sketch
+     * \param values the sorted values added to the sketch
+     * \param quantiles the quantiles to check
+     */
+    void CheckQuantiles(const QuantileSketch& sketch,
+                        const std::vector<double>& values,
+                        const std::vector<double>& quantiles);
+};
+
+QuantileSketchTestCase::QuantileSketchTestCase()
+    : TestCase("QuantileSketch")
+{
+}
+
+void
+QuantileSketchTestCase::CheckQuantiles(const QuantileSketch& sketch,
+                                       const std::vector<double>& values,
+                                       const std::vector<double>& quantiles)
+{
+    double alpha = sketch.GetRelativeAccuracy();
+    for (double q : quantiles)
+    {
+        double exact = values[static_cast<std::size_t>(q * (values.size() - 1))];
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(q),
+                                  exact,
+                                  exact * alpha * 1.0001,
+                                  "Quantile " << q << " out of the relative accuracy");
+    }
+}
+
+void
+QuantileSketchTestCase::DoRun()
+{
+    // Values spanning four orders of magnitude, from 1us to 22ms
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++)
+    {
+        values.push_back(1e-6 * std::pow(1.001, i));
+    }
+    std::vector<double> quantiles = {0.01, 0.1, 0.5, 0.9, 0.99, 0.999};
+
+    QuantileSketch s0(0.01);
+    {
+        // Testing the accuracy of the quantiles
+        for (double value : values)
+        {
+            s0.AddValue(value);
+        }
+        NS_TEST_EXPECT_MSG_EQ(s0.GetCount(), 10000, "");
+        NS_TEST_EXPECT_MSG_EQ(s0.GetMin(), values.front(), "");
+        NS_TEST_EXPECT_MSG_EQ(s0.GetMax(), values.back(), "");
+        NS_TEST_EXPECT_MSG_EQ(s0.GetQuantile(0), values.front(), "");
+        NS_TEST_EXPECT_MSG_EQ(s0.GetQuantile(1), values.back(), "");
+        // log(22026) / log(1.01 / 0.99) bins
+        NS_TEST_EXPECT_MSG_LT(s0.GetNBins(), 501, "Too many bins allocated");
+        CheckQuantiles(s0, values, quantiles);
+    }
+
+    {
+        // Testing merging: the merge of two sketches is the sketch of the union
+        QuantileSketch s1(0.01);
+        QuantileSketch s2(0.01);
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            // add the values in decreasing order to the second sketch
+            s1.AddValue(values[i]);
+            i++;
+            s2.AddValue(values[values.size() - i]);
+        }
+        s1.Merge(s2);
+        NS_TEST_EXPECT_MSG_EQ(s1.GetCount(), s0.GetCount(), "");
+        NS_TEST_EXPECT_MSG_EQ(s1.GetMin(), s0.GetMin(), "");
+        NS_TEST_EXPECT_MSG_EQ(s1.GetMax(), s0.GetMax(), "");
+        NS_TEST_EXPECT_MSG_EQ(s1.GetNBins(), s0.GetNBins(), "");
+        for (double q : quantiles)
+        {
+            NS_TEST_EXPECT_MSG_EQ(s1.GetQuantile(q), s0.GetQuantile(q), "Quantile " << q);
+        }
+
+        QuantileSketch empty(0.01);
+        empty.Merge(s1);
+        NS_TEST_EXPECT_MSG_EQ(empty.GetQuantile(0.99), s0.GetQuantile(0.99), "");
+    }
+
+    {
+        // Testing the serialization round trip
+        std::stringstream ss;
+        ss << s0;
+        QuantileSketch s3;
+        ss >> s3;
+        NS_TEST_EXPECT_MSG_EQ(bool(ss), true, "Sketch not read back");
+        NS_TEST_EXPECT_MSG_EQ(s3.GetRelativeAccuracy(), s0.GetRelativeAccuracy(), "");
+        NS_TEST_EXPECT_MSG_EQ(s3.GetCount(), s0.GetCount(), "");
+        NS_TEST_EXPECT_MSG_EQ(s3.GetMin(), s0.GetMin(), "");
+        NS_TEST_EXPECT_MSG_EQ(s3.GetMax(), s0.GetMax(), "");
+        for (double q : quantiles)
+        {
+            NS_TEST_EXPECT_MSG_EQ(s3.GetQuantile(q), s0.GetQuantile(q), "Quantile " << q);
+        }
+
+        std::stringstream bad("0.01 2048 3 0.1");
+        QuantileSketch s4;
+        bad >> s4;
+        NS_TEST_EXPECT_MSG_EQ(bool(bad), false, "Truncated sketch read");
+        NS_TEST_EXPECT_MSG_EQ(s4.GetCount(), 0, "Sketch modified by a failed read");
+    }
+
+    {
+        // Testing the collapsing of the lowest bins
+        QuantileSketch s5(0.01, 64);
+        for (double value : values)
+        {
+            s5.AddValue(value);
+        }
+        NS_TEST_EXPECT_MSG_EQ(s5.GetNBins(), 64, "");
+        CheckQuantiles(s5, values, {0.9, 0.99, 0.999});
+        // the lowest quantiles collapse into the lowest bin, above the exact value
+        NS_TEST_EXPECT_MSG_GT(s5.GetQuantile(0.01), values[99], "");
+    }
+
+    {
+        // Testing zero values and clearing
+        QuantileSketch s6(0.05);
+        for (int i = 0; i < 10; i++)
+        {
+            s6.AddValue(0);
+        }
+        for (int i = 0; i < 10; i++)
+        {
+            s6.AddValue(1);
+        }
+        NS_TEST_EXPECT_MSG_EQ(s6.GetQuantile(0.4), 0, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(s6.GetQuantile(0.6), 1, 0.05 * 1.0001, "");
+        NS_TEST_EXPECT_MSG_EQ(s6.GetSum(), 10, "");
+        s6.Clear();
+        NS_TEST_EXPECT_MSG_EQ(s6.GetCount(), 0, "");
+        NS_TEST_EXPECT_MSG_EQ(s6.GetQuantile(0.5), 0, "");
+        NS_TEST_EXPECT_MSG_EQ(s6.GetNBins(), 0, "");
+    }
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief QuantileSketch TestSuite
+ */
+class QuantileSketchTestSuite : public TestSuite
+{
+  public:
+    QuantileSketchTestSuite();
+};
+
+QuantileSketchTestSuite::QuantileSketchTestSuite()
+    : TestSuite("quantile-sketch", UNIT)
+{
+    AddTestCase(new QuantileSketchTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static QuantileSketchTestSuite g_quantileSketchTestSuite;
@@ -0,0 +1,125 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/sqlite-batch-writer.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SQLiteBatchWriter Test
+ */
+class SQLiteBatchWriterTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param background whether the rows are written in a background thread
+     */
+    SQLiteBatchWriterTestCase(bool background);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \param db the database
+     * \param query a query returning a single value
+     * \return the value returned by the query
+     */
+    double Query(Ptr<SQLiteOutput> db, const std::string& query);
+
+    bool m_background; //!< Whether the rows are written in a background thread
+};
+
+SQLiteBatchWriterTestCase::SQLiteBatchWriterTestCase(bool background)
+    : TestCase(std::string("SQLiteBatchWriter") + (background ? " in background" : "")),
+      m_background(background)
+{
+}
+
+double
+SQLiteBatchWriterTestCase::Query(Ptr<SQLiteOutput> db, const std::string& query)
+{
+    sqlite3_stmt* stmt;
+    NS_TEST_EXPECT_MSG_EQ(db->WaitPrepare(&stmt, query), true, "Failed to prepare " << query);
+    NS_TEST_EXPECT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "No row returned");
+    double value = db->RetrieveColumn<double>(stmt, 0);
+    SQLiteOutput::SpinFinalize(stmt);
+    return value;
+}
+
+void
+SQLiteBatchWriterTestCase::DoRun()
+{
+    std::string file = CreateTempDirFilename(GetName() + ".db");
+    std::remove(file.c_str());
+    Ptr<SQLiteOutput> db = Create<SQLiteOutput>(file);
+    db->SpinExec("CREATE TABLE Packets (time, flow, size, node)");
+    db->SpinExec("CREATE TABLE Flows (flow, name)");
+
+    {
+        Ptr<SQLiteBatchWriter> writer = Create<SQLiteBatchWriter>(db, 1000, m_background);
+        uint32_t insertPacket = writer->Prepare("INSERT INTO Packets VALUES (?, ?, ?, ?)");
+        uint32_t insertFlow = writer->Prepare("INSERT INTO Flows VALUES (?, ?)");
+        for (uint32_t i = 0; i < 10500; i++)
+        {
+            writer->Insert(insertPacket, MilliSeconds(i), i % 7, uint16_t(100 + i % 3), "n");
+            if (i % 1500 == 0)
+            {
+                writer->Insert(insertFlow, i / 1500, "flow " + std::to_string(i / 1500));
+            }
+        }
+        // the rows of the full batches are written as they are inserted
+        writer->Flush();
+        NS_TEST_EXPECT_MSG_EQ(writer->GetNRows(), 10507, "Rows not written");
+        NS_TEST_EXPECT_MSG_EQ(writer->GetNTransactions(), 11, "Rows not written in batches");
+        writer->Insert(insertFlow, 7, std::string("last"));
+    }
+
+    // the last row is written when the writer is destroyed
+    NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT COUNT(*) FROM Packets"), 10500, "");
+    NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT COUNT(*) FROM Flows"), 8, "");
+    NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT SUM(size) FROM Packets"), 10500 * 101, "");
+    NS_TEST_EXPECT_MSG_EQ_TOL(Query(db, "SELECT MAX(time) FROM Packets"), 10.499, 1e-9, "");
+    NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT flow FROM Flows WHERE name = 'flow 3'"), 3, "");
+    NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT COUNT(*) FROM Packets WHERE node = 'n'"), 10500, "");
+    NS_TEST_EXPECT_MSG_EQ(Query(db, "SELECT flow FROM Flows WHERE name = 'last'"), 7, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SQLiteBatchWriter TestSuite
+ */
+class SQLiteBatchWriterTestSuite : public TestSuite
+{
+  public:
+    SQLiteBatchWriterTestSuite();
+};
+
+SQLiteBatchWriterTestSuite::SQLiteBatchWriterTestSuite()
+    : TestSuite("sqlite-batch-writer", UNIT)
+{
+    AddTestCase(new SQLiteBatchWriterTestCase(false), TestCase::QUICK);
+    AddTestCase(new SQLiteBatchWriterTestCase(true), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SQLiteBatchWriterTestSuite g_sqliteBatchWriterTestSuite;
@@ -0,0 +1,282 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the per-packet cost of the flow queueing
+// disciplines (FqCoDel, FqCobalt and FqPie) at a bottleneck shared by
+// many concurrent flows.  Packets of randomly chosen flows are enqueued
+// until the bottleneck holds 'packets' packets, and then dequeued by the
+// DRR scheduler.  Finally, 'overflow-packets' packets are enqueued in a
+// full queue disc holding at most two packets per flow, so that each
+// enqueue makes the queue disc drop packets from the fat flow.  The flow queues of
+// all the flows are created before the packets are enqueued.
+// Sample usage:  ./ns3 run 'bench-fq-queue-disc --flows=10000 --packets=100000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/fq-cobalt-queue-disc.h"
+#include "ns3/fq-codel-queue-disc.h"
+#include "ns3/fq-pie-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * A queue disc item of a given flow.
+ */
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * \param p the packet
+     * \param flow the flow of the packet
+     */
+    BenchQueueDiscItem(Ptr<Packet> p, uint32_t flow)
+        : QueueDiscItem(p, Address(), 0),
+          m_flow(flow)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+
+    uint32_t Hash(uint32_t perturbation) const override
+    {
+        return m_flow;
+    }
+
+  private:
+    uint32_t m_flow; //!< The flow of the packet
+};
+
+/// Time elapsed in the phases of a benchmark, in ms
+struct Delays
+{
+    int64_t enqueue;  //!< Enqueue of the packets
+    int64_t dequeue;  //!< Dequeue of the packets
+    int64_t overflow; //!< Enqueue of the packets in an overflowing queue disc
+};
+
+/**
+ * Create the packets of a benchmark.
+ *
+ * \param flows the number of flows
+ * \param packets the number of packets
+ * \return the packets, of randomly chosen flows
+ */
+static std::vector<Ptr<QueueDiscItem>>
+CreateItems(uint32_t flows, uint32_t packets)
+{
+    Ptr<UniformRandomVariable> flow = CreateObject<UniformRandomVariable>();
+    std::vector<Ptr<QueueDiscItem>> items;
+    items.reserve(packets);
+    for (uint32_t i = 0; i < packets; i++)
+    {
+        items.push_back(
+            Create<BenchQueueDiscItem>(Create<Packet>(1000), flow->GetInteger(0, flows - 1)));
+    }
+    return items;
+}
+
+/**
+ * Create a queue disc, and the flow queues of all the flows.
+ *
+ * \param flows the number of flows
+ * \param maxPackets the maximum number of packets held by the queue disc
+ * \return the queue disc
+ */
+template <typename T>
+static Ptr<T>
+CreateQueueDisc(uint32_t flows, uint32_t maxPackets)
+{
+    // a flow queue per flow, hence the number of flows rounded up to a power of two
+    uint32_t nQueues = 1;
+    while (nQueues < flows)
+    {
+        nQueues <<= 1;
+    }
+    Ptr<T> qd = CreateObjectWithAttributes<T>(
+        "MaxSize",
+        StringValue(std::to_string(maxPackets) + "p"),
+        "Flows",
+        UintegerValue(nQueues));
+    qd->SetQuantum(1500);
+    qd->Initialize();
+
+    // the creation of the flow queues is not part of the per-packet cost
+    for (uint32_t i = 0; i < flows; i++)
+    {
+        qd->Enqueue(Create<BenchQueueDiscItem>(Create<Packet>(1000), i));
+    }
+    while (qd->Dequeue())
+    {
+    }
+    return qd;
+}
+
+/**
+ * Enqueue packets in a queue disc.
+ *
+ * \param qd the queue disc
+ * \param items the packets
+ * \return the time elapsed, in ms
+ */
+static int64_t
+Enqueue(Ptr<QueueDisc> qd, std::vector<Ptr<QueueDiscItem>> items)
+{
+    SystemWallClockMs time;
+    time.Start();
+    for (auto& item : items)
+    {
+        qd->Enqueue(item);
+    }
+    return time.End();
+}
+
+/**
+ * Run the phases of a benchmark.
+ *
+ * \param flows the number of flows
+ * \param packets the number of packets enqueued and dequeued
+ * \param overflowPackets the number of packets enqueued in the overflowing queue disc
+ * \return the time elapsed in each phase
+ */
+template <typename T>
+static Delays
+Run(uint32_t flows, uint32_t packets, uint32_t overflowPackets)
+{
+    Delays delays;
+
+    Ptr<T> qd = CreateQueueDisc<T>(flows, packets);
+    delays.enqueue = Enqueue(qd, CreateItems(flows, packets));
+    NS_ABORT_MSG_UNLESS(qd->GetNPackets() == packets, "Packets dropped");
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < packets; i++)
+    {
+        qd->Dequeue();
+    }
+    delays.dequeue = time.End();
+    NS_ABORT_MSG_UNLESS(qd->GetNPackets() == 0, "Packets not dequeued");
+    qd->Dispose();
+
+    // fill the queue disc, so that each packet enqueued makes it drop packets
+    qd = CreateQueueDisc<T>(flows, 2 * flows);
+    Enqueue(qd, CreateItems(flows, 2 * flows));
+    delays.overflow = Enqueue(qd, CreateItems(flows, overflowPackets));
+    qd->Dispose();
+
+    Simulator::Destroy();
+    return delays;
+}
+
+/**
+ * Run a benchmark and report its results.
+ *
+ * \param name the name of the queue disc
+ * \param flows the number of flows
+ * \param packets the number of packets enqueued and dequeued
+ * \param overflowPackets the number of packets enqueued in the overflowing queue disc
+ * \param minIterations the number of iterations to minimize the times over
+ */
+template <typename T>
+static void
+Bench(const std::string& name,
+      uint32_t flows,
+      uint32_t packets,
+      uint32_t overflowPackets,
+      uint32_t minIterations)
+{
+    Delays min{std::numeric_limits<int64_t>::max(),
+               std::numeric_limits<int64_t>::max(),
+               std::numeric_limits<int64_t>::max()};
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        Delays delays = Run<T>(flows, packets, overflowPackets);
+        min.enqueue = std::min(min.enqueue, delays.enqueue);
+        min.dequeue = std::min(min.dequeue, delays.dequeue);
+        min.overflow = std::min(min.overflow, delays.overflow);
+    }
+    Report(name + " enqueue", packets, min.enqueue);
+    Report(name + " dequeue", packets, min.dequeue);
+    Report(name + " enqueue-overflow", overflowPackets, min.overflow);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t flows = 10000;
+    uint32_t packets = 100000;
+    uint32_t overflowPackets = 10000;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the per-packet cost of the flow queueing disciplines");
+    cmd.AddValue("flows", "number of concurrent flows", flows);
+    cmd.AddValue("packets", "number of packets enqueued and dequeued", packets);
+    cmd.AddValue("overflow-packets",
+                 "number of packets enqueued in the overflowing queue disc",
+                 overflowPackets);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(flows == 0, "At least one flow is needed");
+    NS_ABORT_MSG_IF(packets == 0 || overflowPackets == 0, "At least one packet must be enqueued");
+
+    std::cout << "Running bench-fq-queue-disc with flows=" << flows << " packets=" << packets
+              << " overflow-packets=" << overflowPackets << std::endl;
+
+    Bench<FqCoDelQueueDisc>("FqCoDel", flows, packets, overflowPackets, minIterations);
+    Bench<FqCobaltQueueDisc>("FqCobalt", flows, packets, overflowPackets, minIterations);
+    Bench<FqPieQueueDisc>("FqPie", flows, packets, overflowPackets, minIterations);
+    return 0;
+}
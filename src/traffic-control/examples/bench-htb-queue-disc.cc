@@ -0,0 +1,307 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the per-packet cost of the HTB queue disc as the
+// number of leaf classes grows (10, 100, 1000, ... up to 'max-leaves').  The
+// root class, whose rate is 'rate', has an inner class per group of 'group-size'
+// leaf classes, and each leaf class is guaranteed an equal share of the root
+// rate, while it may borrow up to the root rate.  Packets of randomly chosen
+// leaf classes are enqueued, and then dequeued by a device serving the queue
+// disc at the root rate, so that the leaf classes keep borrowing and
+// exceeding their rate.
+// Sample usage:  ./ns3 run 'bench-htb-queue-disc --max-leaves=10000 --packets=100000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/htb-queue-disc.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * A queue disc item of a given leaf class.
+ */
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * \param p the packet
+     * \param leaf the index of the leaf class of the packet
+     */
+    BenchQueueDiscItem(Ptr<Packet> p, uint32_t leaf)
+        : QueueDiscItem(p, Address(), 0),
+          m_leaf(leaf)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+
+    /**
+     * \return the index of the leaf class of the packet
+     */
+    uint32_t GetLeaf() const
+    {
+        return m_leaf;
+    }
+
+  private:
+    uint32_t m_leaf; //!< The index of the leaf class of the packet
+};
+
+/**
+ * A packet filter returning the leaf class of a BenchQueueDiscItem.
+ */
+class BenchPacketFilter : public PacketFilter
+{
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override
+    {
+        return true;
+    }
+
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override
+    {
+        return StaticCast<BenchQueueDiscItem>(item)->GetLeaf();
+    }
+};
+
+/**
+ * A device serving a queue disc at a given rate.
+ */
+class BenchDevice
+{
+  public:
+    /**
+     * Constructor
+     * \param qd the queue disc
+     * \param rate the rate of the device
+     */
+    BenchDevice(Ptr<QueueDisc> qd, DataRate rate)
+        : m_qd(qd),
+          m_rate(rate),
+          m_sent(0)
+    {
+        qd->SetSendCallback([this](Ptr<QueueDiscItem> item) { m_sent++; });
+    }
+
+    /**
+     * Dequeue a packet, and schedule the next dequeue after its transmission
+     * time (or after the transmission time of a 1000 bytes packet, if the
+     * queue disc is not backlogged or cannot send)
+     */
+    void Serve()
+    {
+        Ptr<QueueDiscItem> item = m_qd->Dequeue();
+        if (item)
+        {
+            m_sent++;
+        }
+        if (m_qd->GetNPackets() > 0)
+        {
+            Simulator::Schedule(m_rate.CalculateBytesTxTime(item ? item->GetSize() : 1000),
+                                &BenchDevice::Serve,
+                                this);
+        }
+    }
+
+    /**
+     * \return the number of packets sent by the queue disc
+     */
+    uint32_t GetSent() const
+    {
+        return m_sent;
+    }
+
+  private:
+    Ptr<QueueDisc> m_qd; //!< The queue disc
+    DataRate m_rate;     //!< The rate of the device
+    uint32_t m_sent;     //!< The number of packets sent by the queue disc
+};
+
+/// Time elapsed in the phases of a benchmark, in ms
+struct Delays
+{
+    int64_t enqueue; //!< Enqueue of the packets
+    int64_t dequeue; //!< Dequeue of the packets
+};
+
+/**
+ * Create an HTB queue disc and its classes.
+ *
+ * \param leaves the number of leaf classes
+ * \param groupSize the number of leaf classes per inner class
+ * \param rate the rate of the root class
+ * \return the queue disc
+ */
+static Ptr<HtbQueueDisc>
+CreateQueueDisc(uint32_t leaves, uint32_t groupSize, DataRate rate)
+{
+    Ptr<HtbQueueDisc> qd = CreateObject<HtbQueueDisc>();
+    qd->AddPacketFilter(CreateObject<BenchPacketFilter>());
+
+    Ptr<HtbClass> root = CreateObject<HtbClass>();
+    root->SetAttribute("Rate", DataRateValue(rate));
+    uint32_t groups = (leaves + groupSize - 1) / groupSize;
+    DataRate leafRate(std::max<uint64_t>(rate.GetBitRate() / leaves, 1));
+    DataRate groupRate(std::max<uint64_t>(rate.GetBitRate() / groups, 1));
+
+    Ptr<HtbClass> group;
+    for (uint32_t i = 0; i < leaves; i++)
+    {
+        if (i % groupSize == 0)
+        {
+            group = CreateObject<HtbClass>();
+            group->SetAttribute("Rate", DataRateValue(groupRate));
+            group->SetAttribute("Ceil", DataRateValue(rate));
+            group->SetParent(root);
+        }
+        Ptr<HtbClass> leaf = CreateObject<HtbClass>();
+        leaf->SetAttribute("Rate", DataRateValue(leafRate));
+        leaf->SetAttribute("Ceil", DataRateValue(rate));
+        leaf->SetParent(group);
+        leaf->SetQueueDisc(
+            CreateObjectWithAttributes<FifoQueueDisc>("MaxSize", StringValue("100000p")));
+        qd->AddQueueDiscClass(leaf);
+    }
+    qd->Initialize();
+    return qd;
+}
+
+/**
+ * Run the phases of a benchmark.
+ *
+ * \param leaves the number of leaf classes
+ * \param groupSize the number of leaf classes per inner class
+ * \param rate the rate of the root class
+ * \param packets the number of packets enqueued and dequeued
+ * \return the time elapsed in each phase
+ */
+static Delays
+Run(uint32_t leaves, uint32_t groupSize, DataRate rate, uint32_t packets)
+{
+    Delays delays;
+
+    Ptr<UniformRandomVariable> leaf = CreateObject<UniformRandomVariable>();
+    std::vector<Ptr<QueueDiscItem>> items;
+    items.reserve(packets);
+    for (uint32_t i = 0; i < packets; i++)
+    {
+        items.push_back(
+            Create<BenchQueueDiscItem>(Create<Packet>(1000), leaf->GetInteger(0, leaves - 1)));
+    }
+
+    Ptr<HtbQueueDisc> qd = CreateQueueDisc(leaves, groupSize, rate);
+
+    SystemWallClockMs time;
+    time.Start();
+    for (auto& item : items)
+    {
+        qd->Enqueue(item);
+    }
+    delays.enqueue = time.End();
+    NS_ABORT_MSG_UNLESS(qd->GetNPackets() == packets, "Packets dropped");
+
+    BenchDevice device(qd, rate);
+    Simulator::ScheduleNow(&BenchDevice::Serve, &device);
+    time.Start();
+    Simulator::Run();
+    delays.dequeue = time.End();
+    NS_ABORT_MSG_UNLESS(device.GetSent() == packets, "Packets not dequeued");
+
+    qd->Dispose();
+    Simulator::Destroy();
+    return delays;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t maxLeaves = 10000;
+    uint32_t groupSize = 100;
+    uint32_t packets = 100000;
+    std::string rate = "10Gbps";
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the per-packet cost of the HTB queue disc");
+    cmd.AddValue("max-leaves", "maximum number of leaf classes", maxLeaves);
+    cmd.AddValue("group-size", "number of leaf classes per inner class", groupSize);
+    cmd.AddValue("packets", "number of packets enqueued and dequeued", packets);
+    cmd.AddValue("rate", "rate of the root class", rate);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(maxLeaves < 10, "At least 10 leaf classes are needed");
+    NS_ABORT_MSG_IF(groupSize == 0, "At least a leaf class per inner class is needed");
+    NS_ABORT_MSG_IF(packets == 0, "At least one packet must be enqueued");
+
+    std::cout << "Running bench-htb-queue-disc with max-leaves=" << maxLeaves
+              << " group-size=" << groupSize << " packets=" << packets << " rate=" << rate
+              << std::endl;
+
+    for (uint32_t leaves = 10; leaves <= maxLeaves; leaves *= 10)
+    {
+        Delays min{std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max()};
+        for (uint32_t i = 0; i < minIterations; i++)
+        {
+            Delays delays = Run(leaves, groupSize, DataRate(rate), packets);
+            min.enqueue = std::min(min.enqueue, delays.enqueue);
+            min.dequeue = std::min(min.dequeue, delays.dequeue);
+        }
+        std::string name = "Htb leaves=" + std::to_string(leaves);
+        Report(name + " enqueue", packets, min.enqueue);
+        Report(name + " dequeue", packets, min.dequeue);
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the per-packet cost of the active queue management
+// disciplines (Red, Pie and CoDel) under heavy congestion, i.e., when most
+// of the packets are dropped.  The queue disc is filled up to its limit of
+// 'limit' packets, then 'packets' packets are enqueued, each of which is
+// dropped, with a packet dequeued every 'dequeue-interval' packets.
+// Sample usage:  ./ns3 run 'bench-queue-disc-drops --packets=1000000 --limit=100'
+
+#include "ns3/abort.h"
+#include "ns3/codel-queue-disc.h"
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/pie-queue-disc.h"
+#include "ns3/red-queue-disc.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * A queue disc item, which cannot be marked.
+ */
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * \param p the packet
+     */
+    BenchQueueDiscItem(Ptr<Packet> p)
+        : QueueDiscItem(p, Address(), 0)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+};
+
+/**
+ * Enqueue packets in a full queue disc.
+ *
+ * \param qd the queue disc
+ * \param limit the maximum number of packets held by the queue disc
+ * \param packets the number of packets enqueued
+ * \param dequeueInterval the number of packets enqueued per packet dequeued
+ * \return the time elapsed, in ms
+ */
+static int64_t
+Run(Ptr<QueueDisc> qd, uint32_t limit, uint32_t packets, uint32_t dequeueInterval)
+{
+    qd->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, limit));
+    qd->Initialize();
+
+    Ptr<QueueDiscItem> item = Create<BenchQueueDiscItem>(Create<Packet>(1000));
+    while (qd->GetNPackets() < limit)
+    {
+        qd->Enqueue(Create<BenchQueueDiscItem>(Create<Packet>(1000)));
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 1; i <= packets; i++)
+    {
+        qd->Enqueue(item);
+        if (i % dequeueInterval == 0)
+        {
+            qd->Dequeue();
+        }
+    }
+    int64_t delay = time.End();
+
+    QueueDisc::Stats stats = qd->GetStats();
+    NS_ABORT_MSG_UNLESS(stats.nTotalDroppedPackets >= packets - packets / dequeueInterval,
+                        "Packets not dropped");
+    qd->Dispose();
+    Simulator::Destroy();
+    return delay;
+}
+
+/**
+ * Run a benchmark and report its results.
+ *
+ * \param name the name of the queue disc
+ * \param limit the maximum number of packets held by the queue disc
+ * \param packets the number of packets enqueued
+ * \param dequeueInterval the number of packets enqueued per packet dequeued
+ * \param minIterations the number of iterations to minimize the times over
+ */
+template <typename T>
+static void
+Bench(const std::string& name,
+      uint32_t limit,
+      uint32_t packets,
+      uint32_t dequeueInterval,
+      uint32_t minIterations)
+{
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, Run(CreateObject<T>(), limit, packets, dequeueInterval));
+    }
+    Report(name + " enqueue-drop", packets, minDelay);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t packets = 1000000;
+    uint32_t limit = 100;
+    uint32_t dequeueInterval = 10;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the per-packet cost of the AQM disciplines under heavy congestion");
+    cmd.AddValue("packets", "number of packets enqueued in the full queue disc", packets);
+    cmd.AddValue("limit", "maximum number of packets held by the queue disc", limit);
+    cmd.AddValue("dequeue-interval",
+                 "number of packets enqueued per packet dequeued",
+                 dequeueInterval);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(packets == 0, "At least one packet must be enqueued");
+    NS_ABORT_MSG_IF(limit == 0, "The queue disc must hold at least one packet");
+    NS_ABORT_MSG_IF(dequeueInterval == 0, "The dequeue interval must be positive");
+
+    std::cout << "Running bench-queue-disc-drops with packets=" << packets << " limit=" << limit
+              << " dequeue-interval=" << dequeueInterval << std::endl;
+
+    Bench<RedQueueDisc>("Red", limit, packets, dequeueInterval, minIterations);
+    Bench<PieQueueDisc>("Pie", limit, packets, dequeueInterval, minIterations);
+    Bench<CoDelQueueDisc>("CoDel", limit, packets, dequeueInterval, minIterations);
+    return 0;
+}
@@ -149,6 +149,10 @@ CobaltQueueDisc::CobaltQueueDisc()
     : QueueDisc()
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(TARGET_EXCEEDED_DROP);
+    RegisterReason(OVERLIMIT_DROP);
+    RegisterReason(FORCED_MARK);
+    RegisterReason(CE_THRESHOLD_EXCEEDED_MARK);
     InitializeParams();
     m_uv = CreateObject<UniformRandomVariable>();
 }
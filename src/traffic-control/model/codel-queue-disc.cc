@@ -143,6 +143,10 @@ CoDelQueueDisc::CoDelQueueDisc()
       m_dropNext(0)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(TARGET_EXCEEDED_DROP);
+    RegisterReason(OVERLIMIT_DROP);
+    RegisterReason(TARGET_EXCEEDED_MARK);
+    RegisterReason(CE_THRESHOLD_EXCEEDED_MARK);
 }
 
 CoDelQueueDisc::~CoDelQueueDisc()
@@ -50,6 +50,7 @@ FifoQueueDisc::FifoQueueDisc()
     : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(LIMIT_EXCEEDED_DROP);
 }
 
 FifoQueueDisc::~FifoQueueDisc()
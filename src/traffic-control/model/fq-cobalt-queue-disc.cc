@@ -44,16 +44,13 @@ TypeId
 FqCobaltFlow::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::FqCobaltFlow")
-                            .SetParent<QueueDiscClass>()
+                            .SetParent<FqFlow>()
                             .SetGroupName("TrafficControl")
                             .AddConstructor<FqCobaltFlow>();
     return tid;
 }
 
 FqCobaltFlow::FqCobaltFlow()
-    : m_deficit(0),
-      m_status(INACTIVE),
-      m_index(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -63,54 +60,6 @@ FqCobaltFlow::~FqCobaltFlow()
     NS_LOG_FUNCTION(this);
 }
 
-void
-FqCobaltFlow::SetDeficit(uint32_t deficit)
-{
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit = deficit;
-}
-
-int32_t
-FqCobaltFlow::GetDeficit() const
-{
-    NS_LOG_FUNCTION(this);
-    return m_deficit;
-}
-
-void
-FqCobaltFlow::IncreaseDeficit(int32_t deficit)
-{
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit += deficit;
-}
-
-void
-FqCobaltFlow::SetStatus(FlowStatus status)
-{
-    NS_LOG_FUNCTION(this);
-    m_status = status;
-}
-
-FqCobaltFlow::FlowStatus
-FqCobaltFlow::GetStatus() const
-{
-    NS_LOG_FUNCTION(this);
-    return m_status;
-}
-
-void
-FqCobaltFlow::SetIndex(uint32_t index)
-{
-    NS_LOG_FUNCTION(this);
-    m_index = index;
-}
-
-uint32_t
-FqCobaltFlow::GetIndex() const
-{
-    return m_index;
-}
-
 NS_OBJECT_ENSURE_REGISTERED(FqCobaltQueueDisc);
 
 TypeId
@@ -205,6 +154,8 @@ FqCobaltQueueDisc::FqCobaltQueueDisc()
       m_quantum(0)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(UNCLASSIFIED_DROP);
+    RegisterReason(OVERLIMIT_DROP);
 }
 
 FqCobaltQueueDisc::~FqCobaltQueueDisc()
@@ -225,34 +176,14 @@ FqCobaltQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
-uint32_t
-FqCobaltQueueDisc::SetAssociativeHash(uint32_t flowHash)
+void
+FqCobaltQueueDisc::DoDispose()
 {
-    NS_LOG_FUNCTION(this << flowHash);
-
-    uint32_t h = (flowHash % m_flows);
-    uint32_t innerHash = h % m_setWays;
-    uint32_t outerHash = h - innerHash;
-
-    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCobaltFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCobaltFlow::INACTIVE)
-        {
-            // this queue has not been created yet or is associated with this flow
-            // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
-            return i;
-        }
-    }
-
-    // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
-    return outerHash;
+    NS_LOG_FUNCTION(this);
+    m_newFlows.Clear();
+    m_oldFlows.Clear();
+    m_flowTable.Reset(0);
+    QueueDisc::DoDispose();
 }
 
 bool
@@ -265,7 +196,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (GetNPacketFilters() == 0)
     {
-        flowHash = item->Hash(m_perturbation);
+        flowHash = item->GetFlowHash(m_perturbation);
     }
     else
     {
@@ -285,18 +216,18 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (m_enableSetAssociativeHash)
     {
-        h = SetAssociativeHash(flowHash);
+        h = m_flowTable.SetAssociativeHash(flowHash, m_setWays);
     }
     else
     {
         h = flowHash % m_flows;
     }
 
-    Ptr<FqCobaltFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    FqFlow* flow = m_flowTable.Get(h);
+    if (!flow)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqCobaltFlow>();
+        Ptr<FqCobaltFlow> newFlow = m_flowFactory.Create<FqCobaltFlow>();
         Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
         // If Cobalt, Set values of CobaltQueueDisc to match this QueueDisc
         Ptr<CobaltQueueDisc> cobalt = qd->GetObject<CobaltQueueDisc>();
@@ -308,27 +239,25 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
             cobalt->SetAttribute("BlueThreshold", TimeValue(m_blueThreshold));
         }
         qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
+        newFlow->SetQueueDisc(qd);
+        newFlow->SetIndex(h);
+        AddQueueDiscClass(newFlow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqCobaltFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        m_flowTable.Add(newFlow, GetNQueueDiscClasses() - 1);
+        flow = PeekPointer(newFlow);
     }
 
     if (flow->GetStatus() == FqCobaltFlow::INACTIVE)
     {
         flow->SetStatus(FqCobaltFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(flow);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index "
+                                              << m_flowTable.GetClassIndex(h));
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -344,24 +273,23 @@ FqCobaltQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCobaltFlow> flow;
+    FqFlow* flow = nullptr;
     Ptr<QueueDiscItem> item;
 
     do
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            flow = m_newFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_oldFlows.PushBack(m_newFlows.PopFront());
             }
             else
             {
@@ -370,16 +298,15 @@ FqCobaltQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            flow = m_oldFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_oldFlows.PushBack(m_oldFlows.PopFront());
             }
             else
             {
@@ -399,16 +326,15 @@ FqCobaltQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_oldFlows.PushBack(m_newFlows.PopFront());
             }
             else
             {
                 flow->SetStatus(FqCobaltFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -482,6 +408,8 @@ FqCobaltQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.Reset(m_flows);
+
     m_flowFactory.SetTypeId("ns3::FqCobaltFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::CobaltQueueDisc");
@@ -498,27 +426,16 @@ FqCobaltQueueDisc::FqCobaltDrop()
 {
     NS_LOG_FUNCTION(this);
 
-    uint32_t maxBacklog = 0;
-    uint32_t index = 0;
-    Ptr<QueueDisc> qd;
-
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
-    {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
-        {
-            maxBacklog = bytes;
-            index = i;
-        }
-    }
+    FqFlow* flow = m_flowTable.GetFatFlow(m_newFlows, m_oldFlows);
+    NS_ASSERT_MSG(flow, "No packet to drop from the flow queues");
+    Ptr<QueueDisc> qd = flow->GetQueueDisc();
+    uint32_t maxBacklog = qd->GetNBytes();
 
     /* Our goal is to drop half of this fat flow backlog */
     uint32_t len = 0;
     uint32_t count = 0;
     uint32_t threshold = maxBacklog >> 1;
-    qd = GetQueueDiscClass(index)->GetQueueDisc();
     Ptr<QueueDiscItem> item;
 
     do
@@ -530,7 +447,7 @@ FqCobaltQueueDisc::FqCobaltDrop()
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
 
-    return index;
+    return m_flowTable.GetClassIndex(flow->GetIndex());
 }
 
 } // namespace ns3
@@ -38,16 +38,13 @@ TypeId
 FqCoDelFlow::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::FqCoDelFlow")
-                            .SetParent<QueueDiscClass>()
+                            .SetParent<FqFlow>()
                             .SetGroupName("TrafficControl")
                             .AddConstructor<FqCoDelFlow>();
     return tid;
 }
 
 FqCoDelFlow::FqCoDelFlow()
-    : m_deficit(0),
-      m_status(INACTIVE),
-      m_index(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -57,54 +54,6 @@ FqCoDelFlow::~FqCoDelFlow()
     NS_LOG_FUNCTION(this);
 }
 
-void
-FqCoDelFlow::SetDeficit(uint32_t deficit)
-{
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit = deficit;
-}
-
-int32_t
-FqCoDelFlow::GetDeficit() const
-{
-    NS_LOG_FUNCTION(this);
-    return m_deficit;
-}
-
-void
-FqCoDelFlow::IncreaseDeficit(int32_t deficit)
-{
-    NS_LOG_FUNCTION(this << deficit);
-    m_deficit += deficit;
-}
-
-void
-FqCoDelFlow::SetStatus(FlowStatus status)
-{
-    NS_LOG_FUNCTION(this);
-    m_status = status;
-}
-
-FqCoDelFlow::FlowStatus
-FqCoDelFlow::GetStatus() const
-{
-    NS_LOG_FUNCTION(this);
-    return m_status;
-}
-
-void
-FqCoDelFlow::SetIndex(uint32_t index)
-{
-    NS_LOG_FUNCTION(this);
-    m_index = index;
-}
-
-uint32_t
-FqCoDelFlow::GetIndex() const
-{
-    return m_index;
-}
-
 NS_OBJECT_ENSURE_REGISTERED(FqCoDelQueueDisc);
 
 TypeId
@@ -179,6 +128,8 @@ FqCoDelQueueDisc::FqCoDelQueueDisc()
       m_quantum(0)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(UNCLASSIFIED_DROP);
+    RegisterReason(OVERLIMIT_DROP);
 }
 
 FqCoDelQueueDisc::~FqCoDelQueueDisc()
@@ -199,34 +150,14 @@ FqCoDelQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
-uint32_t
-FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
+void
+FqCoDelQueueDisc::DoDispose()
 {
-    NS_LOG_FUNCTION(this << flowHash);
-
-    uint32_t h = (flowHash % m_flows);
-    uint32_t innerHash = h % m_setWays;
-    uint32_t outerHash = h - innerHash;
-
-    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
-        {
-            // this queue has not been created yet or is associated with this flow
-            // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
-            return i;
-        }
-    }
-
-    // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
-    return outerHash;
+    NS_LOG_FUNCTION(this);
+    m_newFlows.Clear();
+    m_oldFlows.Clear();
+    m_flowTable.Reset(0);
+    QueueDisc::DoDispose();
 }
 
 bool
@@ -239,7 +170,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (GetNPacketFilters() == 0)
     {
-        flowHash = item->Hash(m_perturbation);
+        flowHash = item->GetFlowHash(m_perturbation);
     }
     else
     {
@@ -259,18 +190,18 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (m_enableSetAssociativeHash)
     {
-        h = SetAssociativeHash(flowHash);
+        h = m_flowTable.SetAssociativeHash(flowHash, m_setWays);
     }
     else
     {
         h = flowHash % m_flows;
     }
 
-    Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    FqFlow* flow = m_flowTable.Get(h);
+    if (!flow)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqCoDelFlow>();
+        Ptr<FqCoDelFlow> newFlow = m_flowFactory.Create<FqCoDelFlow>();
         Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
         // If CoDel, Set values of CoDelQueueDisc to match this QueueDisc
         Ptr<CoDelQueueDisc> codel = qd->GetObject<CoDelQueueDisc>();
@@ -281,27 +212,25 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
             codel->SetAttribute("UseL4s", BooleanValue(m_useL4s));
         }
         qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
+        newFlow->SetQueueDisc(qd);
+        newFlow->SetIndex(h);
+        AddQueueDiscClass(newFlow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        m_flowTable.Add(newFlow, GetNQueueDiscClasses() - 1);
+        flow = PeekPointer(newFlow);
     }
 
     if (flow->GetStatus() == FqCoDelFlow::INACTIVE)
     {
         flow->SetStatus(FqCoDelFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(flow);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index "
+                                              << m_flowTable.GetClassIndex(h));
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -317,23 +246,23 @@ FqCoDelQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCoDelFlow> flow;
+    FqFlow* flow = nullptr;
     Ptr<QueueDiscItem> item;
 
     do
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            flow = m_newFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
+                m_oldFlows.PushBack(m_newFlows.PopFront());
             }
             else
             {
@@ -342,15 +271,15 @@ FqCoDelQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            flow = m_oldFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
+                m_oldFlows.PushBack(m_oldFlows.PopFront());
             }
             else
             {
@@ -370,16 +299,15 @@ FqCoDelQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_oldFlows.PushBack(m_newFlows.PopFront());
             }
             else
             {
                 flow->SetStatus(FqCoDelFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -453,6 +381,8 @@ FqCoDelQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.Reset(m_flows);
+
     m_flowFactory.SetTypeId("ns3::FqCoDelFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::CoDelQueueDisc");
@@ -466,27 +396,16 @@ FqCoDelQueueDisc::FqCoDelDrop()
 {
     NS_LOG_FUNCTION(this);
 
-    uint32_t maxBacklog = 0;
-    uint32_t index = 0;
-    Ptr<QueueDisc> qd;
-
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
-    {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
-        {
-            maxBacklog = bytes;
-            index = i;
-        }
-    }
+    FqFlow* flow = m_flowTable.GetFatFlow(m_newFlows, m_oldFlows);
+    NS_ASSERT_MSG(flow, "No packet to drop from the flow queues");
+    Ptr<QueueDisc> qd = flow->GetQueueDisc();
+    uint32_t maxBacklog = qd->GetNBytes();
 
     /* Our goal is to drop half of this fat flow backlog */
     uint32_t len = 0;
     uint32_t count = 0;
     uint32_t threshold = maxBacklog >> 1;
-    qd = GetQueueDiscClass(index)->GetQueueDisc();
     Ptr<QueueDiscItem> item;
 
     do
@@ -498,7 +417,7 @@ FqCoDelQueueDisc::FqCoDelDrop()
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
 
-    return index;
+    return m_flowTable.GetClassIndex(flow->GetIndex());
 }
 
 } // namespace ns3
@@ -0,0 +1,252 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "fq-flow-table.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FqFlowTable");
+
+NS_OBJECT_ENSURE_REGISTERED(FqFlow);
+
+TypeId
+FqFlow::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::FqFlow")
+                            .SetParent<QueueDiscClass>()
+                            .SetGroupName("TrafficControl")
+                            .AddConstructor<FqFlow>();
+    return tid;
+}
+
+FqFlow::FqFlow()
+    : m_deficit(0),
+      m_status(INACTIVE),
+      m_index(0),
+      m_next(nullptr)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FqFlow::~FqFlow()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FqFlow::SetDeficit(uint32_t deficit)
+{
+    NS_LOG_FUNCTION(this << deficit);
+    m_deficit = deficit;
+}
+
+int32_t
+FqFlow::GetDeficit() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_deficit;
+}
+
+void
+FqFlow::IncreaseDeficit(int32_t deficit)
+{
+    NS_LOG_FUNCTION(this << deficit);
+    m_deficit += deficit;
+}
+
+void
+FqFlow::SetStatus(FlowStatus status)
+{
+    NS_LOG_FUNCTION(this);
+    m_status = status;
+}
+
+FqFlow::FlowStatus
+FqFlow::GetStatus() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_status;
+}
+
+void
+FqFlow::SetIndex(uint32_t index)
+{
+    NS_LOG_FUNCTION(this);
+    m_index = index;
+}
+
+uint32_t
+FqFlow::GetIndex() const
+{
+    return m_index;
+}
+
+FqFlow*
+FqFlow::GetNext() const
+{
+    return m_next;
+}
+
+FqFlowList::FqFlowList()
+    : m_head(nullptr),
+      m_tail(nullptr)
+{
+}
+
+bool
+FqFlowList::IsEmpty() const
+{
+    return m_head == nullptr;
+}
+
+FqFlow*
+FqFlowList::Front() const
+{
+    return m_head;
+}
+
+void
+FqFlowList::PushBack(FqFlow* flow)
+{
+    NS_ASSERT_MSG(flow && flow->m_next == nullptr && flow != m_tail, "Flow already in a list");
+    if (m_tail)
+    {
+        m_tail->m_next = flow;
+    }
+    else
+    {
+        m_head = flow;
+    }
+    m_tail = flow;
+}
+
+FqFlow*
+FqFlowList::PopFront()
+{
+    NS_ASSERT_MSG(m_head, "The list of flows is empty");
+    FqFlow* flow = m_head;
+    m_head = flow->m_next;
+    if (!m_head)
+    {
+        m_tail = nullptr;
+    }
+    flow->m_next = nullptr;
+    return flow;
+}
+
+void
+FqFlowList::Clear()
+{
+    while (m_head)
+    {
+        PopFront();
+    }
+}
+
+FqFlowTable::FqFlowTable()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FqFlowTable::Reset(uint32_t nFlows)
+{
+    NS_LOG_FUNCTION(this << nFlows);
+    m_entries.assign(nFlows, Entry());
+}
+
+FqFlow*
+FqFlowTable::Get(uint32_t index) const
+{
+    NS_ASSERT_MSG(index < m_entries.size(), "Flow queue index out of range: " << index);
+    return m_entries[index].flow;
+}
+
+uint32_t
+FqFlowTable::GetClassIndex(uint32_t index) const
+{
+    NS_ASSERT_MSG(Get(index), "Flow queue " << index << " not created");
+    return m_entries[index].classIndex;
+}
+
+void
+FqFlowTable::Add(Ptr<FqFlow> flow, uint32_t classIndex)
+{
+    NS_LOG_FUNCTION(this << flow << classIndex);
+    uint32_t index = flow->GetIndex();
+    NS_ASSERT_MSG(!Get(index), "Flow queue " << index << " already created");
+    m_entries[index].flow = PeekPointer(flow);
+    m_entries[index].classIndex = classIndex;
+}
+
+uint32_t
+FqFlowTable::SetAssociativeHash(uint32_t flowHash, uint32_t setWays)
+{
+    NS_LOG_FUNCTION(this << flowHash << setWays);
+
+    uint32_t h = (flowHash % m_entries.size());
+    uint32_t innerHash = h % setWays;
+    uint32_t outerHash = h - innerHash;
+
+    for (uint32_t i = outerHash; i < outerHash + setWays; i++)
+    {
+        Entry& entry = m_entries[i];
+
+        if (!entry.flow || (entry.tagged && entry.tag == flowHash) ||
+            entry.flow->GetStatus() == FqFlow::INACTIVE)
+        {
+            // this queue has not been created yet or is associated with this flow
+            // or is inactive, hence we can use it
+            entry.tag = flowHash;
+            entry.tagged = true;
+            return i;
+        }
+    }
+
+    // all the queues of the set are used. Use the first queue of the set
+    m_entries[outerHash].tag = flowHash;
+    m_entries[outerHash].tagged = true;
+    return outerHash;
+}
+
+FqFlow*
+FqFlowTable::GetFatFlow(const FqFlowList& newFlows, const FqFlowList& oldFlows) const
+{
+    NS_LOG_FUNCTION(this);
+
+    FqFlow* fat = nullptr;
+    uint32_t maxBacklog = 0;
+
+    for (const FqFlowList* list : {&newFlows, &oldFlows})
+    {
+        for (FqFlow* flow = list->Front(); flow; flow = flow->GetNext())
+        {
+            uint32_t bytes = flow->GetQueueDisc()->GetNBytes();
+            if (bytes > maxBacklog ||
+                (bytes > 0 && bytes == maxBacklog &&
+                 GetClassIndex(flow->GetIndex()) < GetClassIndex(fat->GetIndex())))
+            {
+                maxBacklog = bytes;
+                fat = flow;
+            }
+        }
+    }
+    return fat;
+}
+
+} // namespace ns3
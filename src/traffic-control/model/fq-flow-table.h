@@ -0,0 +1,228 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FQ_FLOW_TABLE_H
+#define FQ_FLOW_TABLE_H
+
+#include "ns3/queue-disc.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A flow queue used by the flow queueing disciplines (FqCoDel, FqCobalt
+ * and FqPie), scheduled with Deficit Round Robin.
+ *
+ * A flow is in at most one list of flows (the new or the old flows) at a
+ * time, hence it stores the link to the next flow of its list.
+ */
+class FqFlow : public QueueDiscClass
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    /**
+     * \brief FqFlow constructor
+     */
+    FqFlow();
+
+    ~FqFlow() override;
+
+    /**
+     * \enum FlowStatus
+     * \brief Used to determine the status of this flow queue
+     */
+    enum FlowStatus
+    {
+        INACTIVE,
+        NEW_FLOW,
+        OLD_FLOW
+    };
+
+    /**
+     * \brief Set the deficit for this flow
+     * \param deficit the deficit for this flow
+     */
+    void SetDeficit(uint32_t deficit);
+    /**
+     * \brief Get the deficit for this flow
+     * \return the deficit for this flow
+     */
+    int32_t GetDeficit() const;
+    /**
+     * \brief Increase the deficit for this flow
+     * \param deficit the amount by which the deficit is to be increased
+     */
+    void IncreaseDeficit(int32_t deficit);
+    /**
+     * \brief Set the status for this flow
+     * \param status the status for this flow
+     */
+    void SetStatus(FlowStatus status);
+    /**
+     * \brief Get the status of this flow
+     * \return the status of this flow
+     */
+    FlowStatus GetStatus() const;
+    /**
+     * \brief Set the index for this flow
+     * \param index the index for this flow
+     */
+    void SetIndex(uint32_t index);
+    /**
+     * \brief Get the index of this flow
+     * \return the index of this flow
+     */
+    uint32_t GetIndex() const;
+    /**
+     * \brief Get the next flow of the list of flows this flow is in
+     * \return the next flow, or a null pointer if this flow is the last one
+     */
+    FqFlow* GetNext() const;
+
+  private:
+    friend class FqFlowList;
+
+    int32_t m_deficit;   //!< the deficit for this flow
+    FlowStatus m_status; //!< the status of this flow
+    uint32_t m_index;    //!< the index for this flow
+    FqFlow* m_next;      //!< the next flow of the list of flows this flow is in
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief An intrusive FIFO list of flows (the new or the old flows of the
+ * DRR scheduler).
+ *
+ * Moving a flow from a list to another does not allocate memory.  The list
+ * does not own the flows, which are the classes of the queue disc.
+ */
+class FqFlowList
+{
+  public:
+    FqFlowList();
+
+    /**
+     * \return true if the list is empty
+     */
+    bool IsEmpty() const;
+    /**
+     * \return the first flow of the list, or a null pointer if the list is empty
+     */
+    FqFlow* Front() const;
+    /**
+     * \brief Append a flow, which must not be in a list, at the end of the list
+     * \param flow the flow
+     */
+    void PushBack(FqFlow* flow);
+    /**
+     * \brief Remove the first flow of the list, which must not be empty
+     * \return the flow removed
+     */
+    FqFlow* PopFront();
+    /**
+     * \brief Remove all the flows from the list
+     */
+    void Clear();
+
+  private:
+    FqFlow* m_head; //!< first flow of the list
+    FqFlow* m_tail; //!< last flow of the list
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief The table of the flow queues of a flow queueing discipline, indexed
+ * by the index of the flow queue (i.e., the hash of the flow modulo the number
+ * of flow queues).
+ *
+ * The flow queues are created on demand, when the first packet with a given
+ * index is enqueued.  The table also stores the tags used by the set
+ * associative hash.
+ */
+class FqFlowTable
+{
+  public:
+    FqFlowTable();
+
+    /**
+     * \brief Remove all the flows and size the table
+     * \param nFlows the number of flow queues
+     */
+    void Reset(uint32_t nFlows);
+    /**
+     * \param index the index of the flow queue
+     * \return the flow queue, or a null pointer if it has not been created yet
+     */
+    FqFlow* Get(uint32_t index) const;
+    /**
+     * \param index the index of the flow queue, which must have been created
+     * \return the index of the flow queue among the classes of the queue disc
+     */
+    uint32_t GetClassIndex(uint32_t index) const;
+    /**
+     * \brief Add a flow queue
+     * \param flow the flow queue, whose index has been set
+     * \param classIndex the index of the flow queue among the classes of the queue disc
+     */
+    void Add(Ptr<FqFlow> flow, uint32_t classIndex);
+    /**
+     * Compute the index of the queue for the flow having the given flowHash,
+     * according to the set associative hash approach.
+     *
+     * \param flowHash the hash of the flow 5-tuple
+     * \param setWays the size of a set of queues
+     * \return the index of the queue for the given flow
+     */
+    uint32_t SetAssociativeHash(uint32_t flowHash, uint32_t setWays);
+    /**
+     * \brief Get the flow queue with the largest current byte count.
+     *
+     * Only the flows of the given lists (i.e., the active flows) are
+     * considered, since the inactive flows are empty.  Among the flows
+     * with the largest byte count, the one created first is returned.
+     *
+     * \param newFlows the list of new flows
+     * \param oldFlows the list of old flows
+     * \return the flow queue with the largest current byte count, or a null
+     *         pointer if all the flow queues are empty
+     */
+    FqFlow* GetFatFlow(const FqFlowList& newFlows, const FqFlowList& oldFlows) const;
+
+  private:
+    /// An entry of the table
+    struct Entry
+    {
+        FqFlow* flow{nullptr};  //!< the flow queue, if created
+        uint32_t classIndex{0}; //!< the index of the flow queue among the classes
+        uint32_t tag{0};        //!< the tag used by set associative hash
+        bool tagged{false};     //!< whether the tag has been set
+    };
+
+    std::vector<Entry> m_entries; //!< the entries, indexed by the index of the flow queue
+};
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_TABLE_H */
@@ -0,0 +1,724 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "htb-queue-disc.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("HtbQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED(HtbClass);
+
+TypeId
+HtbClass::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::HtbClass")
+            .SetParent<QueueDiscClass>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<HtbClass>()
+            .AddAttribute("Rate",
+                          "The rate guaranteed to the class",
+                          DataRateValue(DataRate("1Mb/s")),
+                          MakeDataRateAccessor(&HtbClass::m_rate),
+                          MakeDataRateChecker())
+            .AddAttribute("Ceil",
+                          "The maximum rate of the class. If null, it is set to the rate",
+                          DataRateValue(DataRate("0b/s")),
+                          MakeDataRateAccessor(&HtbClass::m_ceil),
+                          MakeDataRateChecker())
+            .AddAttribute("Burst",
+                          "The size of the bucket of the rate, in bytes. If null, it is "
+                          "set to the bytes sent at the rate in 1ms plus 1600 bytes",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbClass::m_burst),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Cburst",
+                          "The size of the bucket of the ceil rate, in bytes. If null, it "
+                          "is set to the bytes sent at the ceil rate in 1ms plus 1600 bytes",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbClass::m_cburst),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Priority",
+                          "The priority of the class (the lower, the higher the priority) "
+                          "when borrowing bandwidth",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbClass::m_priority),
+                          MakeUintegerChecker<uint32_t>(0, HtbQueueDisc::N_PRIORITIES - 1))
+            .AddAttribute("Quantum",
+                          "The bytes a leaf class sends in a round when borrowing "
+                          "bandwidth. If null, it is set to the bytes sent at the rate "
+                          "in a second, divided by the R2q attribute of the queue disc",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbClass::m_quantum),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+HtbClass::HtbClass()
+    : m_id(0),
+      m_level(0),
+      m_mode(CAN_SEND),
+      m_activity(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HtbClass::~HtbClass()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+HtbClass::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_parent = nullptr;
+    QueueDiscClass::DoDispose();
+}
+
+void
+HtbClass::SetParent(Ptr<HtbClass> parent)
+{
+    NS_LOG_FUNCTION(this << parent);
+    m_parent = parent;
+}
+
+Ptr<HtbClass>
+HtbClass::GetParent() const
+{
+    return m_parent;
+}
+
+DataRate
+HtbClass::GetRate() const
+{
+    return m_rate;
+}
+
+DataRate
+HtbClass::GetCeil() const
+{
+    return m_ceil;
+}
+
+uint32_t
+HtbClass::GetPriority() const
+{
+    return m_priority;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(HtbQueueDisc);
+
+/**
+ * \return the maximum time elapsed since the last update of the tokens of a class
+ */
+static Time
+MaxElapsed()
+{
+    static const Time maxElapsed = Seconds(60);
+    return maxElapsed;
+}
+
+TypeId
+HtbQueueDisc::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::HtbQueueDisc")
+            .SetParent<QueueDisc>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<HtbQueueDisc>()
+            .AddAttribute("DefaultClass",
+                          "The index of the leaf class of the packets that no packet "
+                          "filter is able to classify",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbQueueDisc::m_defaultClass),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("R2q",
+                          "The divisor of the bytes sent at the rate of a class in a "
+                          "second, which yields the default quantum of the class",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&HtbQueueDisc::m_r2q),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+HtbQueueDisc::HtbQueueDisc()
+    : QueueDisc(QueueDiscSizePolicy::NO_LIMITS)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HtbQueueDisc::~HtbQueueDisc()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+HtbQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_watchdog);
+    m_htbClasses.clear();
+    for (auto& cl : m_innerClasses)
+    {
+        cl->Dispose();
+    }
+    m_innerClasses.clear();
+    m_waitQueue.clear();
+    QueueDisc::DoDispose();
+}
+
+bool
+HtbQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+
+    uint32_t index = m_defaultClass;
+    int32_t ret = Classify(item);
+
+    if (ret == PacketFilter::PF_NO_MATCH)
+    {
+        NS_LOG_DEBUG("No filter has been able to classify this packet, using the default class");
+    }
+    else if (ret >= 0 && static_cast<uint32_t>(ret) < GetNQueueDiscClasses())
+    {
+        index = ret;
+    }
+
+    HtbClass* cl = m_htbClasses[index];
+    Ptr<QueueDisc> qd = cl->GetQueueDisc();
+    bool retval = qd->Enqueue(item);
+
+    // If Queue::Enqueue fails, QueueDisc::Drop is called by the child queue disc
+    // because QueueDisc::AddQueueDiscClass sets the drop callback
+
+    if (!cl->m_activity && qd->GetNPackets() > 0)
+    {
+        Activate(cl);
+    }
+
+    NS_LOG_LOGIC("Number packets class " << index << ": " << qd->GetNPackets());
+
+    return retval;
+}
+
+Ptr<QueueDiscItem>
+HtbQueueDisc::DoDequeue()
+{
+    NS_LOG_FUNCTION(this);
+
+    Time now = Simulator::Now();
+    ProcessWaitQueue(now);
+
+    // the rows of the lowest level are served first, then the rows of the
+    // highest priority (i.e., the lowest value)
+    for (uint32_t level = 0; level < MAX_DEPTH; level++)
+    {
+        for (uint32_t priority = 0; priority < N_PRIORITIES && m_rowMasks[level]; priority++)
+        {
+            Ptr<QueueDiscItem> item;
+            if ((m_rowMasks[level] & (1 << priority)) &&
+                (item = DequeueTree(priority, level, now)))
+            {
+                return item;
+            }
+        }
+    }
+
+    // No class can send. Wake the queue disc when the first class changes mode
+    if (GetNPackets() > 0 && !m_waitQueue.empty())
+    {
+        Time next = m_waitQueue.begin()->first;
+        if (m_watchdog.IsExpired() || TimeStep(m_watchdog.GetTs()) > next)
+        {
+            Simulator::Cancel(m_watchdog);
+            m_watchdog = Simulator::Schedule(next - now, &QueueDisc::Run, this);
+            NS_LOG_LOGIC("Waking event scheduled in " << (next - now).As(Time::S));
+        }
+    }
+    return nullptr;
+}
+
+void
+HtbQueueDisc::ProcessWaitQueue(Time now)
+{
+    NS_LOG_FUNCTION(this << now);
+
+    while (!m_waitQueue.empty() && m_waitQueue.begin()->first <= now)
+    {
+        HtbClass* cl = m_htbClasses[m_waitQueue.begin()->second];
+        m_waitQueue.erase(m_waitQueue.begin());
+
+        Time diff = std::min(now - cl->m_checkPoint, MaxElapsed());
+        ChangeMode(cl, diff);
+        if (cl->m_mode != HtbClass::CAN_SEND)
+        {
+            AddToWaitQueue(cl, now + diff);
+        }
+    }
+}
+
+Ptr<QueueDiscItem>
+HtbQueueDisc::DequeueTree(uint32_t priority, uint32_t level, Time now)
+{
+    NS_LOG_FUNCTION(this << priority << level);
+
+    HtbClass* start = LookupLeaf(priority, level);
+    HtbClass* cl = start;
+    Ptr<QueueDiscItem> item;
+
+    while (cl)
+    {
+        Ptr<QueueDisc> qd = cl->GetQueueDisc();
+        if ((item = qd->Dequeue()))
+        {
+            break;
+        }
+
+        // the child queue disc is not work-conserving or dropped its packets
+        if (qd->GetNPackets() == 0)
+        {
+            Deactivate(cl);
+            if (cl == start)
+            {
+                start = nullptr;
+            }
+        }
+        else
+        {
+            AdvanceLeaf(cl, priority, level);
+        }
+        cl = LookupLeaf(priority, level);
+        if (!start)
+        {
+            start = cl;
+        }
+        else if (cl == start)
+        {
+            return nullptr;
+        }
+    }
+
+    if (!item)
+    {
+        return nullptr;
+    }
+
+    // serve the next leaf class when the deficit of this one is exhausted
+    uint32_t bytes = item->GetSize();
+    cl->m_deficits[level] -= bytes;
+    if (cl->m_deficits[level] < 0)
+    {
+        cl->m_deficits[level] += cl->m_quantum;
+        AdvanceLeaf(cl, priority, level);
+    }
+
+    if (cl->GetQueueDisc()->GetNPackets() == 0)
+    {
+        Deactivate(cl);
+    }
+    Charge(cl, level, bytes, now);
+
+    NS_LOG_LOGIC("Popped from class " << cl->m_id << " borrowing from level " << level << ": "
+                                      << item);
+    return item;
+}
+
+HtbClass*
+HtbQueueDisc::LookupLeaf(uint32_t priority, uint32_t level)
+{
+    NS_LOG_FUNCTION(this << priority << level);
+
+    HtbClass::RoundRobin* rr = &m_rows[level][priority];
+    while (!rr->ids.empty())
+    {
+        auto it = rr->ids.lower_bound(rr->next);
+        if (it == rr->ids.end())
+        {
+            it = rr->ids.begin();
+        }
+        rr->next = *it;
+        HtbClass* cl = m_htbClasses[*it];
+        if (cl->m_level == 0)
+        {
+            return cl;
+        }
+        rr = &cl->m_feeds[priority];
+    }
+    return nullptr;
+}
+
+void
+HtbQueueDisc::AdvanceLeaf(HtbClass* cl, uint32_t priority, uint32_t level)
+{
+    NS_LOG_FUNCTION(this << cl << priority << level);
+
+    // a leaf class found from a row of a level above 0 borrows from an ancestor,
+    // hence it is linked to its parent
+    HtbClass::RoundRobin& rr = (level > 0 ? cl->m_parent->m_feeds[priority] : m_rows[0][priority]);
+    rr.next = cl->m_id + 1;
+}
+
+void
+HtbQueueDisc::Charge(HtbClass* cl, uint32_t level, uint32_t bytes, Time now)
+{
+    NS_LOG_FUNCTION(this << cl << level << bytes);
+
+    for (; cl; cl = PeekPointer(cl->m_parent))
+    {
+        Time diff = std::min(now - cl->m_checkPoint, MaxElapsed());
+        if (cl->m_level >= level)
+        {
+            // this class sends at its rate or lends to its descendants
+            cl->m_tokens = std::min(cl->m_tokens + diff, cl->m_buffer) -
+                           cl->m_rate.CalculateBytesTxTime(bytes);
+            cl->m_tokens = std::max(cl->m_tokens, Time(0) - MaxElapsed());
+        }
+        else
+        {
+            // this class borrows from an ancestor
+            cl->m_tokens = std::min(cl->m_tokens + diff, cl->m_buffer);
+        }
+        cl->m_ctokens = std::min(cl->m_ctokens + diff, cl->m_cbuffer) -
+                        cl->m_ceil.CalculateBytesTxTime(bytes);
+        cl->m_ctokens = std::max(cl->m_ctokens, Time(0) - MaxElapsed());
+        cl->m_checkPoint = now;
+
+        HtbClass::Mode oldMode = cl->m_mode;
+        diff = Time(0);
+        ChangeMode(cl, diff);
+        if (oldMode != cl->m_mode)
+        {
+            if (oldMode != HtbClass::CAN_SEND)
+            {
+                m_waitQueue.erase({cl->m_waitUntil, cl->m_id});
+            }
+            if (cl->m_mode != HtbClass::CAN_SEND)
+            {
+                AddToWaitQueue(cl, now + diff);
+            }
+        }
+    }
+}
+
+void
+HtbQueueDisc::ChangeMode(HtbClass* cl, Time& diff)
+{
+    NS_LOG_FUNCTION(this << cl);
+
+    HtbClass::Mode mode;
+    Time toks = cl->m_ctokens + diff;
+    if (toks.IsStrictlyNegative())
+    {
+        diff = Time(0) - toks;
+        mode = HtbClass::CANT_SEND;
+    }
+    else if ((toks = cl->m_tokens + diff).IsPositive())
+    {
+        mode = HtbClass::CAN_SEND;
+    }
+    else
+    {
+        diff = Time(0) - toks;
+        mode = HtbClass::MAY_BORROW;
+    }
+
+    if (mode == cl->m_mode)
+    {
+        return;
+    }
+
+    NS_LOG_LOGIC("Class " << cl->m_id << " changes mode from " << cl->m_mode << " to " << mode);
+    if (cl->m_activity)
+    {
+        if (cl->m_mode != HtbClass::CANT_SEND)
+        {
+            DeactivatePriorities(cl);
+        }
+        cl->m_mode = mode;
+        if (mode != HtbClass::CANT_SEND)
+        {
+            ActivatePriorities(cl);
+        }
+    }
+    else
+    {
+        cl->m_mode = mode;
+    }
+}
+
+void
+HtbQueueDisc::Activate(HtbClass* cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+    cl->m_activity = 1 << cl->m_priority;
+    ActivatePriorities(cl);
+}
+
+void
+HtbQueueDisc::Deactivate(HtbClass* cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+    DeactivatePriorities(cl);
+    cl->m_activity = 0;
+}
+
+void
+HtbQueueDisc::ActivatePriorities(HtbClass* cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+
+    uint8_t mask = cl->m_activity;
+    HtbClass* parent = PeekPointer(cl->m_parent);
+
+    // a class that may borrow is linked to its parent, which in turn is linked
+    // to its own parent for the priorities it was not yet active for
+    while (cl->m_mode == HtbClass::MAY_BORROW && parent && mask)
+    {
+        uint8_t newMask = 0;
+        for (uint32_t priority = 0; priority < N_PRIORITIES; priority++)
+        {
+            if (!(mask & (1 << priority)))
+            {
+                continue;
+            }
+            if (parent->m_feeds[priority].ids.empty())
+            {
+                newMask |= 1 << priority;
+            }
+            parent->m_feeds[priority].ids.insert(cl->m_id);
+        }
+        parent->m_activity |= newMask;
+        cl = parent;
+        parent = PeekPointer(cl->m_parent);
+        mask = newMask;
+    }
+
+    if (cl->m_mode == HtbClass::CAN_SEND && mask)
+    {
+        for (uint32_t priority = 0; priority < N_PRIORITIES; priority++)
+        {
+            if (!(mask & (1 << priority)))
+            {
+                continue;
+            }
+            m_rows[cl->m_level][priority].ids.insert(cl->m_id);
+            m_rowMasks[cl->m_level] |= 1 << priority;
+        }
+    }
+}
+
+void
+HtbQueueDisc::DeactivatePriorities(HtbClass* cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+
+    uint8_t mask = cl->m_activity;
+    HtbClass* parent = PeekPointer(cl->m_parent);
+
+    while (cl->m_mode == HtbClass::MAY_BORROW && parent && mask)
+    {
+        uint8_t newMask = 0;
+        for (uint32_t priority = 0; priority < N_PRIORITIES; priority++)
+        {
+            if (!(mask & (1 << priority)))
+            {
+                continue;
+            }
+            parent->m_feeds[priority].ids.erase(cl->m_id);
+            if (parent->m_feeds[priority].ids.empty())
+            {
+                newMask |= 1 << priority;
+            }
+        }
+        parent->m_activity &= ~newMask;
+        cl = parent;
+        parent = PeekPointer(cl->m_parent);
+        mask = newMask;
+    }
+
+    if (cl->m_mode == HtbClass::CAN_SEND && mask)
+    {
+        for (uint32_t priority = 0; priority < N_PRIORITIES; priority++)
+        {
+            if (!(mask & (1 << priority)))
+            {
+                continue;
+            }
+            m_rows[cl->m_level][priority].ids.erase(cl->m_id);
+            if (m_rows[cl->m_level][priority].ids.empty())
+            {
+                m_rowMasks[cl->m_level] &= ~(1 << priority);
+            }
+        }
+    }
+}
+
+void
+HtbQueueDisc::AddToWaitQueue(HtbClass* cl, Time time)
+{
+    NS_LOG_FUNCTION(this << cl << time);
+    cl->m_waitUntil = time;
+    m_waitQueue.insert({time, cl->m_id});
+}
+
+bool
+HtbQueueDisc::CheckConfig()
+{
+    NS_LOG_FUNCTION(this);
+    if (GetNInternalQueues() > 0)
+    {
+        NS_LOG_ERROR("HtbQueueDisc cannot have internal queues");
+        return false;
+    }
+
+    if (GetNQueueDiscClasses() == 0)
+    {
+        NS_LOG_ERROR("HtbQueueDisc needs at least a leaf class");
+        return false;
+    }
+
+    if (m_defaultClass >= GetNQueueDiscClasses())
+    {
+        NS_LOG_ERROR("The default class of HtbQueueDisc is not a leaf class");
+        return false;
+    }
+
+    // the leaf classes are the classes of the queue disc, followed by the inner
+    // classes, which are the ancestors of the leaf classes
+    m_htbClasses.clear();
+    m_innerClasses.clear();
+    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        Ptr<HtbClass> cl = DynamicCast<HtbClass>(GetQueueDiscClass(i));
+        if (!cl)
+        {
+            NS_LOG_ERROR("The classes of HtbQueueDisc must be HtbClass objects");
+            return false;
+        }
+        m_htbClasses.push_back(PeekPointer(cl));
+    }
+
+    std::set<HtbClass*> inner;
+    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        // the ancestors of the leaf class, from its parent to its root class
+        std::vector<HtbClass*> ancestors;
+        for (Ptr<HtbClass> p = m_htbClasses[i]->GetParent(); p; p = p->GetParent())
+        {
+            if (p->GetQueueDisc())
+            {
+                NS_LOG_ERROR("The parent of an HtbClass cannot have a child queue disc");
+                return false;
+            }
+            if (ancestors.size() == MAX_DEPTH - 1)
+            {
+                NS_LOG_ERROR("The hierarchy of HtbClass objects is too deep or has a cycle");
+                return false;
+            }
+            ancestors.push_back(PeekPointer(p));
+        }
+
+        // an inner class at depth d (0 for the root classes) has level MAX_DEPTH - 1 - d
+        for (uint32_t d = 0; d < ancestors.size(); d++)
+        {
+            HtbClass* p = ancestors[ancestors.size() - 1 - d];
+            if (inner.insert(p).second)
+            {
+                p->m_id = m_htbClasses.size();
+                p->m_level = MAX_DEPTH - 1 - d;
+                m_htbClasses.push_back(p);
+                m_innerClasses.push_back(p);
+            }
+        }
+    }
+
+    for (auto cl : m_htbClasses)
+    {
+        if (cl->m_rate.GetBitRate() == 0)
+        {
+            NS_LOG_ERROR("The rate of an HtbClass must be positive");
+            return false;
+        }
+        if (cl->m_ceil.GetBitRate() != 0 && cl->m_ceil < cl->m_rate)
+        {
+            NS_LOG_ERROR("The ceil rate of an HtbClass cannot be less than its rate");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+HtbQueueDisc::InitializeParams()
+{
+    NS_LOG_FUNCTION(this);
+
+    Time now = Simulator::Now();
+    for (uint32_t i = 0; i < m_htbClasses.size(); i++)
+    {
+        HtbClass* cl = m_htbClasses[i];
+        cl->m_id = i;
+        if (i < GetNQueueDiscClasses())
+        {
+            cl->m_level = 0;
+        }
+        if (cl->m_ceil.GetBitRate() == 0)
+        {
+            cl->m_ceil = cl->m_rate;
+        }
+        // the default buckets hold the bytes sent in 1ms plus a few packets
+        if (cl->m_burst == 0)
+        {
+            cl->m_burst = cl->m_rate.GetBitRate() / 8000 + 1600;
+        }
+        if (cl->m_cburst == 0)
+        {
+            cl->m_cburst = cl->m_ceil.GetBitRate() / 8000 + 1600;
+        }
+        if (cl->m_quantum == 0)
+        {
+            cl->m_quantum = std::clamp<uint64_t>(cl->m_rate.GetBitRate() / 8 / m_r2q, 1000, 200000);
+        }
+
+        cl->m_buffer = cl->m_rate.CalculateBytesTxTime(cl->m_burst);
+        cl->m_cbuffer = cl->m_ceil.CalculateBytesTxTime(cl->m_cburst);
+        cl->m_tokens = cl->m_buffer;
+        cl->m_ctokens = cl->m_cbuffer;
+        cl->m_checkPoint = now;
+        cl->m_mode = HtbClass::CAN_SEND;
+        cl->m_activity = 0;
+        cl->m_feeds.assign(cl->m_level > 0 ? N_PRIORITIES : 0, HtbClass::RoundRobin());
+        cl->m_deficits.assign(cl->m_level == 0 ? MAX_DEPTH : 0, 0);
+    }
+
+    for (auto& rows : m_rows)
+    {
+        rows.fill(HtbClass::RoundRobin());
+    }
+    m_rowMasks.fill(0);
+    m_waitQueue.clear();
+}
+
+} // namespace ns3
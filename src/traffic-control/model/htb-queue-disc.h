@@ -0,0 +1,270 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HTB_QUEUE_DISC_H
+#define HTB_QUEUE_DISC_H
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/queue-disc.h"
+
+#include <array>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class HtbQueueDisc;
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A class of an HTB queue disc.
+ *
+ * A class is guaranteed to send at its rate and may borrow the unused
+ * bandwidth of its ancestors up to its ceil rate. Leaf classes have a child
+ * queue disc and are added to the HTB queue disc as its queue disc classes;
+ * inner classes have no child queue disc and are only reachable through the
+ * parents of the leaf classes.
+ */
+class HtbClass : public QueueDiscClass
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    /**
+     * \brief HtbClass constructor
+     */
+    HtbClass();
+
+    ~HtbClass() override;
+
+    /**
+     * \brief Set the parent of this class
+     * \param parent the parent class, which must not have a child queue disc,
+     *        or a null pointer if this class is a root class
+     */
+    void SetParent(Ptr<HtbClass> parent);
+    /**
+     * \brief Get the parent of this class
+     * \return the parent class, or a null pointer if this class is a root class
+     */
+    Ptr<HtbClass> GetParent() const;
+    /**
+     * \brief Get the rate guaranteed to this class
+     * \return the rate guaranteed to this class
+     */
+    DataRate GetRate() const;
+    /**
+     * \brief Get the maximum rate of this class
+     * \return the maximum rate of this class
+     */
+    DataRate GetCeil() const;
+    /**
+     * \brief Get the priority of this class
+     * \return the priority of this class
+     */
+    uint32_t GetPriority() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    friend class HtbQueueDisc;
+
+    /// The mode of a class
+    enum Mode
+    {
+        CANT_SEND,  //!< The class exceeds its ceil rate
+        MAY_BORROW, //!< The class exceeds its rate, but not its ceil rate
+        CAN_SEND    //!< The class does not exceed its rate
+    };
+
+    /// A set of classes served in round robin order
+    struct RoundRobin
+    {
+        std::set<uint32_t> ids; //!< the identifiers of the classes
+        uint32_t next{0};       //!< the identifier of the class to serve next, if present
+    };
+
+    /* parameters of the class */
+    Ptr<HtbClass> m_parent; //!< The parent class
+    DataRate m_rate;        //!< The rate guaranteed to the class
+    DataRate m_ceil;        //!< The maximum rate of the class
+    uint32_t m_burst;       //!< The size of the bucket of the rate, in bytes
+    uint32_t m_cburst;      //!< The size of the bucket of the ceil rate, in bytes
+    uint32_t m_priority;    //!< The priority of the class
+    uint32_t m_quantum;     //!< The quantum of the class, in bytes
+
+    /* variables of the scheduler */
+    uint32_t m_id;                   //!< The identifier of the class in the queue disc
+    uint32_t m_level;                //!< The level of the class (0 for leaf classes)
+    Mode m_mode;                     //!< The current mode of the class
+    Time m_buffer;                   //!< The time needed to send m_burst bytes at m_rate
+    Time m_cbuffer;                  //!< The time needed to send m_cburst bytes at m_ceil
+    Time m_tokens;                   //!< The tokens of the rate, as a time
+    Time m_ctokens;                  //!< The tokens of the ceil rate, as a time
+    Time m_checkPoint;               //!< The last time the tokens were updated
+    Time m_waitUntil;                //!< The time the class changes mode, if not CAN_SEND
+    uint8_t m_activity;              //!< The priorities of the backlogged leaves in the subtree
+    std::vector<RoundRobin> m_feeds; //!< The children that may borrow, by priority
+    std::vector<int32_t> m_deficits; //!< The deficits of a leaf class, by level
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A Hierarchical Token Bucket (HTB) queue disc.
+ *
+ * HTB shapes the traffic of a hierarchy of classes, each of which is
+ * guaranteed to send at its rate and may borrow the bandwidth unused by its
+ * ancestors up to its ceil rate. Packets are classified by the packet filters
+ * into a leaf class (the value returned by the packet filters is the index of
+ * the leaf class among the classes of the queue disc), or into the default
+ * class if no packet filter is able to classify them.
+ *
+ * As in Linux, the classes that are neither backlogged nor able to lend are
+ * not considered by the scheduler: the backlogged leaf classes that can send
+ * or may borrow are linked to the ancestor they borrow from, and the classes
+ * that exceed their rate are kept in a single wait queue, ordered by the time
+ * they change mode. Hence, the class to serve is selected in logarithmic time
+ * in the number of classes, and a single timer is scheduled when no class can
+ * send, rather than an event per class.
+ */
+class HtbQueueDisc : public QueueDisc
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    /**
+     * \brief HtbQueueDisc constructor
+     */
+    HtbQueueDisc();
+
+    ~HtbQueueDisc() override;
+
+    /// Maximum depth of the class hierarchy
+    static constexpr uint32_t MAX_DEPTH = 8;
+    /// Number of priorities of the classes
+    static constexpr uint32_t N_PRIORITIES = 8;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    bool DoEnqueue(Ptr<QueueDiscItem> item) override;
+    Ptr<QueueDiscItem> DoDequeue() override;
+    bool CheckConfig() override;
+    void InitializeParams() override;
+
+    /**
+     * \brief Update the mode of the classes whose waiting time has elapsed
+     * \param now the current time
+     */
+    void ProcessWaitQueue(Time now);
+    /**
+     * \brief Dequeue a packet from a leaf class borrowing from a class in a row
+     * \param priority the priority of the row
+     * \param level the level of the row
+     * \param now the current time
+     * \return the packet, or a null pointer if no packet was dequeued
+     */
+    Ptr<QueueDiscItem> DequeueTree(uint32_t priority, uint32_t level, Time now);
+    /**
+     * \brief Get the leaf class to serve next among the ones borrowing from the
+     *        classes of a row
+     * \param priority the priority of the row
+     * \param level the level of the row
+     * \return the leaf class, or a null pointer if the row is empty
+     */
+    HtbClass* LookupLeaf(uint32_t priority, uint32_t level);
+    /**
+     * \brief Serve the class following the given leaf class next
+     * \param cl the leaf class
+     * \param priority the priority of the row the leaf class was found from
+     * \param level the level of the row the leaf class was found from
+     */
+    void AdvanceLeaf(HtbClass* cl, uint32_t priority, uint32_t level);
+    /**
+     * \brief Charge the classes from a leaf class to its root class for a packet
+     * \param cl the leaf class
+     * \param level the level of the class the leaf class borrowed from
+     * \param bytes the size of the packet
+     * \param now the current time
+     */
+    void Charge(HtbClass* cl, uint32_t level, uint32_t bytes, Time now);
+    /**
+     * \brief Update the mode of a class
+     * \param cl the class
+     * \param diff the time elapsed since the last update of the tokens, set to the
+     *        time until the class changes mode, if the class cannot send
+     */
+    void ChangeMode(HtbClass* cl, Time& diff);
+    /**
+     * \brief Link a leaf class that has become backlogged
+     * \param cl the leaf class
+     */
+    void Activate(HtbClass* cl);
+    /**
+     * \brief Unlink a leaf class that is no longer backlogged
+     * \param cl the leaf class
+     */
+    void Deactivate(HtbClass* cl);
+    /**
+     * \brief Link a class, for the priorities of its backlogged leaf classes, to
+     *        its parent or to the row of its level
+     * \param cl the class
+     */
+    void ActivatePriorities(HtbClass* cl);
+    /**
+     * \brief Unlink a class, for the priorities of its backlogged leaf classes,
+     *        from its parent or from the row of its level
+     * \param cl the class
+     */
+    void DeactivatePriorities(HtbClass* cl);
+    /**
+     * \brief Add a class to the wait queue
+     * \param cl the class
+     * \param time the time the class changes mode
+     */
+    void AddToWaitQueue(HtbClass* cl, Time time);
+
+    /* parameters for the HTB queue disc */
+    uint32_t m_defaultClass; //!< Index of the leaf class of the unclassified packets
+    uint32_t m_r2q;          //!< Divisor of the rate computing the default quantum
+
+    /* variables stored by the HTB queue disc */
+    std::vector<HtbClass*> m_htbClasses;       //!< All the classes, by identifier
+    std::vector<Ptr<HtbClass>> m_innerClasses; //!< The inner classes
+    /// The classes that can send and have backlogged leaf classes, by level and priority
+    std::array<std::array<HtbClass::RoundRobin, N_PRIORITIES>, MAX_DEPTH> m_rows;
+    std::array<uint8_t, MAX_DEPTH> m_rowMasks; //!< The priorities of the non-empty rows
+    /// The classes that cannot send, by the time they change mode
+    std::set<std::pair<Time, uint32_t>> m_waitQueue;
+    EventId m_watchdog; //!< The event waking the queue disc when a class changes mode
+};
+
+} // namespace ns3
+
+#endif /* HTB_QUEUE_DISC_H */
@@ -20,6 +20,7 @@
 
 #include "mq-queue-disc.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 namespace ns3
@@ -35,12 +36,21 @@ MqQueueDisc::GetTypeId()
     static TypeId tid = TypeId("ns3::MqQueueDisc")
                             .SetParent<QueueDisc>()
                             .SetGroupName("TrafficControl")
-                            .AddConstructor<MqQueueDisc>();
+                            .AddConstructor<MqQueueDisc>()
+                            .AddAttribute("BatchedDequeue",
+                                          "Whether each child queue disc is attached to its "
+                                          "device transmission queue, so that it is only run "
+                                          "when the latter is not stopped and then dequeues a "
+                                          "burst of packets bounded by the queue limits",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&MqQueueDisc::m_batchedDequeue),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 MqQueueDisc::MqQueueDisc()
-    : QueueDisc(QueueDiscSizePolicy::NO_LIMITS)
+    : QueueDisc(QueueDiscSizePolicy::NO_LIMITS),
+      m_batchedDequeue(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -98,6 +108,20 @@ void
 MqQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
+
+    // the i-th child queue disc maps to the i-th device transmission queue
+    for (std::size_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        Ptr<QueueDisc> qd = GetQueueDiscClass(i)->GetQueueDisc();
+        if (m_batchedDequeue)
+        {
+            qd->AttachTxQueue(i);
+        }
+        else
+        {
+            qd->DetachTxQueue();
+        }
+    }
 }
 
 } // namespace ns3
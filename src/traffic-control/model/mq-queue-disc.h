@@ -32,6 +32,12 @@ namespace ns3
  * mq is a classful multi-queue aware dummy scheduler. It has as many child
  * queue discs as the number of device transmission queues. Packets are
  * directly enqueued into and dequeued from child queue discs.
+ *
+ * In batched mode (BatchedDequeue attribute), each child queue disc is attached
+ * to its device transmission queue: the traffic control layer only enqueues
+ * packets into a child queue disc whose transmission queue is stopped, and the
+ * child queue disc dequeues a burst of packets, bounded by the queue limits of
+ * the transmission queue (if any), when the transmission queue is woken.
  */
 class MqQueueDisc : public QueueDisc
 {
@@ -60,6 +66,8 @@ class MqQueueDisc : public QueueDisc
     Ptr<const QueueDiscItem> DoPeek() override;
     bool CheckConfig() override;
     void InitializeParams() override;
+
+    bool m_batchedDequeue; //!< Whether the children are attached to the transmission queues
 };
 
 } // namespace ns3
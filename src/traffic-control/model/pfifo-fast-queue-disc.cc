@@ -53,6 +53,7 @@ PfifoFastQueueDisc::PfifoFastQueueDisc()
     : QueueDisc(QueueDiscSizePolicy::MULTIPLE_QUEUES, QueueSizeUnit::PACKETS)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(LIMIT_EXCEEDED_DROP);
 }
 
 PfifoFastQueueDisc::~PfifoFastQueueDisc()
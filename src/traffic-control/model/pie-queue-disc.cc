@@ -142,6 +142,10 @@ PieQueueDisc::PieQueueDisc()
     : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(UNFORCED_DROP);
+    RegisterReason(FORCED_DROP);
+    RegisterReason(UNFORCED_MARK);
+    RegisterReason(CE_THRESHOLD_EXCEEDED_MARK);
     m_uv = CreateObject<UniformRandomVariable>();
     m_rtrsEvent = Simulator::Schedule(m_sUpdate, &PieQueueDisc::CalculateP, this);
 }
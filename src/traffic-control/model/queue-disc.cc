@@ -24,6 +24,7 @@
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-limits.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/socket.h"
@@ -324,11 +325,15 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
       m_maxSize(QueueSize("1p")), // to avoid that setting the mode at construction time is ignored
       m_running(false),
       m_peeked(false),
+      m_txQueueAttached(false),
+      m_txQueueIndex(0),
       m_sizePolicy(policy),
       m_prohibitChangeMode(false)
 {
     NS_LOG_FUNCTION(this << (uint16_t)policy);
 
+    RegisterReason(INTERNAL_QUEUE_DROP);
+
     // These lambdas call the DropBeforeEnqueue or DropAfterDequeue methods of this
     // QueueDisc object. Given that a callback to the operator() of these lambdas
     // is connected to the DropBeforeEnqueue and DropAfterDequeue traces of the
@@ -346,20 +351,21 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     // is connected to the DropBeforeEnqueue and DropAfterDequeue traces of the
     // child queue discs, the concatenation of the CHILD_QUEUE_DISC_DROP constant
     // and the second argument provided by such traces is passed as the reason why
-    // the packet is dropped.
+    // the packet is dropped. Such reasons are built at run time, hence they are
+    // looked up by their content.
     m_childQueueDiscDbeFunctor = [this](Ptr<const QueueDiscItem> item, const char* r) {
         return DropBeforeEnqueue(
             item,
-            m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r).data());
+            InternReason(m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r)));
     };
     m_childQueueDiscDadFunctor = [this](Ptr<const QueueDiscItem> item, const char* r) {
         return DropAfterDequeue(
             item,
-            m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r).data());
+            InternReason(m_childQueueDiscDropMsg.assign(CHILD_QUEUE_DISC_DROP).append(r)));
     };
     m_childQueueDiscMarkFunctor = [this](Ptr<const QueueDiscItem> item, const char* r) {
         return Mark(const_cast<QueueDiscItem*>(PeekPointer(item)),
-                    m_childQueueDiscMarkMsg.assign(CHILD_QUEUE_DISC_MARK).append(r).data());
+                    InternReason(m_childQueueDiscMarkMsg.assign(CHILD_QUEUE_DISC_MARK).append(r)));
     };
 }
 
@@ -429,6 +435,29 @@ QueueDisc::GetStats()
                               (m_requeued ? m_requeued->GetSize() : 0) -
                               m_stats.nTotalDroppedBytesAfterDequeue;
 
+    // the per-reason counters are only copied here to avoid to look up the reason
+    // in a map every time a packet is dropped or marked
+    for (ReasonId id = 0; id < m_reasons.size(); id++)
+    {
+        const std::string& reason = m_reasons[id];
+        const ReasonStats& stats = m_reasonStats[id];
+        if (stats.nDroppedPacketsBeforeEnqueue > 0)
+        {
+            m_stats.nDroppedPacketsBeforeEnqueue[reason] = stats.nDroppedPacketsBeforeEnqueue;
+            m_stats.nDroppedBytesBeforeEnqueue[reason] = stats.nDroppedBytesBeforeEnqueue;
+        }
+        if (stats.nDroppedPacketsAfterDequeue > 0)
+        {
+            m_stats.nDroppedPacketsAfterDequeue[reason] = stats.nDroppedPacketsAfterDequeue;
+            m_stats.nDroppedBytesAfterDequeue[reason] = stats.nDroppedBytesAfterDequeue;
+        }
+        if (stats.nMarkedPackets > 0)
+        {
+            m_stats.nMarkedPackets[reason] = stats.nMarkedPackets;
+            m_stats.nMarkedBytes[reason] = stats.nMarkedBytes;
+        }
+    }
+
     return m_stats;
 }
 
@@ -559,6 +588,28 @@ QueueDisc::GetSendCallback() const
     return m_send;
 }
 
+void
+QueueDisc::AttachTxQueue(std::size_t txq)
+{
+    NS_LOG_FUNCTION(this << txq);
+    m_txQueueAttached = true;
+    m_txQueueIndex = txq;
+}
+
+void
+QueueDisc::DetachTxQueue()
+{
+    NS_LOG_FUNCTION(this);
+    m_txQueueAttached = false;
+    m_txQueueIndex = 0;
+}
+
+bool
+QueueDisc::IsAttachedToTxQueue() const
+{
+    return m_txQueueAttached;
+}
+
 void
 QueueDisc::SetQuota(const uint32_t quota)
 {
@@ -722,77 +773,101 @@ QueueDisc::PacketDequeued(Ptr<const QueueDiscItem> item)
     }
 }
 
+QueueDisc::ReasonId
+QueueDisc::RegisterReason(const char* reason)
+{
+    NS_LOG_FUNCTION(this << reason);
+
+    ReasonId id = InternReason(reason);
+    for (const auto& registered : m_registeredReasons)
+    {
+        if (registered.first == reason)
+        {
+            return id;
+        }
+    }
+    m_registeredReasons.emplace_back(reason, id);
+    return id;
+}
+
+QueueDisc::ReasonId
+QueueDisc::GetReasonId(const char* reason)
+{
+    // the registered reasons are few, and they are identified by their address
+    for (const auto& registered : m_registeredReasons)
+    {
+        if (registered.first == reason)
+        {
+            return registered.second;
+        }
+    }
+    return InternReason(reason);
+}
+
+QueueDisc::ReasonId
+QueueDisc::InternReason(std::string_view reason)
+{
+    auto it = m_reasonIds.find(reason);
+    if (it != m_reasonIds.end())
+    {
+        return it->second;
+    }
+
+    NS_LOG_DEBUG("Interning reason \"" << reason << "\" with identifier " << m_reasons.size());
+    ReasonId id = m_reasons.size();
+    m_reasons.emplace_back(reason);
+    m_reasonStats.emplace_back();
+    m_reasonIds.emplace(m_reasons.back(), id);
+    return id;
+}
+
 void
 QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
 {
-    NS_LOG_FUNCTION(this << item << reason);
+    DropBeforeEnqueue(item, GetReasonId(reason));
+}
+
+void
+QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, ReasonId reason)
+{
+    NS_LOG_FUNCTION(this << item << m_reasons[reason]);
 
     m_stats.nTotalDroppedPackets++;
     m_stats.nTotalDroppedBytes += item->GetSize();
     m_stats.nTotalDroppedPacketsBeforeEnqueue++;
     m_stats.nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
-    // update the number of packets dropped for the given reason
-    std::map<std::string, uint32_t>::iterator itp =
-        m_stats.nDroppedPacketsBeforeEnqueue.find(reason);
-    if (itp != m_stats.nDroppedPacketsBeforeEnqueue.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nDroppedPacketsBeforeEnqueue[reason] = 1;
-    }
-    // update the amount of bytes dropped for the given reason
-    std::map<std::string, uint64_t>::iterator itb = m_stats.nDroppedBytesBeforeEnqueue.find(reason);
-    if (itb != m_stats.nDroppedBytesBeforeEnqueue.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nDroppedBytesBeforeEnqueue[reason] = item->GetSize();
-    }
+    // update the number of packets and the amount of bytes dropped for the given reason
+    m_reasonStats[reason].nDroppedPacketsBeforeEnqueue++;
+    m_reasonStats[reason].nDroppedBytesBeforeEnqueue += item->GetSize();
 
     NS_LOG_DEBUG("Total packets/bytes dropped before enqueue: "
                  << m_stats.nTotalDroppedPacketsBeforeEnqueue << " / "
                  << m_stats.nTotalDroppedBytesBeforeEnqueue);
     NS_LOG_LOGIC("m_traceDropBeforeEnqueue (p)");
     m_traceDrop(item);
-    m_traceDropBeforeEnqueue(item, reason);
+    m_traceDropBeforeEnqueue(item, m_reasons[reason].c_str());
 }
 
 void
 QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
 {
-    NS_LOG_FUNCTION(this << item << reason);
+    DropAfterDequeue(item, GetReasonId(reason));
+}
+
+void
+QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, ReasonId reason)
+{
+    NS_LOG_FUNCTION(this << item << m_reasons[reason]);
 
     m_stats.nTotalDroppedPackets++;
     m_stats.nTotalDroppedBytes += item->GetSize();
     m_stats.nTotalDroppedPacketsAfterDequeue++;
     m_stats.nTotalDroppedBytesAfterDequeue += item->GetSize();
 
-    // update the number of packets dropped for the given reason
-    std::map<std::string, uint32_t>::iterator itp =
-        m_stats.nDroppedPacketsAfterDequeue.find(reason);
-    if (itp != m_stats.nDroppedPacketsAfterDequeue.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nDroppedPacketsAfterDequeue[reason] = 1;
-    }
-    // update the amount of bytes dropped for the given reason
-    std::map<std::string, uint64_t>::iterator itb = m_stats.nDroppedBytesAfterDequeue.find(reason);
-    if (itb != m_stats.nDroppedBytesAfterDequeue.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nDroppedBytesAfterDequeue[reason] = item->GetSize();
-    }
+    // update the number of packets and the amount of bytes dropped for the given reason
+    m_reasonStats[reason].nDroppedPacketsAfterDequeue++;
+    m_reasonStats[reason].nDroppedBytesAfterDequeue += item->GetSize();
 
     // if in the context of a peek request a dequeued packet is dropped, we need
     // to update the statistics and fire the dequeue trace before firing the drop
@@ -810,13 +885,19 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
                  << m_stats.nTotalDroppedBytesAfterDequeue);
     NS_LOG_LOGIC("m_traceDropAfterDequeue (p)");
     m_traceDrop(item);
-    m_traceDropAfterDequeue(item, reason);
+    m_traceDropAfterDequeue(item, m_reasons[reason].c_str());
 }
 
 bool
 QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
 {
-    NS_LOG_FUNCTION(this << item << reason);
+    return Mark(item, GetReasonId(reason));
+}
+
+bool
+QueueDisc::Mark(Ptr<QueueDiscItem> item, ReasonId reason)
+{
+    NS_LOG_FUNCTION(this << item << m_reasons[reason]);
 
     bool retval = item->Mark();
 
@@ -828,30 +909,13 @@ QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
     m_stats.nTotalMarkedPackets++;
     m_stats.nTotalMarkedBytes += item->GetSize();
 
-    // update the number of packets marked for the given reason
-    std::map<std::string, uint32_t>::iterator itp = m_stats.nMarkedPackets.find(reason);
-    if (itp != m_stats.nMarkedPackets.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nMarkedPackets[reason] = 1;
-    }
-    // update the amount of bytes marked for the given reason
-    std::map<std::string, uint64_t>::iterator itb = m_stats.nMarkedBytes.find(reason);
-    if (itb != m_stats.nMarkedBytes.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nMarkedBytes[reason] = item->GetSize();
-    }
+    // update the number of packets and the amount of bytes marked for the given reason
+    m_reasonStats[reason].nMarkedPackets++;
+    m_reasonStats[reason].nMarkedBytes += item->GetSize();
 
     NS_LOG_DEBUG("Total packets/bytes marked: " << m_stats.nTotalMarkedPackets << " / "
                                                 << m_stats.nTotalMarkedBytes);
-    m_traceMark(item, reason);
+    m_traceMark(item, m_reasons[reason].c_str());
     return true;
 }
 
@@ -956,9 +1020,17 @@ QueueDisc::Run()
 
     if (RunBegin())
     {
+        // a queue disc attached to a transmission queue having queue limits dequeues
+        // packets until the queue limits stop the transmission queue
+        bool limited = m_txQueueAttached && m_devQueueIface &&
+                       m_devQueueIface->GetTxQueue(m_txQueueIndex)->GetQueueLimits();
         uint32_t quota = m_quota;
         while (Restart())
         {
+            if (limited)
+            {
+                continue;
+            }
             quota -= 1;
             if (quota <= 0)
             {
@@ -1038,9 +1110,13 @@ QueueDisc::DequeuePacket()
         // multiple queues), ask the queue disc to dequeue a packet (a multi-queue aware
         // queue disc should try not to dequeue a packet destined to a stopped queue).
         // Otherwise, ask the queue disc to dequeue a packet only if the (unique) queue
-        // is not stopped.
-        if (!m_devQueueIface || m_devQueueIface->GetNTxQueues() > 1 ||
-            !m_devQueueIface->GetTxQueue(0)->IsStopped())
+        // is not stopped. A queue disc attached to a transmission queue is asked to
+        // dequeue a packet only if such queue is not stopped.
+        if (!m_devQueueIface ||
+            (m_txQueueAttached
+                 ? !m_devQueueIface->GetTxQueue(m_txQueueIndex)->IsStopped()
+                 : (m_devQueueIface->GetNTxQueues() > 1 ||
+                    !m_devQueueIface->GetTxQueue(0)->IsStopped())))
         {
             item = Dequeue();
             // If the item is not null, add the header to the packet.
@@ -1090,6 +1166,19 @@ QueueDisc::Transmit(Ptr<QueueDiscItem> item)
         item->GetPacket()->RemovePacketTag(priorityTag);
     }
     NS_ASSERT_MSG(m_send, "Send callback not set");
+
+    // packets built for segmentation offload are split into segments, which are
+    // sent to the device one at a time. If the device queue gets stopped, the
+    // remaining segments are requeued
+    while (Ptr<QueueDiscItem> segment = item->PopSegment())
+    {
+        m_send(segment);
+        if (m_devQueueIface && m_devQueueIface->GetTxQueue(item->GetTxQueueIndex())->IsStopped())
+        {
+            Requeue(item);
+            return false;
+        }
+    }
     m_send(item);
 
     // the behavior here slightly diverges from Linux. In Linux, it is advised that
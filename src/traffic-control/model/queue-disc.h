@@ -31,6 +31,8 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -170,6 +172,14 @@ enum QueueDiscSizePolicy
  * queue disc, the reason is "(Dropped by child queue disc) " followed by the
  * reason why the child queue disc dropped the packet.
  *
+ * The reasons are interned: each distinct reason gets an identifier, which
+ * indexes the per-reason counters updated on every drop or mark. Subclasses
+ * register the reasons they use (typically their static constant strings)
+ * by calling RegisterReason in their constructor, so that dropping or marking
+ * a packet for one of these reasons does not involve any string comparison
+ * or memory allocation. The string-keyed per-reason counters of the Stats
+ * structure are filled from the interned counters when GetStats is called.
+ *
  * The QueueDisc base class provides the SojournTime trace source, which provides
  * the sojourn time of every packet dequeued from a queue disc, including packets
  * that are dropped or requeued after being dequeued. The sojourn time is taken
@@ -206,21 +216,25 @@ class QueueDisc : public Object
         uint32_t nTotalDroppedPackets;
         /// Total packets dropped before enqueue
         uint32_t nTotalDroppedPacketsBeforeEnqueue;
-        /// Packets dropped before enqueue, for each reason
+        /// Packets dropped before enqueue, for each reason -- this value is not kept up to date,
+        /// call GetStats first
         std::map<std::string, uint32_t, std::less<>> nDroppedPacketsBeforeEnqueue;
         /// Total packets dropped after dequeue
         uint32_t nTotalDroppedPacketsAfterDequeue;
-        /// Packets dropped after dequeue, for each reason
+        /// Packets dropped after dequeue, for each reason -- this value is not kept up to date,
+        /// call GetStats first
         std::map<std::string, uint32_t, std::less<>> nDroppedPacketsAfterDequeue;
         /// Total dropped bytes
         uint64_t nTotalDroppedBytes;
         /// Total bytes dropped before enqueue
         uint64_t nTotalDroppedBytesBeforeEnqueue;
-        /// Bytes dropped before enqueue, for each reason
+        /// Bytes dropped before enqueue, for each reason -- this value is not kept up to date, call
+        /// GetStats first
         std::map<std::string, uint64_t, std::less<>> nDroppedBytesBeforeEnqueue;
         /// Total bytes dropped after dequeue
         uint64_t nTotalDroppedBytesAfterDequeue;
-        /// Bytes dropped after dequeue, for each reason
+        /// Bytes dropped after dequeue, for each reason -- this value is not kept up to date, call
+        /// GetStats first
         std::map<std::string, uint64_t, std::less<>> nDroppedBytesAfterDequeue;
         /// Total requeued packets
         uint32_t nTotalRequeuedPackets;
@@ -228,11 +242,12 @@ class QueueDisc : public Object
         uint64_t nTotalRequeuedBytes;
         /// Total marked packets
         uint32_t nTotalMarkedPackets;
-        /// Marked packets, for each reason
+        /// Marked packets, for each reason -- this value is not kept up to date, call
+        /// GetStats first
         std::map<std::string, uint32_t, std::less<>> nMarkedPackets;
         /// Total marked bytes
         uint32_t nTotalMarkedBytes;
-        /// Marked bytes, for each reason
+        /// Marked bytes, for each reason -- this value is not kept up to date, call GetStats first
         std::map<std::string, uint64_t, std::less<>> nMarkedBytes;
 
         /// constructor
@@ -378,6 +393,30 @@ class QueueDisc : public Object
      */
     SendCallback GetSendCallback() const;
 
+    /**
+     * \brief Attach this queue disc to a single transmission queue of the device.
+     *
+     * A queue disc attached to a transmission queue of a multi-queue device (e.g.,
+     * a child of an mq queue disc in batched mode) is not run while such transmission
+     * queue is stopped. When run, it dequeues a burst of packets, which ends when the
+     * transmission queue is stopped or the queue disc is empty. The burst is bounded
+     * by the quota, unless the transmission queue has queue limits (e.g., BQL), which
+     * then bound the burst.
+     *
+     * \param txq the index of the transmission queue
+     */
+    void AttachTxQueue(std::size_t txq);
+
+    /**
+     * \brief Detach this queue disc from the transmission queue it is attached to, if any.
+     */
+    void DetachTxQueue();
+
+    /**
+     * \return true if this queue disc is attached to a single transmission queue
+     */
+    bool IsAttachedToTxQueue() const;
+
     /**
      * \brief Set the maximum number of dequeue operations following a packet enqueue
      * \param quota the maximum number of dequeue operations following a packet enqueue.
@@ -572,7 +611,66 @@ class QueueDisc : public Object
      */
     bool Mark(Ptr<QueueDiscItem> item, const char* reason);
 
+    /// Identifier of a reason to drop or mark packets, local to a queue disc
+    typedef uint32_t ReasonId;
+
+    /**
+     * \brief Register a reason to drop or mark packets
+     *
+     * Subclasses should register the reasons they pass to DropBeforeEnqueue,
+     * DropAfterDequeue and Mark at construction time. Reasons that are not
+     * registered are interned the first time they are used, but are then
+     * looked up by their content on every drop or mark.
+     *
+     * \param reason the reason, which must be a string with static storage duration
+     * \return the identifier of the reason
+     */
+    ReasonId RegisterReason(const char* reason);
+
   private:
+    /// Counters kept for each reason to drop or mark packets
+    struct ReasonStats
+    {
+        uint32_t nDroppedPacketsBeforeEnqueue{0}; //!< Packets dropped before enqueue
+        uint64_t nDroppedBytesBeforeEnqueue{0};   //!< Bytes dropped before enqueue
+        uint32_t nDroppedPacketsAfterDequeue{0};  //!< Packets dropped after dequeue
+        uint64_t nDroppedBytesAfterDequeue{0};    //!< Bytes dropped after dequeue
+        uint32_t nMarkedPackets{0};               //!< Marked packets
+        uint64_t nMarkedBytes{0};                 //!< Marked bytes
+    };
+
+    /**
+     * \brief Get the identifier of a reason, interning the reason if needed
+     * \param reason the reason
+     * \return the identifier of the reason
+     */
+    ReasonId GetReasonId(const char* reason);
+    /**
+     * \brief Get the identifier of a reason from its content, interning the reason if needed
+     * \param reason the reason
+     * \return the identifier of the reason
+     */
+    ReasonId InternReason(std::string_view reason);
+    /**
+     * \brief Update the statistics and fire the traces of a packet dropped before enqueue
+     * \param item item that was dropped
+     * \param reason the identifier of the reason why the item was dropped
+     */
+    void DropBeforeEnqueue(Ptr<const QueueDiscItem> item, ReasonId reason);
+    /**
+     * \brief Update the statistics and fire the traces of a packet dropped after dequeue
+     * \param item item that was dropped
+     * \param reason the identifier of the reason why the item was dropped
+     */
+    void DropAfterDequeue(Ptr<const QueueDiscItem> item, ReasonId reason);
+    /**
+     * \brief Mark the given packet and, if successful, update the statistics
+     * \param item item that has to be marked
+     * \param reason the identifier of the reason why the item has to be marked
+     * \return true if the item was successfully marked, false otherwise
+     */
+    bool Mark(Ptr<QueueDiscItem> item, ReasonId reason);
+
     /**
      * This function actually enqueues a packet into the queue disc.
      * \param item item to enqueue
@@ -703,11 +801,20 @@ class QueueDisc : public Object
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
+    bool m_txQueueAttached;        //!< Attached to a single transmission queue
+    std::size_t m_txQueueIndex;    //!< Index of the transmission queue attached to
     std::string m_childQueueDiscDropMsg; //!< Reason why a packet was dropped by a child queue disc
     std::string m_childQueueDiscMarkMsg; //!< Reason why a packet was marked by a child queue disc
     QueueDiscSizePolicy m_sizePolicy;    //!< The queue disc size policy
     bool m_prohibitChangeMode;           //!< True if changing mode is prohibited
 
+    std::vector<std::string> m_reasons;     //!< Interned reasons, by identifier
+    std::vector<ReasonStats> m_reasonStats; //!< Per-reason counters, by identifier
+    /// Registered reasons (with static storage duration) and their identifiers
+    std::vector<std::pair<const char*, ReasonId>> m_registeredReasons;
+    /// Identifiers of the interned reasons
+    std::map<std::string, ReasonId, std::less<>> m_reasonIds;
+
     /// Traced callback: fired when a packet is enqueued
     TracedCallback<Ptr<const QueueDiscItem>> m_traceEnqueue;
     /// Traced callback: fired when a packet is dequeued
@@ -229,6 +229,10 @@ RedQueueDisc::RedQueueDisc()
     : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
 {
     NS_LOG_FUNCTION(this);
+    RegisterReason(UNFORCED_DROP);
+    RegisterReason(FORCED_DROP);
+    RegisterReason(UNFORCED_MARK);
+    RegisterReason(FORCED_MARK);
     m_uv = CreateObject<UniformRandomVariable>();
 }
 
@@ -399,6 +399,16 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
                 SocketPriorityTag priorityTag;
                 item->GetPacket()->RemovePacketTag(priorityTag);
             }
+            // packets built for segmentation offload are split into segments
+            while (Ptr<QueueDiscItem> segment = item->PopSegment())
+            {
+                device->Send(segment->GetPacket(), segment->GetAddress(), segment->GetProtocol());
+                if (devQueueIface && devQueueIface->GetTxQueue(txq)->IsStopped())
+                {
+                    m_dropped(item->GetPacket());
+                    return;
+                }
+            }
             device->Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
         }
         else
@@ -415,7 +425,13 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
         Ptr<QueueDisc> qDisc = ndi->second.m_queueDiscsToWake[txq];
         NS_ASSERT(qDisc);
         qDisc->Enqueue(item);
-        qDisc->Run();
+        // a queue disc attached to a stopped transmission queue is run when the
+        // transmission queue is woken
+        if (!qDisc->IsAttachedToTxQueue() || !devQueueIface ||
+            !devQueueIface->GetTxQueue(txq)->IsStopped())
+        {
+            qDisc->Run();
+        }
     }
 }
 
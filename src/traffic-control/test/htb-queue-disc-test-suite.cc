@@ -0,0 +1,296 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/htb-queue-disc.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Item
+ */
+class HtbQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param p the packet
+     * \param leaf the index of the leaf class of the packet, or -1 if the packet
+     *        cannot be classified
+     */
+    HtbQueueDiscTestItem(Ptr<Packet> p, int32_t leaf);
+    void AddHeader() override;
+    bool Mark() override;
+    /**
+     * \return the index of the leaf class of the packet, or -1
+     */
+    int32_t GetLeaf() const;
+
+  private:
+    int32_t m_leaf; //!< the index of the leaf class of the packet
+};
+
+HtbQueueDiscTestItem::HtbQueueDiscTestItem(Ptr<Packet> p, int32_t leaf)
+    : QueueDiscItem(p, Address(), 0),
+      m_leaf(leaf)
+{
+}
+
+void
+HtbQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+HtbQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+int32_t
+HtbQueueDiscTestItem::GetLeaf() const
+{
+    return m_leaf;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Packet Filter, returning the leaf class of a test item
+ */
+class HtbQueueDiscTestFilter : public PacketFilter
+{
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override;
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override;
+};
+
+bool
+HtbQueueDiscTestFilter::CheckProtocol(Ptr<QueueDiscItem> item) const
+{
+    return true;
+}
+
+int32_t
+HtbQueueDiscTestFilter::DoClassify(Ptr<QueueDiscItem> item) const
+{
+    int32_t leaf = DynamicCast<HtbQueueDiscTestItem>(item)->GetLeaf();
+    return (leaf < 0 ? PacketFilter::PF_NO_MATCH : leaf);
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Case
+ *
+ * A hierarchy of classes is created, in which all the leaf classes are
+ * backlogged. The queue disc is polled for packets every 100us for 2 seconds,
+ * and the rate of each leaf class is checked.
+ */
+class HtbQueueDiscTestCase : public TestCase
+{
+  public:
+    /// The configuration of a class
+    struct ClassConfig
+    {
+        int32_t parent;    //!< the index of the parent class, or -1 for a root class
+        std::string rate;  //!< the rate of the class
+        std::string ceil;  //!< the ceil rate of the class
+        uint32_t priority; //!< the priority of the class
+        bool leaf;         //!< whether the class is a leaf class
+        double expected;   //!< the expected rate of a leaf class, in Mbps
+    };
+
+    /**
+     * Constructor
+     *
+     * \param name the name of the test case
+     * \param classes the classes, listed after their parent
+     * \param unclassified whether the packets of the last leaf class cannot be classified
+     *        (hence, the last leaf class must be the default class)
+     */
+    HtbQueueDiscTestCase(std::string name,
+                         std::vector<ClassConfig> classes,
+                         bool unclassified = false);
+
+  private:
+    void DoRun() override;
+    /**
+     * Dequeue a packet from the queue disc and count it
+     *
+     * \param qd the queue disc
+     */
+    void Dequeue(Ptr<QueueDisc> qd);
+    /**
+     * Count the bytes sent by a leaf class
+     *
+     * \param item the packet
+     */
+    void Count(Ptr<QueueDiscItem> item);
+
+    std::vector<ClassConfig> m_classes; //!< the classes
+    bool m_unclassified;                //!< whether the last leaf class gets unclassified packets
+    std::vector<uint64_t> m_bytes;      //!< the bytes sent by each leaf class
+};
+
+HtbQueueDiscTestCase::HtbQueueDiscTestCase(std::string name,
+                                           std::vector<ClassConfig> classes,
+                                           bool unclassified)
+    : TestCase("Sanity check on the htb queue disc implementation: " + name),
+      m_classes(classes),
+      m_unclassified(unclassified)
+{
+}
+
+void
+HtbQueueDiscTestCase::Count(Ptr<QueueDiscItem> item)
+{
+    int32_t leaf = DynamicCast<HtbQueueDiscTestItem>(item)->GetLeaf();
+    m_bytes[leaf < 0 ? m_bytes.size() - 1 : leaf] += item->GetSize();
+}
+
+void
+HtbQueueDiscTestCase::Dequeue(Ptr<QueueDisc> qd)
+{
+    if (Ptr<QueueDiscItem> item = qd->Dequeue())
+    {
+        Count(item);
+    }
+}
+
+void
+HtbQueueDiscTestCase::DoRun()
+{
+    Ptr<HtbQueueDisc> qd = CreateObject<HtbQueueDisc>();
+    qd->AddPacketFilter(CreateObject<HtbQueueDiscTestFilter>());
+
+    std::vector<Ptr<HtbClass>> classes;
+    for (const auto& config : m_classes)
+    {
+        Ptr<HtbClass> cl = CreateObjectWithAttributes<HtbClass>("Rate",
+                                                                StringValue(config.rate),
+                                                                "Ceil",
+                                                                StringValue(config.ceil),
+                                                                "Priority",
+                                                                UintegerValue(config.priority));
+        if (config.parent >= 0)
+        {
+            cl->SetParent(classes[config.parent]);
+        }
+        if (config.leaf)
+        {
+            cl->SetQueueDisc(
+                CreateObjectWithAttributes<FifoQueueDisc>("MaxSize", StringValue("5000p")));
+            qd->AddQueueDiscClass(cl);
+        }
+        classes.push_back(cl);
+    }
+    uint32_t nLeaves = qd->GetNQueueDiscClasses();
+    if (m_unclassified)
+    {
+        qd->SetAttribute("DefaultClass", UintegerValue(nLeaves - 1));
+    }
+    qd->SetSendCallback([this](Ptr<QueueDiscItem> item) { Count(item); });
+    qd->Initialize();
+
+    // enqueue enough packets to keep all the leaf classes backlogged
+    m_bytes.assign(nLeaves, 0);
+    for (uint32_t i = 0; i < 4000; i++)
+    {
+        for (uint32_t leaf = 0; leaf < nLeaves; leaf++)
+        {
+            int32_t index = (m_unclassified && leaf == nLeaves - 1 ? -1 : leaf);
+            qd->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(1000), index));
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(qd->GetNPackets(), 4000 * nLeaves, "Packets dropped");
+
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        Simulator::Schedule(MicroSeconds(100 * i), &HtbQueueDiscTestCase::Dequeue, this, qd);
+    }
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    uint32_t leaf = 0;
+    for (const auto& config : m_classes)
+    {
+        if (config.leaf)
+        {
+            double rate = m_bytes[leaf] * 8 / 2e6;
+            NS_TEST_EXPECT_MSG_EQ_TOL(rate,
+                                      config.expected,
+                                      config.expected * 0.05,
+                                      "Unexpected rate (Mbps) of the leaf class " << leaf);
+            leaf++;
+        }
+    }
+
+    qd->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Suite
+ */
+static class HtbQueueDiscTestSuite : public TestSuite
+{
+  public:
+    HtbQueueDiscTestSuite()
+        : TestSuite("htb-queue-disc", UNIT)
+    {
+        // the excess bandwidth is shared in proportion to the quantums, hence to the rates
+        AddTestCase(new HtbQueueDiscTestCase("borrowing",
+                                             {{-1, "10Mbps", "10Mbps", 0, false, 0},
+                                              {0, "2Mbps", "10Mbps", 0, true, 2.5},
+                                              {0, "6Mbps", "10Mbps", 0, true, 7.5}}),
+                    TestCase::QUICK);
+        // a leaf class cannot exceed its ceil rate
+        AddTestCase(new HtbQueueDiscTestCase("ceil",
+                                             {{-1, "10Mbps", "10Mbps", 0, false, 0},
+                                              {0, "1Mbps", "3Mbps", 0, true, 3}}),
+                    TestCase::QUICK);
+        // the excess bandwidth is lent to the leaf classes with the highest priority
+        AddTestCase(new HtbQueueDiscTestCase("priority",
+                                             {{-1, "10Mbps", "10Mbps", 0, false, 0},
+                                              {0, "1Mbps", "10Mbps", 1, true, 1},
+                                              {0, "1Mbps", "10Mbps", 0, true, 9}}),
+                    TestCase::QUICK);
+        // an inner class limits the bandwidth borrowed by its descendants, and the
+        // unclassified packets are enqueued in the default class
+        AddTestCase(new HtbQueueDiscTestCase("hierarchy",
+                                             {{-1, "10Mbps", "10Mbps", 0, false, 0},
+                                              {0, "8Mbps", "10Mbps", 0, false, 0},
+                                              {1, "1Mbps", "10Mbps", 0, true, 4},
+                                              {1, "1Mbps", "10Mbps", 0, true, 4},
+                                              {0, "2Mbps", "2Mbps", 0, false, 0},
+                                              {4, "1Mbps", "10Mbps", 0, true, 2}},
+                                             true),
+                    TestCase::QUICK);
+    }
+} g_htbQueueTestSuite; ///< the test suite
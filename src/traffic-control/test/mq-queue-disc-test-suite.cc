@@ -0,0 +1,275 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/mq-queue-disc.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/packet.h"
+#include "ns3/queue-limits.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Mq Queue Disc Test Item
+ */
+class MqQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param p the packet
+     * \param txq the index of the device transmission queue
+     */
+    MqQueueDiscTestItem(Ptr<Packet> p, std::size_t txq);
+    void AddHeader() override;
+    bool Mark() override;
+};
+
+MqQueueDiscTestItem::MqQueueDiscTestItem(Ptr<Packet> p, std::size_t txq)
+    : QueueDiscItem(p, Address(), 0)
+{
+    SetTxQueueIndex(txq);
+}
+
+void
+MqQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+MqQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Queue limits allowing a fixed number of bytes in the device queue
+ */
+class MqQueueDiscTestLimits : public QueueLimits
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param limit the maximum number of bytes in the device queue
+     */
+    MqQueueDiscTestLimits(int32_t limit);
+    void Reset() override;
+    void Completed(uint32_t count) override;
+    int32_t Available() const override;
+    void Queued(uint32_t count) override;
+
+  private:
+    int32_t m_limit;  //!< the maximum number of bytes in the device queue
+    int32_t m_queued; //!< the number of bytes in the device queue
+};
+
+MqQueueDiscTestLimits::MqQueueDiscTestLimits(int32_t limit)
+    : m_limit(limit),
+      m_queued(0)
+{
+}
+
+void
+MqQueueDiscTestLimits::Reset()
+{
+    m_queued = 0;
+}
+
+void
+MqQueueDiscTestLimits::Completed(uint32_t count)
+{
+    m_queued -= count;
+}
+
+int32_t
+MqQueueDiscTestLimits::Available() const
+{
+    return m_limit - m_queued;
+}
+
+void
+MqQueueDiscTestLimits::Queued(uint32_t count)
+{
+    m_queued += count;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Mq Queue Disc Test Case
+ *
+ * An mq queue disc with two FIFO child queue discs serves a device with two
+ * transmission queues. Packets are enqueued into the child queue disc of a
+ * stopped transmission queue, which is then woken. In batched mode, the child
+ * queue disc does not dequeue (and requeue) packets while its transmission queue
+ * is stopped, and dequeues a burst of packets bounded by the queue limits of the
+ * transmission queue, rather than by the quota, when the latter is woken.
+ */
+class MqQueueDiscTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param batched whether the mq queue disc is in batched mode
+     */
+    MqQueueDiscTestCase(bool batched);
+
+  private:
+    void DoRun() override;
+    /**
+     * Send a packet to the device
+     *
+     * \param item the packet
+     */
+    void Send(Ptr<QueueDiscItem> item);
+
+    bool m_batched;                      //!< whether the mq queue disc is in batched mode
+    Ptr<NetDeviceQueueInterface> m_ndqi; //!< the device queue interface
+    std::vector<uint32_t> m_sent;        //!< number of packets sent to each transmission queue
+};
+
+MqQueueDiscTestCase::MqQueueDiscTestCase(bool batched)
+    : TestCase(std::string("Sanity check on the mq queue disc implementation") +
+               (batched ? " in batched mode" : "")),
+      m_batched(batched)
+{
+}
+
+void
+MqQueueDiscTestCase::Send(Ptr<QueueDiscItem> item)
+{
+    std::size_t txq = item->GetTxQueueIndex();
+    m_sent[txq]++;
+    m_ndqi->GetTxQueue(txq)->NotifyQueuedBytes(item->GetSize());
+}
+
+void
+MqQueueDiscTestCase::DoRun()
+{
+    const std::size_t nTxQueues = 2;
+    m_ndqi = CreateObjectWithAttributes<NetDeviceQueueInterface>("NTxQueues",
+                                                                 UintegerValue(nTxQueues));
+    m_sent.assign(nTxQueues, 0);
+
+    // the queue limits of the first transmission queue allow 5 packets in the queue
+    m_ndqi->GetTxQueue(0)->SetQueueLimits(CreateObject<MqQueueDiscTestLimits>(5000));
+
+    Ptr<MqQueueDisc> mq =
+        CreateObjectWithAttributes<MqQueueDisc>("BatchedDequeue", BooleanValue(m_batched));
+    std::vector<Ptr<QueueDisc>> children;
+    for (std::size_t i = 0; i < nTxQueues; i++)
+    {
+        Ptr<QueueDisc> child =
+            CreateObjectWithAttributes<FifoQueueDisc>("Quota", UintegerValue(2));
+        Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass>();
+        c->SetQueueDisc(child);
+        mq->AddQueueDiscClass(c);
+        child->SetNetDeviceQueueInterface(m_ndqi);
+        child->SetSendCallback([this](Ptr<QueueDiscItem> item) { Send(item); });
+        m_ndqi->GetTxQueue(i)->SetWakeCallback(MakeCallback(&QueueDisc::Run, child));
+        children.push_back(child);
+    }
+    mq->Initialize();
+
+    for (std::size_t i = 0; i < nTxQueues; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(children[i]->IsAttachedToTxQueue(),
+                              m_batched,
+                              "The child queue discs must be attached in batched mode only");
+    }
+
+    // enqueue 10 packets into each child queue disc while the transmission queues
+    // are stopped
+    for (std::size_t i = 0; i < nTxQueues; i++)
+    {
+        m_ndqi->GetTxQueue(i)->Stop();
+        for (uint32_t j = 0; j < 10; j++)
+        {
+            children[i]->Enqueue(Create<MqQueueDiscTestItem>(Create<Packet>(1000), i));
+            children[i]->Run();
+        }
+    }
+
+    for (std::size_t i = 0; i < nTxQueues; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_sent[i], 0, "No packet must be sent to a stopped queue");
+        NS_TEST_ASSERT_MSG_EQ(children[i]->GetStats().nTotalRequeuedPackets,
+                              (m_batched ? 0 : 1),
+                              "Packets must not be requeued in batched mode");
+    }
+
+    // when woken, the first transmission queue, having queue limits, gets packets
+    // until the queue limits are exceeded (in batched mode), the second one gets
+    // as many packets as the quota
+    for (std::size_t i = 0; i < nTxQueues; i++)
+    {
+        m_ndqi->GetTxQueue(i)->Wake();
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent[0],
+                          (m_batched ? 6 : 2),
+                          "Unexpected number of packets sent to the first queue");
+    NS_TEST_ASSERT_MSG_EQ(m_ndqi->GetTxQueue(0)->IsStopped(),
+                          m_batched,
+                          "The queue limits must stop the first queue in batched mode only");
+    NS_TEST_ASSERT_MSG_EQ(m_sent[1], 2, "Unexpected number of packets sent to the second queue");
+    NS_TEST_ASSERT_MSG_EQ(children[1]->GetNPackets(),
+                          8,
+                          "Unexpected number of packets in the second child queue disc");
+
+    // completing the transmission of the packets restarts the first queue, which
+    // gets another burst of packets
+    m_ndqi->GetTxQueue(0)->NotifyTransmittedBytes(m_sent[0] * 1000);
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent[0],
+                          (m_batched ? 10 : 2),
+                          "Unexpected number of packets sent to the first queue");
+    NS_TEST_ASSERT_MSG_EQ(children[0]->GetNPackets(),
+                          (m_batched ? 0 : 8),
+                          "Unexpected number of packets in the first child queue disc");
+
+    mq->Dispose();
+    m_ndqi->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Mq Queue Disc Test Suite
+ */
+static class MqQueueDiscTestSuite : public TestSuite
+{
+  public:
+    MqQueueDiscTestSuite()
+        : TestSuite("mq-queue-disc", UNIT)
+    {
+        AddTestCase(new MqQueueDiscTestCase(false), TestCase::QUICK);
+        AddTestCase(new MqQueueDiscTestCase(true), TestCase::QUICK);
+    }
+} g_mqQueueTestSuite; ///< the test suite
@@ -94,6 +94,8 @@ class TestChildQueueDisc : public QueueDisc
 TestChildQueueDisc::TestChildQueueDisc()
     : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
 {
+    // AFTER_DEQUEUE is not registered, hence it is interned when first used
+    RegisterReason(BEFORE_ENQUEUE);
 }
 
 TestChildQueueDisc::~TestChildQueueDisc()
@@ -580,6 +582,33 @@ QueueDiscTracesTestCase::DoRun()
     CheckDroppedBeforeEnqueue(child, 1, pktSizeUnit * 5);
     CheckDroppedAfterDequeue(child, 2, pktSizeUnit * 3);
 
+    // Check the statistics kept for each reason
+    QueueDisc::Stats stats = child->GetStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.nDroppedPacketsBeforeEnqueue.size(),
+                          1,
+                          "Verify that packets were dropped before enqueue for a single reason");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNDroppedPackets(TestChildQueueDisc::BEFORE_ENQUEUE),
+                          1,
+                          "Verify that the packets dropped for a reason are computed correctly");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNDroppedBytes(TestChildQueueDisc::BEFORE_ENQUEUE),
+                          pktSizeUnit * 5,
+                          "Verify that the bytes dropped for a reason are computed correctly");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNDroppedPackets(TestChildQueueDisc::AFTER_DEQUEUE),
+                          2,
+                          "Verify that the packets dropped for a reason are computed correctly");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNDroppedBytes(TestChildQueueDisc::AFTER_DEQUEUE),
+                          pktSizeUnit * 3,
+                          "Verify that the bytes dropped for a reason are computed correctly");
+
+    stats = root->GetStats();
+    std::string childDrop = QueueDisc::CHILD_QUEUE_DISC_DROP;
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNDroppedPackets(childDrop + TestChildQueueDisc::BEFORE_ENQUEUE),
+                          1,
+                          "Verify that the packets dropped by the child are computed correctly");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNDroppedBytes(childDrop + TestChildQueueDisc::AFTER_DEQUEUE),
+                          pktSizeUnit * 3,
+                          "Verify that the bytes dropped by the child are computed correctly");
+
     Simulator::Destroy();
 }
 
@@ -0,0 +1,177 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the channel access of many contending stations.
+// 'stas' 802.11ax stations, all within range of each other, have saturated
+// best effort and background traffic: every millisecond, the AC_BE and AC_BK
+// MAC queues of every station are topped up to 'backlog' packets, sent to the
+// next station. Hence, two EDCAFs per station contend for the medium during
+// 'duration' seconds, and the channel access managers of all the stations are
+// notified of every PPDU. The number of MPDUs received is printed, so that the
+// results of different builds can be compared.
+// Sample usage:  ./ns3 run 'bench-channel-access-manager --stas=256'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/qos-utils.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Top up the MAC queues of the given device and reschedule itself.
+ *
+ * \param device the device
+ * \param to the address of the receiver of the packets
+ * \param backlog the number of packets to keep in each MAC queue
+ * \param payloadSize the size of the packets
+ */
+static void
+TopUp(Ptr<WifiNetDevice> device, Address to, uint32_t backlog, uint32_t payloadSize)
+{
+    for (uint8_t tid : {0, 1}) // AC_BE and AC_BK
+    {
+        auto queue = device->GetMac()->GetTxopQueue(QosUtilsMapTidToAc(tid));
+        for (auto n = queue->GetNPackets(); n < backlog; n++)
+        {
+            auto packet = Create<Packet>(payloadSize);
+            SocketPriorityTag priorityTag;
+            priorityTag.SetPriority(tid);
+            packet->AddPacketTag(priorityTag);
+            device->Send(packet, to, 1);
+        }
+    }
+    Simulator::Schedule(MilliSeconds(1), &TopUp, device, to, backlog, payloadSize);
+}
+
+/**
+ * Run a simulation.
+ *
+ * \param nStas the number of stations
+ * \param duration the simulated time, in seconds
+ * \param backlog the number of packets to keep in each MAC queue
+ * \param payloadSize the size of the packets
+ * \param received the number of MPDUs received
+ * \return the time elapsed running the simulation, in ms
+ */
+static int64_t
+Run(uint32_t nStas,
+    double duration,
+    uint32_t backlog,
+    uint32_t payloadSize,
+    uint64_t& received)
+{
+    NodeContainer nodes;
+    nodes.Create(nStas);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HeMcs7"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate24Mbps"));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 1);
+
+    received = 0;
+    for (uint32_t i = 0; i < nStas; i++)
+    {
+        auto device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        device->GetMac()->TraceConnectWithoutContext(
+            "MacRx",
+            Callback<void, Ptr<const Packet>>([&received](Ptr<const Packet>) { received++; }));
+        Simulator::Schedule(MicroSeconds(i),
+                            &TopUp,
+                            device,
+                            devices.Get((i + 1) % nStas)->GetAddress(),
+                            backlog,
+                            payloadSize);
+    }
+
+    Simulator::Stop(Seconds(duration));
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nStas = 128;
+    double duration = 0.2;
+    uint32_t backlog = 8;
+    uint32_t payloadSize = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the channel access of many contending stations");
+    cmd.AddValue("stas", "number of stations", nStas);
+    cmd.AddValue("duration", "simulated time (s)", duration);
+    cmd.AddValue("backlog", "number of packets kept in each MAC queue", backlog);
+    cmd.AddValue("payloadSize", "size of the packets (bytes)", payloadSize);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nStas < 2, "At least two stations are needed");
+
+    std::cout << "Running bench-channel-access-manager with stas=" << nStas
+              << " duration=" << duration << " backlog=" << backlog << std::endl;
+
+    uint64_t received;
+    int64_t elapsed = Run(nStas, duration, backlog, payloadSize, received);
+    std::cout << received << " MPDUs received" << std::endl;
+    Report("MPDUs received", received, elapsed);
+    return 0;
+}
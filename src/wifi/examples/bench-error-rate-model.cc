@@ -0,0 +1,159 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the computation of the chunk success rates by the
+// error rate models, with and without lookup tables. For each model, 'n'
+// success rates are computed for random modes, SNRs and chunk sizes, as done
+// by the interference helper when a PPDU is received. The largest difference
+// between the success rates computed with and without lookup tables is
+// reported as well.
+// Sample usage:  ./ns3 run 'bench-error-rate-model --n=10000000'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/dsss-phy.h"
+#include "ns3/error-rate-model.h"
+#include "ns3/he-phy.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-tx-vector.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/// A chunk whose success rate is computed
+struct Chunk
+{
+    WifiTxVector txVector; //!< the TXVECTOR of the chunk
+    double snr;            //!< the SNR of the chunk (linear scale)
+    uint64_t nbits;        //!< the number of bits in the chunk
+};
+
+/**
+ * Compute the success rates of the given chunks.
+ *
+ * \param model the error rate model
+ * \param chunks the chunks
+ * \param successRates the success rates of the chunks
+ * \return the time elapsed computing the success rates, in ms
+ */
+static int64_t
+Run(Ptr<ErrorRateModel> model, const std::vector<Chunk>& chunks, std::vector<double>& successRates)
+{
+    successRates.resize(chunks.size());
+    SystemWallClockMs time;
+    time.Start();
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        const auto& chunk = chunks[i];
+        successRates[i] = model->GetChunkSuccessRate(chunk.txVector.GetMode(),
+                                                     chunk.txVector,
+                                                     chunk.snr,
+                                                     chunk.nbits);
+    }
+    return time.End();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the computation of the chunk success rates");
+    cmd.AddValue("n", "number of success rates computed for each model", n);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-error-rate-model with n=" << n << std::endl;
+
+    std::vector<WifiTxVector> txVectors;
+    for (const auto& mode : {DsssPhy::GetDsssRate1Mbps(), DsssPhy::GetDsssRate11Mbps()})
+    {
+        txVectors.emplace_back(mode, 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 22, false);
+    }
+    for (uint8_t mcs = 0; mcs < 12; mcs++)
+    {
+        for (uint16_t width : {20, 80})
+        {
+            txVectors.emplace_back(HePhy::GetHeMcs(mcs),
+                                   0,
+                                   WIFI_PREAMBLE_HE_SU,
+                                   800,
+                                   1,
+                                   1,
+                                   0,
+                                   width,
+                                   false);
+        }
+    }
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::vector<Chunk> chunks;
+    chunks.reserve(n);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        chunks.push_back({txVectors[rng->GetInteger(0, txVectors.size() - 1)],
+                          DbToRatio(rng->GetValue(-5, 45)),
+                          rng->GetInteger(1, 8 * 1500)});
+    }
+
+    for (const std::string model : {"ns3::NistErrorRateModel", "ns3::YansErrorRateModel"})
+    {
+        ObjectFactory factory(model);
+        std::vector<double> expected;
+        std::vector<double> successRates;
+        int64_t analytic = Run(factory.Create<ErrorRateModel>(), chunks, expected);
+        factory.Set("UseLookupTables", BooleanValue(true));
+        auto tableModel = factory.Create<ErrorRateModel>();
+        // the first run includes the construction of the tables
+        int64_t first = Run(tableModel, chunks, successRates);
+        int64_t table = Run(tableModel, chunks, successRates);
+        double maxError = 0;
+        for (std::size_t i = 0; i < chunks.size(); i++)
+        {
+            maxError = std::max(maxError, std::abs(successRates[i] - expected[i]));
+        }
+        Report(model + " analytic", n, analytic);
+        Report(model + " lookup tables (first run)", n, first);
+        Report(model + " lookup tables", n, table);
+        std::cout << "max difference " << maxError << std::endl;
+    }
+    return 0;
+}
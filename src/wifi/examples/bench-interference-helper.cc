@@ -0,0 +1,180 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the interference helpers of the wifi PHYs in a
+// dense BSS. 'stas' stations operating on an 80 MHz 802.11ax channel are
+// placed within a few meters of each other, so that every PHY receives every
+// PPDU, and each of them broadcasts 'packets' packets at random times over
+// 'duration' seconds, so that the PPDUs overlap frequently. The simulation is
+// run with the InterferenceHelper and with the RingBufferInterferenceHelper,
+// and the number of packets received must be the same in both cases.
+// Sample usage:  ./ns3 run 'bench-interference-helper --stas=100'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/packet.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Run a simulation.
+ *
+ * \param nStas the number of stations
+ * \param packets the number of packets sent by each station
+ * \param duration the duration over which the packets are sent
+ * \param interferenceHelper the TypeId of the interference helpers
+ * \param received the number of packets received
+ * \return the time elapsed running the simulation, in ms
+ */
+static int64_t
+Run(uint32_t nStas,
+    uint32_t packets,
+    Time duration,
+    const std::string& interferenceHelper,
+    uint64_t& received)
+{
+    NodeContainer nodes;
+    nodes.Create(nStas);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(0.5),
+                                  "DeltaY",
+                                  DoubleValue(0.5),
+                                  "GridWidth",
+                                  UintegerValue(std::ceil(std::sqrt(nStas))));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    SpectrumWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    phy.SetInterferenceHelper(interferenceHelper);
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HeMcs0"));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 1);
+
+    received = 0;
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        DynamicCast<WifiNetDevice>(devices.Get(i))
+            ->GetPhy()
+            ->TraceConnectWithoutContext(
+                "PhyRxEnd",
+                Callback<void, Ptr<const Packet>>([&received](Ptr<const Packet>) { received++; }));
+    }
+
+    // the stations send their packets at random times
+    Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable>();
+    start->SetStream(0);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<NetDevice> sender = devices.Get(i);
+        for (uint32_t p = 0; p < packets; p++)
+        {
+            Simulator::Schedule(MicroSeconds(start->GetInteger(1, duration.GetMicroSeconds())),
+                                [sender]() {
+                                    sender->Send(Create<Packet>(1000), sender->GetBroadcast(), 1);
+                                });
+        }
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nStas = 30;
+    uint32_t packets = 10;
+    double duration = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the interference helpers in a dense BSS");
+    cmd.AddValue("stas", "number of stations", nStas);
+    cmd.AddValue("packets", "number of packets sent by each station", packets);
+    cmd.AddValue("duration", "duration over which the packets are sent (s)", duration);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nStas == 0 || duration <= 0, "There must be stations sending packets");
+
+    std::cout << "Running bench-interference-helper with stas=" << nStas
+              << " packets=" << packets << " duration=" << duration << std::endl;
+
+    uint64_t receivedMap;
+    uint64_t receivedRing;
+    int64_t map = Run(nStas, packets, Seconds(duration), "ns3::InterferenceHelper", receivedMap);
+    int64_t ring = Run(nStas,
+                       packets,
+                       Seconds(duration),
+                       "ns3::RingBufferInterferenceHelper",
+                       receivedRing);
+    NS_ABORT_MSG_IF(receivedMap != receivedRing,
+                    "Different numbers of packets received: " << receivedMap << " vs "
+                                                              << receivedRing);
+    std::cout << nStas << " stations, " << receivedMap << " packets received" << std::endl;
+    Report("InterferenceHelper", nStas * packets, map);
+    Report("RingBufferInterferenceHelper", nStas * packets, ring);
+    return 0;
+}
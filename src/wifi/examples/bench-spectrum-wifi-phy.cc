@@ -0,0 +1,216 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the generation of the transmit PSDs of HE PPDUs and
+// the integration of the received PSDs over the bands of a SpectrumWifiPhy.
+// First, 'signals' transmit PSDs of an HE SU PPDU occupying the whole
+// 'channelWidth' MHz channel are built twice: with the same transmit power, so
+// that all but the first one are copies of the PSD stored by
+// WifiSpectrumValueHelper, and with a different transmit power each time, so
+// that each PSD is generated (and the stored PSDs are regularly flushed). Then,
+// 'signals' such PPDUs are passed to SpectrumWifiPhy::StartRx (one every 200
+// microseconds) of a PHY operating on that channel, which computes the received
+// power over each 20 MHz, 40 MHz, 80 MHz and 160 MHz band and each RU of the
+// channel. By default, the received power is below the RX sensitivity, so that
+// the PPDUs are only tracked as interference. The sum of the received powers
+// reported by the SignalArrival trace source is printed, so that the results of
+// different builds can be compared.
+// Sample usage:  ./ns3 run 'bench-spectrum-wifi-phy --channelWidth=80'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/he-phy.h"
+#include "ns3/he-ppdu.h"
+#include "ns3/interference-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-wifi-phy.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-spectrum-phy-interface.h"
+#include "ns3/wifi-spectrum-signal-parameters.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Build the given number of transmit PSDs of an HE SU PPDU.
+ *
+ * \param channel the operating channel
+ * \param signals the number of PSDs to build
+ * \param txPowerW the transmit power in watts
+ * \param varyPower whether the transmit power of each PSD slightly differs from
+ *        that of the previous ones, so that no stored PSD can be reused
+ * \param totalPowerW the sum of the powers of the PSDs, in watts
+ * \return the time elapsed building the PSDs, in ms
+ */
+static int64_t
+BuildTxPsds(const WifiPhyOperatingChannel& channel,
+            uint32_t signals,
+            double txPowerW,
+            bool varyPower,
+            double& totalPowerW)
+{
+    const auto width = channel.GetWidth();
+    totalPowerW = 0;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < signals; i++)
+    {
+        auto psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
+            channel.GetFrequency(),
+            width,
+            varyPower ? txPowerW * (1 + i * 1e-9) : txPowerW,
+            width);
+        totalPowerW += WifiSpectrumValueHelper::GetBandPowerW(psd, {0, psd->GetValuesN() - 1});
+    }
+    return time.End();
+}
+
+/**
+ * Pass the given number of HE SU PPDUs to SpectrumWifiPhy::StartRx.
+ *
+ * \param channel the operating channel
+ * \param signals the number of PPDUs
+ * \param rxPowerW the received power in watts
+ * \param totalPowerDbm the sum of the received powers reported by the PHY, in dBm
+ * \return the time elapsed running the simulation, in ms
+ */
+static int64_t
+ReceiveSignals(const WifiPhyOperatingChannel& channel,
+               uint32_t signals,
+               double rxPowerW,
+               double& totalPowerDbm)
+{
+    auto node = CreateObject<Node>();
+    auto device = CreateObject<WifiNetDevice>();
+    auto phy = CreateObject<SpectrumWifiPhy>();
+    phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    phy->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+    phy->SetDevice(device);
+    phy->AddChannel(CreateObject<MultiModelSpectrumChannel>());
+    phy->SetOperatingChannel(WifiPhy::ChannelTuple{channel.GetNumber(),
+                                                   channel.GetWidth(),
+                                                   channel.GetPhyBand(),
+                                                   0});
+    phy->ConfigureStandard(WIFI_STANDARD_80211ax);
+    device->SetPhy(phy);
+    node->AddDevice(device);
+
+    totalPowerDbm = 0;
+    phy->TraceConnectWithoutContext(
+        "SignalArrival",
+        Callback<void, bool, uint32_t, double, Time>(
+            [&totalPowerDbm](bool, uint32_t, double rxPowerDbm, Time) {
+                totalPowerDbm += rxPowerDbm;
+            }));
+
+    const auto width = channel.GetWidth();
+    WifiTxVector txVector(HePhy::GetHeMcs0(), 0, WIFI_PREAMBLE_HE_SU, 800, 1, 1, 0, width, false);
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    auto psdu = Create<WifiPsdu>(Create<Packet>(1000), hdr);
+    auto params = Create<WifiSpectrumSignalParameters>();
+    params->psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
+        channel.GetFrequency(),
+        width,
+        rxPowerW,
+        width);
+    params->duration = MicroSeconds(100);
+    params->txWidth = width;
+    for (uint32_t i = 0; i < signals; i++)
+    {
+        Simulator::Schedule(MicroSeconds(200 * (i + 1)), [=]() {
+            params->ppdu = Create<HePpdu>(psdu, txVector, channel, params->duration, i);
+            phy->StartRx(params, nullptr);
+        });
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    phy->Dispose();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint16_t channelWidth = 160;
+    uint32_t signals = 20000;
+    double rxPowerDbm = -110;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the TX PSDs and the band integration of SpectrumWifiPhy");
+    cmd.AddValue("channelWidth", "width of the channel (20, 40, 80 or 160 MHz)", channelWidth);
+    cmd.AddValue("signals", "number of PSDs built and of PPDUs received", signals);
+    cmd.AddValue("rxPower", "received power (dBm)", rxPowerDbm);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(channelWidth != 20 && channelWidth != 40 && channelWidth != 80 &&
+                        channelWidth != 160,
+                    "Unsupported channel width " << channelWidth);
+    WifiPhyOperatingChannel channel;
+    channel.SetDefault(channelWidth, WIFI_STANDARD_80211ax, WIFI_PHY_BAND_5GHZ);
+
+    std::cout << "Running bench-spectrum-wifi-phy with channelWidth=" << channelWidth
+              << " signals=" << signals << " rxPower=" << rxPowerDbm << std::endl;
+
+    double totalPowerW;
+    int64_t psdElapsed = BuildTxPsds(channel, signals, DbmToW(20), false, totalPowerW);
+    double variedTotalPowerW;
+    int64_t variedPsdElapsed =
+        BuildTxPsds(channel, signals, DbmToW(20), true, variedTotalPowerW);
+    double totalPowerDbm;
+    int64_t rxElapsed = ReceiveSignals(channel, signals, DbmToW(rxPowerDbm), totalPowerDbm);
+    std::cout.precision(17);
+    std::cout << "Total TX power " << totalPowerW << " W (same power), " << variedTotalPowerW
+              << " W (varying power), total RX power " << totalPowerDbm << " dBm" << std::endl;
+    std::cout.precision(6);
+    Report("TX PSDs built with the same power (stored PSD reused)", signals, psdElapsed);
+    Report("TX PSDs built with varying power (PSD generated)", signals, variedPsdElapsed);
+    Report("PPDUs passed to StartRx", signals, rxElapsed);
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the MAC queues of an AP and their scheduler when
+// A-MPDUs are aggregated at 802.11be rates. The AP holds 'depth' MPDUs for each
+// of the 8 TIDs of 'stas' stations. 'n' times, for each Access Category, the
+// container queue selected by the MAC queue scheduler is served: the MPDUs that
+// fit in an A-MPDU of maximum duration transmitted with the given EHT MCS,
+// channel width and number of spatial streams are peeked and dequeued, as done
+// by the MPDU aggregator, and as many new MPDUs are enqueued in that container
+// queue to keep it backlogged. Since the scheduler serves the container queues
+// in FCFS order, all the container queues are served in turn.
+// Sample usage:  ./ns3 run 'bench-wifi-mac-queue --stas=64 --n=2000'
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/eht-phy.h"
+#include "ns3/packet.h"
+#include "ns3/qos-utils.h"
+#include "ns3/queue-size.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nStas = 32;
+    uint32_t depth = 0;
+    uint32_t n = 10000;
+    uint32_t mcs = 13;
+    uint32_t width = 160;
+    uint32_t nss = 1;
+    uint32_t payloadSize = 1500;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the MAC queues of an AP aggregating A-MPDUs at 802.11be rates");
+    cmd.AddValue("stas", "number of stations the AP holds MPDUs for", nStas);
+    cmd.AddValue("depth",
+                 "number of MPDUs held for each TID of each station (0 for twice the number "
+                 "of MPDUs in an A-MPDU)",
+                 depth);
+    cmd.AddValue("n", "number of A-MPDUs built for each Access Category", n);
+    cmd.AddValue("mcs", "EHT MCS used to transmit the A-MPDUs", mcs);
+    cmd.AddValue("width", "channel width used to transmit the A-MPDUs (MHz)", width);
+    cmd.AddValue("nss", "number of spatial streams used to transmit the A-MPDUs", nss);
+    cmd.AddValue("payloadSize", "size of the MSDUs (bytes)", payloadSize);
+    cmd.Parse(argc, argv);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    // size of an A-MPDU subframe, i.e., MPDU delimiter, MAC header, payload, FCS and padding
+    uint32_t subframeSize = (4 + hdr.GetSize() + payloadSize + 4 + 3) / 4 * 4;
+    // an A-MPDU lasts at most aPPDUMaxTime (5.484 ms) and contains at most 1024 MPDUs
+    uint64_t rate = EhtPhy::GetDataRate(mcs, width, 800, nss);
+    auto ampduSize = static_cast<uint32_t>(
+        std::min<uint64_t>(1024, MicroSeconds(5484).GetSeconds() * rate / (8 * subframeSize)));
+    if (depth == 0)
+    {
+        depth = 2 * ampduSize;
+    }
+    NS_ABORT_MSG_IF(ampduSize == 0, "No MPDU fits in an A-MPDU");
+
+    std::cout << "Running bench-wifi-mac-queue with stas=" << nStas << " depth=" << depth
+              << " n=" << n << " (" << ampduSize << " MPDUs per A-MPDU)" << std::endl;
+
+    // each Access Category holds the MPDUs of two TIDs
+    Config::SetDefault("ns3::WifiMacQueue::MaxSize",
+                       QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, 2 * nStas * depth)));
+
+    NodeContainer node(1);
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211be);
+    WifiMacHelper mac;
+    // the AP does not transmit any frame while the benchmark is running
+    mac.SetType("ns3::ApWifiMac", "BeaconGeneration", BooleanValue(false));
+    auto device = DynamicCast<WifiNetDevice>(wifi.Install(phy, mac, node).Get(0));
+    auto apMac = device->GetMac();
+
+    // the timestamps of the MPDUs determine the order in which the queues are served
+    Time stamp;
+    auto packet = Create<Packet>(payloadSize);
+    hdr.SetAddr2(apMac->GetAddress());
+    hdr.SetAddr3(apMac->GetAddress());
+    for (uint32_t sta = 0; sta < nStas; sta++)
+    {
+        hdr.SetAddr1(Mac48Address::Allocate());
+        for (uint8_t tid = 0; tid < 8; tid++)
+        {
+            hdr.SetQosTid(tid);
+            auto queue = apMac->GetTxopQueue(QosUtilsMapTidToAc(tid));
+            for (uint32_t i = 0; i < depth; i++)
+            {
+                stamp += NanoSeconds(1);
+                NS_ABORT_IF(!queue->Enqueue(Create<WifiMpdu>(packet, hdr, stamp)));
+            }
+        }
+    }
+
+    std::list<Ptr<const WifiMpdu>> ampdu;
+    uint64_t nMpdus = 0;
+    auto serveQueues = [&]() {
+        for (auto ac : {AC_BE, AC_BK, AC_VI, AC_VO})
+        {
+            auto queue = apMac->GetTxopQueue(ac);
+            auto mpdu = queue->PeekFirstAvailable(SINGLE_LINK_OP_ID);
+            NS_ABORT_MSG_IF(!mpdu, "The queues must be backlogged");
+            auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+            ampdu.clear();
+            while (mpdu && ampdu.size() < ampduSize)
+            {
+                ampdu.push_back(mpdu);
+                mpdu = queue->PeekByQueueId(queueId, mpdu);
+            }
+            queue->DequeueIfQueued(ampdu);
+            for (const auto& dequeued : ampdu)
+            {
+                stamp += NanoSeconds(1);
+                NS_ABORT_IF(!queue->Enqueue(
+                    Create<WifiMpdu>(dequeued->GetPacket(), dequeued->GetHeader(), stamp)));
+            }
+            nMpdus += ampdu.size();
+        }
+    };
+    // the queues are served from within simulation events, as done by the Txops
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i), serveQueues);
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    Report("MPDUs aggregated", nMpdus, time.End());
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the delivery of PPDUs by YansWifiChannel as the
+// number of stations grows. 'min-stas' stations, then ten times as many, and
+// so on up to 'max-stas' stations, are placed on a square grid with a constant
+// density (one station every 'spacing' meters), so that the number of stations
+// within range of a sender does not depend on the number of stations.
+// 'senders' stations spread over the grid broadcast 'packets' packets each,
+// and the simulation is run:
+// - with the MaxRange attribute of the channel set to 0, i.e., the PPDUs are
+//   delivered to all the stations;
+// - with the MaxRange attribute set to 'range' meters, i.e., the PPDUs are only
+//   delivered to the stations found within range by the spatial index.
+// The number of packets received must be the same in both cases.
+// Sample usage:  ./ns3 run 'bench-yans-wifi-channel --max-stas=10000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * Print the result of a benchmark.
+ *
+ * \param name name of the benchmark
+ * \param ops number of operations performed
+ * \param deltaMs time elapsed, in ms
+ */
+static void
+Report(const std::string& name, uint64_t ops, int64_t deltaMs)
+{
+    double ps = ops;
+    ps *= 1000;
+    ps /= std::max<int64_t>(deltaMs, 1);
+    std::cout << ps << " ops/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+/**
+ * Run a simulation.
+ *
+ * \param nStas the number of stations
+ * \param spacing the distance between neighbor stations, in meters
+ * \param senders the number of stations sending packets
+ * \param packets the number of packets sent by each sender
+ * \param maxRange the value of the MaxRange attribute of the channel
+ * \param received the number of packets received
+ * \return the time elapsed running the simulation, in ms
+ */
+static int64_t
+Run(uint32_t nStas,
+    double spacing,
+    uint32_t senders,
+    uint32_t packets,
+    double maxRange,
+    uint64_t& received)
+{
+    NodeContainer nodes;
+    nodes.Create(nStas);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(spacing),
+                                  "DeltaY",
+                                  DoubleValue(spacing),
+                                  "GridWidth",
+                                  UintegerValue(std::ceil(std::sqrt(nStas))));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
+    Ptr<YansWifiChannel> channel = channelHelper.Create();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 1);
+
+    received = 0;
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        DynamicCast<WifiNetDevice>(devices.Get(i))
+            ->GetPhy()
+            ->TraceConnectWithoutContext(
+                "PhyRxEnd",
+                Callback<void, Ptr<const Packet>>([&received](Ptr<const Packet>) { received++; }));
+    }
+
+    // the senders are spread over the grid and take turns to send a packet
+    for (uint32_t p = 0; p < packets; p++)
+    {
+        for (uint32_t s = 0; s < senders; s++)
+        {
+            Ptr<NetDevice> sender = devices.Get(s * nStas / senders);
+            Simulator::Schedule(MilliSeconds(p * senders + s) + MicroSeconds(1), [sender]() {
+                sender->Send(Create<Packet>(100), sender->GetBroadcast(), 1);
+            });
+        }
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t minStas = 100;
+    uint32_t maxStas = 10000;
+    double spacing = 20;
+    double range = 250;
+    uint32_t senders = 10;
+    uint32_t packets = 10;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the delivery of PPDUs by YansWifiChannel");
+    cmd.AddValue("min-stas", "smallest number of stations", minStas);
+    cmd.AddValue("max-stas", "largest number of stations", maxStas);
+    cmd.AddValue("spacing", "distance between neighbor stations (m)", spacing);
+    cmd.AddValue("range", "value of the MaxRange attribute of the channel (m)", range);
+    cmd.AddValue("senders", "number of stations sending packets", senders);
+    cmd.AddValue("packets", "number of packets sent by each sender", packets);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(minStas == 0 || senders == 0 || senders > minStas,
+                    "There must be at least a sender and at most one sender per station");
+    NS_ABORT_MSG_IF(range <= 0, "The range must be positive");
+
+    std::cout << "Running bench-yans-wifi-channel with spacing=" << spacing << " range=" << range
+              << " senders=" << senders << " packets=" << packets << std::endl;
+
+    for (uint32_t nStas = minStas; nStas <= maxStas; nStas *= 10)
+    {
+        uint64_t receivedAll;
+        uint64_t receivedInRange;
+        int64_t all = Run(nStas, spacing, senders, packets, 0, receivedAll);
+        int64_t inRange = Run(nStas, spacing, senders, packets, range, receivedInRange);
+        NS_ABORT_MSG_IF(receivedAll != receivedInRange,
+                        "Different numbers of packets received: " << receivedAll << " vs "
+                                                                  << receivedInRange);
+        std::cout << nStas << " stations, " << receivedAll << " packets received" << std::endl;
+        std::ostringstream oss;
+        oss << nStas << " stations, MaxRange=";
+        Report(oss.str() + "0", senders * packets, all);
+        oss << range;
+        Report(oss.str(), senders * packets, inRange);
+    }
+    return 0;
+}
@@ -26,14 +26,17 @@
 // options, traces, and a validation option; the main output is a Gnuplot
 // plot file plotting throughput vs. number of nodes.
 
+#include "ns3/abort.h"
 #include "ns3/ampdu-subframe-header.h"
 #include "ns3/application-container.h"
 #include "ns3/boolean.h"
 #include "ns3/command-line.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/error-model.h"
 #include "ns3/gnuplot.h"
 #include "ns3/integer.h"
+#include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/node-list.h"
@@ -42,16 +45,21 @@
 #include "ns3/packet-socket-server.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/qos-txop.h"
 #include "ns3/queue-size.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/ssid.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-mac-trailer.h"
 #include "ns3/wifi-mac.h"
 #include "ns3/wifi-net-device.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/wifi-utils.h"
 #include "ns3/yans-wifi-helper.h"
 
+#include <cmath>
 #include <fstream>
 
 /// Avoid std::numbers::pi because it's C++20
@@ -114,6 +122,7 @@ std::set<uint32_t> associated; ///< Contains the IDs of the STAs that successful
 bool tracing = false;    ///< Flag to enable/disable generation of tracing files
 uint32_t pktSize = 1500; ///< packet size used for the simulation (in bytes)
 uint8_t maxMpdus = 0;    ///< The maximum number of MPDUs in A-MPDUs (0 to disable MPDU aggregation)
+uint64_t eventCount = 0; ///< The number of events executed by the simulator during the last run
 
 /// Table of the expected values for EIFS
 std::map<std::string /* mode */,
@@ -2386,6 +2395,125 @@ RestartCalc()
     rxEventAbortedByTx.clear();
 }
 
+/// The parameters of the analytic (Bianchi) model of the contention among saturated stations
+struct BianchiModelParameters
+{
+    uint32_t cwMin{0};      ///< the minimum contention window
+    uint32_t cwMax{0};      ///< the maximum contention window
+    Time slot;              ///< the slot duration
+    Time successDuration;   ///< the time the medium is busy because of a successful transmission
+    Time collisionDuration; ///< the time the medium is busy because of a collision
+    uint32_t payloadBits{0}; ///< the number of bits of payload carried by a successful transmission
+};
+
+/// The solution of the analytic (Bianchi) model
+struct BianchiModelSolution
+{
+    double tau{0};        ///< the probability that a station transmits in a random slot
+    double p{0};          ///< the probability that a transmission collides
+    double throughput{0}; ///< the total throughput in Mbps
+};
+
+BianchiModelSolution analyticModel; ///< The solution of the analytic model for the last run
+
+/**
+ * Get the parameters of the analytic model for the stations configured as the given
+ * device. The EDCA parameters are the ones of the (best effort) channel access function
+ * of the device, i.e., the ones advertised in the EDCA Parameter Set in an infrastructure
+ * network, and the durations are computed with the TXVECTORs that the remote station
+ * manager of the device selects for the data frames and the acknowledgments.
+ *
+ * \param device the device
+ * \param receiver the address of the receiver of the data frames
+ * \return the parameters of the analytic model
+ */
+BianchiModelParameters
+GetBianchiModelParameters(Ptr<WifiNetDevice> device, Mac48Address receiver)
+{
+    Ptr<WifiMac> mac = device->GetMac();
+    Ptr<WifiPhy> phy = device->GetPhy();
+    Ptr<Txop> txop = mac->GetQosSupported() ? Ptr<Txop>(mac->GetQosTxop(AC_BE)) : mac->GetTxop();
+
+    WifiMacHeader hdr;
+    hdr.SetType(mac->GetQosSupported() ? WIFI_MAC_QOSDATA : WIFI_MAC_DATA);
+    hdr.SetAddr1(receiver);
+    if (mac->GetQosSupported())
+    {
+        hdr.SetQosTid(0);
+    }
+    Ptr<WifiRemoteStationManager> manager = device->GetRemoteStationManager();
+    WifiTxVector dataTxVector = manager->GetDataTxVector(hdr, phy->GetChannelWidth());
+    WifiTxVector ackTxVector = manager->GetAckTxVector(receiver, dataTxVector);
+    uint32_t mpduSize = pktSize + LLC_SNAP_HEADER_LENGTH + hdr.GetSize() + WIFI_MAC_FCS_LENGTH;
+    Time data = WifiPhy::CalculateTxDuration(mpduSize, dataTxVector, phy->GetPhyBand());
+    Time ack = WifiPhy::CalculateTxDuration(GetAckSize(), ackTxVector, phy->GetPhyBand());
+    Time aifs = phy->GetSifs() + txop->GetAifsn() * phy->GetSlot();
+
+    BianchiModelParameters params;
+    params.cwMin = txop->GetMinCw();
+    params.cwMax = txop->GetMaxCw();
+    params.slot = phy->GetSlot();
+    params.successDuration = data + phy->GetSifs() + ack + aifs;
+    // as in the DIFS variant of the model (the one validated by default), a collision keeps
+    // the medium busy for the duration of the data frame followed by AIFS
+    params.collisionDuration = data + aifs;
+    params.payloadBits = pktSize * 8;
+    return params;
+}
+
+/**
+ * Solve the analytic model of Bianchi for the given number of saturated stations,
+ * assuming that frames are retransmitted until they are successfully received.
+ *
+ * \param nStas the number of stations
+ * \param params the parameters of the model
+ * \return the solution of the model
+ */
+BianchiModelSolution
+SolveBianchiModel(uint32_t nStas, const BianchiModelParameters& params)
+{
+    const double w = params.cwMin + 1;
+    const auto m = static_cast<uint32_t>(std::lround(std::log2((params.cwMax + 1) / w)));
+    // the probability to transmit in a slot given the collision probability p (the sum
+    // of the powers of 2p avoids the singularity of the closed form at p = 1/2)
+    auto getTau = [w, m](double p) {
+        double sum = 0;
+        for (uint32_t i = 0; i < m; ++i)
+        {
+            sum += std::pow(2 * p, i);
+        }
+        return 2 / (1 + w + p * w * sum);
+    };
+
+    // find the fixed point by bisection, the right-hand side decreasing as tau increases
+    double low = 0;
+    double high = 1;
+    for (uint8_t i = 0; i < 64; ++i)
+    {
+        double tau = (low + high) / 2;
+        if (tau < getTau(1 - std::pow(1 - tau, nStas - 1)))
+        {
+            low = tau;
+        }
+        else
+        {
+            high = tau;
+        }
+    }
+
+    BianchiModelSolution solution;
+    solution.tau = (low + high) / 2;
+    solution.p = 1 - std::pow(1 - solution.tau, nStas - 1);
+    double pTr = 1 - std::pow(1 - solution.tau, nStas);
+    double pS = nStas * solution.tau * std::pow(1 - solution.tau, nStas - 1) / pTr;
+    solution.throughput =
+        pS * pTr * params.payloadBits /
+        ((1 - pTr) * params.slot.ToDouble(Time::US) +
+         pTr * pS * params.successDuration.ToDouble(Time::US) +
+         pTr * (1 - pS) * params.collisionDuration.ToDouble(Time::US));
+    return solution;
+}
+
 /**
  * Class to configure and run an experiment.
  */
@@ -2411,6 +2539,8 @@ class Experiment
      * \param apTxPowerDbm the AP transmit power in dBm
      * \param staTxPowerDbm the STA transmit power in dBm
      * \param pktInterval the packet interval
+     * \param analyticStas the number of stations replaced by the analytic model (adhoc only,
+     *        nothing is simulated if all the stations are replaced)
      * \return 0 if all went well
      */
     int Run(const WifiHelper& wifi,
@@ -2426,7 +2556,8 @@ class Experiment
             double distanceM,
             double apTxPowerDbm,
             double staTxPowerDbm,
-            Time pktInterval);
+            Time pktInterval,
+            uint32_t analyticStas);
 };
 
 Experiment::Experiment()
@@ -2447,19 +2578,27 @@ Experiment::Run(const WifiHelper& helper,
                 double distance,
                 double apTxPowerDbm,
                 double staTxPowerDbm,
-                Time pktInterval)
+                Time pktInterval,
+                uint32_t analyticStas)
 {
     RngSeedManager::SetSeed(10);
     RngSeedManager::SetRun(10);
 
+    // If only some of the stations are replaced by the analytic model (hybrid mode), they
+    // are represented by a proxy station sending to a sink station, which are the last two
+    // nodes. If all of them are, a single pair of stations is installed to get the
+    // parameters of the model.
+    const bool analyticOnly = (analyticStas >= networkSize);
+    const bool hybrid = (analyticStas > 0) && !analyticOnly;
+    uint32_t nSimulatedStas = analyticOnly ? (infra ? 1 : 2) : networkSize - analyticStas;
     NodeContainer wifiNodes;
     if (infra)
     {
-        wifiNodes.Create(networkSize + 1);
+        wifiNodes.Create(nSimulatedStas + 1);
     }
     else
     {
-        wifiNodes.Create(networkSize);
+        wifiNodes.Create(hybrid ? nSimulatedStas + 2 : nSimulatedStas);
     }
 
     YansWifiPhyHelper phy = wifiPhy;
@@ -2529,6 +2668,42 @@ Experiment::Run(const WifiHelper& helper,
                                          UintegerValue(maxMpdus * (pktSize + 50)));
     }
 
+    analyticModel = SolveBianchiModel(
+        networkSize,
+        GetBianchiModelParameters(DynamicCast<WifiNetDevice>(devices.Get(infra ? 1 : 0)),
+                                  Mac48Address::ConvertFrom(devices.Get(infra ? 0 : 1 % nNodes)
+                                                                ->GetAddress())));
+    if (analyticOnly)
+    {
+        eventCount = 0;
+        Simulator::Destroy();
+        return 0;
+    }
+    if (hybrid)
+    {
+        // The proxy transmits with the probability that at least one of the replaced stations
+        // transmits in a slot, i.e., with a fixed contention window, and the sink loses the
+        // frames that stand for collisions among the replaced stations
+        double tauProxy = 1 - std::pow(1 - analyticModel.tau, analyticStas);
+        auto cw = static_cast<uint32_t>(std::lround(std::max(2 / tauProxy - 2, 0.0)));
+        Ptr<WifiMac> proxyMac = DynamicCast<WifiNetDevice>(devices.Get(nNodes - 2))->GetMac();
+        Ptr<Txop> proxyTxop = proxyMac->GetQosSupported()
+                                  ? Ptr<Txop>(proxyMac->GetQosTxop(AC_BE))
+                                  : proxyMac->GetTxop();
+        proxyTxop->SetMinCw(cw);
+        proxyTxop->SetMaxCw(cw);
+        double lossRate = 1 - analyticStas * analyticModel.tau *
+                                  std::pow(1 - analyticModel.tau, analyticStas - 1) / tauProxy;
+        Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+        errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+        errorModel->SetRate(lossRate);
+        DynamicCast<WifiNetDevice>(devices.Get(nNodes - 1))
+            ->GetPhy()
+            ->SetPostReceptionErrorModel(errorModel);
+        NS_LOG_DEBUG("Proxy of " << analyticStas << " stations with CW " << cw
+                                 << ", loss rate at the sink " << lossRate);
+    }
+
     MobilityHelper mobility;
     Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
     mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
@@ -2556,9 +2731,11 @@ Experiment::Run(const WifiHelper& helper,
     startTime->SetAttribute("Max", DoubleValue(5.0));
 
     uint32_t i = infra ? 1 : 0;
-    for (; i < nNodes; ++i)
+    for (; i < (hybrid ? nNodes - 1 : nNodes); ++i)
     {
-        uint32_t j = infra ? 0 : (i + 1) % nNodes;
+        // in hybrid mode, the simulated stations form the ring and the proxy sends to the sink
+        uint32_t j = infra ? 0 : (hybrid && i < nSimulatedStas ? (i + 1) % nSimulatedStas
+                                                                : (i + 1) % nNodes);
         PacketSocketAddress socketAddr;
         socketAddr.SetSingleDevice(devices.Get(i)->GetIfIndex());
         socketAddr.SetPhysicalAddress(devices.Get(j)->GetAddress());
@@ -2649,6 +2826,7 @@ Experiment::Run(const WifiHelper& helper,
     }
 
     Simulator::Run();
+    eventCount = Simulator::GetEventCount();
     Simulator::Destroy();
 
     if (tracing)
@@ -2683,6 +2861,23 @@ GetCount(const std::map<Mac48Address, uint64_t>& counter, Mac48Address addr)
     return count;
 }
 
+/**
+ * Get the total throughput of the last run.
+ *
+ * \return the sum of the throughputs of all the stations in Mbps
+ */
+double
+GetTotalThroughput()
+{
+    double throughput = 0;
+    for (const auto& [addr, bytes] : bytesReceived)
+    {
+        Time dataTransferDuration = timeLastReceived[addr] - timeFirstReceived[addr];
+        throughput += bytes * 8 / static_cast<double>(dataTransferDuration.GetMicroSeconds());
+    }
+    return throughput;
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -2716,6 +2911,13 @@ main(int argc, char* argv[])
     double distance = 0.001; ///< The distance in meters between the AP and the STAs
     double apTxPower = 16;   ///< The transmit power of the AP in dBm (if infrastructure only)
     double staTxPower = 16;  ///< The transmit power of each STA in dBm (or all STAs if adhoc)
+    bool abstractReception = false;  ///< Flag to abstract the reception of PPDUs at the PHY
+    bool compareAbstraction = false; ///< Flag to compare the abstracted reception of PPDUs against
+                                     ///< the detailed one
+    uint32_t analyticStas = 0; ///< Number of stations replaced by the analytic model (all of them
+                               ///< if greater than or equal to the number of stations)
+    bool compareAnalytic = false; ///< Flag to compare the analytic or hybrid mode against the
+                                  ///< simulation of all the stations
 
     // Disable fragmentation and RTS/CTS
     Config::SetDefault("ns3::WifiRemoteStationManager::FragmentationThreshold",
@@ -2778,8 +2980,37 @@ main(int argc, char* argv[])
                  "Set the transmit power of each STA in dBm (or all STAs if adhoc)",
                  staTxPower);
     cmd.AddValue("pktInterval", "Set the socket packet interval in microseconds", pktInterval);
+    cmd.AddValue("abstractReception",
+                 "Determine the outcome of the reception of PPDUs in a single event at the end of "
+                 "the PPDUs (see the WifiPhy::AbstractReception attribute)",
+                 abstractReception);
+    cmd.AddValue("compareAbstraction",
+                 "Run each trial with the detailed reception of PPDUs, then with the abstracted "
+                 "one, and compare the throughputs and the numbers of simulated events (the "
+                 "relative error is also checked against maxRelativeError if validate is set)",
+                 compareAbstraction);
+    cmd.AddValue("analyticStas",
+                 "Number of stations replaced by the analytic model of Bianchi: they are "
+                 "represented by a single station whose contention window and losses match the "
+                 "model (adhoc only), or nothing is simulated if all the stations are replaced",
+                 analyticStas);
+    cmd.AddValue("compareAnalytic",
+                 "Run each trial with all the stations simulated, then with analyticStas stations "
+                 "replaced by the analytic model, and compare the throughputs and the numbers of "
+                 "simulated events (the relative error is also checked against maxRelativeError "
+                 "if validate is set)",
+                 compareAnalytic);
     cmd.Parse(argc, argv);
 
+    if (compareAbstraction)
+    {
+        abstractReception = false;
+    }
+    NS_ABORT_MSG_IF(analyticStas > 0 && maxMpdus > 0,
+                    "The analytic model does not support A-MPDUs");
+    NS_ABORT_MSG_IF(compareAnalytic && analyticStas == 0,
+                    "compareAnalytic requires some stations to be replaced (see analyticStas)");
+
     if (tracing)
     {
         cwTraceFile.open("wifi-bianchi-cw-trace.out");
@@ -2977,6 +3208,16 @@ main(int argc, char* argv[])
     {
         averageThroughput = 0;
         double throughput;
+        if (analyticStas > 0 && analyticStas < n)
+        {
+            NS_ABORT_MSG_IF(infra,
+                            "Replacing only some of the stations by the analytic model requires "
+                            "the adhoc mode");
+            NS_ABORT_MSG_IF(n < analyticStas + 2,
+                            "At least two stations must be simulated in hybrid mode");
+        }
+        // the number of stations replaced by the analytic model in the first run of each trial
+        const uint32_t nAnalyticStas = compareAnalytic ? 0 : analyticStas;
         for (uint32_t runIndex = 0; runIndex < trials; runIndex++)
         {
             packetsReceived.clear();
@@ -3010,6 +3251,8 @@ main(int argc, char* argv[])
                 socketSendTraceFile << "# Trial " << runIndex + 1 << " of " << trials << "; "
                                     << phyModeStr.str() << " for " << n << " nodes" << std::endl;
             }
+            Config::SetDefault("ns3::WifiPhy::AbstractReception",
+                               BooleanValue(abstractReception));
             experiment.Run(wifi,
                            wifiPhy,
                            wifiMac,
@@ -3023,9 +3266,13 @@ main(int argc, char* argv[])
                            distance,
                            apTxPower,
                            staTxPower,
-                           MicroSeconds(pktInterval));
+                           MicroSeconds(pktInterval),
+                           nAnalyticStas);
             uint32_t k = 0;
-            if (bytesReceived.size() != n)
+            // the senders are the simulated stations and the proxy of the replaced ones, if any
+            uint32_t nSenders =
+                (nAnalyticStas == 0) ? n : (nAnalyticStas >= n ? 0 : n - nAnalyticStas + 1);
+            if (bytesReceived.size() != nSenders)
             {
                 NS_FATAL_ERROR("Not all stations got traffic!");
             }
@@ -3064,9 +3311,96 @@ main(int argc, char* argv[])
                           << dataTransferDuration << "; throughput " << nodeThroughput << " Mbps"
                           << std::endl;
             }
+            if (nAnalyticStas >= n)
+            {
+                throughput = analyticModel.throughput;
+                std::cout << "Analytic model: tau " << analyticModel.tau << "; p "
+                          << analyticModel.p << std::endl;
+            }
             std::cout << "Total throughput: " << throughput << " Mbps" << std::endl;
             averageThroughput += throughput;
             throughputArray[runIndex] = throughput;
+
+            if (compareAbstraction)
+            {
+                uint64_t detailedEventCount = eventCount;
+                associated.clear();
+                RestartCalc();
+                Config::SetDefault("ns3::WifiPhy::AbstractReception", BooleanValue(true));
+                experiment.Run(wifi,
+                               wifiPhy,
+                               wifiMac,
+                               wifiChannel,
+                               runIndex,
+                               n,
+                               Seconds(duration),
+                               false,
+                               infra,
+                               guardIntervalNs,
+                               distance,
+                               apTxPower,
+                               staTxPower,
+                               MicroSeconds(pktInterval),
+                               nAnalyticStas);
+                double abstractedThroughput = GetTotalThroughput();
+                double relativeError = std::abs(abstractedThroughput - throughput) / throughput;
+                std::cout << "Abstracted reception: total throughput " << abstractedThroughput
+                          << " Mbps; relative error " << 100 * relativeError << "%; events "
+                          << eventCount << " (detailed reception: " << detailedEventCount
+                          << ", ratio " << static_cast<double>(detailedEventCount) / eventCount
+                          << ")" << std::endl;
+                if (validate && (relativeError > maxRelativeError))
+                {
+                    NS_FATAL_ERROR("Relative error of the abstracted reception is too high!");
+                }
+            }
+
+            if (compareAnalytic)
+            {
+                uint64_t simulatedEventCount = eventCount;
+                associated.clear();
+                RestartCalc();
+                Config::SetDefault("ns3::WifiPhy::AbstractReception",
+                                   BooleanValue(abstractReception));
+                experiment.Run(wifi,
+                               wifiPhy,
+                               wifiMac,
+                               wifiChannel,
+                               runIndex,
+                               n,
+                               Seconds(duration),
+                               false,
+                               infra,
+                               guardIntervalNs,
+                               distance,
+                               apTxPower,
+                               staTxPower,
+                               MicroSeconds(pktInterval),
+                               analyticStas);
+                double modelThroughput =
+                    (analyticStas >= n) ? analyticModel.throughput : GetTotalThroughput();
+                double relativeError = std::abs(modelThroughput - throughput) / throughput;
+                std::cout << "Analytic model (tau " << analyticModel.tau << ", p "
+                          << analyticModel.p << "): throughput " << analyticModel.throughput
+                          << " Mbps; relative error "
+                          << 100 * std::abs(analyticModel.throughput - throughput) / throughput
+                          << "%" << std::endl;
+                if (analyticStas < n)
+                {
+                    std::cout << "Hybrid simulation (" << analyticStas
+                              << " stations replaced by the analytic model): total throughput "
+                              << modelThroughput << " Mbps; relative error "
+                              << 100 * relativeError << "%; events " << eventCount
+                              << " (all stations simulated: " << simulatedEventCount
+                              << ", ratio "
+                              << static_cast<double>(simulatedEventCount) / eventCount << ")"
+                              << std::endl;
+                }
+                if (validate && (relativeError > maxRelativeError))
+                {
+                    NS_FATAL_ERROR("Relative error of the analytic model is too high!");
+                }
+            }
         }
         averageThroughput = averageThroughput / trials;
 
@@ -56,6 +56,7 @@
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
 #include "ns3/node.h"
+#include "ns3/object-factory.h"
 #include "ns3/packet.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
@@ -101,6 +102,8 @@ class InterferenceExperiment
         WifiPreamble preamble; ///< preamble
         bool captureEnabled;   ///< whether physical layer capture is enabled
         double captureMargin;  ///< margin used for physical layer capture
+        /// TypeId of the interference helpers
+        std::string interferenceHelper;
     };
 
     InterferenceExperiment();
@@ -208,7 +211,8 @@ InterferenceExperiment::Input::Input()
       band(WIFI_PHY_BAND_5GHZ),
       preamble(WIFI_PREAMBLE_LONG),
       captureEnabled(false),
-      captureMargin(0)
+      captureMargin(0),
+      interferenceHelper("ns3::InterferenceHelper")
 {
 }
 
@@ -251,15 +255,16 @@ InterferenceExperiment::Run(InterferenceExperiment::Input input)
     Ptr<SpectrumWifiPhy> rx = CreateObject<SpectrumWifiPhy>();
     rx->SetDevice(devRx);
 
-    Ptr<InterferenceHelper> interferenceTxA = CreateObject<InterferenceHelper>();
+    ObjectFactory interferenceHelper(input.interferenceHelper);
+    Ptr<InterferenceHelper> interferenceTxA = interferenceHelper.Create<InterferenceHelper>();
     m_txA->SetInterferenceHelper(interferenceTxA);
     Ptr<ErrorRateModel> errorTxA = CreateObject<NistErrorRateModel>();
     m_txA->SetErrorRateModel(errorTxA);
-    Ptr<InterferenceHelper> interferenceTxB = CreateObject<InterferenceHelper>();
+    Ptr<InterferenceHelper> interferenceTxB = interferenceHelper.Create<InterferenceHelper>();
     m_txB->SetInterferenceHelper(interferenceTxB);
     Ptr<ErrorRateModel> errorTxB = CreateObject<NistErrorRateModel>();
     m_txB->SetErrorRateModel(errorTxB);
-    Ptr<InterferenceHelper> interferenceRx = CreateObject<InterferenceHelper>();
+    Ptr<InterferenceHelper> interferenceRx = interferenceHelper.Create<InterferenceHelper>();
     rx->SetInterferenceHelper(interferenceRx);
     Ptr<ErrorRateModel> errorRx = CreateObject<NistErrorRateModel>();
     rx->SetErrorRateModel(errorRx);
@@ -340,6 +345,9 @@ main(int argc, char* argv[])
     cmd.AddValue("preamble", "Type of preamble", str_preamble);
     cmd.AddValue("enableCapture", "Enable/disable physical layer capture", input.captureEnabled);
     cmd.AddValue("captureMargin", "Margin used for physical layer capture", input.captureMargin);
+    cmd.AddValue("interferenceHelper",
+                 "TypeId of the interference helper (e.g., ns3::RingBufferInterferenceHelper)",
+                 input.interferenceHelper);
     cmd.AddValue("checkResults", "Used to check results at the end of the test", checkResults);
     cmd.AddValue("expectRxASuccessful",
                  "Indicate whether packet A is expected to be successfully received",
@@ -375,12 +375,19 @@ ChannelAccessManager::DoGrantDcfAccess()
     NS_LOG_FUNCTION(this);
     uint32_t k = 0;
     Time now = Simulator::Now();
+    Time accessGrantStart = GetAccessGrantStart();
+    if (accessGrantStart > now)
+    {
+        // the backoff of every Txop ends at least an AIFS after the access grant start
+        NS_LOG_DEBUG("Medium busy until " << accessGrantStart << ", no access granted");
+        return;
+    }
     for (Txops::iterator i = m_txops.begin(); i != m_txops.end(); k++)
     {
         Ptr<Txop> txop = *i;
         if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED &&
             (!txop->IsQosTxop() || !StaticCast<QosTxop>(txop)->EdcaDisabled(m_linkId)) &&
-            GetBackoffEndFor(txop) <= now)
+            GetBackoffEndFor(txop, accessGrantStart) <= now)
         {
             /**
              * This is the first Txop we find with an expired backoff and which
@@ -395,7 +402,7 @@ ChannelAccessManager::DoGrantDcfAccess()
             {
                 Ptr<Txop> otherTxop = *j;
                 if (otherTxop->GetAccessStatus(m_linkId) == Txop::REQUESTED &&
-                    GetBackoffEndFor(otherTxop) <= now)
+                    GetBackoffEndFor(otherTxop, accessGrantStart) <= now)
                 {
                     NS_LOG_DEBUG(
                         "dcf " << k << " needs access. backoff expired. internal collision. slots="
@@ -442,6 +449,7 @@ ChannelAccessManager::DoGrantDcfAccess()
                 // but did not transmit anything
                 i--;
                 k = std::distance(m_txops.begin(), i);
+                accessGrantStart = GetAccessGrantStart();
             }
         }
         i++;
@@ -503,22 +511,22 @@ ChannelAccessManager::GetAccessGrantStart(bool ignoreNav) const
 }
 
 Time
-ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop)
+ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop, const Time& accessGrantStart)
 {
-    NS_LOG_FUNCTION(this << txop);
-    Time mostRecentEvent =
-        std::max({txop->GetBackoffStart(m_linkId),
-                  GetAccessGrantStart() + (txop->GetAifsn(m_linkId) * GetSlot())});
+    NS_LOG_FUNCTION(this << txop << accessGrantStart);
+    Time mostRecentEvent = std::max(txop->GetBackoffStart(m_linkId),
+                                    accessGrantStart + (txop->GetAifsn(m_linkId) * GetSlot()));
     NS_LOG_DEBUG("Backoff start: " << mostRecentEvent.As(Time::US));
 
     return mostRecentEvent;
 }
 
 Time
-ChannelAccessManager::GetBackoffEndFor(Ptr<Txop> txop)
+ChannelAccessManager::GetBackoffEndFor(Ptr<Txop> txop, const Time& accessGrantStart)
 {
-    NS_LOG_FUNCTION(this << txop);
-    Time backoffEnd = GetBackoffStartFor(txop) + (txop->GetBackoffSlots(m_linkId) * GetSlot());
+    NS_LOG_FUNCTION(this << txop << accessGrantStart);
+    Time backoffEnd = GetBackoffStartFor(txop, accessGrantStart) +
+                      (txop->GetBackoffSlots(m_linkId) * GetSlot());
     NS_LOG_DEBUG("Backoff end: " << backoffEnd.As(Time::US));
 
     return backoffEnd;
@@ -528,13 +536,23 @@ void
 ChannelAccessManager::UpdateBackoff()
 {
     NS_LOG_FUNCTION(this);
+    const Time now = Simulator::Now();
+    const Time accessGrantStart = GetAccessGrantStart();
+    if (accessGrantStart > now)
+    {
+        // the backoff of every Txop starts at least an AIFS after the access grant
+        // start, hence no backoff slot has elapsed. This is the common case of the
+        // notifications received while the medium is busy
+        return;
+    }
+    const Time slot = GetSlot();
     uint32_t k = 0;
-    for (auto txop : m_txops)
+    for (const auto& txop : m_txops)
     {
-        Time backoffStart = GetBackoffStartFor(txop);
-        if (backoffStart <= Simulator::Now())
+        Time backoffStart = GetBackoffStartFor(txop, accessGrantStart);
+        if (backoffStart <= now)
         {
-            uint32_t nIntSlots = ((Simulator::Now() - backoffStart) / GetSlot()).GetHigh();
+            uint32_t nIntSlots = ((now - backoffStart) / slot).GetHigh();
             /*
              * EDCA behaves slightly different to DCA. For EDCA we
              * decrement once at the slot boundary at the end of AIFS as
@@ -552,7 +570,7 @@ ChannelAccessManager::UpdateBackoff()
             }
             uint32_t n = std::min(nIntSlots, txop->GetBackoffSlots(m_linkId));
             NS_LOG_DEBUG("dcf " << k << " dec backoff slots=" << n);
-            Time backoffUpdateBound = backoffStart + (n * GetSlot());
+            Time backoffUpdateBound = backoffStart + (n * slot);
             txop->UpdateBackoffSlotsNow(n, backoffUpdateBound, m_linkId);
         }
         ++k;
@@ -568,13 +586,15 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
      * if there is one, how many slots for AIFS+backoff does it require ?
      */
     bool accessTimeoutNeeded = false;
+    const Time now = Simulator::Now();
+    const Time accessGrantStart = GetAccessGrantStart();
     Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime();
-    for (auto txop : m_txops)
+    for (const auto& txop : m_txops)
     {
         if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED)
         {
-            Time tmp = GetBackoffEndFor(txop);
-            if (tmp > Simulator::Now())
+            Time tmp = GetBackoffEndFor(txop, accessGrantStart);
+            if (tmp > now)
             {
                 accessTimeoutNeeded = true;
                 expectedBackoffEnd = std::min(expectedBackoffEnd, tmp);
@@ -585,7 +605,7 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
     if (accessTimeoutNeeded)
     {
         NS_LOG_DEBUG("expected backoff end=" << expectedBackoffEnd);
-        Time expectedBackoffDelay = expectedBackoffEnd - Simulator::Now();
+        Time expectedBackoffDelay = expectedBackoffEnd - now;
         if (m_accessTimeout.IsRunning() &&
             Simulator::GetDelayLeft(m_accessTimeout) > expectedBackoffDelay)
         {
@@ -279,19 +279,23 @@ class ChannelAccessManager : public Object
      * started for the given Txop.
      *
      * \param txop the Txop
+     * \param accessGrantStart the value returned by GetAccessGrantStart(), which callers
+     *                         computing the backoff start of several Txops in a row
+     *                         only need to compute once
      *
      * \return the time when the backoff procedure started
      */
-    Time GetBackoffStartFor(Ptr<Txop> txop);
+    Time GetBackoffStartFor(Ptr<Txop> txop, const Time& accessGrantStart);
     /**
      * Return the time when the backoff procedure
      * ended (or will ended) for the given Txop.
      *
      * \param txop the Txop
+     * \param accessGrantStart the value returned by GetAccessGrantStart()
      *
      * \return the time when the backoff procedure ended (or will ended)
      */
-    Time GetBackoffEndFor(Ptr<Txop> txop);
+    Time GetBackoffEndFor(Ptr<Txop> txop, const Time& accessGrantStart);
     /**
      * This method determines whether the medium has been idle during a period (of
      * non-null duration) immediately preceding the time this method is called. If
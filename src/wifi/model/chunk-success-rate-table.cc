@@ -0,0 +1,124 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "chunk-success-rate-table.h"
+
+#include "wifi-utils.h"
+
+#include "ns3/log.h"
+
+#include <cmath>
+#include <map>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ChunkSuccessRateTable");
+
+/**
+ * The tables are interpolated where the success rate of a bit is above 0.9, i.e.,
+ * ln(-ln(1 - p)) is below this value. At lower SNRs, ln(-ln(1 - p)) is too steep
+ * to be interpolated accurately, notably because the models cap p at 1.
+ */
+static const double MAX_INTERPOLATED_VALUE = std::log(-std::log(0.9));
+
+/**
+ * At lower SNRs, a success rate below this value is returned without
+ * interpolation since it is an upper bound of the actual success rate.
+ */
+static const double NEGLIGIBLE_SUCCESS_RATE = 1e-6;
+
+/**
+ * \return the tables built so far, indexed by their key
+ */
+static std::map<ChunkSuccessRateTable::Key, Ptr<const ChunkSuccessRateTable>>&
+GetTables()
+{
+    static std::map<ChunkSuccessRateTable::Key, Ptr<const ChunkSuccessRateTable>> tables;
+    return tables;
+}
+
+ChunkSuccessRateTable::ChunkSuccessRateTable(const SuccessRateFunction& successRate)
+{
+    NS_LOG_FUNCTION(this);
+    auto size = static_cast<std::size_t>(std::lround((MAX_SNR_DB - MIN_SNR_DB) / SNR_STEP_DB)) + 1;
+    m_values.reserve(size);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        double snrDb = MIN_SNR_DB + i * SNR_STEP_DB;
+        // -inf if no bit is in error, +inf if no bit is received
+        m_values.push_back(std::log(-std::log(successRate(DbToRatio(snrDb)))));
+    }
+}
+
+std::optional<double>
+ChunkSuccessRateTable::GetChunkSuccessRate(double snr, uint64_t nbits) const
+{
+    NS_LOG_FUNCTION(this << snr << nbits);
+    if (nbits == 0)
+    {
+        return 1.0;
+    }
+    double x = (RatioToDb(snr) - MIN_SNR_DB) / SNR_STEP_DB;
+    if (!(x >= 0) || x >= m_values.size() - 1)
+    {
+        return std::nullopt;
+    }
+    auto i = static_cast<std::size_t>(x);
+    double z0 = m_values[i];
+    double z1 = m_values[i + 1];
+    if (z0 > MAX_INTERPOLATED_VALUE)
+    {
+        // the success rate of a bit is at most the one at the end of the interval
+        double maxSuccessRate = std::exp(-static_cast<double>(nbits) * std::exp(z1));
+        if (maxSuccessRate < NEGLIGIBLE_SUCCESS_RATE)
+        {
+            return maxSuccessRate;
+        }
+        return std::nullopt;
+    }
+    if (std::isfinite(z0) && std::isfinite(z1))
+    {
+        return std::exp(-static_cast<double>(nbits) * std::exp(z0 + (x - i) * (z1 - z0)));
+    }
+    if (z0 == z1)
+    {
+        // ln(-ln(1 - p)) is -inf: no bit is in error over the whole interval
+        return 1.0;
+    }
+    // the analytic model is needed to know where the success rate of a bit reaches 1
+    return std::nullopt;
+}
+
+Ptr<const ChunkSuccessRateTable>
+ChunkSuccessRateTable::Get(const Key& key, const SuccessRateFunction& successRate)
+{
+    auto& tables = GetTables();
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Build table for key (" << key.first << ", " << key.second << ")");
+        it = tables.emplace(key, Create<ChunkSuccessRateTable>(successRate)).first;
+    }
+    return it->second;
+}
+
+std::size_t
+ChunkSuccessRateTable::GetNTables()
+{
+    return GetTables().size();
+}
+
+} // namespace ns3
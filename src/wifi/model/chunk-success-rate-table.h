@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHUNK_SUCCESS_RATE_TABLE_H
+#define CHUNK_SUCCESS_RATE_TABLE_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ *
+ * A table of the success rates of an error rate model for a given mode, which
+ * is used to interpolate the success rate of a chunk instead of computing it
+ * analytically.
+ *
+ * The error rate models compute the success rate of a chunk of n bits as
+ * (1 - p)^n, where p is the error probability of a bit at the given SNR. The
+ * table stores ln(-ln(1 - p)) on a uniform grid of SNR values in dB, where
+ * this function is smooth enough to be linearly interpolated, and the size of
+ * the chunk is applied to the interpolated value. Hence, the absolute error on
+ * the success rate of a chunk is bounded by the relative error on p divided by
+ * e, whatever the size of the chunk. Outside of the tables, and where the
+ * success rate of a bit is too low to be interpolated accurately, the success
+ * rate must be computed analytically.
+ *
+ * The tables are built at first use and shared by all the error rate models in
+ * the process.
+ */
+class ChunkSuccessRateTable : public SimpleRefCount<ChunkSuccessRateTable>
+{
+  public:
+    /// The key of a table: the UIDs of the TypeId of the error rate model and of the mode
+    using Key = std::pair<uint16_t, uint32_t>;
+
+    /// Function returning the success rate of a single bit at the given SNR (linear scale)
+    using SuccessRateFunction = std::function<double(double)>;
+
+    static constexpr double MIN_SNR_DB = -20;   //!< the lowest SNR of the tables (dB)
+    static constexpr double MAX_SNR_DB = 70;    //!< the highest SNR of the tables (dB)
+    static constexpr double SNR_STEP_DB = 0.02; //!< the SNR step of the tables (dB)
+
+    /**
+     * Build a table by sampling the given function.
+     *
+     * \param successRate the success rate of a single bit as a function of the SNR
+     */
+    ChunkSuccessRateTable(const SuccessRateFunction& successRate);
+
+    /**
+     * \param snr the SNR of the chunk (linear scale)
+     * \param nbits the number of bits in the chunk
+     * \return the success rate of the chunk, or std::nullopt if it cannot be
+     *         interpolated from the table at this SNR
+     */
+    std::optional<double> GetChunkSuccessRate(double snr, uint64_t nbits) const;
+
+    /**
+     * Get the table with the given key, which is built by sampling the given
+     * function if it does not exist yet.
+     *
+     * \param key the key of the table
+     * \param successRate the success rate of a single bit as a function of the SNR
+     * \return the table
+     */
+    static Ptr<const ChunkSuccessRateTable> Get(const Key& key,
+                                                const SuccessRateFunction& successRate);
+
+    /**
+     * \return the number of tables built so far
+     */
+    static std::size_t GetNTables();
+
+  private:
+    std::vector<double> m_values; //!< ln(-ln(1 - p)) for every SNR of the grid
+};
+
+} // namespace ns3
+
+#endif /* CHUNK_SUCCESS_RATE_TABLE_H */
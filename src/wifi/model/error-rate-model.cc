@@ -19,8 +19,10 @@
 
 #include "error-rate-model.h"
 
+#include "chunk-success-rate-table.h"
 #include "wifi-tx-vector.h"
 
+#include "ns3/boolean.h"
 #include "ns3/dsss-error-rate-model.h"
 
 namespace ns3
@@ -31,10 +33,57 @@ NS_OBJECT_ENSURE_REGISTERED(ErrorRateModel);
 TypeId
 ErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::ErrorRateModel").SetParent<Object>().SetGroupName("Wifi");
+    static TypeId tid =
+        TypeId("ns3::ErrorRateModel")
+            .SetParent<Object>()
+            .SetGroupName("Wifi")
+            .AddAttribute("UseLookupTables",
+                          "If true, the success rates are interpolated from tables built at "
+                          "first use and shared by all the error rate models, instead of being "
+                          "computed analytically. This is supported by the DSSS modes and by "
+                          "the NIST and YANS error rate models.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ErrorRateModel::m_useLookupTables),
+                          MakeBooleanChecker());
     return tid;
 }
 
+ErrorRateModel::ErrorRateModel()
+    : m_useLookupTables(false)
+{
+}
+
+bool
+ErrorRateModel::UseLookupTables() const
+{
+    return m_useLookupTables;
+}
+
+/**
+ * \param mode the DSSS/HR-DSSS mode applicable to the chunk
+ * \param snr the SNR of the chunk
+ * \param nbits the number of bits in the chunk
+ * \return probability of successfully receiving the chunk
+ */
+static double
+GetDsssChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits)
+{
+    switch (mode.GetDataRate(22, 0, 1))
+    {
+    case 1000000:
+        return DsssErrorRateModel::GetDsssDbpskSuccessRate(snr, nbits);
+    case 2000000:
+        return DsssErrorRateModel::GetDsssDqpskSuccessRate(snr, nbits);
+    case 5500000:
+        return DsssErrorRateModel::GetDsssDqpskCck5_5SuccessRate(snr, nbits);
+    case 11000000:
+        return DsssErrorRateModel::GetDsssDqpskCck11SuccessRate(snr, nbits);
+    default:
+        NS_ASSERT("undefined DSSS/HR-DSSS datarate");
+    }
+    return 0;
+}
+
 double
 ErrorRateModel::CalculateSnr(const WifiTxVector& txVector, double ber) const
 {
@@ -73,25 +122,22 @@ ErrorRateModel::GetChunkSuccessRate(WifiMode mode,
     if (mode.GetModulationClass() == WIFI_MOD_CLASS_DSSS ||
         mode.GetModulationClass() == WIFI_MOD_CLASS_HR_DSSS)
     {
-        switch (mode.GetDataRate(22, 0, 1))
+        if (m_useLookupTables)
         {
-        case 1000000:
-            return DsssErrorRateModel::GetDsssDbpskSuccessRate(snr, nbits);
-        case 2000000:
-            return DsssErrorRateModel::GetDsssDqpskSuccessRate(snr, nbits);
-        case 5500000:
-            return DsssErrorRateModel::GetDsssDqpskCck5_5SuccessRate(snr, nbits);
-        case 11000000:
-            return DsssErrorRateModel::GetDsssDqpskCck11SuccessRate(snr, nbits);
-        default:
-            NS_ASSERT("undefined DSSS/HR-DSSS datarate");
+            auto table = ChunkSuccessRateTable::Get(
+                {ErrorRateModel::GetTypeId().GetUid(), mode.GetUid()},
+                [mode](double sample) { return GetDsssChunkSuccessRate(mode, sample, 1); });
+            if (auto csr = table->GetChunkSuccessRate(snr, nbits))
+            {
+                return *csr;
+            }
         }
+        return GetDsssChunkSuccessRate(mode, snr, nbits);
     }
     else
     {
         return DoGetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
     }
-    return 0;
 }
 
 bool
@@ -41,6 +41,8 @@ class ErrorRateModel : public Object
      */
     static TypeId GetTypeId();
 
+    ErrorRateModel();
+
     /**
      * \param txVector a specific transmission vector including WifiMode
      * \param ber a target BER
@@ -102,6 +104,13 @@ class ErrorRateModel : public Object
      */
     virtual int64_t AssignStreams(int64_t stream);
 
+  protected:
+    /**
+     * \return whether the success rates are interpolated from a ChunkSuccessRateTable
+     *         rather than computed analytically, where the model supports it
+     */
+    bool UseLookupTables() const;
+
   private:
     /**
      * A pure virtual method that must be implemented in the subclass.
@@ -123,6 +132,8 @@ class ErrorRateModel : public Object
                                          uint8_t numRxAntennas,
                                          WifiPpduField field,
                                          uint16_t staId) const = 0;
+
+    bool m_useLookupTables; //!< whether to interpolate the success rates from tables
 };
 
 } // namespace ns3
@@ -24,6 +24,8 @@
 #include "ns3/enum.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -143,46 +145,49 @@ void
 FcfsWifiQueueScheduler::DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus)
 {
     NS_LOG_FUNCTION(this << +ac << mpdus.size());
-
-    std::set<WifiContainerQueueId> queueIds;
-
-    for (const auto& mpdu : mpdus)
-    {
-        queueIds.insert(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
-
-    for (const auto& queueId : queueIds)
-    {
-        if (auto item = GetWifiMacQueue(ac)->PeekByQueueId(queueId))
-        {
-            SetPriority(ac,
-                        queueId,
-                        {item->GetTimestamp(), std::get<WifiContainerQueueType>(queueId)});
-        }
-    }
+    UpdatePriorities(ac, mpdus);
 }
 
 void
 FcfsWifiQueueScheduler::DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus)
 {
     NS_LOG_FUNCTION(this << +ac << mpdus.size());
+    UpdatePriorities(ac, mpdus);
+}
 
-    std::set<WifiContainerQueueId> queueIds;
+void
+FcfsWifiQueueScheduler::UpdatePriorities(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus)
+{
+    NS_LOG_FUNCTION(this << +ac << mpdus.size());
+
+    // take the storage of m_queueIds, because peeking a queue may remove MPDUs with
+    // expired lifetime and hence call this function again
+    auto queueIds = std::move(m_queueIds);
+    queueIds.clear();
 
+    // the queues are visited in increasing order of their IDs, once each
     for (const auto& mpdu : mpdus)
     {
-        queueIds.insert(WifiMacQueueContainer::GetQueueId(mpdu));
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        if (queueIds.empty() || queueIds.back() != queueId)
+        {
+            queueIds.push_back(queueId);
+        }
     }
+    std::sort(queueIds.begin(), queueIds.end());
+    queueIds.erase(std::unique(queueIds.begin(), queueIds.end()), queueIds.end());
 
+    auto queue = GetWifiMacQueue(ac);
     for (const auto& queueId : queueIds)
     {
-        if (auto item = GetWifiMacQueue(ac)->PeekByQueueId(queueId))
+        if (auto item = queue->PeekByQueueId(queueId))
         {
             SetPriority(ac,
                         queueId,
                         {item->GetTimestamp(), std::get<WifiContainerQueueType>(queueId)});
         }
     }
+    m_queueIds = std::move(queueIds);
 }
 
 } // namespace ns3
@@ -24,6 +24,8 @@
 
 #include "ns3/nstime.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -85,7 +87,17 @@ class FcfsWifiQueueScheduler : public WifiMacQueueSchedulerImpl<FcfsPrio>
     void DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) override;
     void DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) override;
 
+    /**
+     * Update the priority of the container queues that held the given MPDUs, which
+     * have been dequeued or removed, according to the MPDUs now at their head.
+     *
+     * \param ac the Access Category of the dequeued or removed MPDUs
+     * \param mpdus the list of dequeued or removed MPDUs
+     */
+    void UpdatePriorities(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus);
+
     DropPolicy m_dropPolicy; //!< Drop behavior of queue
+    std::vector<WifiContainerQueueId> m_queueIds; //!< storage reused by UpdatePriorities
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
 
@@ -753,6 +753,24 @@ HePhy::ProcessSigB(Ptr<Event> event, PhyFieldRxStatus status)
     return status;
 }
 
+bool
+HePhy::IsReceptionAbstractable(Ptr<const WifiPpdu> ppdu) const
+{
+    // the processing of SIG-A depends on the time it is received when the PPDU is
+    // possibly filtered based on the BSS color or on the TRIGVECTOR, or when an
+    // OBSS PD algorithm is notified of its reception
+    uint8_t myBssColor = GetBssColor();
+    uint8_t rxBssColor = ppdu->GetTxVector().GetBssColor();
+    if ((myBssColor != 0 && rxBssColor != 0 && myBssColor != rxBssColor) ||
+        (m_trigVectorExpirationTime.has_value() &&
+         m_trigVectorExpirationTime.value() >= Simulator::Now()) ||
+        !m_endOfHeSigACallback.IsNull())
+    {
+        return false;
+    }
+    return VhtPhy::IsReceptionAbstractable(ppdu);
+}
+
 bool
 HePhy::IsConfigSupported(Ptr<const WifiPpdu> ppdu) const
 {
@@ -456,6 +456,16 @@ HtPhy::IsConfigSupported(Ptr<const WifiPpdu> ppdu) const
     return true;
 }
 
+WifiPhyRxfailureReason
+HtPhy::GetFailureReason(WifiPpduField field) const
+{
+    if (field == WIFI_PPDU_FIELD_HT_SIG)
+    {
+        return HT_SIG_FAILURE;
+    }
+    return OfdmPhy::GetFailureReason(field);
+}
+
 Ptr<SpectrumValue>
 HtPhy::GetTxPowerSpectralDensity(double txPowerW, Ptr<const WifiPpdu> ppdu) const
 {
@@ -182,9 +182,9 @@ InterferenceHelper::NiChange::GetEvent() const
  ****************************************************************/
 
 InterferenceHelper::InterferenceHelper()
-    : m_errorRateModel(nullptr),
-      m_numRxAntennas(1),
-      m_rxing(false)
+    : m_rxing(false),
+      m_errorRateModel(nullptr),
+      m_numRxAntennas(1)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -149,14 +149,14 @@ class InterferenceHelper : public Object
      *
      * \param band the band to be added
      */
-    void AddBand(const WifiSpectrumBandInfo& band);
+    virtual void AddBand(const WifiSpectrumBandInfo& band);
 
     /**
      * Check whether bands are already tracked by this interference helper.
      *
      * \return true if bands are tracked by this interference helper, false otherwise
      */
-    bool HasBands() const;
+    virtual bool HasBands() const;
 
     /**
      * Update the frequency bands that belongs to a given frequency range when the spectrum model is
@@ -165,8 +165,8 @@ class InterferenceHelper : public Object
      * \param bands the bands to be added in the new spectrum model
      * \param freqRange the frequency range the bands belong to
      */
-    void UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
-                     const FrequencyRange& freqRange);
+    virtual void UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
+                             const FrequencyRange& freqRange);
 
     /**
      * Set the noise figure.
@@ -203,7 +203,7 @@ class InterferenceHelper : public Object
      *          energy on the medium for a given band will
      *          be higher than the requested threshold.
      */
-    Time GetEnergyDuration(double energyW, const WifiSpectrumBandInfo& band);
+    virtual Time GetEnergyDuration(double energyW, const WifiSpectrumBandInfo& band);
 
     /**
      * Add the PPDU-related signal to interference helper.
@@ -291,7 +291,7 @@ class InterferenceHelper : public Object
      * \param endTime the end time of the signal
      * \param freqRange the frequency range in which the received signal event had been detected
      */
-    void NotifyRxEnd(Time endTime, const FrequencyRange& freqRange);
+    virtual void NotifyRxEnd(Time endTime, const FrequencyRange& freqRange);
 
     /**
      * Update event to scale its received power (W) per band.
@@ -299,7 +299,7 @@ class InterferenceHelper : public Object
      * \param event the event to be updated
      * \param rxPower the received power (W) per band to be added to the current event
      */
-    void UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBand& rxPower);
+    virtual void UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBand& rxPower);
 
   protected:
     void DoDispose() override;
@@ -352,7 +352,6 @@ class InterferenceHelper : public Object
                                             const WifiTxVector& txVector,
                                             uint16_t staId = SU_STA_ID) const;
 
-  private:
     /**
      * Noise and Interference (thus Ni) event.
      */
@@ -406,14 +405,6 @@ class InterferenceHelper : public Object
      */
     using FirstPowerPerBand = std::map<WifiSpectrumBandInfo, double>;
 
-    /**
-     * Check whether a given band is tracked by this interference helper.
-     *
-     * \param band the band to be checked
-     * \return true if the band is already tracked by this interference helper, false otherwise
-     */
-    bool HasBand(const WifiSpectrumBandInfo& band) const;
-
     /**
      * Check whether a given band belongs to a given frequency range.
      *
@@ -431,7 +422,7 @@ class InterferenceHelper : public Object
      * \param isStartOfdmaRxing flag whether event corresponds to the start of the OFDMA payload
      * reception (only used for UL-OFDMA)
      */
-    void AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing);
+    virtual void AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing);
 
     /**
      * Calculate noise and interference power in W.
@@ -442,9 +433,21 @@ class InterferenceHelper : public Object
      *
      * \return noise and interference power
      */
-    double CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand* nis,
-                                       const WifiSpectrumBandInfo& band) const;
+    virtual double CalculateNoiseInterferenceW(Ptr<Event> event,
+                                               NiChangesPerBand* nis,
+                                               const WifiSpectrumBandInfo& band) const;
+
+    FirstPowerPerBand m_firstPowers; //!< first power of each band in watts
+    bool m_rxing;                    //!< flag whether it is in receiving state
+
+  private:
+    /**
+     * Check whether a given band is tracked by this interference helper.
+     *
+     * \param band the band to be checked
+     * \return true if the band is already tracked by this interference helper, false otherwise
+     */
+    bool HasBand(const WifiSpectrumBandInfo& band) const;
     /**
      * Calculate the error rate of the given PHY payload only in the provided time
      * window (thus enabling per MPDU PER information). The PHY payload can be divided into
@@ -501,10 +504,8 @@ class InterferenceHelper : public Object
 
     double m_noiseFigure;                 //!< noise figure (linear)
     Ptr<ErrorRateModel> m_errorRateModel; //!< error rate model
-    uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
-    NiChangesPerBand m_niChanges;    //!< NI Changes for each band
-    FirstPowerPerBand m_firstPowers; //!< first power of each band in watts
-    bool m_rxing;                    //!< flag whether it is in receiving state
+    uint8_t m_numRxAntennas;      //!< the number of RX antennas in the corresponding receiver
+    NiChangesPerBand m_niChanges; //!< NI Changes for each band
 
     /**
      * Returns an iterator to the first NiChange that is later than moment
@@ -20,6 +20,7 @@
 
 #include "nist-error-rate-model.h"
 
+#include "chunk-success-rate-table.h"
 #include "wifi-tx-vector.h"
 
 #include "ns3/log.h"
@@ -213,23 +214,38 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
-        if (mode.GetConstellationSize() == 2)
+        if (UseLookupTables())
         {
-            return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
-        }
-        else if (mode.GetConstellationSize() == 4)
-        {
-            return GetFecQpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
-        }
-        else
-        {
-            return GetFecQamBer(mode.GetConstellationSize(),
-                                snr,
-                                nbits,
-                                GetBValue(mode.GetCodeRate()));
+            auto table = ChunkSuccessRateTable::Get(
+                {NistErrorRateModel::GetTypeId().GetUid(), mode.GetUid()},
+                [this, mode](double sample) {
+                    return CalculateChunkSuccessRate(mode, sample, 1);
+                });
+            if (auto csr = table->GetChunkSuccessRate(snr, nbits))
+            {
+                return *csr;
+            }
         }
+        return CalculateChunkSuccessRate(mode, snr, nbits);
     }
     return 0;
 }
 
+double
+NistErrorRateModel::CalculateChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const
+{
+    if (mode.GetConstellationSize() == 2)
+    {
+        return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
+    }
+    else if (mode.GetConstellationSize() == 4)
+    {
+        return GetFecQpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
+    }
+    else
+    {
+        return GetFecQamBer(mode.GetConstellationSize(), snr, nbits, GetBValue(mode.GetCodeRate()));
+    }
+}
+
 } // namespace ns3
@@ -53,6 +53,17 @@ class NistErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    /**
+     * Compute the probability of successfully receiving a chunk of an
+     * ERP-OFDM, OFDM, HT, VHT, HE or EHT mode.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunk
+     * \param snr the SNR of the chunk (linear scale)
+     * \param nbits the number of bits in the chunk
+     *
+     * \return probability of successfully receiving the chunk
+     */
+    double CalculateChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const;
     /**
      * Return the bValue such that coding rate = bValue / (bValue + 1).
      *
@@ -351,6 +351,12 @@ OfdmPhy::IsChannelWidthSupported(Ptr<const WifiPpdu> ppdu) const
     return true;
 }
 
+bool
+OfdmPhy::IsReceptionAbstractable(Ptr<const WifiPpdu> ppdu) const
+{
+    return IsChannelWidthSupported(ppdu) && PhyEntity::IsReceptionAbstractable(ppdu);
+}
+
 bool
 OfdmPhy::IsAllConfigSupported(WifiPpduField /* field */, Ptr<const WifiPpdu> ppdu) const
 {
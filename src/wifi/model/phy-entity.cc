@@ -598,15 +598,14 @@ PhyEntity::DoStartReceivePayload(Ptr<Event> event)
     return payloadDuration;
 }
 
-void
-PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
+std::vector<std::pair<Time, Time>>
+PhyEntity::GetMpduWindows(Ptr<Event> event) const
 {
     NS_LOG_FUNCTION(this << *event);
     Ptr<const WifiPpdu> ppdu = event->GetPpdu();
     Ptr<const WifiPsdu> psdu = GetAddressedPsduInPpdu(ppdu);
     const WifiTxVector& txVector = event->GetTxVector();
     uint16_t staId = GetStaId(ppdu);
-    Time endOfMpduDuration = NanoSeconds(0);
     Time relativeStart = NanoSeconds(0);
     Time psduDuration = ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
     Time remainingAmpduDuration = psduDuration;
@@ -615,8 +614,9 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
         (nMpdus > 1) ? FIRST_MPDU_IN_AGGREGATE : (psdu->IsSingle() ? SINGLE_MPDU : NORMAL_MPDU);
     uint32_t totalAmpduSize = 0;
     double totalAmpduNumSymbols = 0.0;
-    auto mpdu = psdu->begin();
-    for (size_t i = 0; i < nMpdus && mpdu != psdu->end(); ++mpdu)
+    std::vector<std::pair<Time, Time>> windows;
+    windows.reserve(nMpdus);
+    for (size_t i = 0; i < nMpdus; ++i)
     {
         uint32_t size = (mpduType == NORMAL_MPDU) ? psdu->GetSize() : psdu->GetAmpduSubframeSize(i);
         Time mpduDuration = m_wifiPhy->GetPayloadDuration(size,
@@ -639,11 +639,30 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
             }
         }
 
-        endOfMpduDuration += mpduDuration;
-        NS_LOG_INFO("Schedule end of MPDU #"
-                    << i << " in " << endOfMpduDuration.As(Time::NS) << " (relativeStart="
-                    << relativeStart.As(Time::NS) << ", mpduDuration=" << mpduDuration.As(Time::NS)
-                    << ", remainingAmdpuDuration=" << remainingAmpduDuration.As(Time::NS) << ")");
+        NS_LOG_INFO("MPDU #" << i << ": relativeStart=" << relativeStart.As(Time::NS)
+                             << ", mpduDuration=" << mpduDuration.As(Time::NS)
+                             << ", remainingAmdpuDuration=" << remainingAmpduDuration.As(Time::NS));
+        windows.emplace_back(relativeStart, mpduDuration);
+
+        // Prepare next iteration
+        relativeStart += mpduDuration;
+        mpduType = (i + 1 == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
+    }
+    return windows;
+}
+
+void
+PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
+{
+    NS_LOG_FUNCTION(this << *event);
+    Ptr<const WifiPsdu> psdu = GetAddressedPsduInPpdu(event->GetPpdu());
+    auto mpdu = psdu->begin();
+    size_t i = 0;
+    for (const auto& [relativeStart, mpduDuration] : GetMpduWindows(event))
+    {
+        NS_ASSERT(mpdu != psdu->end());
+        Time endOfMpduDuration = relativeStart + mpduDuration;
+        NS_LOG_INFO("Schedule end of MPDU #" << i << " in " << endOfMpduDuration.As(Time::NS));
         m_endOfMpduEvents.push_back(Simulator::Schedule(endOfMpduDuration,
                                                         &PhyEntity::EndOfMpdu,
                                                         this,
@@ -652,11 +671,8 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
                                                         i,
                                                         relativeStart,
                                                         mpduDuration));
-
-        // Prepare next iteration
+        ++mpdu;
         ++i;
-        relativeStart += mpduDuration;
-        mpduType = (i == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
     }
 }
 
@@ -1047,6 +1063,13 @@ PhyEntity::EndPreambleDetectionPeriod(Ptr<Event> event)
                                  m_wifiPhy->m_currentEvent->GetRxPowerWPerBand());
         m_wifiPhy->m_timeLastPreambleDetected = Simulator::Now();
 
+        if (m_wifiPhy->m_abstractReception && !m_wifiPhy->m_frameCaptureModel &&
+            IsReceptionAbstractable(event->GetPpdu()))
+        {
+            StartAbstractedReception(event);
+            return;
+        }
+
         // Continue receiving preamble
         Time durationTillEnd = GetDuration(WIFI_PPDU_FIELD_PREAMBLE, event->GetTxVector()) -
                                m_wifiPhy->GetPreambleDetectionDuration();
@@ -1078,6 +1101,74 @@ PhyEntity::EndPreambleDetectionPeriod(Ptr<Event> event)
     }
 }
 
+bool
+PhyEntity::IsReceptionAbstractable(Ptr<const WifiPpdu> ppdu) const
+{
+    return ppdu->GetType() == WIFI_PPDU_TYPE_SU && IsConfigSupported(ppdu);
+}
+
+void
+PhyEntity::StartAbstractedReception(Ptr<Event> event)
+{
+    NS_LOG_FUNCTION(this << *event);
+    Ptr<const WifiPpdu> ppdu = event->GetPpdu();
+    uint16_t staId = GetStaId(ppdu);
+    m_signalNoiseMap.insert({std::make_pair(ppdu->GetUid(), staId), SignalNoiseDbm()});
+    m_statusPerMpduMap.insert({std::make_pair(ppdu->GetUid(), staId), std::vector<bool>()});
+    Time durationTillEnd = event->GetEndTime() - Simulator::Now();
+    // PHY-RXSTART is indicated at the end of the preamble detection period, hence
+    // with the remaining duration of the PPDU rather than the payload duration
+    NotifyPayloadBegin(event->GetTxVector(), durationTillEnd);
+    m_endRxPayloadEvents.push_back(
+        Simulator::Schedule(durationTillEnd, &PhyEntity::EndAbstractedReception, this, event));
+    m_state->SwitchToRx(durationTillEnd);
+}
+
+void
+PhyEntity::EndAbstractedReception(Ptr<Event> event)
+{
+    NS_LOG_FUNCTION(this << *event);
+    NS_ASSERT(event->GetEndTime() == Simulator::Now());
+    Ptr<const WifiPpdu> ppdu = event->GetPpdu();
+    Ptr<const WifiPsdu> psdu = GetAddressedPsduInPpdu(ppdu);
+    WifiPreamble preamble = event->GetTxVector().GetPreambleType();
+
+    // The PHY header fields are processed in the order they are received, with the
+    // same SNR and PER as if their reception ended at the end of each field
+    for (auto field = GetNextField(WIFI_PPDU_FIELD_PREAMBLE, preamble);
+         field != WIFI_PPDU_FIELD_DATA;
+         field = GetNextField(field, preamble))
+    {
+        if (field == WIFI_PPDU_FIELD_TRAINING)
+        {
+            continue; // always consider that training has been correctly received
+        }
+        SnrPer snrPer = GetPhyHeaderSnrPer(field, event);
+        NS_LOG_DEBUG(field << ": SNR(dB)=" << RatioToDb(snrPer.snr) << ", PER=" << snrPer.per);
+        if (GetRandomValue() > snrPer.per)
+        {
+            continue;
+        }
+        NS_LOG_DEBUG("Drop packet because " << field << " reception failed");
+        m_wifiPhy->NotifyRxDrop(psdu, GetFailureReason(field));
+        // the medium has been busy until the end of the PPDU, as if CCA had been held busy
+        m_state->SwitchFromRxEndOk();
+        DoEndReceivePayload(ppdu);
+        m_wifiPhy->SwitchMaybeToCcaBusy(ppdu);
+        return;
+    }
+
+    auto mpdu = psdu->begin();
+    size_t i = 0;
+    for (const auto& [relativeStart, mpduDuration] : GetMpduWindows(event))
+    {
+        EndOfMpdu(event, Create<WifiPsdu>(*mpdu, false), i, relativeStart, mpduDuration);
+        ++mpdu;
+        ++i;
+    }
+    EndReceivePayload(event);
+}
+
 bool
 PhyEntity::IsConfigSupported(Ptr<const WifiPpdu> ppdu) const
 {
@@ -1091,6 +1182,19 @@ PhyEntity::IsConfigSupported(Ptr<const WifiPpdu> ppdu) const
     return true;
 }
 
+WifiPhyRxfailureReason
+PhyEntity::GetFailureReason(WifiPpduField field) const
+{
+    switch (field)
+    {
+    case WIFI_PPDU_FIELD_NON_HT_HEADER:
+        return L_SIG_FAILURE;
+    default:
+        NS_ASSERT_MSG(false, "Unknown PPDU field");
+        return UNKNOWN;
+    }
+}
+
 void
 PhyEntity::CancelAllEvents()
 {
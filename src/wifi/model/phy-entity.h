@@ -422,6 +422,18 @@ class PhyEntity : public SimpleRefCount<PhyEntity>
      */
     void EndReceivePayload(Ptr<Event> event);
 
+    /**
+     * The last symbol of a PPDU whose reception is abstracted has arrived.
+     *
+     * The outcome of the reception of the PHY header fields and of the MPDUs
+     * is determined in turn, as done at the end of each field and of each MPDU
+     * when the PPDU is received field by field, and the reception is then
+     * completed like in \see EndReceivePayload.
+     *
+     * \param event the event holding incoming PPDU's information
+     */
+    void EndAbstractedReception(Ptr<Event> event);
+
     /**
      * Reset PHY at the end of the PPDU under reception after it has failed the PHY header.
      *
@@ -636,6 +648,25 @@ class PhyEntity : public SimpleRefCount<PhyEntity>
      */
     void EndPreambleDetectionPeriod(Ptr<Event> event);
 
+    /**
+     * Check whether the reception of the given PPDU can be abstracted, i.e.
+     * whether its outcome can be determined at the end of the PPDU without
+     * processing the PHY header fields upon their reception.
+     *
+     * \param ppdu the received PPDU
+     * \return \c true if the reception of the PPDU can be abstracted, \c false otherwise
+     */
+    virtual bool IsReceptionAbstractable(Ptr<const WifiPpdu> ppdu) const;
+
+    /**
+     * Start the abstracted reception of the PPDU once its preamble has been detected:
+     * the PHY switches to RX state until the end of the PPDU, at which the outcome of
+     * the reception is determined (\see EndAbstractedReception).
+     *
+     * \param event the event holding incoming PPDU's information
+     */
+    void StartAbstractedReception(Ptr<Event> event);
+
     /**
      * Start receiving the PSDU (i.e. the first symbol of the PSDU has arrived).
      *
@@ -677,6 +708,14 @@ class PhyEntity : public SimpleRefCount<PhyEntity>
      */
     virtual bool IsConfigSupported(Ptr<const WifiPpdu> ppdu) const;
 
+    /**
+     * Get the failure reason corresponding to the unsuccessful processing of a given PPDU field.
+     *
+     * \param field the PPDU field
+     * \return the failure reason corresponding to the unsuccessful processing of the PPDU field
+     */
+    virtual WifiPhyRxfailureReason GetFailureReason(WifiPpduField field) const;
+
     /**
      * Drop the PPDU and the corresponding preamble detection event, but keep CCA busy
      * state after the completion of the currently processed event.
@@ -728,6 +767,15 @@ class PhyEntity : public SimpleRefCount<PhyEntity>
                    Time relativeStart,
                    Time mpduDuration);
 
+    /**
+     * Get the start time, relatively to the start of the payload, and the duration of
+     * each MPDU in the PSDU addressed to this PHY.
+     *
+     * \param event the event holding incoming PPDU's information
+     * \return the relative start time and the duration of each MPDU
+     */
+    std::vector<std::pair<Time, Time>> GetMpduWindows(Ptr<Event> event) const;
+
     /**
      * Schedule end of MPDUs events.
      *
@@ -0,0 +1,308 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ring-buffer-interference-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RingBufferInterferenceHelper");
+
+NS_OBJECT_ENSURE_REGISTERED(RingBufferInterferenceHelper);
+
+RingBufferInterferenceHelper::RingBufferInterferenceHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RingBufferInterferenceHelper::~RingBufferInterferenceHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+RingBufferInterferenceHelper::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::RingBufferInterferenceHelper")
+                            .SetParent<InterferenceHelper>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<RingBufferInterferenceHelper>();
+    return tid;
+}
+
+void
+RingBufferInterferenceHelper::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_bands.clear();
+    InterferenceHelper::DoDispose();
+}
+
+std::size_t
+RingBufferInterferenceHelper::GetNextPosition(const Changes& changes, Time moment)
+{
+    auto it = std::upper_bound(changes.entries.cbegin() + changes.head,
+                               changes.entries.cend(),
+                               moment,
+                               [](Time t, const Change& change) { return t < change.time; });
+    return it - changes.entries.cbegin();
+}
+
+std::size_t
+RingBufferInterferenceHelper::GetPreviousPosition(const Changes& changes, Time moment)
+{
+    // This is safe since there is always a change at time 0, before moment.
+    return GetNextPosition(changes, moment) - 1;
+}
+
+std::size_t
+RingBufferInterferenceHelper::Insert(Changes& changes, Change&& change)
+{
+    // Most changes are at the current time or later, hence close to the end
+    auto pos = changes.entries.size();
+    while (pos > changes.head + 1 && changes.entries[pos - 1].time > change.time)
+    {
+        --pos;
+    }
+    changes.entries.insert(changes.entries.begin() + pos, std::move(change));
+    return pos;
+}
+
+void
+RingBufferInterferenceHelper::Prune(Changes& changes, std::size_t pos)
+{
+    if (pos == changes.head)
+    {
+        return;
+    }
+    // The first change (at time 0) replaces the last removed one
+    for (auto i = changes.head + 1; i < pos; ++i)
+    {
+        changes.entries[i].event = nullptr;
+    }
+    changes.entries[pos] = std::move(changes.entries[changes.head]);
+    changes.head = pos;
+    if (changes.head > changes.entries.size() / 2)
+    {
+        changes.entries.erase(changes.entries.begin(), changes.entries.begin() + changes.head);
+        changes.head = 0;
+    }
+}
+
+void
+RingBufferInterferenceHelper::AddBand(const WifiSpectrumBandInfo& band)
+{
+    NS_LOG_FUNCTION(this << band);
+    NS_ASSERT(m_bands.count(band) == 0);
+    NS_ASSERT(m_firstPowers.count(band) == 0);
+    auto result = m_bands.insert({band, Changes{}});
+    NS_ASSERT(result.second);
+    // Always have a zero power noise event in the list
+    result.first->second.entries.push_back({Time(0), 0.0, nullptr});
+    result.first->second.head = 0;
+    m_firstPowers.insert({band, 0.0});
+}
+
+bool
+RingBufferInterferenceHelper::HasBands() const
+{
+    return !m_bands.empty();
+}
+
+void
+RingBufferInterferenceHelper::UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
+                                          const FrequencyRange& freqRange)
+{
+    NS_LOG_FUNCTION(this << freqRange);
+    for (auto it = m_bands.begin(); it != m_bands.end();)
+    {
+        const auto frequencies = it->first.frequencies;
+        if (IsBandInFrequencyRange(it->first, freqRange) &&
+            std::none_of(bands.cbegin(), bands.cend(), [frequencies](const auto& item) {
+                return frequencies == item.frequencies;
+            }))
+        {
+            // band does not belong to the new bands, erase it
+            m_firstPowers.erase(it->first);
+            it = m_bands.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    for (const auto& band : bands)
+    {
+        if (m_bands.count(band) == 0)
+        {
+            // this is a new band, add it
+            AddBand(band);
+        }
+    }
+}
+
+std::size_t
+RingBufferInterferenceHelper::GetCapacity(const WifiSpectrumBandInfo& band) const
+{
+    auto it = m_bands.find(band);
+    NS_ABORT_IF(it == m_bands.end());
+    return it->second.entries.size();
+}
+
+Time
+RingBufferInterferenceHelper::GetEnergyDuration(double energyW, const WifiSpectrumBandInfo& band)
+{
+    NS_LOG_FUNCTION(this << energyW << band);
+    Time now = Simulator::Now();
+    auto bandIt = m_bands.find(band);
+    NS_ABORT_IF(bandIt == m_bands.end());
+    const auto& entries = bandIt->second.entries;
+    auto i = GetPreviousPosition(bandIt->second, now);
+    Time end = entries[i].time;
+    for (; i < entries.size(); ++i)
+    {
+        end = entries[i].time;
+        if (entries[i].power < energyW)
+        {
+            break;
+        }
+    }
+    return end > now ? end - now : MicroSeconds(0);
+}
+
+void
+RingBufferInterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing)
+{
+    NS_LOG_FUNCTION(this << event << isStartOfdmaRxing);
+    for (const auto& [band, power] : event->GetRxPowerWPerBand())
+    {
+        auto bandIt = m_bands.find(band);
+        NS_ABORT_IF(bandIt == m_bands.end());
+        auto& changes = bandIt->second;
+        auto previousPowerPosition = GetPreviousPosition(changes, event->GetStartTime());
+        double previousPowerStart = changes.entries[previousPowerPosition].power;
+        double previousPowerEnd =
+            changes.entries[GetPreviousPosition(changes, event->GetEndTime())].power;
+        if (!m_rxing)
+        {
+            m_firstPowers.find(band)->second = previousPowerStart;
+            Prune(changes, previousPowerPosition);
+        }
+        else if (isStartOfdmaRxing)
+        {
+            // See InterferenceHelper::AppendEvent
+            m_firstPowers.find(band)->second = previousPowerStart;
+        }
+        auto first = Insert(changes, {event->GetStartTime(), previousPowerStart, event});
+        // the change at the end time is inserted after the change at the start time
+        auto last = Insert(changes, {event->GetEndTime(), previousPowerEnd, event});
+        for (auto i = first; i != last; ++i)
+        {
+            changes.entries[i].power += power;
+        }
+    }
+}
+
+void
+RingBufferInterferenceHelper::UpdateEvent(Ptr<Event> event,
+                                          const RxPowerWattPerChannelBand& rxPower)
+{
+    NS_LOG_FUNCTION(this << event);
+    // This is called for UL MU events, in order to scale power as long as UL MU PPDUs arrive
+    for (const auto& [band, power] : rxPower)
+    {
+        auto bandIt = m_bands.find(band);
+        NS_ABORT_IF(bandIt == m_bands.end());
+        auto& changes = bandIt->second;
+        auto first = GetPreviousPosition(changes, event->GetStartTime());
+        auto last = GetPreviousPosition(changes, event->GetEndTime());
+        for (auto i = first; i != last; ++i)
+        {
+            changes.entries[i].power += power;
+        }
+    }
+    event->UpdateRxPowerW(rxPower);
+}
+
+double
+RingBufferInterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
+                                                          NiChangesPerBand* nis,
+                                                          const WifiSpectrumBandInfo& band) const
+{
+    NS_LOG_FUNCTION(this << band);
+    auto firstPowerIt = m_firstPowers.find(band);
+    NS_ABORT_IF(firstPowerIt == m_firstPowers.end());
+    double noiseInterferenceW = firstPowerIt->second;
+    auto bandIt = m_bands.find(band);
+    NS_ABORT_IF(bandIt == m_bands.end());
+    const auto& changes = bandIt->second;
+    const auto& entries = changes.entries;
+    const auto start = event->GetStartTime();
+    const auto rxPowerW = event->GetRxPowerW(band);
+
+    // first change at the start time of the event
+    auto begin = std::lower_bound(entries.cbegin() + changes.head,
+                                  entries.cend(),
+                                  start,
+                                  [](const Change& change, Time t) { return change.time < t; });
+    NS_ABORT_IF(begin == entries.cend() || begin->time != start);
+    const auto now = Simulator::Now();
+    for (auto it = begin; it != entries.cend() && it->time < now; ++it)
+    {
+        noiseInterferenceW = it->power - rxPowerW;
+    }
+    auto it = begin;
+    for (; it != entries.cend() && it->event != event; ++it)
+    {
+        ;
+    }
+    NiChanges ni;
+    ni.emplace_hint(ni.end(), start, NiChange(0, event));
+    while (++it != entries.cend() && it->event != event)
+    {
+        ni.emplace_hint(ni.end(), it->time, NiChange(it->power, it->event));
+    }
+    ni.emplace_hint(ni.end(), event->GetEndTime(), NiChange(0, event));
+    nis->insert({band, std::move(ni)});
+    NS_ASSERT_MSG(noiseInterferenceW >= 0,
+                  "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
+    return noiseInterferenceW;
+}
+
+void
+RingBufferInterferenceHelper::NotifyRxEnd(Time endTime, const FrequencyRange& freqRange)
+{
+    NS_LOG_FUNCTION(this << endTime << freqRange);
+    m_rxing = false;
+    // Update m_firstPowers for frame capture
+    for (const auto& [band, changes] : m_bands)
+    {
+        if (!IsBandInFrequencyRange(band, freqRange))
+        {
+            continue;
+        }
+        NS_ASSERT(changes.entries.size() > changes.head + 1);
+        auto pos = GetPreviousPosition(changes, endTime);
+        NS_ASSERT(pos > changes.head);
+        m_firstPowers.find(band)->second = changes.entries[pos - 1].power;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_INTERFERENCE_HELPER_H
+#define RING_BUFFER_INTERFERENCE_HELPER_H
+
+#include "interference-helper.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief handles interference calculations with time-sorted arrays
+ *
+ * This interference helper gives the same results as InterferenceHelper, but
+ * stores the changes of noise and interference power of each band in a
+ * time-sorted array rather than in a multimap. As in InterferenceHelper, each
+ * change holds the total power of the signals on the band from its time on,
+ * i.e., the sum of the powers of the previous changes, so that the power at a
+ * given time is found by a binary search.
+ *
+ * Since the signals mostly start at the current time, the changes are usually
+ * appended at (or close to) the end of the array. The expired changes are
+ * pruned by moving the head of the array, which is compacted once more than
+ * half of it is expired, so that the memory used by a band is bounded by twice
+ * the number of pending changes.
+ *
+ * This helper is selected with WifiPhyHelper::SetInterferenceHelper or with
+ * the InterferenceHelper attribute of WifiPhy.
+ */
+class RingBufferInterferenceHelper : public InterferenceHelper
+{
+  public:
+    RingBufferInterferenceHelper();
+    ~RingBufferInterferenceHelper() override;
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    void AddBand(const WifiSpectrumBandInfo& band) override;
+    bool HasBands() const override;
+    void UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
+                     const FrequencyRange& freqRange) override;
+    Time GetEnergyDuration(double energyW, const WifiSpectrumBandInfo& band) override;
+    void NotifyRxEnd(Time endTime, const FrequencyRange& freqRange) override;
+    void UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBand& rxPower) override;
+
+    /**
+     * \param band the band
+     * \return the number of changes of noise and interference power stored for the band,
+     *         including the expired changes that are not compacted yet
+     */
+    std::size_t GetCapacity(const WifiSpectrumBandInfo& band) const;
+
+  protected:
+    void DoDispose() override;
+    void AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing) override;
+    double CalculateNoiseInterferenceW(Ptr<Event> event,
+                                       NiChangesPerBand* nis,
+                                       const WifiSpectrumBandInfo& band) const override;
+
+  private:
+    /// A change of noise and interference power
+    struct Change
+    {
+        Time time;        //!< the time of the change
+        double power;     //!< the total power from the time of the change, in watts
+        Ptr<Event> event; //!< the event that caused the change
+    };
+
+    /// The changes of noise and interference power of a band
+    struct Changes
+    {
+        std::vector<Change> entries; //!< the changes, sorted by time
+        std::size_t head;            //!< the index of the first valid change
+    };
+
+    /**
+     * \param changes the changes of a band
+     * \param moment a time
+     * \return the index of the first change that is later than moment
+     */
+    static std::size_t GetNextPosition(const Changes& changes, Time moment);
+    /**
+     * \param changes the changes of a band
+     * \param moment a time
+     * \return the index of the last change that is not later than moment
+     */
+    static std::size_t GetPreviousPosition(const Changes& changes, Time moment);
+    /**
+     * Insert a change after the changes that are not later than it.
+     *
+     * \param changes the changes of a band
+     * \param change the change to insert
+     * \return the index of the inserted change
+     */
+    static std::size_t Insert(Changes& changes, Change&& change);
+    /**
+     * Remove the changes up to a given one, which becomes the first change.
+     * This is equivalent to removing all the changes after the first one up to
+     * the given one in InterferenceHelper.
+     *
+     * \param changes the changes of a band
+     * \param pos the index of the last change to remove
+     */
+    static void Prune(Changes& changes, std::size_t pos);
+
+    std::map<WifiSpectrumBandInfo, Changes> m_bands; //!< the changes of each band
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_INTERFERENCE_HELPER_H */
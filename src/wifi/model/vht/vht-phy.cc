@@ -305,8 +305,7 @@ VhtPhy::GetFailureReason(WifiPpduField field) const
     case WIFI_PPDU_FIELD_SIG_B:
         return SIG_B_FAILURE;
     default:
-        NS_ASSERT_MSG(false, "Unknown PPDU field");
-        return UNKNOWN;
+        return HtPhy::GetFailureReason(field);
     }
 }
 
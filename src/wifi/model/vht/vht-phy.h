@@ -277,6 +277,7 @@ class VhtPhy : public HtPhy
     uint8_t GetNumberBccEncoders(const WifiTxVector& txVector) const override;
     PhyFieldRxStatus DoEndReceiveField(WifiPpduField field, Ptr<Event> event) override;
     bool IsAllConfigSupported(WifiPpduField field, Ptr<const WifiPpdu> ppdu) const override;
+    WifiPhyRxfailureReason GetFailureReason(WifiPpduField field) const override;
     uint32_t GetMaxPsduSize() const override;
     CcaIndication GetCcaIndication(const Ptr<const WifiPpdu> ppdu) override;
 
@@ -293,14 +294,6 @@ class VhtPhy : public HtPhy
      */
     PhyFieldRxStatus EndReceiveSig(Ptr<Event> event, WifiPpduField field);
 
-    /**
-     * Get the failure reason corresponding to the unsuccessful processing of a given PPDU field.
-     *
-     * \param field the PPDU field
-     * \return the failure reason corresponding to the unsuccessful processing of the PPDU field
-     */
-    virtual WifiPhyRxfailureReason GetFailureReason(WifiPpduField field) const;
-
     /**
      * Process SIG-A or SIG-B, perform amendment-specific actions, and
      * provide an updated status of the reception.
@@ -25,6 +25,8 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
+#include <string_view>
+
 namespace ns3
 {
 
@@ -33,22 +35,45 @@ WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
+    m_freeElems.clear();
+    m_lastQueueId.reset();
+    m_lastQueueInfo = nullptr;
+}
+
+WifiMacQueueContainer::QueueInfo&
+WifiMacQueueContainer::GetQueueInfo(const WifiContainerQueueId& queueId) const
+{
+    // references to the elements of an unordered_map are not invalidated by rehashing
+    if (!m_lastQueueId || *m_lastQueueId != queueId)
+    {
+        m_lastQueueInfo = &m_queues[queueId];
+        m_lastQueueId = queueId;
+    }
+    return *m_lastQueueInfo;
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& queueInfo = GetQueueInfo(queueId);
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == queueInfo.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    queueInfo.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    if (m_freeElems.empty())
+    {
+        return queueInfo.queue.emplace(pos, item);
+    }
+
+    // reuse an element from the pool
+    auto it = m_freeElems.begin();
+    it->mpdu = item;
+    queueInfo.queue.splice(pos, m_freeElems, it);
+    return it;
 }
 
 WifiMacQueueContainer::iterator
@@ -56,16 +81,25 @@ WifiMacQueueContainer::erase(const_iterator pos)
 {
     if (pos->expired)
     {
-        return m_expiredQueue.erase(pos);
+        return Recycle(m_expiredQueue, pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto& queueInfo = GetQueueInfo(GetQueueId(pos->mpdu));
+    NS_ASSERT(queueInfo.nBytes >= pos->mpdu->GetSize());
+    queueInfo.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    return Recycle(queueInfo.queue, pos);
+}
+
+WifiMacQueueContainer::iterator
+WifiMacQueueContainer::Recycle(ContainerQueue& queue, const_iterator pos)
+{
+    // erasing an empty range converts pos into a non-const iterator
+    auto it = queue.erase(pos, pos);
+    auto next = std::next(it);
+    it->Release();
+    m_freeElems.splice(m_freeElems.end(), queue, it);
+    return next;
 }
 
 Ptr<WifiMpdu>
@@ -100,28 +134,33 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return GetQueueInfo(queueId).queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    if (m_lastQueueId && *m_lastQueueId == queueId)
+    {
+        return m_lastQueueInfo->nBytes;
+    }
+    if (auto it = m_queues.find(queueId); it != m_queues.end())
     {
-        return 0;
+        return it->second.nBytes;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return 0;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(GetQueueInfo(queueId));
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& queueInfo) const
 {
+    auto& queue = queueInfo.queue;
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     iterator firstExpiredIt = queue.begin();
     iterator lastExpiredIt = firstExpiredIt;
@@ -151,11 +190,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(queueInfo.nBytes >= lastExpiredIt->mpdu->GetSize());
+            queueInfo.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
@@ -209,14 +245,14 @@ std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queue
     auto [type, addrType, address, tid] = queueId;
     const std::size_t size = tid.has_value() ? 8 : 7;
 
-    uint8_t buffer[size];
+    char buffer[8];
     buffer[0] = type;
-    address.CopyTo(buffer + 1);
+    address.CopyTo(reinterpret_cast<uint8_t*>(buffer + 1));
     if (tid.has_value())
     {
         buffer[7] = *tid;
     }
 
-    std::string s(buffer, buffer + size);
-    return std::hash<std::string>{}(s);
+    // same hash as a std::string holding the same characters, without constructing it
+    return std::hash<std::string_view>{}(std::string_view(buffer, size));
 }
@@ -109,6 +109,12 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ *
+ * The elements removed from the container queues are kept in a pool and are
+ * reused to store the MPDUs inserted afterwards, so that the container does not
+ * allocate memory once the number of queued MPDUs has reached its peak. Since
+ * MPDUs are mostly inserted in and removed from the same container queue in a
+ * row, the container queue used last is cached to save the hash table lookups.
  */
 class WifiMacQueueContainer
 {
@@ -205,21 +211,48 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /// A container queue along with the size in bytes of the MPDUs it stores
+    struct QueueInfo
+    {
+        ContainerQueue queue; //!< the container queue
+        uint32_t nBytes{0};   //!< size in bytes of the container queue
+    };
+
+    /**
+     * Get the information about the container queue identified by the given QueueId.
+     * The container queue is created if it does not exist.
+     *
+     * \param queueId the given QueueId
+     * \return a reference to the information about the given container queue
+     */
+    QueueInfo& GetQueueInfo(const WifiContainerQueueId& queueId) const;
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * \param queue the given container queue
+     * \param queueInfo the information about the given container queue
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& queueInfo) const;
+
+    /**
+     * Remove the element pointed to by the given iterator from the given container
+     * queue and add it to the pool of unused elements.
+     *
+     * \param queue the container queue storing the element
+     * \param pos iterator to the element to remove
+     * \return iterator following the removed element
+     */
+    iterator Recycle(ContainerQueue& queue, const_iterator pos);
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
+    ContainerQueue m_freeElems;            //!< pool of unused elements
+    mutable std::optional<WifiContainerQueueId> m_lastQueueId; //!< ID of the last queue used
+    mutable QueueInfo* m_lastQueueInfo{nullptr}; //!< information about the last queue used
 };
 
 } // namespace ns3
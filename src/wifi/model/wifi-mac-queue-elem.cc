@@ -34,8 +34,26 @@ WifiMacQueueElem::WifiMacQueueElem(Ptr<WifiMpdu> item)
 
 WifiMacQueueElem::~WifiMacQueueElem()
 {
-    deleter(mpdu);
+    if (!deleter.IsNull())
+    {
+        deleter(mpdu);
+    }
     inflights.clear();
 }
 
+void
+WifiMacQueueElem::Release()
+{
+    if (!deleter.IsNull())
+    {
+        deleter(mpdu);
+        deleter.Nullify();
+    }
+    inflights.clear();
+    mpdu = nullptr;
+    expiryTime = Time(0);
+    ac = AC_UNDEF;
+    expired = false;
+}
+
 } // namespace ns3
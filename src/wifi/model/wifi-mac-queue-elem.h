@@ -64,6 +64,12 @@ struct WifiMacQueueElem
     WifiMacQueueElem(Ptr<WifiMpdu> item);
 
     ~WifiMacQueueElem();
+
+    /**
+     * Release the MPDU stored by this element and reset all the other fields, so that
+     * this element can be reused to store another MPDU.
+     */
+    void Release();
 };
 
 } // namespace ns3
@@ -269,6 +269,15 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
                        const std::set<uint8_t>& tids,
                        const std::set<uint8_t>& linkIds);
 
+    /**
+     * Remove the container queues that held the given MPDUs and became empty after
+     * the MPDUs were dequeued or removed from the sorted list of queues.
+     *
+     * \param ac the Access Category of the dequeued or removed MPDUs
+     * \param mpdus the list of dequeued or removed MPDUs
+     */
+    void RemoveEmptyQueues(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus);
+
     std::vector<PerAcInfo> m_perAcInfo{AC_UNDEF}; //!< vector of per-AC information
     NS_LOG_TEMPLATE_DECLARE;                      //!< the log component
 };
@@ -679,29 +688,7 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyDequeue(AcIndex ac,
     NS_ASSERT(static_cast<uint8_t>(ac) < AC_UNDEF);
 
     DoNotifyDequeue(ac, mpdus);
-
-    std::list<WifiContainerQueueId> queueIds;
-
-    for (const auto& mpdu : mpdus)
-    {
-        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
-
-    for (const auto& queueId : queueIds)
-    {
-        if (GetWifiMacQueue(ac)->GetNBytes(queueId) == 0)
-        {
-            // The queue has now become empty and needs to be removed from the sorted
-            // list kept by the scheduler
-            auto queueInfoIt = m_perAcInfo[ac].queueInfoMap.find(queueId);
-            NS_ASSERT(queueInfoIt != m_perAcInfo[ac].queueInfoMap.end());
-            if (queueInfoIt->second.priorityIt.has_value())
-            {
-                m_perAcInfo[ac].sortedQueues.erase(queueInfoIt->second.priorityIt.value());
-                queueInfoIt->second.priorityIt.reset();
-            }
-        }
-    }
+    RemoveEmptyQueues(ac, mpdus);
 }
 
 template <class Priority, class Compare>
@@ -713,17 +700,31 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyRemove(AcIndex ac,
     NS_ASSERT(static_cast<uint8_t>(ac) < AC_UNDEF);
 
     DoNotifyRemove(ac, mpdus);
+    RemoveEmptyQueues(ac, mpdus);
+}
 
-    std::list<WifiContainerQueueId> queueIds;
+template <class Priority, class Compare>
+void
+WifiMacQueueSchedulerImpl<Priority, Compare>::RemoveEmptyQueues(
+    AcIndex ac,
+    const std::list<Ptr<WifiMpdu>>& mpdus)
+{
+    NS_LOG_FUNCTION(this << +ac);
+
+    auto queue = GetWifiMacQueue(ac);
+    std::optional<WifiContainerQueueId> prevQueueId;
 
     for (const auto& mpdu : mpdus)
     {
-        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        if (prevQueueId == queueId)
+        {
+            // the MPDUs of a container queue are usually dequeued or removed together
+            continue;
+        }
+        prevQueueId = queueId;
 
-    for (const auto& queueId : queueIds)
-    {
-        if (GetWifiMacQueue(ac)->GetNBytes(queueId) == 0)
+        if (queue->GetNBytes(queueId) == 0)
         {
             // The queue has now become empty and needs to be removed from the sorted
             // list kept by the scheduler
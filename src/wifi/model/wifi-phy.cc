@@ -251,6 +251,17 @@ WifiPhy::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&WifiPhy::m_postReceptionErrorModel),
                           MakePointerChecker<ErrorModel>())
+            .AddAttribute("AbstractReception",
+                          "If true, once the preamble of a SU PPDU is detected, the outcome of "
+                          "the reception of its PHY header and of its payload is determined in "
+                          "a single event at the end of the PPDU, using the same SNR and error "
+                          "rate computations as the reception field by field. The PHY is in RX "
+                          "state from the end of the preamble detection period. PPDUs whose "
+                          "reception cannot be abstracted, and all PPDUs if a frame capture "
+                          "model is installed, are received field by field.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&WifiPhy::m_abstractReception),
+                          MakeBooleanChecker())
             .AddAttribute("InterferenceHelper",
                           "Ptr to an object that implements the interference helper",
                           PointerValue(),
@@ -360,6 +371,7 @@ WifiPhy::WifiPhy()
       m_txSpatialStreams(1),
       m_rxSpatialStreams(1),
       m_wifiRadioEnergyModel(nullptr),
+      m_abstractReception(false),
       m_timeLastPreambleDetected(Seconds(0))
 {
     NS_LOG_FUNCTION(this);
@@ -1488,8 +1500,29 @@ WifiPhy::GetPayloadDuration(uint32_t size,
 Time
 WifiPhy::CalculatePhyPreambleAndHeaderDuration(const WifiTxVector& txVector)
 {
-    return GetStaticPhyEntity(txVector.GetModulationClass())
-        ->CalculatePhyPreambleAndHeaderDuration(txVector);
+    return CalculatePhyPreambleAndHeaderDuration(
+        txVector,
+        WifiTxDurationCache::GetKey(txVector, WIFI_PHY_BAND_UNSPECIFIED));
+}
+
+Time
+WifiPhy::CalculatePhyPreambleAndHeaderDuration(const WifiTxVector& txVector,
+                                               const std::optional<WifiTxDurationCache::Key>& key)
+{
+    if (key)
+    {
+        if (auto duration = WifiTxDurationCache::LookupPreambleAndHeaderDuration(*key))
+        {
+            return *duration;
+        }
+    }
+    Time duration = GetStaticPhyEntity(txVector.GetModulationClass())
+                        ->CalculatePhyPreambleAndHeaderDuration(txVector);
+    if (key)
+    {
+        WifiTxDurationCache::AddPreambleAndHeaderDuration(*key, duration);
+    }
+    return duration;
 }
 
 Time
@@ -1498,9 +1531,23 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              WifiPhyBand band,
                              uint16_t staId)
 {
-    Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+    auto key = WifiTxDurationCache::GetKey(txVector, band);
+    if (key)
+    {
+        if (auto duration = WifiTxDurationCache::LookupTxDuration(*key, size))
+        {
+            return *duration;
+        }
+    }
+    // on a miss, only the payload duration has to be computed if the preamble
+    // duration is cached, e.g., when an MPDU is added to an A-MPDU
+    Time duration = CalculatePhyPreambleAndHeaderDuration(txVector, key) +
                     GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+    if (key)
+    {
+        WifiTxDurationCache::AddTxDuration(*key, size, duration);
+    }
     return duration;
 }
 
@@ -25,10 +25,12 @@
 #include "wifi-phy-operating-channel.h"
 #include "wifi-phy-state-helper.h"
 #include "wifi-standards.h"
+#include "wifi-tx-duration-cache.h"
 
 #include "ns3/error-model.h"
 
 #include <limits>
+#include <optional>
 
 namespace ns3
 {
@@ -1269,6 +1271,17 @@ class WifiPhy : public Object
     std::map<WifiModulationClass, Ptr<PhyEntity>> m_phyEntities;
 
   private:
+    /**
+     * \param txVector the transmission parameters used for this packet
+     * \param key the key of the TXVECTOR in the cache of the TX durations, if it can be cached
+     *
+     * \return the total amount of time this PHY will stay busy for the transmission of the PHY
+     * preamble and PHY header.
+     */
+    static Time CalculatePhyPreambleAndHeaderDuration(
+        const WifiTxVector& txVector,
+        const std::optional<WifiTxDurationCache::Key>& key);
+
     /**
      * Configure WifiPhy with appropriate channel frequency and
      * supported rates for 802.11a standard.
@@ -1507,6 +1520,7 @@ class WifiPhy : public Object
     Ptr<PreambleDetectionModel> m_preambleDetectionModel; //!< Preamble detection model
     Ptr<WifiRadioEnergyModel> m_wifiRadioEnergyModel;     //!< Wifi radio energy model
     Ptr<ErrorModel> m_postReceptionErrorModel;            //!< Error model for receive packet events
+    bool m_abstractReception; //!< whether the reception of SU PPDUs is abstracted
     Time m_timeLastPreambleDetected; //!< Record the time the last preamble was detected
 
     Callback<void> m_capabilitiesChangedCallback; //!< Callback when PHY capabilities changed
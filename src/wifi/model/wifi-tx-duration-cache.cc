@@ -0,0 +1,267 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "wifi-tx-duration-cache.h"
+
+#include "wifi-tx-vector.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <array>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WifiTxDurationCache");
+
+namespace
+{
+
+/// An entry of a cache
+struct Entry
+{
+    WifiTxDurationCache::Key key{0, 0}; //!< the key of the TXVECTOR
+    uint32_t size{0};                   //!< the size of the PSDU (unused for the preambles)
+    Time duration;                      //!< the cached duration
+    bool valid{false};                  //!< whether the entry holds a duration
+};
+
+/// A set of entries sharing the same index in a cache
+struct Set
+{
+    std::array<Entry, WifiTxDurationCache::WAYS> entries; //!< the entries of the set
+    std::size_t next{0}; //!< the index of the entry to overwrite when the set is full
+
+    /**
+     * \param key the key of the TXVECTOR
+     * \param size the size of the PSDU
+     * \return the entry holding the duration for the given key and size, if any
+     */
+    const Entry* Find(const WifiTxDurationCache::Key& key, uint32_t size) const
+    {
+        for (const auto& entry : entries)
+        {
+            if (entry.valid && entry.size == size && entry.key == key)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Store the given duration in an invalid entry or, if the set is full, in
+     * the entries of the set in turn.
+     *
+     * \param key the key of the TXVECTOR
+     * \param size the size of the PSDU
+     * \param duration the duration to store
+     */
+    void Add(const WifiTxDurationCache::Key& key, uint32_t size, Time duration)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(), [](const Entry& entry) {
+            return !entry.valid;
+        });
+        if (it == entries.end())
+        {
+            it = entries.begin() + next;
+            next = (next + 1) % entries.size();
+        }
+        it->key = key;
+        it->size = size;
+        it->duration = duration;
+        it->valid = true;
+    }
+};
+
+/// The state of the caches
+struct State
+{
+    std::array<Set, WifiTxDurationCache::TX_DURATION_CACHE_SIZE / WifiTxDurationCache::WAYS>
+        txDurations; //!< the sets of the cache of the TX durations
+    std::array<Set, WifiTxDurationCache::PREAMBLE_CACHE_SIZE / WifiTxDurationCache::WAYS>
+        preambles; //!< the sets of the cache of the preamble durations
+    WifiTxDurationCache::Counters txDurationCounters; //!< counters of the TX durations
+    WifiTxDurationCache::Counters preambleCounters;   //!< counters of the preamble durations
+    bool enabled{true};                               //!< whether the cache is enabled
+};
+
+/**
+ * \return the state of the caches
+ */
+State&
+GetState()
+{
+    static State state;
+    return state;
+}
+
+/**
+ * \param key the key of the TXVECTOR
+ * \param size the size of the PSDU
+ * \return a hash of the given key and size
+ */
+uint64_t
+Hash(const WifiTxDurationCache::Key& key, uint32_t size)
+{
+    // mix the bits as done by the finalizer of SplitMix64
+    uint64_t h = key.mode ^ (key.params * 0x9e3779b97f4a7c15ULL) ^ size;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+/// The bits of WifiTxDurationCache::Key::params holding the band
+constexpr uint64_t BAND_MASK = 0xffULL << 40;
+
+/**
+ * \param key the key of the TXVECTOR
+ * \return the key of the TXVECTOR in the cache of the preamble durations, which
+ *         does not depend on the band
+ */
+WifiTxDurationCache::Key
+GetPreambleKey(const WifiTxDurationCache::Key& key)
+{
+    return {key.mode, key.params & ~BAND_MASK};
+}
+
+} // namespace
+
+bool
+WifiTxDurationCache::Key::operator==(const Key& other) const
+{
+    return mode == other.mode && params == other.params;
+}
+
+double
+WifiTxDurationCache::Counters::GetHitRate() const
+{
+    auto lookups = hits + misses;
+    return (lookups == 0) ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+std::optional<WifiTxDurationCache::Key>
+WifiTxDurationCache::GetKey(const WifiTxVector& txVector, WifiPhyBand band)
+{
+    if (!GetState().enabled || txVector.IsMu())
+    {
+        return std::nullopt;
+    }
+    const auto& inactiveSubchannels = txVector.GetInactiveSubchannels();
+    if (std::find(inactiveSubchannels.cbegin(), inactiveSubchannels.cend(), true) !=
+        inactiveSubchannels.cend())
+    {
+        return std::nullopt;
+    }
+    Key key;
+    key.mode = (static_cast<uint64_t>(txVector.GetMode().GetUid()) << 32) |
+               (static_cast<uint64_t>(txVector.GetChannelWidth()) << 16) |
+               txVector.GetGuardInterval();
+    key.params = static_cast<uint64_t>(txVector.GetPreambleType()) |
+                 (static_cast<uint64_t>(txVector.GetNss()) << 8) |
+                 (static_cast<uint64_t>(txVector.GetNess()) << 16) |
+                 (static_cast<uint64_t>(txVector.GetNTx()) << 24) |
+                 (static_cast<uint64_t>(txVector.GetEhtPpduType()) << 32) |
+                 (static_cast<uint64_t>(band) << 40) |
+                 (static_cast<uint64_t>(txVector.IsStbc()) << 48) |
+                 (static_cast<uint64_t>(txVector.IsLdpc()) << 49) |
+                 (static_cast<uint64_t>(txVector.IsAggregation()) << 50);
+    return key;
+}
+
+std::optional<Time>
+WifiTxDurationCache::LookupTxDuration(const Key& key, uint32_t size)
+{
+    auto& state = GetState();
+    const auto& set = state.txDurations[Hash(key, size) % state.txDurations.size()];
+    if (const auto entry = set.Find(key, size))
+    {
+        state.txDurationCounters.hits++;
+        return entry->duration;
+    }
+    state.txDurationCounters.misses++;
+    return std::nullopt;
+}
+
+void
+WifiTxDurationCache::AddTxDuration(const Key& key, uint32_t size, Time duration)
+{
+    NS_LOG_FUNCTION(size << duration);
+    auto& sets = GetState().txDurations;
+    sets[Hash(key, size) % sets.size()].Add(key, size, duration);
+}
+
+std::optional<Time>
+WifiTxDurationCache::LookupPreambleAndHeaderDuration(const Key& key)
+{
+    auto& state = GetState();
+    auto preambleKey = GetPreambleKey(key);
+    const auto& set = state.preambles[Hash(preambleKey, 0) % state.preambles.size()];
+    if (const auto entry = set.Find(preambleKey, 0))
+    {
+        state.preambleCounters.hits++;
+        return entry->duration;
+    }
+    state.preambleCounters.misses++;
+    return std::nullopt;
+}
+
+void
+WifiTxDurationCache::AddPreambleAndHeaderDuration(const Key& key, Time duration)
+{
+    NS_LOG_FUNCTION(duration);
+    auto preambleKey = GetPreambleKey(key);
+    auto& sets = GetState().preambles;
+    sets[Hash(preambleKey, 0) % sets.size()].Add(preambleKey, 0, duration);
+}
+
+void
+WifiTxDurationCache::Enable(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    GetState().enabled = enable;
+}
+
+bool
+WifiTxDurationCache::IsEnabled()
+{
+    return GetState().enabled;
+}
+
+void
+WifiTxDurationCache::Clear()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    auto& state = GetState();
+    state.txDurations.fill(Set());
+    state.preambles.fill(Set());
+    state.txDurationCounters = Counters();
+    state.preambleCounters = Counters();
+}
+
+const WifiTxDurationCache::Counters&
+WifiTxDurationCache::GetTxDurationCounters()
+{
+    return GetState().txDurationCounters;
+}
+
+const WifiTxDurationCache::Counters&
+WifiTxDurationCache::GetPreambleAndHeaderCounters()
+{
+    return GetState().preambleCounters;
+}
+
+} // namespace ns3
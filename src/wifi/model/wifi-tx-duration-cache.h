@@ -0,0 +1,154 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_TX_DURATION_CACHE_H
+#define WIFI_TX_DURATION_CACHE_H
+
+#include "wifi-phy-band.h"
+
+#include "ns3/nstime.h"
+
+#include <optional>
+
+namespace ns3
+{
+
+class WifiTxVector;
+
+/**
+ * \ingroup wifi
+ *
+ * A cache of the durations computed by WifiPhy::CalculateTxDuration and
+ * WifiPhy::CalculatePhyPreambleAndHeaderDuration for single-user transmissions.
+ *
+ * The MAC computes the TX duration of the PSDU it is building every time an MPDU
+ * is added to an A-MPDU, with the same TXVECTOR and a PSDU size that grows by
+ * one A-MPDU subframe at a time, and the duration of the control frames is
+ * computed many times for the same few sizes. The duration of the preamble and
+ * PHY headers only depends on the TXVECTOR and is cached separately, hence a
+ * miss on the TX duration of a PSDU only requires to compute the duration of
+ * its payload.
+ *
+ * Both caches are set-associative tables: the durations are stored in a set
+ * of entries selected by a hash of the relevant parameters of the TXVECTOR, the
+ * band and the PSDU size, whose entries are overwritten in turn once it is
+ * full. The cached durations are the ones that would
+ * be computed otherwise, so the cache does not change the results of a
+ * simulation. The cache is shared by all the PHYs in the process.
+ */
+class WifiTxDurationCache
+{
+  public:
+    /**
+     * The key of the TXVECTOR (and band) the durations are computed for. It packs
+     * all the parameters of the TXVECTOR the duration of a single-user
+     * transmission depends on.
+     */
+    struct Key
+    {
+        uint64_t mode;   //!< the UID of the mode, the channel width and the guard interval
+        uint64_t params; //!< the other parameters of the TXVECTOR and the band
+
+        /**
+         * \param other the key to compare to
+         * \return whether the keys are equal
+         */
+        bool operator==(const Key& other) const;
+    };
+
+    /// The counters of a cache
+    struct Counters
+    {
+        uint64_t hits{0};   //!< number of lookups that found the duration in the cache
+        uint64_t misses{0}; //!< number of lookups that did not
+
+        /**
+         * \return the ratio of the lookups that found the duration in the cache
+         */
+        double GetHitRate() const;
+    };
+
+    /**
+     * Get the key for the given TXVECTOR and band, unless the durations computed
+     * for this TXVECTOR cannot be cached (e.g., multi-user or punctured
+     * transmissions) or the cache is disabled.
+     *
+     * \param txVector the TXVECTOR
+     * \param band the frequency band
+     * \return the key, if any
+     */
+    static std::optional<Key> GetKey(const WifiTxVector& txVector, WifiPhyBand band);
+
+    /**
+     * \param key the key of the TXVECTOR
+     * \param size the size of the PSDU in bytes
+     * \return the TX duration of the PSDU, if found in the cache
+     */
+    static std::optional<Time> LookupTxDuration(const Key& key, uint32_t size);
+
+    /**
+     * \param key the key of the TXVECTOR
+     * \param size the size of the PSDU in bytes
+     * \param duration the TX duration of the PSDU
+     */
+    static void AddTxDuration(const Key& key, uint32_t size, Time duration);
+
+    /**
+     * \param key the key of the TXVECTOR (the band is ignored)
+     * \return the duration of the preamble and PHY headers, if found in the cache
+     */
+    static std::optional<Time> LookupPreambleAndHeaderDuration(const Key& key);
+
+    /**
+     * \param key the key of the TXVECTOR (the band is ignored)
+     * \param duration the duration of the preamble and PHY headers
+     */
+    static void AddPreambleAndHeaderDuration(const Key& key, Time duration);
+
+    /**
+     * Enable or disable the cache. The cache is enabled by default.
+     *
+     * \param enable whether to enable the cache
+     */
+    static void Enable(bool enable);
+
+    /**
+     * \return whether the cache is enabled
+     */
+    static bool IsEnabled();
+
+    /**
+     * Remove all the entries of the caches and reset their counters.
+     */
+    static void Clear();
+
+    /**
+     * \return the counters of the cache of the TX durations
+     */
+    static const Counters& GetTxDurationCounters();
+
+    /**
+     * \return the counters of the cache of the preamble and PHY header durations
+     */
+    static const Counters& GetPreambleAndHeaderCounters();
+
+    static constexpr std::size_t TX_DURATION_CACHE_SIZE = 4096; //!< entries of the TX durations
+    static constexpr std::size_t PREAMBLE_CACHE_SIZE = 256; //!< entries of the preamble durations
+    static constexpr std::size_t WAYS = 4;                  //!< entries of a set
+};
+
+} // namespace ns3
+
+#endif /* WIFI_TX_DURATION_CACHE_H */
@@ -20,6 +20,7 @@
 
 #include "yans-error-rate-model.h"
 
+#include "chunk-success-rate-table.h"
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
@@ -216,194 +217,220 @@ YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
         {
             phyRate = mode.GetPhyRate(txVector, staId);
         }
-        if (mode.GetConstellationSize() == 2)
+        uint32_t signalSpread = txVector.GetChannelWidth() * 1000000;
+        if (UseLookupTables())
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
+            // the success rate only depends on Eb/No = snr * signalSpread / phyRate, hence the
+            // table of a mode is used whatever the channel width
+            auto table = ChunkSuccessRateTable::Get(
+                {YansErrorRateModel::GetTypeId().GetUid(), mode.GetUid()},
+                [this, mode](double sample) {
+                    return CalculateChunkSuccessRate(mode, sample, 1, 1, 1);
+                });
+            if (auto csr = table->GetChunkSuccessRate(snr * signalSpread / phyRate, nbits))
             {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth() * 1000000, // signal spread
-                                     phyRate,                              // PHY rate
-                                     10,                                   // dFree
-                                     11);                                  // adFree
-            }
-            else
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth() * 1000000, // signal spread
-                                     phyRate,                              // PHY rate
-                                     5,                                    // dFree
-                                     8);                                   // adFree
+                return *csr;
             }
         }
-        else if (mode.GetConstellationSize() == 4)
+        return CalculateChunkSuccessRate(mode, snr, nbits, signalSpread, phyRate);
+    }
+    return 0;
+}
+
+double
+YansErrorRateModel::CalculateChunkSuccessRate(WifiMode mode,
+                                              double snr,
+                                              uint64_t nbits,
+                                              uint32_t signalSpread,
+                                              uint64_t phyRate) const
+{
+    if (mode.GetConstellationSize() == 2)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4,                                    // m
-                                    10,                                   // dFree
-                                    11,                                   // adFree
-                                    0);                                   // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4,                                    // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31);                                  // adFreePlusOne
-            }
+            return GetFecBpskBer(snr,
+                                 nbits,
+                                 signalSpread, // signal spread
+                                 phyRate,      // PHY rate
+                                 10,           // dFree
+                                 11);          // adFree
         }
-        else if (mode.GetConstellationSize() == 16)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    16,                                   // m
-                                    10,                                   // dFree
-                                    11,                                   // adFree
-                                    0);                                   // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    16,                                   // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31);                                  // adFreePlusOne
-            }
+            return GetFecBpskBer(snr,
+                                 nbits,
+                                 signalSpread, // signal spread
+                                 phyRate,      // PHY rate
+                                 5,            // dFree
+                                 8);           // adFree
         }
-        else if (mode.GetConstellationSize() == 64)
+    }
+    else if (mode.GetConstellationSize() == 4)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    64,                                   // m
-                                    6,                                    // dFree
-                                    1,                                    // adFree
-                                    16);                                  // adFreePlusOne
-            }
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    64,                                   // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69);                                  // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    64,                                   // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31);                                  // adFreePlusOne
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4,            // m
+                                10,           // dFree
+                                11,           // adFree
+                                0);           // adFreePlusOne
         }
-        else if (mode.GetConstellationSize() == 256)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    256,                                  // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69                                    // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    256,                                  // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31                                    // adFreePlusOne
-                );
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4,            // m
+                                5,            // dFree
+                                8,            // adFree
+                                31);          // adFreePlusOne
         }
-        else if (mode.GetConstellationSize() == 1024)
+    }
+    else if (mode.GetConstellationSize() == 16)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    1024,                                 // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69                                    // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    1024,                                 // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31                                    // adFreePlusOne
-                );
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                16,           // m
+                                10,           // dFree
+                                11,           // adFree
+                                0);           // adFreePlusOne
         }
-        else if (mode.GetConstellationSize() == 4096)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4096,                                 // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69                                    // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4096,                                 // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31                                    // adFreePlusOne
-                );
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                16,           // m
+                                5,            // dFree
+                                8,            // adFree
+                                31);          // adFreePlusOne
+        }
+    }
+    else if (mode.GetConstellationSize() == 64)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                64,           // m
+                                6,            // dFree
+                                1,            // adFree
+                                16);          // adFreePlusOne
+        }
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
+        {
+            // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                64,           // m
+                                4,            // dFree
+                                14,           // adFree
+                                69);          // adFreePlusOne
+        }
+        else
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                64,           // m
+                                5,            // dFree
+                                8,            // adFree
+                                31);          // adFreePlusOne
+        }
+    }
+    else if (mode.GetConstellationSize() == 256)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                256,          // m
+                                4,            // dFree
+                                14,           // adFree
+                                69            // adFreePlusOne
+            );
+        }
+        else
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                256,          // m
+                                5,            // dFree
+                                8,            // adFree
+                                31            // adFreePlusOne
+            );
+        }
+    }
+    else if (mode.GetConstellationSize() == 1024)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                1024,         // m
+                                4,            // dFree
+                                14,           // adFree
+                                69            // adFreePlusOne
+            );
+        }
+        else
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                1024,         // m
+                                5,            // dFree
+                                8,            // adFree
+                                31            // adFreePlusOne
+            );
+        }
+    }
+    else if (mode.GetConstellationSize() == 4096)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4096,         // m
+                                4,            // dFree
+                                14,           // adFree
+                                69            // adFreePlusOne
+            );
+        }
+        else
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4096,         // m
+                                5,            // dFree
+                                8,            // adFree
+                                31            // adFreePlusOne
+            );
         }
     }
     return 0;
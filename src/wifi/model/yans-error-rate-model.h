@@ -69,6 +69,23 @@ class YansErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    /**
+     * Compute the probability of successfully receiving a chunk of an
+     * ERP-OFDM, OFDM, HT, VHT, HE or EHT mode.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunk
+     * \param snr the SNR of the chunk (linear scale)
+     * \param nbits the number of bits in the chunk
+     * \param signalSpread the signal spread (Hz)
+     * \param phyRate the PHY rate of the chunk (bit/s)
+     *
+     * \return probability of successfully receiving the chunk
+     */
+    double CalculateChunkSuccessRate(WifiMode mode,
+                                     double snr,
+                                     uint64_t nbits,
+                                     uint32_t signalSpread,
+                                     uint64_t phyRate) const;
     /**
      * Return BER of BPSK with the given parameters.
      *
@@ -24,6 +24,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -57,11 +58,23 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The maximum distance (in meters) between the sender and the "
+                          "receivers of a PPDU, which must be large enough that the PPDU "
+                          "cannot be detected farther. If 0, the PPDU is delivered to all "
+                          "the receivers, whatever their distance. Otherwise, the receivers "
+                          "within this distance are found by means of a spatial index of "
+                          "the PHYs, and the PPDU is not delivered to the other receivers.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::SetMaxRange,
+                                             &YansWifiChannel::GetMaxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -69,9 +82,33 @@ YansWifiChannel::YansWifiChannel()
 YansWifiChannel::~YansWifiChannel()
 {
     NS_LOG_FUNCTION(this);
+    m_index.Clear();
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_index.Clear();
+    Channel::DoDispose();
+}
+
+void
+YansWifiChannel::SetMaxRange(double range)
+{
+    NS_LOG_FUNCTION(this << range);
+    m_maxRange = range;
+    // the spatial index is built at the first transmission
+    m_index.Clear();
+}
+
+double
+YansWifiChannel::GetMaxRange() const
+{
+    return m_maxRange;
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -92,42 +129,86 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); i++)
+
+    if (m_maxRange == 0)
     {
-        if (sender != (*i))
+        for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); i++)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
-
-            Ptr<MobilityModel> receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            Ptr<NetDevice> dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPowerDbm);
+            SendTo(sender, senderMobility, *i, ppdu, txPowerDbm);
         }
+        return;
     }
+
+    if (m_index.GetN() != m_phyList.size())
+    {
+        // the mobility models of the PHYs may not be available when the PHYs
+        // are added to the channel, hence the index is built (or completed) when
+        // a PPDU is sent
+        if (m_index.GetN() == 0)
+        {
+            m_index.SetCellSize(m_maxRange);
+        }
+        for (std::size_t i = m_index.GetN(); i < m_phyList.size(); i++)
+        {
+            m_index.Add(m_phyList[i]->GetMobility(), i);
+        }
+    }
+
+    // the candidates are sorted, so that the receptions are scheduled in the same
+    // order as without the spatial index
+    m_index.GetCandidates(senderMobility->GetPosition(), m_maxRange, m_candidates);
+    for (auto i : m_candidates)
+    {
+        Ptr<MobilityModel> receiverMobility = m_phyList[i]->GetMobility();
+        if (senderMobility->GetDistanceFrom(receiverMobility) <= m_maxRange)
+        {
+            SendTo(sender, senderMobility, m_phyList[i], ppdu, txPowerDbm);
+        }
+    }
+}
+
+void
+YansWifiChannel::SendTo(Ptr<YansWifiPhy> sender,
+                        Ptr<MobilityModel> senderMobility,
+                        Ptr<YansWifiPhy> receiver,
+                        Ptr<const WifiPpdu> ppdu,
+                        double txPowerDbm) const
+{
+    if (sender == receiver)
+    {
+        return;
+    }
+
+    // For now don't account for inter channel interference nor channel bonding
+    if (receiver->GetChannelNumber() != sender->GetChannelNumber())
+    {
+        return;
+    }
+
+    Ptr<MobilityModel> receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    Ptr<NetDevice> dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    Simulator::ScheduleWithContext(dstNode,
+                                   delay,
+                                   &YansWifiChannel::Receive,
+                                   receiver,
+                                   ppdu,
+                                   rxPowerDbm);
 }
 
 void
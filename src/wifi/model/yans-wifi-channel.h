@@ -21,6 +21,7 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid-index.h"
 
 namespace ns3
 {
@@ -41,6 +42,12 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, a PPDU is delivered to all the PHYs of the channel, whose received
+ * power is computed by the propagation loss model. If the MaxRange attribute is
+ * set, the PPDU is only delivered to the PHYs within that distance of the sender,
+ * which are found by means of a spatial index (see ns3::MobilityGridIndex)
+ * rather than by computing the distance to all the PHYs.
  */
 class YansWifiChannel : public Channel
 {
@@ -96,6 +103,9 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+  protected:
+    void DoDispose() override;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
@@ -113,9 +123,37 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
-    PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
-    Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
-    Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    /**
+     * \param range the maximum distance of the receivers of a PPDU, in meters,
+     *        or 0 if all the receivers are considered
+     */
+    void SetMaxRange(double range);
+    /**
+     * \return the maximum distance of the receivers of a PPDU, in meters
+     */
+    double GetMaxRange() const;
+    /**
+     * Schedule the reception of a PPDU by a receiver
+     *
+     * \param sender the PHY object from which the PPDU is originating
+     * \param senderMobility the mobility model of the sender
+     * \param receiver the receiver
+     * \param ppdu the PPDU
+     * \param txPowerDbm the TX power associated to the PPDU, in dBm
+     */
+    void SendTo(Ptr<YansWifiPhy> sender,
+                Ptr<MobilityModel> senderMobility,
+                Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu,
+                double txPowerDbm) const;
+
+    /// List of YansWifiPhys connected to this YansWifiChannel
+    PhyList m_phyList;
+    Ptr<PropagationLossModel> m_loss;           //!< Propagation loss model
+    Ptr<PropagationDelayModel> m_delay;         //!< Propagation delay model
+    double m_maxRange;                          //!< Maximum distance of the receivers, or 0
+    mutable MobilityGridIndex m_index;          //!< Spatial index of the PHYs, if m_maxRange > 0
+    mutable std::vector<uint32_t> m_candidates; //!< Receivers returned by the spatial index
 };
 
 } // namespace ns3
@@ -0,0 +1,256 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/interference-helper.h"
+#include "ns3/log.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ring-buffer-interference-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/wifi-phy-operating-channel.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-utils.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("InterferenceHelperTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief RingBufferInterferenceHelper equivalence test
+ *
+ * A random sequence of overlapping signals on several bands is added to an
+ * InterferenceHelper and to a RingBufferInterferenceHelper. Some of the
+ * signals are received, and the SNR and PER computed by both helpers at the
+ * end of the reception, as well as the durations returned by
+ * GetEnergyDuration, are checked to be equal. The memory used by the
+ * RingBufferInterferenceHelper is checked to be bounded.
+ */
+class RingBufferInterferenceHelperTest : public TestCase
+{
+  public:
+    RingBufferInterferenceHelperTest();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Add a random signal to both helpers and possibly start receiving it
+     */
+    void AddSignal();
+    /**
+     * End the reception of a signal and check the results of both helpers
+     *
+     * \param event the signal in the InterferenceHelper
+     * \param ringEvent the signal in the RingBufferInterferenceHelper
+     */
+    void EndReception(Ptr<Event> event, Ptr<Event> ringEvent);
+
+    Ptr<InterferenceHelper> m_helper;               //!< the reference interference helper
+    Ptr<RingBufferInterferenceHelper> m_ringHelper; //!< the interference helper under test
+    std::vector<WifiSpectrumBandInfo> m_bands;      //!< the bands
+    Ptr<UniformRandomVariable> m_rng;               //!< the random variable stream
+    Ptr<const WifiPpdu> m_ppdu;                     //!< the PPDU of the signals
+    bool m_rxing;                                   //!< whether a signal is being received
+    Ptr<Event> m_lastEvent;     //!< the last signal in the InterferenceHelper
+    Ptr<Event> m_lastRingEvent; //!< the last signal in the RingBufferInterferenceHelper
+    uint32_t m_nReceptions;     //!< the number of receptions
+    std::size_t m_maxCapacity;  //!< the maximum number of changes stored for a band
+};
+
+RingBufferInterferenceHelperTest::RingBufferInterferenceHelperTest()
+    : TestCase("Check that RingBufferInterferenceHelper gives the results of InterferenceHelper"),
+      m_rxing(false),
+      m_nReceptions(0),
+      m_maxCapacity(0)
+{
+}
+
+void
+RingBufferInterferenceHelperTest::DoSetup()
+{
+    m_helper = CreateObject<InterferenceHelper>();
+    m_ringHelper = CreateObject<RingBufferInterferenceHelper>();
+    for (uint64_t i = 0; i < 4; i++)
+    {
+        m_bands.push_back({{i * 64, i * 64 + 63}, {5170e6 + i * 20e6, 5190e6 + i * 20e6}});
+    }
+    for (Ptr<InterferenceHelper> helper : {m_helper, Ptr<InterferenceHelper>(m_ringHelper)})
+    {
+        helper->SetNoiseFigure(DbToRatio(7));
+        helper->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+        helper->UpdateBands(m_bands, WHOLE_WIFI_SPECTRUM);
+    }
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    WifiTxVector txVector(OfdmPhy::GetOfdmRate6Mbps(),
+                          0,
+                          WIFI_PREAMBLE_LONG,
+                          800,
+                          1,
+                          1,
+                          0,
+                          20,
+                          false);
+    m_ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(100), hdr),
+                              txVector,
+                              WifiPhyOperatingChannel());
+}
+
+void
+RingBufferInterferenceHelperTest::DoTeardown()
+{
+    m_helper->Dispose();
+    m_ringHelper->Dispose();
+    m_lastEvent = nullptr;
+    m_lastRingEvent = nullptr;
+    m_ppdu = nullptr;
+}
+
+void
+RingBufferInterferenceHelperTest::AddSignal()
+{
+    // the first band is always used, so that the signal may be received
+    RxPowerWattPerChannelBand rxPower;
+    for (std::size_t i = 0; i < m_bands.size(); i++)
+    {
+        if (i == 0 || m_rng->GetValue() < 0.5)
+        {
+            rxPower.insert({m_bands[i], DbmToW(m_rng->GetValue(-95, -60))});
+        }
+    }
+    RxPowerWattPerChannelBand ringRxPower = rxPower;
+    Time duration = MicroSeconds(m_rng->GetInteger(20, 400));
+    bool isStartOfdmaRxing = m_rxing && (m_rng->GetValue() < 0.1);
+    auto event = m_helper->Add(m_ppdu, m_ppdu->GetTxVector(), duration, rxPower, isStartOfdmaRxing);
+    auto ringEvent = m_ringHelper->Add(m_ppdu,
+                                       m_ppdu->GetTxVector(),
+                                       duration,
+                                       ringRxPower,
+                                       isStartOfdmaRxing);
+
+    if (m_lastEvent && m_rng->GetValue() < 0.1)
+    {
+        // scale the power of the previous signal, as done for UL MU signals
+        RxPowerWattPerChannelBand update;
+        for (const auto& [band, power] : m_lastEvent->GetRxPowerWPerBand())
+        {
+            update.insert({band, power / 2});
+        }
+        m_helper->UpdateEvent(m_lastEvent, update);
+        m_ringHelper->UpdateEvent(m_lastRingEvent, update);
+    }
+    m_lastEvent = event;
+    m_lastRingEvent = ringEvent;
+
+    for (const auto& band : m_bands)
+    {
+        double energyW = DbmToW(m_rng->GetValue(-90, -60));
+        NS_TEST_EXPECT_MSG_EQ(m_ringHelper->GetEnergyDuration(energyW, band),
+                              m_helper->GetEnergyDuration(energyW, band),
+                              "Unexpected energy duration");
+        m_maxCapacity = std::max(m_maxCapacity, m_ringHelper->GetCapacity(band));
+    }
+
+    if (!m_rxing && m_rng->GetValue() < 0.3)
+    {
+        m_rxing = true;
+        m_helper->NotifyRxStart();
+        m_ringHelper->NotifyRxStart();
+        Simulator::Schedule(duration,
+                            &RingBufferInterferenceHelperTest::EndReception,
+                            this,
+                            event,
+                            ringEvent);
+    }
+}
+
+void
+RingBufferInterferenceHelperTest::EndReception(Ptr<Event> event, Ptr<Event> ringEvent)
+{
+    const auto& band = m_bands.front();
+    NS_TEST_EXPECT_MSG_EQ(m_ringHelper->CalculateSnr(ringEvent, 20, 1, band),
+                          m_helper->CalculateSnr(event, 20, 1, band),
+                          "Unexpected SNR");
+    Time payloadDuration = event->GetDuration() - MicroSeconds(20);
+    for (const auto& window : {std::make_pair(Time(0), payloadDuration),
+                               std::make_pair(payloadDuration / 2, payloadDuration)})
+    {
+        auto snrPer = m_helper->CalculatePayloadSnrPer(event, 20, band, SU_STA_ID, window);
+        auto ringSnrPer =
+            m_ringHelper->CalculatePayloadSnrPer(ringEvent, 20, band, SU_STA_ID, window);
+        NS_TEST_EXPECT_MSG_EQ(ringSnrPer.snr, snrPer.snr, "Unexpected payload SNR");
+        NS_TEST_EXPECT_MSG_EQ(ringSnrPer.per, snrPer.per, "Unexpected payload PER");
+    }
+    auto snrPer =
+        m_helper->CalculatePhyHeaderSnrPer(event, 20, band, WIFI_PPDU_FIELD_NON_HT_HEADER);
+    auto ringSnrPer =
+        m_ringHelper->CalculatePhyHeaderSnrPer(ringEvent, 20, band, WIFI_PPDU_FIELD_NON_HT_HEADER);
+    NS_TEST_EXPECT_MSG_EQ(ringSnrPer.snr, snrPer.snr, "Unexpected PHY header SNR");
+    NS_TEST_EXPECT_MSG_EQ(ringSnrPer.per, snrPer.per, "Unexpected PHY header PER");
+
+    m_helper->NotifyRxEnd(Simulator::Now(), WHOLE_WIFI_SPECTRUM);
+    m_ringHelper->NotifyRxEnd(Simulator::Now(), WHOLE_WIFI_SPECTRUM);
+    m_rxing = false;
+    m_nReceptions++;
+}
+
+void
+RingBufferInterferenceHelperTest::DoRun()
+{
+    Time time = MicroSeconds(1);
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        Simulator::Schedule(time, &RingBufferInterferenceHelperTest::AddSignal, this);
+        time += MicroSeconds(m_rng->GetInteger(0, 40));
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_GT(m_nReceptions, 100, "Too few receptions were checked");
+    NS_TEST_EXPECT_MSG_LT(m_maxCapacity, 256, "The expired changes were not pruned");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Interference helper Test Suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+  public:
+    InterferenceHelperTestSuite();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite()
+    : TestSuite("wifi-interference-helper", UNIT)
+{
+    AddTestCase(new RingBufferInterferenceHelperTest, TestCase::QUICK);
+}
+
+static InterferenceHelperTestSuite g_interferenceHelperTestSuite; ///< the test suite
@@ -28,8 +28,10 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 #include "ns3/wifi-psdu.h"
+#include "ns3/wifi-tx-duration-cache.h"
 #include "ns3/yans-wifi-phy.h"
 
+#include <list>
 #include <numeric>
 
 using namespace ns3;
@@ -1769,6 +1771,176 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief TX duration cache test
+ *
+ * Check that the TX durations returned when the cache is enabled are the ones
+ * computed when it is disabled, for PSDU sizes growing by one A-MPDU subframe at
+ * a time as done when an A-MPDU is built, and that the cache counters are
+ * consistent.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Check the TX durations returned by the TX duration cache")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    std::list<std::pair<WifiTxVector, WifiPhyBand>> txVectors;
+    auto addTxVector = [&txVectors](WifiMode mode,
+                                    WifiPreamble preamble,
+                                    uint16_t channelWidth,
+                                    uint16_t guardInterval,
+                                    uint8_t nss,
+                                    WifiPhyBand band) {
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        txVector.SetPreambleType(preamble);
+        txVector.SetChannelWidth(channelWidth);
+        txVector.SetGuardInterval(guardInterval);
+        txVector.SetNss(nss);
+        txVector.SetNTx(nss);
+        txVector.SetStbc(false);
+        txVector.SetNess(0);
+        txVectors.emplace_back(txVector, band);
+    };
+    addTxVector(DsssPhy::GetDsssRate1Mbps(),
+                WIFI_PREAMBLE_LONG,
+                22,
+                800,
+                1,
+                WIFI_PHY_BAND_2_4GHZ);
+    addTxVector(DsssPhy::GetDsssRate11Mbps(),
+                WIFI_PREAMBLE_SHORT,
+                22,
+                800,
+                1,
+                WIFI_PHY_BAND_2_4GHZ);
+    addTxVector(ErpOfdmPhy::GetErpOfdmRate6Mbps(),
+                WIFI_PREAMBLE_LONG,
+                20,
+                800,
+                1,
+                WIFI_PHY_BAND_2_4GHZ);
+    addTxVector(OfdmPhy::GetOfdmRate54Mbps(), WIFI_PREAMBLE_LONG, 20, 800, 1, WIFI_PHY_BAND_5GHZ);
+    addTxVector(HtPhy::GetHtMcs7(), WIFI_PREAMBLE_HT_MF, 20, 800, 1, WIFI_PHY_BAND_2_4GHZ);
+    addTxVector(HtPhy::GetHtMcs15(), WIFI_PREAMBLE_HT_MF, 40, 400, 2, WIFI_PHY_BAND_5GHZ);
+    addTxVector(VhtPhy::GetVhtMcs9(), WIFI_PREAMBLE_VHT_SU, 80, 400, 2, WIFI_PHY_BAND_5GHZ);
+    addTxVector(HePhy::GetHeMcs11(), WIFI_PREAMBLE_HE_SU, 160, 800, 1, WIFI_PHY_BAND_6GHZ);
+    addTxVector(HePhy::GetHeMcs0(), WIFI_PREAMBLE_HE_ER_SU, 20, 3200, 1, WIFI_PHY_BAND_5GHZ);
+    addTxVector(EhtPhy::GetEhtMcs13(), WIFI_PREAMBLE_EHT_MU, 160, 800, 4, WIFI_PHY_BAND_6GHZ);
+    // the same TXVECTOR in another band may lead to a different TX duration
+    addTxVector(HtPhy::GetHtMcs7(), WIFI_PREAMBLE_HT_MF, 20, 800, 1, WIFI_PHY_BAND_5GHZ);
+    for (auto& [txVector, band] : txVectors)
+    {
+        if (txVector.GetModulationClass() == WIFI_MOD_CLASS_EHT)
+        {
+            txVector.SetEhtPpduType(1); // EHT SU transmission
+        }
+    }
+
+    // the PSDU sizes of an A-MPDU being built, MPDU by MPDU
+    std::vector<uint32_t> sizes;
+    for (uint32_t size = 1540; size < 65535; size += 1544)
+    {
+        sizes.push_back(size);
+    }
+
+    const bool enabled = WifiTxDurationCache::IsEnabled();
+
+    // TX durations computed without the cache
+    WifiTxDurationCache::Enable(false);
+    std::vector<Time> expected;
+    std::vector<Time> expectedPreambles;
+    for (const auto& [txVector, band] : txVectors)
+    {
+        NS_TEST_EXPECT_MSG_EQ(WifiTxDurationCache::GetKey(txVector, band).has_value(),
+                              false,
+                              "No key expected when the cache is disabled");
+        expectedPreambles.push_back(WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector));
+        for (auto size : sizes)
+        {
+            expected.push_back(WifiPhy::CalculateTxDuration(size, txVector, band));
+        }
+    }
+
+    WifiTxDurationCache::Enable(true);
+    WifiTxDurationCache::Clear();
+    // all the lookups miss the first time, and hit the second time
+    for (uint64_t pass = 1; pass <= 2; pass++)
+    {
+        auto expectedIt = expected.cbegin();
+        auto expectedPreambleIt = expectedPreambles.cbegin();
+        for (const auto& [txVector, band] : txVectors)
+        {
+            NS_TEST_EXPECT_MSG_EQ(WifiTxDurationCache::GetKey(txVector, band).has_value(),
+                                  true,
+                                  "Key expected for " << txVector);
+            NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector),
+                                  *expectedPreambleIt++,
+                                  "Unexpected preamble duration for " << txVector);
+            for (auto size : sizes)
+            {
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(size, txVector, band),
+                                      *expectedIt++,
+                                      "Unexpected TX duration for size " << size << " and "
+                                                                         << txVector);
+            }
+        }
+        const auto& counters = WifiTxDurationCache::GetTxDurationCounters();
+        NS_TEST_EXPECT_MSG_EQ(counters.hits,
+                              (pass - 1) * expected.size(),
+                              "Unexpected number of TX duration cache hits after pass " << pass);
+        NS_TEST_EXPECT_MSG_EQ(counters.misses,
+                              expected.size(),
+                              "Unexpected number of TX duration cache misses after pass " << pass);
+    }
+    NS_TEST_EXPECT_MSG_EQ(WifiTxDurationCache::GetTxDurationCounters().GetHitRate(),
+                          0.5,
+                          "Unexpected TX duration cache hit rate");
+    // the preamble duration is computed once for every TXVECTOR, except for the
+    // TXVECTOR used in two bands
+    NS_TEST_EXPECT_MSG_EQ(WifiTxDurationCache::GetPreambleAndHeaderCounters().misses,
+                          txVectors.size() - 1,
+                          "Unexpected number of preamble cache misses");
+
+    // TX durations of MU and punctured transmissions are not cached
+    WifiTxVector muTxVector;
+    muTxVector.SetPreambleType(WIFI_PREAMBLE_HE_MU);
+    muTxVector.SetChannelWidth(20);
+    muTxVector.SetGuardInterval(800);
+    muTxVector.SetHeMuUserInfo(1, {{HeRu::RU_242_TONE, 1, true}, 5, 1});
+    NS_TEST_EXPECT_MSG_EQ(WifiTxDurationCache::GetKey(muTxVector, WIFI_PHY_BAND_5GHZ).has_value(),
+                          false,
+                          "No key expected for an MU transmission");
+    WifiTxVector puncturedTxVector;
+    puncturedTxVector.SetMode(HePhy::GetHeMcs11());
+    puncturedTxVector.SetPreambleType(WIFI_PREAMBLE_HE_SU);
+    puncturedTxVector.SetChannelWidth(80);
+    puncturedTxVector.SetGuardInterval(800);
+    puncturedTxVector.SetInactiveSubchannels({false, true, false, false});
+    NS_TEST_EXPECT_MSG_EQ(
+        WifiTxDurationCache::GetKey(puncturedTxVector, WIFI_PHY_BAND_6GHZ).has_value(),
+        false,
+        "No key expected for a punctured transmission");
+
+    WifiTxDurationCache::Clear();
+    WifiTxDurationCache::Enable(enabled);
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1788,6 +1960,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 
     AddTestCase(new PhyHeaderSectionsTest, TestCase::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::QUICK);
+
     // 20 MHz band, even number of users per HE-SIG-B content channel
     AddTestCase(new HeSigBDurationTest(
                     {{{HeRu::RU_106_TONE, 1, true}, 11, 1}, {{HeRu::RU_106_TONE, 2, true}, 10, 4}},
@@ -25,11 +25,17 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
+#include "ns3/chunk-success-rate-table.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/dsss-phy.h"
+#include "ns3/eht-phy.h"
+#include "ns3/erp-ofdm-phy.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1039,6 +1045,123 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case for the lookup tables
+ *
+ * The success rates interpolated from the lookup tables by the NIST and YANS
+ * error rate models are checked against the success rates computed
+ * analytically, for DSSS, ERP-OFDM, OFDM, HE and EHT modes, various channel
+ * widths, chunk sizes and SNRs, including SNRs outside the tables. It is also
+ * checked that the tables are shared by all the error rate models.
+ */
+class WifiErrorRateModelsTestCaseLookupTables : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseLookupTables();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the success rates interpolated by an error rate model.
+     *
+     * \param analytic the error rate model computing the success rates analytically
+     * \param table the error rate model interpolating the success rates
+     * \param snrStep the step between the SNRs at which the success rates are checked (dB)
+     */
+    void CheckModel(Ptr<ErrorRateModel> analytic, Ptr<ErrorRateModel> table, double snrStep);
+};
+
+WifiErrorRateModelsTestCaseLookupTables::WifiErrorRateModelsTestCaseLookupTables()
+    : TestCase("WifiErrorRateModel test case lookup tables")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTables::CheckModel(Ptr<ErrorRateModel> analytic,
+                                                    Ptr<ErrorRateModel> table,
+                                                    double snrStep)
+{
+    const std::vector<WifiMode> modes{DsssPhy::GetDsssRate1Mbps(),
+                                      DsssPhy::GetDsssRate2Mbps(),
+                                      DsssPhy::GetDsssRate5_5Mbps(),
+                                      DsssPhy::GetDsssRate11Mbps(),
+                                      ErpOfdmPhy::GetErpOfdmRate6Mbps(),
+                                      OfdmPhy::GetOfdmRate9Mbps(),
+                                      OfdmPhy::GetOfdmRate54Mbps(),
+                                      HePhy::GetHeMcs0(),
+                                      HePhy::GetHeMcs1(),
+                                      HePhy::GetHeMcs2(),
+                                      HePhy::GetHeMcs3(),
+                                      HePhy::GetHeMcs4(),
+                                      HePhy::GetHeMcs5(),
+                                      HePhy::GetHeMcs6(),
+                                      HePhy::GetHeMcs7(),
+                                      HePhy::GetHeMcs8(),
+                                      HePhy::GetHeMcs9(),
+                                      HePhy::GetHeMcs10(),
+                                      HePhy::GetHeMcs11(),
+                                      EhtPhy::GetEhtMcs12(),
+                                      EhtPhy::GetEhtMcs13()};
+    for (const auto& mode : modes)
+    {
+        for (uint16_t width : {20, 160})
+        {
+            if (mode.GetModulationClass() < WIFI_MOD_CLASS_HE && width > 20)
+            {
+                continue;
+            }
+            WifiPreamble preamble = WIFI_PREAMBLE_LONG;
+            uint16_t guardInterval = 800;
+            if (mode.GetModulationClass() >= WIFI_MOD_CLASS_HE)
+            {
+                preamble = WIFI_PREAMBLE_HE_SU;
+                guardInterval = 3200;
+            }
+            WifiTxVector txVector(mode, 0, preamble, guardInterval, 1, 1, 0, width, false);
+            for (double snrDb = -30; snrDb <= 80; snrDb += snrStep)
+            {
+                double snr = DbToRatio(snrDb);
+                for (uint64_t nbits : {0, 1, 8 * 40, 8 * 1500, 8 * 65535})
+                {
+                    double expected = analytic->GetChunkSuccessRate(mode, txVector, snr, nbits);
+                    double value = table->GetChunkSuccessRate(mode, txVector, snr, nbits);
+                    NS_TEST_ASSERT_MSG_EQ_TOL(value,
+                                              expected,
+                                              5e-5,
+                                              "Unexpected success rate for mode "
+                                                  << mode << " width " << width << " SNR "
+                                                  << snrDb << "dB and " << nbits << " bits");
+                }
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTables::DoRun()
+{
+    for (const auto& model : {NistErrorRateModel::GetTypeId(), YansErrorRateModel::GetTypeId()})
+    {
+        ObjectFactory factory(model.GetName());
+        auto analytic = factory.Create<ErrorRateModel>();
+        factory.Set("UseLookupTables", BooleanValue(true));
+        auto table = factory.Create<ErrorRateModel>();
+        // the SNR step is not a multiple of the step of the tables
+        CheckModel(analytic, table, 0.071);
+
+        // another model must use the tables built for the first one
+        auto nTables = ChunkSuccessRateTable::GetNTables();
+        CheckModel(analytic, factory.Create<ErrorRateModel>(), 1.1);
+        NS_TEST_EXPECT_MSG_EQ(ChunkSuccessRateTable::GetNTables(),
+                              nTables,
+                              "The tables should be shared by all the error rate models");
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1057,6 +1180,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseLookupTables, TestCase::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
@@ -53,6 +53,7 @@
 #include "ns3/wifi-utils.h"
 
 #include <optional>
+#include <sstream>
 
 using namespace ns3;
 
@@ -3999,6 +4000,274 @@ TestAmpduReception::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Abstracted reception test
+ *
+ * The same sequence of HE SU A-MPDUs, some of them overlapped by an interfering
+ * PPDU that is too weak to be detected, is received by a PHY receiving PPDUs
+ * field by field and by a PHY whose reception is abstracted. The outcome of every
+ * reception (PHY header failure, or status of every MPDU) is checked to be the same
+ * for both PHYs, and the number of events executed by the simulator is checked to be
+ * reduced by the abstraction.
+ */
+class TestAbstractedReception : public WifiPhyReceptionTest
+{
+  public:
+    TestAbstractedReception();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+
+    /// A PPDU to receive, possibly overlapped by an interfering PPDU
+    struct Reception
+    {
+        Time start;                   //!< the start of the PPDU
+        double rxPowerDbm;            //!< the RX power of the PPDU in dBm
+        std::optional<Time> offset;   //!< the start of the interfering PPDU, if any, relatively
+                                      //!< to the start of the PPDU
+        double interferencePowerDbm; //!< the RX power of the interfering PPDU in dBm
+    };
+
+    /**
+     * Receive all the PPDUs of the scenario and record the outcome of their reception.
+     *
+     * \param abstractReception whether the reception of the PPDUs is abstracted
+     * \return the number of events executed by the simulator
+     */
+    uint64_t RunScenario(bool abstractReception);
+
+    /**
+     * Send a PPDU to the PHY.
+     *
+     * \param rxPowerDbm the RX power of the PPDU in dBm
+     * \param nMpdus the number of MPDUs in the PSDU
+     */
+    void SendPpdu(double rxPowerDbm, std::size_t nMpdus);
+
+    /**
+     * Callback triggered when a PSDU has been successfully received.
+     *
+     * \param psdu the PSDU
+     * \param rxSignalInfo the info on the received signal (\see RxSignalInfo)
+     * \param txVector the transmission parameters
+     * \param statusPerMpdu reception status per MPDU
+     */
+    void RxSuccess(Ptr<const WifiPsdu> psdu,
+                   RxSignalInfo rxSignalInfo,
+                   WifiTxVector txVector,
+                   std::vector<bool> statusPerMpdu);
+
+    /**
+     * Callback triggered when a PSDU has been unsuccessfully received.
+     *
+     * \param psdu the PSDU
+     */
+    void RxFailure(Ptr<const WifiPsdu> psdu);
+
+    /**
+     * Callback triggered when a packet has been dropped.
+     *
+     * \param p the packet
+     * \param reason the reason why the packet has been dropped
+     */
+    void RxDropped(Ptr<const Packet> p, WifiPhyRxfailureReason reason);
+
+    std::vector<Reception> m_receptions; //!< the PPDUs to receive
+    std::vector<std::string> m_outcomes; //!< the outcome of every reception
+    std::size_t m_nHeaderFailures{0};    //!< the number of PHY header failures
+    std::size_t m_nMpduFailures{0};      //!< the number of MPDUs received in error
+    std::size_t m_nMpduSuccesses{0};     //!< the number of MPDUs successfully received
+};
+
+TestAbstractedReception::TestAbstractedReception()
+    : WifiPhyReceptionTest("Abstracted reception test")
+{
+}
+
+void
+TestAbstractedReception::DoSetup()
+{
+    WifiPhyReceptionTest::DoSetup();
+
+    m_phy->SetReceiveOkCallback(MakeCallback(&TestAbstractedReception::RxSuccess, this));
+    m_phy->SetReceiveErrorCallback(MakeCallback(&TestAbstractedReception::RxFailure, this));
+    m_phy->TraceConnectWithoutContext("PhyRxDrop",
+                                      MakeCallback(&TestAbstractedReception::RxDropped, this));
+
+    // the interfering PPDUs are not detected
+    Ptr<ThresholdPreambleDetectionModel> preambleDetectionModel =
+        CreateObject<ThresholdPreambleDetectionModel>();
+    preambleDetectionModel->SetAttribute("MinimumRssi", DoubleValue(-82));
+    m_phy->SetPreambleDetectionModel(preambleDetectionModel);
+}
+
+void
+TestAbstractedReception::SendPpdu(double rxPowerDbm, std::size_t nMpdus)
+{
+    WifiTxVector txVector =
+        WifiTxVector(HePhy::GetHeMcs(2), 0, WIFI_PREAMBLE_HE_SU, 800, 1, 1, 0, 20, true);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+
+    std::vector<Ptr<WifiMpdu>> mpduList;
+    for (std::size_t i = 0; i < nMpdus; ++i)
+    {
+        mpduList.push_back(Create<WifiMpdu>(Create<Packet>(500), hdr));
+    }
+    Ptr<WifiPsdu> psdu = Create<WifiPsdu>(mpduList);
+
+    Time txDuration = m_phy->CalculateTxDuration(psdu->GetSize(), txVector, m_phy->GetPhyBand());
+
+    Ptr<WifiPpdu> ppdu =
+        Create<HePpdu>(psdu, txVector, m_phy->GetOperatingChannel(), txDuration, m_uid++);
+
+    Ptr<SpectrumValue> txPowerSpectrum =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(FREQUENCY,
+                                                                    CHANNEL_WIDTH,
+                                                                    DbmToW(rxPowerDbm),
+                                                                    GUARD_WIDTH);
+
+    Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters>();
+    txParams->psd = txPowerSpectrum;
+    txParams->txPhy = nullptr;
+    txParams->duration = txDuration;
+    txParams->ppdu = ppdu;
+    txParams->txWidth = CHANNEL_WIDTH;
+
+    m_phy->StartRx(txParams, nullptr);
+}
+
+void
+TestAbstractedReception::RxSuccess(Ptr<const WifiPsdu> psdu,
+                                   RxSignalInfo rxSignalInfo,
+                                   WifiTxVector txVector,
+                                   std::vector<bool> statusPerMpdu)
+{
+    NS_LOG_FUNCTION(this << *psdu << rxSignalInfo << txVector);
+    if (statusPerMpdu.empty()) // wait for the whole A-MPDU
+    {
+        return;
+    }
+    std::string outcome = "success ";
+    for (bool ok : statusPerMpdu)
+    {
+        outcome += ok ? '1' : '0';
+        ++(ok ? m_nMpduSuccesses : m_nMpduFailures);
+    }
+    m_outcomes.push_back(outcome);
+}
+
+void
+TestAbstractedReception::RxFailure(Ptr<const WifiPsdu> psdu)
+{
+    NS_LOG_FUNCTION(this << *psdu);
+    m_nMpduFailures += psdu->GetNMpdus();
+    m_outcomes.emplace_back("failure");
+}
+
+void
+TestAbstractedReception::RxDropped(Ptr<const Packet> p, WifiPhyRxfailureReason reason)
+{
+    NS_LOG_FUNCTION(this << p << reason);
+    if (reason == RXING || reason == BUSY_DECODING_PREAMBLE || reason == PREAMBLE_DETECT_FAILURE)
+    {
+        return; // interfering PPDU
+    }
+    m_nHeaderFailures++;
+    std::ostringstream oss;
+    oss << "drop " << reason;
+    m_outcomes.push_back(oss.str());
+}
+
+uint64_t
+TestAbstractedReception::RunScenario(bool abstractReception)
+{
+    m_phy->SetAttribute("AbstractReception", BooleanValue(abstractReception));
+    m_phy->AssignStreams(1);
+    m_outcomes.clear();
+    m_nHeaderFailures = 0;
+    m_nMpduFailures = 0;
+    m_nMpduSuccesses = 0;
+
+    for (const auto& reception : m_receptions)
+    {
+        Simulator::Schedule(reception.start,
+                            &TestAbstractedReception::SendPpdu,
+                            this,
+                            reception.rxPowerDbm,
+                            4);
+        if (reception.offset)
+        {
+            Simulator::Schedule(reception.start + *reception.offset,
+                                &TestAbstractedReception::SendPpdu,
+                                this,
+                                reception.interferencePowerDbm,
+                                1);
+        }
+    }
+    Simulator::Run();
+    uint64_t eventCount = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return eventCount;
+}
+
+void
+TestAbstractedReception::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    auto random = CreateObject<UniformRandomVariable>();
+    random->SetStream(0);
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        Reception reception;
+        reception.start = MilliSeconds(i + 1);
+        reception.rxPowerDbm = random->GetValue(-82, -72);
+        if (random->GetValue() < 0.7)
+        {
+            // the interfering PPDU starts after the preamble detection period and
+            // may overlap the PHY header fields or the payload (but does not start
+            // at the boundary between two fields)
+            reception.offset = MicroSeconds(random->GetInteger(5, 250)) + NanoSeconds(100);
+            reception.interferencePowerDbm = random->GetValue(-88, -83);
+        }
+        m_receptions.push_back(reception);
+    }
+
+    uint64_t detailedEventCount = RunScenario(false);
+    auto detailedOutcomes = m_outcomes;
+
+    // start again with a new PHY whose reception is abstracted
+    WifiPhyReceptionTest::DoTeardown();
+    DoSetup();
+    uint64_t abstractedEventCount = RunScenario(true);
+
+    NS_TEST_ASSERT_MSG_EQ(m_outcomes.size(),
+                          detailedOutcomes.size(),
+                          "Unexpected number of receptions with abstracted reception");
+    for (std::size_t i = 0; i < m_outcomes.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_outcomes[i],
+                              detailedOutcomes[i],
+                              "Unexpected outcome of reception #" << i);
+    }
+    NS_TEST_EXPECT_MSG_GT(m_nHeaderFailures, 0, "The PHY header failures were not tested");
+    NS_TEST_EXPECT_MSG_GT(m_nMpduFailures, 0, "The MPDU failures were not tested");
+    NS_TEST_EXPECT_MSG_GT(m_nMpduSuccesses, 0, "The MPDU successes were not tested");
+    NS_LOG_INFO("Events: " << detailedEventCount << " (detailed reception), "
+                           << abstractedEventCount << " (abstracted reception)");
+    NS_TEST_EXPECT_MSG_GT(detailedEventCount,
+                          3 * abstractedEventCount,
+                          "The number of events was not reduced enough");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -4875,6 +5144,7 @@ WifiPhyReceptionTestSuite::WifiPhyReceptionTestSuite()
     AddTestCase(new TestSimpleFrameCaptureModel, TestCase::QUICK);
     AddTestCase(new TestPhyHeadersReception, TestCase::QUICK);
     AddTestCase(new TestAmpduReception, TestCase::QUICK);
+    AddTestCase(new TestAbstractedReception, TestCase::QUICK);
     AddTestCase(new TestUnsupportedModulationReception(), TestCase::QUICK);
     AddTestCase(new TestUnsupportedBandwidthReception(), TestCase::QUICK);
     AddTestCase(new TestPrimary20CoveredByPpdu(), TestCase::QUICK);
@@ -24,6 +24,8 @@
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/frame-exchange-manager.h"
@@ -37,6 +39,7 @@
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-server.h"
 #include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/socket.h"
@@ -3535,6 +3538,183 @@ IdealRateManagerMimoTest::DoRun()
     Simulator::Destroy();
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Propagation loss model counting the computations of the received power
+ */
+class CountingPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    uint32_t m_count{0}; ///< number of computations of the received power
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+    int64_t DoAssignStreams(int64_t stream) override;
+};
+
+TypeId
+CountingPropagationLossModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::CountingPropagationLossModel")
+                            .SetParent<PropagationLossModel>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<CountingPropagationLossModel>();
+    return tid;
+}
+
+double
+CountingPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                            Ptr<MobilityModel> a,
+                                            Ptr<MobilityModel> b) const
+{
+    const_cast<CountingPropagationLossModel*>(this)->m_count++;
+    return txPowerDbm;
+}
+
+int64_t
+CountingPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return 0;
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the MaxRange attribute of YansWifiChannel
+ *
+ * A station broadcasts a packet every 100 ms for 10 seconds, whose preamble is
+ * detected up to about 50 meters away. The other stations are:
+ * - a station 20 meters away;
+ * - a station 1000 meters away;
+ * - a station moving from 1000 meters away towards the sender at 150 m/s;
+ * - a station 2000 meters away, moved 30 meters away after 5 seconds.
+ *
+ * The same packets must be received by each station whether the MaxRange
+ * attribute is set to 300 meters or not, while the received power must be
+ * computed for fewer stations when it is set.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+  public:
+    YansWifiChannelMaxRangeTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Run the simulation
+     * \param maxRange the value of the MaxRange attribute
+     * \param received the number of packets received by each station
+     * \return the number of computations of the received power
+     */
+    uint32_t Run(double maxRange, std::vector<uint32_t>& received);
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest()
+    : TestCase("Check the MaxRange attribute of YansWifiChannel")
+{
+}
+
+uint32_t
+YansWifiChannelMaxRangeTest::Run(double maxRange, std::vector<uint32_t>& received)
+{
+    NodeContainer nodes;
+    nodes.Create(5);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    positions->Add(Vector(20, 0, 0));
+    positions->Add(Vector(1000, 0, 0));
+    positions->Add(Vector(1000, 0, 0));
+    positions->Add(Vector(0, 2000, 0));
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    nodes.Get(3)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(Vector(-150, 0, 0));
+    Simulator::Schedule(Seconds(5),
+                        &MobilityModel::SetPosition,
+                        nodes.Get(4)->GetObject<MobilityModel>(),
+                        Vector(0, 30, 0));
+
+    Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel>();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    Ptr<CountingPropagationLossModel> counter = CreateObject<CountingPropagationLossModel>();
+    counter->SetNext(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationLossModel(counter);
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    received.assign(nodes.GetN(), 0);
+    for (uint32_t i = 1; i < nodes.GetN(); i++)
+    {
+        DynamicCast<WifiNetDevice>(devices.Get(i))
+            ->GetPhy()
+            ->TraceConnectWithoutContext(
+                "PhyRxEnd",
+                Callback<void, Ptr<const Packet>>([&received, i](Ptr<const Packet>) {
+                    received[i]++;
+                }));
+    }
+
+    Ptr<NetDevice> sender = devices.Get(0);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Simulator::Schedule(MilliSeconds(100 * i) + MicroSeconds(1), [sender]() {
+            sender->Send(Create<Packet>(100), sender->GetBroadcast(), 1);
+        });
+    }
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+    return counter->m_count;
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun()
+{
+    std::vector<uint32_t> all;
+    std::vector<uint32_t> inRange;
+    uint32_t allCount = Run(0, all);
+    uint32_t inRangeCount = Run(300, inRange);
+
+    NS_TEST_EXPECT_MSG_EQ(all[1], 100, "The close station must receive all the packets");
+    NS_TEST_EXPECT_MSG_EQ(all[2], 0, "The far station must not receive any packet");
+    NS_TEST_EXPECT_MSG_GT(all[3], 0, "The moving station must receive some packets");
+    NS_TEST_EXPECT_MSG_LT(all[3], 100, "The moving station must not receive all the packets");
+    NS_TEST_EXPECT_MSG_EQ(all[4], 50, "The moved station must receive half the packets");
+    for (std::size_t i = 0; i < all.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(inRange[i],
+                              all[i],
+                              "Different packets received by station " << i
+                                                                       << " with MaxRange set");
+    }
+    NS_TEST_EXPECT_MSG_EQ(allCount, 400, "The received power must be computed for all stations");
+    NS_TEST_EXPECT_MSG_LT(inRangeCount, 300, "The far stations must be culled with MaxRange set");
+}
+
 //-----------------------------------------------------------------------------
 /**
  * \ingroup wifi-test
@@ -3810,6 +3990,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new Bug2470TestCase, TestCase::QUICK);            // Bug 2470
     AddTestCase(new Issue40TestCase, TestCase::QUICK);            // Issue #40
     AddTestCase(new Issue169TestCase, TestCase::QUICK);           // Issue #169
+    AddTestCase(new YansWifiChannelMaxRangeTest, TestCase::QUICK);
     AddTestCase(new IdealRateManagerChannelWidthTest, TestCase::QUICK);
     AddTestCase(new IdealRateManagerMimoTest, TestCase::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::QUICK);
@@ -25,6 +25,8 @@
 #include "ns3/wifi-standards.h"
 
 #include <cmath>
+#include <functional>
+#include <string>
 
 using namespace ns3;
 
@@ -306,6 +308,121 @@ WifiOfdmMaskSlopesTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test checks that the transmit PSDs built by WifiSpectrumValueHelper for
+ * the same parameters are equal, and that modifying a returned PSD does not modify
+ * the PSDs returned afterwards.
+ */
+class WifiTxPsdTemplateTestCase : public TestCase
+{
+  public:
+    WifiTxPsdTemplateTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the given transmit PSDs are distinct objects holding the same values.
+     *
+     * \param first the first transmit PSD
+     * \param second the second transmit PSD
+     * \param name the name of the transmit PSDs
+     */
+    void CheckEqual(Ptr<const SpectrumValue> first,
+                    Ptr<const SpectrumValue> second,
+                    const std::string& name);
+};
+
+WifiTxPsdTemplateTestCase::WifiTxPsdTemplateTestCase()
+    : TestCase("Check the transmit PSDs copied from the previously built ones")
+{
+}
+
+void
+WifiTxPsdTemplateTestCase::CheckEqual(Ptr<const SpectrumValue> first,
+                                      Ptr<const SpectrumValue> second,
+                                      const std::string& name)
+{
+    NS_TEST_EXPECT_MSG_NE(first, second, name << ": the same PSD object is returned twice");
+    NS_TEST_ASSERT_MSG_EQ(first->GetSpectrumModelUid(),
+                          second->GetSpectrumModelUid(),
+                          name << ": unexpected spectrum model");
+    NS_TEST_ASSERT_MSG_EQ(first->GetValuesN(), second->GetValuesN(), name);
+    for (uint32_t i = 0; i < first->GetValuesN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((*first)[i], (*second)[i], name << ": mismatch for subcarrier " << i);
+    }
+}
+
+void
+WifiTxPsdTemplateTestCase::DoRun()
+{
+    const double txPowerW = 0.1;
+    auto ofdm = [=](double powerW) {
+        return WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(5180, 20, powerW, 20);
+    };
+    auto ht = [=](double powerW) {
+        return WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(5190, 40, powerW, 40);
+    };
+    auto duplicated = [=](double powerW) {
+        return WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
+            5210,
+            80,
+            powerW,
+            80,
+            -20.0,
+            -28.0,
+            -40.0,
+            {false, true, false, false});
+    };
+    auto he = [=](double powerW) {
+        return WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5250, 160, powerW, 160);
+    };
+
+    for (const auto& [name, create] :
+         std::initializer_list<std::pair<std::string, std::function<Ptr<SpectrumValue>(double)>>>{
+             {"OFDM", ofdm},
+             {"HT", ht},
+             {"Duplicated 20 MHz", duplicated},
+             {"HE", he}})
+    {
+        auto first = create(txPowerW);
+        auto second = create(txPowerW);
+        CheckEqual(first, second, name);
+
+        // the values of the PSDs returned afterwards must not change
+        *first *= 2;
+        auto third = create(txPowerW);
+        CheckEqual(second, third, name);
+
+        // the PSD built for another transmit power has other values
+        auto other = create(2 * txPowerW);
+        NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*other),
+                                  2 * txPowerW,
+                                  1e-6,
+                                  name << ": unexpected power");
+    }
+
+    // the punctured subchannels are taken into account
+    auto unpunctured =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210, 80, txPowerW, 80);
+    auto punctured =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210,
+                                                                    80,
+                                                                    txPowerW,
+                                                                    80,
+                                                                    -20.0,
+                                                                    -28.0,
+                                                                    -40.0,
+                                                                    {false, true, false, false});
+    NS_TEST_EXPECT_MSG_LT(WifiSpectrumValueHelper::GetBandPowerW(punctured, {1280, 1535}),
+                          WifiSpectrumValueHelper::GetBandPowerW(unpunctured, {1280, 1535}) / 10,
+                          "The second 20 MHz subchannel should be punctured");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1318,4 +1435,6 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite()
                                                prec,
                                                {0, 0, 0, 0, 0, 0, 1, 1}),
                 TestCase::QUICK);
+
+    AddTestCase(new WifiTxPsdTemplateTestCase, TestCase::QUICK);
 }